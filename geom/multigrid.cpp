@@ -35,7 +35,9 @@
 
 #include "geom/multigrid.h"
 #include "num/solver.h"
+#include "misc/instrument.h"
 #include <set>
+#include <limits>
 
 namespace DROPS
 {
@@ -150,7 +152,7 @@ void PeriodicEdgesCL::AccumulateMFR( int lvl)
 
 
 MultiGridCL::MultiGridCL (const MGBuilderCL& Builder)
-    : _TriangVertex( *this), _TriangEdge( *this), _TriangFace( *this), _TriangTetra( *this), _version(0)
+    : _TriangVertex( *this), _TriangEdge( *this), _TriangFace( *this), _TriangTetra( *this), _version(0), _cacheGeometry( false)
 {
     Builder.build(this);
     FinalizeModify();
@@ -167,15 +169,50 @@ void MultiGridCL::ClearTriangCache ()
     _TriangFace.clear();
     _TriangTetra.clear();
 
-    for (std::map<int, ColorClassesCL*>::iterator it= _colors.begin(), end= _colors.end(); it != end; ++it)
-        delete it->second;
+    // the colorings are kept for recoloring after the modification of the multigrid
+    for (std::map<int, ColorClassesCL*>::iterator it= _colors.begin(), end= _colors.end(); it != end; ++it) {
+        std::map<int, ColorClassesCL*>::iterator prev= _prevColors.find( it->first);
+        if (prev != _prevColors.end())
+            delete prev->second;
+        it->second->clear_tetras();
+        _prevColors[it->first]= it->second;
+    }
     _colors.clear();
+    ClearGeometryCache();
+}
+
+void MultiGridCL::ClearPrevColors ()
+{
+    for (std::map<int, ColorClassesCL*>::iterator it= _prevColors.begin(), end= _prevColors.end(); it != end; ++it)
+        delete it->second;
+    _prevColors.clear();
+}
+
+void MultiGridCL::ClearGeometryCache () const
+{
+    for (std::map<int, TetraGeometryCacheCL*>::iterator it= _geometry.begin(), end= _geometry.end(); it != end; ++it)
+        delete it->second;
+    _geometry.clear();
 }
 
 void MultiGridCL::CloseGrid(Uint Level)
 {
     Comment("Closing grid " << Level << "." << std::endl, DebugRefineEasyC);
 
+#if !defined(_PAR) && defined(_OPENMP)
+    // Close only reads the marks of the edges and sets the mark of the tetra itself.
+    if (omp_get_max_threads() > 1) {
+        std::vector<TetraCL*> tetras;
+        for (TetraIterator tIt(_Tetras[Level].begin()), tEnd(_Tetras[Level].end()); tIt!=tEnd; ++tIt)
+            if ( tIt->IsRegular() && !tIt->IsMarkedForRegRef() )
+                tetras.push_back( &*tIt);
+#       pragma omp parallel for
+        for (int i= 0; i < static_cast<int>( tetras.size()); ++i)
+            tetras[i]->Close();
+        Comment("Closing grid " << Level << " done." << std::endl, DebugRefineEasyC);
+        return;
+    }
+#endif
     for (TetraIterator tIt(_Tetras[Level].begin()), tEnd(_Tetras[Level].end()); tIt!=tEnd; ++tIt)
     {
 #ifdef _PAR
@@ -434,6 +471,11 @@ void MultiGridCL::RefineGrid (Uint Level)
     const Uint nextLevel(Level+1);
     if ( Level==GetLastLevel() ) AppendLevel();
 
+#if !defined(_PAR) && defined(_OPENMP) && !defined(DROPS_WIN)
+    if (omp_get_max_threads() > 1)
+        RefineGridParallel( Level);
+    else
+#endif
     for (TetraIterator tIt(_Tetras[Level].begin()), tEnd(_Tetras[Level].end()); tIt!=tEnd; ++tIt)
     {
         if ( tIt->IsMarkEqRule() ) continue;
@@ -480,8 +522,171 @@ void MultiGridCL::RefineGrid (Uint Level)
 }
 
 
+#if !defined(_PAR) && defined(_OPENMP) && !defined(DROPS_WIN)
+namespace {
+
+/// \brief Maps simplices in the buffers of RefineGridParallel to their position.
+template <class SimplexT>
+class BufferMapCL
+{
+  private:
+    typedef std::list<SimplexT> ContT;
+    typedef std::pair<ContT*, typename ContT::iterator> PosT;
+    std::tr1::unordered_map<const SimplexT*, PosT> map_;
+
+  public:
+    BufferMapCL (std::vector<ContT>& buffers) {
+        for (size_t i= 0; i < buffers.size(); ++i)
+            for (typename ContT::iterator it= buffers[i].begin(), end= buffers[i].end(); it != end; ++it)
+                map_[&*it]= PosT( &buffers[i], it);
+    }
+    /// \brief Moves p to the end of level, if p is still in a buffer.
+    void MoveTo (ContT& level, const SimplexT* p) {
+        typename std::tr1::unordered_map<const SimplexT*, PosT>::iterator it= map_.find( p);
+        if (it == map_.end())
+            return;
+        level.splice( level.end(), *it->second.first, it->second.second);
+        map_.erase( it);
+    }
+    bool empty () const { return map_.empty(); }
+};
+
+} // end of anonymous namespace
+
+void MultiGridCL::RefineGridParallel (Uint Level)
+/** The children of the tetras on Level are created in four steps:
+    -# Serially in the order of the tetra list: The refinement rules are set and the midvertices and
+       subedges of all edges, which are marked for refinement but not yet refined, are built. Thus, the
+       vertices are created in the same order as by the serial algorithm.
+    -# The tetras to be refined are colored greedily such that tetras of the same color have no common vertex.
+       Hence, they do not share edges, faces, midvertices or recycle bins.
+    -# For each color in parallel: The inner edges, faces and children are collected. New simplices
+       are stored in buffers of the parent tetra; the scratch arrays of TetraCL are threadprivate.
+    -# Serially in the order of the tetra list: The simplices are moved from the buffers to the containers
+       of the next level and the new children are numbered.
+
+    The resulting multigrid (including the order of the simplices and the ids) is the same as for the
+    serial algorithm, independent of the number of threads.
+*/
+{
+    const Uint nextLevel= Level+1;
+
+    std::vector<TetraCL*> work;
+    for (TetraIterator tIt(_Tetras[Level].begin()), tEnd(_Tetras[Level].end()); tIt!=tEnd; ++tIt)
+    {
+        if ( tIt->IsMarkEqRule() ) continue;
+
+        tIt->SetRefRule( tIt->GetRefMark() );
+        if ( tIt->IsMarkedForNoRef() )
+        {
+            if ( tIt->_Children )
+                { delete tIt->_Children; tIt->_Children=0; }
+        }
+        else
+            work.push_back( &*tIt);
+    }
+    const int num_work= work.size();
+    std::vector<TetraCL::EdgeContT>  edges( num_work);
+    std::vector<TetraCL::FaceContT>  faces( num_work);
+    std::vector<TetraCL::TetraContT> children( num_work);
+
+    // build midvertices and subedges; they are found in the recycle bins by TetraCL::CollectEdges
+    for (int i= 0; i < num_work; ++i)
+        for (Uint edge= 0; edge < NumEdgesC; ++edge)
+        {
+            EdgeCL* const ep= work[i]->_Edges[edge];
+            if ( ep->IsMarkedForRef() && !ep->IsRefined() )
+            {
+                ep->BuildSubEdges( edges[i], _Vertices[nextLevel], _Bnd);
+                TetraCL::EdgeContT::iterator sub= edges[i].end();
+                (--sub)->RecycleMe();
+                (--sub)->RecycleMe();
+            }
+        }
+
+    // greedy coloring
+    typedef std::tr1::unordered_map<const VertexCL*, std::vector<int> > VertexColorMapT;
+    VertexColorMapT vertColors;
+    std::vector<std::vector<int> > colors;
+    std::vector<bool> used;
+    for (int i= 0; i < num_work; ++i)
+    {
+        used.assign( colors.size() + 1, false);
+        std::vector<int>* vc[NumVertsC];
+        for (Uint v= 0; v < NumVertsC; ++v)
+        {
+            vc[v]= &vertColors[work[i]->_Vertices[v]];
+            for (size_t k= 0; k < vc[v]->size(); ++k)
+                used[(*vc[v])[k]]= true;
+        }
+        const size_t c= std::find( used.begin(), used.end(), false) - used.begin();
+        if (c == colors.size())
+            colors.push_back( std::vector<int>());
+        colors[c].push_back( i);
+        for (Uint v= 0; v < NumVertsC; ++v)
+            vc[v]->push_back( static_cast<int>( c));
+    }
+    Comment("Refining grid " << Level << " with " << colors.size() << " colors." << std::endl, DebugRefineEasyC);
+
+    for (size_t c= 0; c < colors.size(); ++c)
+    {
+        const std::vector<int>& color= colors[c];
+#       pragma omp parallel for schedule(dynamic, 16)
+        for (int k= 0; k < static_cast<int>( color.size()); ++k)
+        {
+            TetraCL* const t= work[color[k]];
+            const RefRuleCL& refrule( t->GetRefData() );
+            // all subedges exist, thus no vertex is created
+            t->CollectEdges           (refrule, _Vertices[nextLevel], edges[color[k]], _Bnd);
+            t->CollectFaces           (refrule, faces[color[k]]);
+            t->CollectAndLinkChildren (refrule, children[color[k]], /*newIds*/ false);
+        }
+    }
+
+    // An edge or face on a common face of two parents is created by the parent with the smaller color.
+    // The serial algorithm creates it with the first parent in list order, hence the simplices are
+    // moved to the level in the order in which they are used by the parents.
+    BufferMapCL<EdgeCL> edgeMap( edges);
+    BufferMapCL<FaceCL> faceMap( faces);
+    for (int i= 0; i < num_work; ++i)
+    {
+        TetraCL* const t= work[i];
+        const RefRuleCL& refrule( t->GetRefData() );
+        for (Uint edge= 0; edge < NumEdgesC; ++edge)
+        {
+            EdgeCL* const ep= t->_Edges[edge];
+            if ( ep->IsMarkedForRef() )
+            {
+                edgeMap.MoveTo( _Edges[nextLevel], t->_Vertices[VertOfEdge(edge, 0)]->FindEdge( ep->GetMidVertex()));
+                edgeMap.MoveTo( _Edges[nextLevel], ep->GetMidVertex()->FindEdge( t->_Vertices[VertOfEdge(edge, 1)]));
+            }
+        }
+        for (const byte* e= std::lower_bound( refrule.Edges, refrule.Edges + refrule.EdgeNum, static_cast<byte>( NumObviousEdgesC));
+            e != refrule.Edges + refrule.EdgeNum; ++e)
+            edgeMap.MoveTo( _Edges[nextLevel], t->GetVertMidVert( VertOfEdge(*e, 0))->FindEdge( t->GetVertMidVert( VertOfEdge(*e, 1))));
+        for (Uint f= 0; f < refrule.FaceNum; ++f)
+        {
+            const Uint face= refrule.Faces[f];
+            if ( !IsParentFace( face) )
+                faceMap.MoveTo( _Faces[nextLevel], t->GetVertMidVert( VertOfFace(face, 0))->FindFace(
+                    t->GetVertMidVert( VertOfFace(face, 1)), t->GetVertMidVert( VertOfFace(face, 2))));
+        }
+        for (TetraCL::TetraContT::iterator it= children[i].begin(), end= children[i].end(); it != end; ++it)
+            it->_Id= IdCL<TetraCL>();
+        _Tetras[nextLevel].splice( _Tetras[nextLevel].end(), children[i]);
+    }
+    Assert( edgeMap.empty() && faceMap.empty(), DROPSErrCL("MultiGridCL::RefineGridParallel: unused simplices"), DebugRefineEasyC);
+    for (int i= 0; i < num_work; ++i) // empty, if all simplices have been found above
+    {
+        _Edges[nextLevel].splice( _Edges[nextLevel].end(), edges[i]);
+        _Faces[nextLevel].splice( _Faces[nextLevel].end(), faces[i]);
+    }
+}
+#endif
+
 void MultiGridCL::Refine()
 {
+    DROPS_REGION( "Refine");
 #ifndef _PAR
     PeriodicEdgesCL perEdges( *this);
 #endif
@@ -575,6 +780,7 @@ void MultiGridCL::Scale( double s)
     for (VertexIterator it= GetAllVertexBegin(), end= GetAllVertexEnd();
         it!=end; ++it)
         it->_Coord*= s;
+    ClearGeometryCache();
 }
 
 void MultiGridCL::Transform( Point3DCL (*mapping)(const Point3DCL&))
@@ -582,6 +788,7 @@ void MultiGridCL::Transform( Point3DCL (*mapping)(const Point3DCL&))
     for (VertexIterator it= GetAllVertexBegin(), end= GetAllVertexEnd();
         it!=end; ++it)
         it->_Coord= mapping(it->_Coord);
+    ClearGeometryCache();
 }
 
 class VertPtrLessCL : public std::binary_function<const VertexCL*, const VertexCL* , bool>
@@ -1191,6 +1398,127 @@ LocatorCL::Locate(LocationCL& loc, const MultiGridCL& MG, int trilevel, const Po
     loc._Tetra= 0; std::fill(b.begin(), b.end(), 0.);
 }
 
+void LocatorIndexCL::Build()
+{
+    const int lvl= mg_.GetTriangTetra().StdIndex( lvl_);
+    tetras_.clear();
+    DROPS_FOR_TRIANG_CONST_TETRA( mg_, lvl, it)
+        tetras_.push_back( &*it);
+    const Uint numTetra= tetras_.size();
+
+    // affine maps to barycentric coordinates and bounding boxes of the tetras
+    baryMap_.resize( 12*numTetra);
+    std::vector<Point3DCL> tmin( numTetra), tmax( numTetra);
+    bbmin_= Point3DCL( std::numeric_limits<double>::max());
+    bbmax_= Point3DCL( -std::numeric_limits<double>::max());
+    SMatrixCL<3,3> T;
+    double det;
+    for (Uint t= 0; t < numTetra; ++t) {
+        const TetraCL& tet= *tetras_[t];
+        GetTrafoTr( T, det, tet);
+        double* m= &baryMap_[12*t];
+        const Point3DCL& v0= tet.GetVertex( 0)->GetCoord();
+        for (int i= 0; i < 3; ++i) {
+            m[i]= v0[i];
+            for (int j= 0; j < 3; ++j)
+                m[3 + 3*i + j]= T( j, i);
+        }
+        tmin[t]= tmax[t]= v0;
+        for (int v= 1; v < 4; ++v) {
+            const Point3DCL& c= tet.GetVertex( v)->GetCoord();
+            for (int i= 0; i < 3; ++i) {
+                tmin[t][i]= std::min( tmin[t][i], c[i]);
+                tmax[t][i]= std::max( tmax[t][i], c[i]);
+            }
+        }
+        for (int i= 0; i < 3; ++i) {
+            bbmin_[i]= std::min( bbmin_[i], tmin[t][i]);
+            bbmax_[i]= std::max( bbmax_[i], tmax[t][i]);
+        }
+    }
+
+    // uniform grid with about one tetra per cell
+    const Point3DCL ext= bbmax_ - bbmin_;
+    const double vol= std::max( ext[0], 1e-300)*std::max( ext[1], 1e-300)*std::max( ext[2], 1e-300),
+                 h= std::pow( vol/std::max( numTetra, 1u), 1./3.);
+    for (int i= 0; i < 3; ++i) {
+        n_[i]= std::max( 1u, static_cast<Uint>( std::min( ext[i]/h, 1024.)));
+        hinv_[i]= ext[i] > 0. ? n_[i]/ext[i] : 0.;
+    }
+
+    // sort the tetras into the cells (counting sort)
+    cellBegin_.assign( n_[0]*n_[1]*n_[2] + 1, 0);
+    std::vector<size_t> pos;
+    for (int pass= 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            for (size_t c= 1; c < cellBegin_.size(); ++c)
+                cellBegin_[c]+= cellBegin_[c-1];
+            cellTetra_.resize( cellBegin_.back());
+            pos.assign( cellBegin_.begin(), cellBegin_.end() - 1);
+        }
+        for (Uint t= 0; t < numTetra; ++t) {
+            const Uint lo[3]= { Cell( tmin[t][0], 0), Cell( tmin[t][1], 1), Cell( tmin[t][2], 2) },
+                       hi[3]= { Cell( tmax[t][0], 0), Cell( tmax[t][1], 1), Cell( tmax[t][2], 2) };
+            for (Uint k= lo[2]; k <= hi[2]; ++k)
+                for (Uint j= lo[1]; j <= hi[1]; ++j)
+                    for (Uint i= lo[0]; i <= hi[0]; ++i) {
+                        const size_t c= (k*n_[1] + j)*n_[0] + i;
+                        if (pass == 0)
+                            ++cellBegin_[c + 1];
+                        else
+                            cellTetra_[pos[c]++]= t;
+                    }
+        }
+    }
+    version_= mg_.GetVersion();
+}
+
+void LocatorIndexCL::ToBary( Uint t, const Point3DCL& p, SVectorCL<4>& b) const
+{
+    const double* m= &baryMap_[12*t];
+    const double d[3]= { p[0] - m[0], p[1] - m[1], p[2] - m[2] };
+    b[0]= 1.;
+    for (int i= 0; i < 3; ++i) {
+        b[i+1]= m[3 + 3*i]*d[0] + m[4 + 3*i]*d[1] + m[5 + 3*i]*d[2];
+        b[0]-= b[i+1];
+    }
+}
+
+bool LocatorIndexCL::Locate (LocationCL& loc, const Point3DCL& p, double tol) const
+{
+    Assert( version_ == mg_.GetVersion(), DROPSErrCL( "LocatorIndexCL::Locate: Index is outdated, call Update()."), DebugContainerC);
+    SVectorCL<4> b;
+    for (int i= 0; i < 3; ++i)
+        if (p[i] < bbmin_[i] - tol || p[i] > bbmax_[i] + tol) {
+            loc= LocationCL();
+            return false;
+        }
+    const size_t c= (Cell( p[2], 2)*n_[1] + Cell( p[1], 1))*n_[0] + Cell( p[0], 0);
+    for (size_t i= cellBegin_[c]; i < cellBegin_[c + 1]; ++i) {
+        ToBary( cellTetra_[i], p, b);
+        if (b[0] >= -tol && b[1] >= -tol && b[2] >= -tol && b[3] >= -tol) {
+            loc= LocationCL( tetras_[cellTetra_[i]], b);
+            return true;
+        }
+    }
+    loc= LocationCL();
+    return false;
+}
+
+void LocatorIndexCL::Locate (std::vector<LocationCL>& loc, const std::vector<Point3DCL>& p, double tol) const
+{
+    loc.resize( p.size());
+#pragma omp parallel for schedule(static)
+    for (int i= 0; i < static_cast<int>( p.size()); ++i)
+        Locate( loc[i], p[i], tol);
+}
+
+size_t LocatorIndexCL::memory() const
+{
+    return tetras_.capacity()*sizeof( const TetraCL*) + baryMap_.capacity()*sizeof( double)
+        + cellBegin_.capacity()*sizeof( size_t) + cellTetra_.capacity()*sizeof( Uint);
+}
+
 void MarkAll (DROPS::MultiGridCL& mg)
 {
     DROPS_FOR_TRIANG_TETRA( mg, /*default-level*/-1, It)
@@ -1250,14 +1578,10 @@ std::string PrioToString(Uint prio)
 #endif
 
 
-void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin,
-                                        MultiGridCL::const_TriangTetraIteratorCL end,
-                                        std::vector<TetraNumVecT>& neighbors, match_fun match, const BndCondCL& Bnd)
+void ColorClassesCL::compute_vertex_map (MultiGridCL::const_TriangTetraIteratorCL begin,
+                                         MultiGridCL::const_TriangTetraIteratorCL end,
+                                         VertexMapT& vertexMap, match_fun match, const BndCondCL& Bnd)
 {
-    const size_t num_tetra= std::distance( begin, end);
-
-    typedef std::tr1::unordered_map<const VertexCL*, TetraNumVecT> VertexMapT;
-    VertexMapT vertexMap;
     // Collect all tetras, that have vertex v in vertexMap[v].
     for (MultiGridCL::const_TriangTetraIteratorCL sit= begin; sit != end; ++sit)
         for (int i= 0; i < 4; ++i)
@@ -1291,55 +1615,234 @@ void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL
     	}
     	if (!listper2.empty()) throw DROPSErrCL ( "ColorClassesCL::compute_neighbors : Periodic boundaries do not match!");
     }
+}
 
-    // For every tetra j, store all neighboring tetras in neighbors[j].
-    typedef std::set<size_t> TetraNumSetT;
-    std::vector<TetraNumSetT> neighborsets( num_tetra);
-#   pragma omp parallel
-    {
+void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin, const VertexMapT& vertexMap,
+                                        const TetraNumVecT& todo, std::vector<TetraNumVecT>& neighbors)
+{
+    // For every tetra j in todo, store all neighboring tetras (without j) in neighbors[j].
+#ifndef DROPS_WIN
+    size_t k;
+#else
+    int k;
+#endif
+#   pragma omp parallel for schedule(dynamic, 256)
+    for (k= 0; k < todo.size(); ++k) {
+        const size_t j= todo[k];
+        TetraNumVecT& n= neighbors[j];
+        for (int i= 0; i < 4; ++i) {
+            const TetraNumVecT& tetra_nums= vertexMap.find( (begin + j)->GetVertex( i))->second;
+            n.insert( n.end(), tetra_nums.begin(), tetra_nums.end());
+        }
+        std::sort( n.begin(), n.end());
+        n.erase( std::unique( n.begin(), n.end()), n.end());
+        n.erase( std::lower_bound( n.begin(), n.end(), j));
+    }
+}
+
+void ColorClassesCL::check_old_colors (const VertexMapT& vertexMap, std::vector<int>& color)
+/// For each vertex the colors of the adjacent tetras must be different. Of the tetras with the same color,
+/// the first one keeps it.
+{
+    std::vector<std::pair<int, size_t> > colored;
+    for (VertexMapT::const_iterator it= vertexMap.begin(); it != vertexMap.end(); ++it) {
+        colored.clear();
+        for (TetraNumVecT::const_iterator t= it->second.begin(); t != it->second.end(); ++t)
+            if (color[*t] >= 0)
+                colored.push_back( std::make_pair( color[*t], *t));
+        std::sort( colored.begin(), colored.end());
+        for (size_t i= 1; i < colored.size(); ++i)
+            if (colored[i].first == colored[i-1].first && colored[i].second != colored[i-1].second)
+                color[colored[i].second]= -1;
+    }
+}
+
+void ColorClassesCL::color_greedy (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color)
+/// Each tetra gets the least frequently used color, which is not used by a neighbor.
+{
+    std::vector<size_t> frequency; // number of tetras for each color
+    for (size_t j= 0; j < color.size(); ++j)
+        if (color[j] >= 0) {
+            if (static_cast<size_t>( color[j]) >= frequency.size())
+                frequency.resize( color[j] + 1, 0);
+            ++frequency[color[j]];
+        }
+    std::vector<size_t> used( frequency.size(), 0); // used[c]==j+1 iff a neighbor of j has color c
+    for (TetraNumVecT::const_iterator jt= todo.begin(); jt != todo.end(); ++jt) {
+        const size_t j= *jt;
+        for (TetraNumVecT::const_iterator n= neighbors[j].begin(); n != neighbors[j].end(); ++n)
+            if (color[*n] >= 0)
+                used[color[*n]]= j + 1;
+        int c= -1;
+        for (size_t i= 0; i < frequency.size(); ++i)
+            if (used[i] != j + 1 && (c < 0 || frequency[i] < frequency[c]))
+                c= i;
+        if (c < 0) { // Add new color
+            c= frequency.size();
+            frequency.push_back( 0);
+            used.push_back( 0);
+        }
+        color[j]= c;
+        ++frequency[c];
+    }
+}
+
+namespace {
+
+/// \brief Pseudo random weight of the j-th tetra for the Jones-Plassmann coloring (integer hash of j).
+inline Uint jp_weight (size_t j)
+{
+    Uint x= static_cast<Uint>( j);
+    x= ((x >> 16) ^ x)*0x45d9f3bu;
+    x= ((x >> 16) ^ x)*0x45d9f3bu;
+    return (x >> 16) ^ x;
+}
+
+/// \brief Order of the tetras in the Jones-Plassmann coloring; ties are broken by the number of the tetra.
+inline bool jp_less (size_t i, size_t j)
+{
+    const Uint wi= jp_weight( i), wj= jp_weight( j);
+    return wi < wj || (wi == wj && i < j);
+}
+
+} // end of anonymous namespace
+
+void ColorClassesCL::color_jones_plassmann (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color)
+/// In each round, the uncolored tetras, which have a larger weight than all their uncolored neighbors, form an
+/// independent set. They are colored in parallel with the smallest color, which is not used by a neighbor.
+/// The result does not depend on the number of threads.
+{
+    TetraNumVecT active( todo);
+    std::vector<char> selected;
+    while (!active.empty()) {
+        selected.assign( active.size(), 0);
 #ifndef DROPS_WIN
-        size_t j;
+        size_t k;
 #else
-        int j;
+        int k;
 #endif
-#       pragma omp for
-        for (j= 0; j < num_tetra; ++j)
-            for (int i= 0; i < 4; ++i) {
-                const TetraNumVecT& tetra_nums= vertexMap[(begin + j)->GetVertex( i)];
-                neighborsets[j].insert( tetra_nums.begin(), tetra_nums.end());
+#       pragma omp parallel
+        {
+            std::vector<int> used;
+#           pragma omp for schedule(dynamic, 256)
+            for (k= 0; k < active.size(); ++k) {
+                const size_t j= active[k];
+                bool is_max= true;
+                for (TetraNumVecT::const_iterator n= neighbors[j].begin(); is_max && n != neighbors[j].end(); ++n)
+                    if (color[*n] < 0 && jp_less( j, *n))
+                        is_max= false;
+                selected[k]= is_max;
+            }
+#           pragma omp for schedule(dynamic, 256)
+            for (k= 0; k < active.size(); ++k) {
+                if (!selected[k]) continue;
+                const size_t j= active[k];
+                used.clear();
+                for (TetraNumVecT::const_iterator n= neighbors[j].begin(); n != neighbors[j].end(); ++n)
+                    if (color[*n] >= 0)
+                        used.push_back( color[*n]);
+                std::sort( used.begin(), used.end());
+                int c= 0;
+                for (std::vector<int>::const_iterator u= used.begin(); u != used.end() && *u <= c; ++u)
+                    if (*u == c) ++c;
+                color[j]= c;
             }
-#       pragma omp for
-        for (j= 0; j < num_tetra; ++j) {
-            neighbors[j].resize( neighborsets[j].size());
-            std::copy( neighborsets[j].begin(), neighborsets[j].end(), neighbors[j].begin());
         }
+        size_t num= 0;
+        for (size_t i= 0; i < active.size(); ++i)
+            if (!selected[i])
+                active[num++]= active[i];
+        active.resize( num);
     }
 }
 
-void ColorClassesCL::fill_pointer_arrays (
-    const std::list<ColorFreqT>& color_list, const std::vector<int>& color,
+void ColorClassesCL::balance_colors (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color)
+/// Tetras of todo in classes larger than the average are moved to the smallest admissible class below the average.
+{
+    int num_colors= 0;
+    for (size_t j= 0; j < color.size(); ++j)
+        num_colors= std::max( num_colors, color[j] + 1);
+    if (num_colors == 0)
+        return;
+    std::vector<size_t> frequency( num_colors, 0);
+    for (size_t j= 0; j < color.size(); ++j)
+        ++frequency[color[j]];
+    const size_t target= (color.size() + num_colors - 1)/num_colors;
+
+    std::vector<size_t> used( num_colors, 0); // used[c]==j+1 iff a neighbor of j has color c
+    for (TetraNumVecT::const_iterator jt= todo.begin(); jt != todo.end(); ++jt) {
+        const size_t j= *jt;
+        if (frequency[color[j]] <= target)
+            continue;
+        for (TetraNumVecT::const_iterator n= neighbors[j].begin(); n != neighbors[j].end(); ++n)
+            used[color[*n]]= j + 1;
+        int c= -1;
+        for (int i= 0; i < num_colors; ++i)
+            if (used[i] != j + 1 && frequency[i] < target && (c < 0 || frequency[i] < frequency[c]))
+                c= i;
+        if (c >= 0) {
+            --frequency[color[j]];
+            color[j]= c;
+            ++frequency[c];
+        }
+    }
+}
+
+void ColorClassesCL::fill_pointer_arrays (const std::vector<int>& color,
     MultiGridCL::const_TriangTetraIteratorCL begin, MultiGridCL::const_TriangTetraIteratorCL end)
 {
-    colors_.resize( color_list.size());
-    for (std::list<ColorFreqT>::const_iterator it= color_list.begin(); it != color_list.end(); ++it)
-        colors_[it->first].reserve( it->second);
     const size_t num_tetra= std::distance( begin, end);
-    for (size_t j= 0; j < num_tetra; ++j)
-        colors_[color[j]].push_back( &*(begin + j));
+
+    // number the colors consecutively, as colors of a previous coloring may have vanished
+    std::vector<size_t> frequency;
+    for (size_t j= 0; j < num_tetra; ++j) {
+        if (static_cast<size_t>( color[j]) >= frequency.size())
+            frequency.resize( color[j] + 1, 0);
+        ++frequency[color[j]];
+    }
+    std::vector<int> newcolor( frequency.size(), -1);
+    int num= 0;
+    for (size_t i= 0; i < frequency.size(); ++i)
+        if (frequency[i] > 0)
+            newcolor[i]= num++;
+
+    colors_.clear();
+    colors_.resize( num);
+    positions_.clear();
+    positions_.resize( num);
+    for (size_t i= 0; i < frequency.size(); ++i)
+        if (frequency[i] > 0)
+            positions_[newcolor[i]].reserve( frequency[i]);
+    id_color_.resize( num_tetra);
+    for (size_t j= 0; j < num_tetra; ++j) {
+        positions_[newcolor[color[j]]].push_back( j);
+        id_color_[j]= std::make_pair( (begin + j)->GetId().GetIdent(), newcolor[color[j]]);
+    }
+    std::sort( id_color_.begin(), id_color_.end());
 
 #ifndef DROPS_WIN
     size_t j;
 #else
     int j;
 #endif
-    // tetra sorting for better memory access pattern
+    // tetra sorting for better memory access pattern; the positions are kept in step with the pointers
     #pragma omp parallel for
-    for (j= 0; j < num_colors(); ++j)
-        sort( colors_[j].begin(), colors_[j].end());
+    for (j= 0; j < num_colors(); ++j) {
+        std::vector<std::pair<const TetraCL*, size_t> > tp( positions_[j].size());
+        for (size_t k= 0; k < tp.size(); ++k)
+            tp[k]= std::make_pair( &*(begin + positions_[j][k]), positions_[j][k]);
+        std::sort( tp.begin(), tp.end());
+        colors_[j].resize( tp.size());
+        for (size_t k= 0; k < tp.size(); ++k) {
+            colors_[j][k]=    tp[k].first;
+            positions_[j][k]= tp[k].second;
+        }
+    }
 }
 
 void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
-                                            MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd)
+                                            MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd,
+                                            const ColorClassesCL* prev)
 {
 #   ifdef _PAR
         ParTimerCL timer;
@@ -1350,40 +1853,39 @@ void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIterat
 
     const size_t num_tetra= std::distance( begin, end);
 
-    // Build the adjacency lists (a vector of neighbors for each tetra).
-    std::vector<TetraNumVecT> neighbors( num_tetra);
-    compute_neighbors( begin, end, neighbors, match, Bnd);
+    VertexMapT vertexMap;
+    compute_vertex_map( begin, end, vertexMap, match, Bnd);
 
-    // Color the tetras
+    // Take over the colors of the previous coloring
     std::vector<int> color( num_tetra, -1); // Color of each tetra
-    std::list<ColorFreqT> color_frequency;  // list of colors together with number of their occurrence
-    std::vector<int> used_colors; // list of the colors of all neighbors (multiple occurrences of the same color or -1 are allowed)
-    for (size_t j= 0; j < num_tetra; ++j) {
-        for (TetraNumVecT::iterator neigh_it= neighbors[j].begin(); neigh_it != neighbors[j].end(); ++neigh_it)
-            used_colors.push_back( color[*neigh_it]);
-        bool color_found= false;
-        std::list<ColorFreqT>::iterator it;
-        for (it= color_frequency.begin(); it != color_frequency.end(); ++it)
-            if (find( used_colors.begin(), used_colors.end(), it->first) == used_colors.end()) {
-                color_found= true;
-                break;
-            }
-        if (color_found) {
-            color[j]= it->first;
-            ++it->second;
-            // Move color to the end: LRU-policy for evenly used colors.
-            color_frequency.splice( color_frequency.end(), color_frequency, it);
-        }
-        else {
-            color_frequency.push_back( std::make_pair( color_frequency.size(), 1)); // Add new color with one use
-            color[j]= color_frequency.back().first;
-        }
-        used_colors.clear();
+    if (prev != 0) {
+        for (size_t j= 0; j < num_tetra; ++j)
+            color[j]= prev->color_of( (begin + j)->GetId().GetIdent());
+        check_old_colors( vertexMap, color);
     }
+    TetraNumVecT todo;
+    for (size_t j= 0; j < num_tetra; ++j)
+        if (color[j] < 0)
+            todo.push_back( j);
+    num_recolored_= todo.size();
+
+    // Build the adjacency lists (a vector of neighbors for each tetra to be colored).
+    std::vector<TetraNumVecT> neighbors( num_tetra);
+    compute_neighbors( begin, vertexMap, todo, neighbors);
+    vertexMap.clear();
+
+    // Color the tetras
+#ifdef _OPENMP
+    if (omp_get_max_threads() > 1)
+        color_jones_plassmann( neighbors, todo, color);
+    else
+#endif
+        color_greedy( neighbors, todo, color);
+    balance_colors( neighbors, todo, color);
     neighbors.clear();
 
     // Build arrays of pointers for the colors
-    fill_pointer_arrays( color_frequency, color, begin, end);
+    fill_pointer_arrays( color, begin, end);
     color.clear();
 
     // for (size_t j= 0; j < num_colors(); ++j)
@@ -1392,18 +1894,75 @@ void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIterat
 
     timer.Stop();
     const double duration= timer.GetTime();
-    std::cout << "Creation of the tetra-coloring took " << duration << " seconds, " << num_colors() << " colors used." << '\n';
+    std::cout << "Creation of the tetra-coloring took " << duration << " seconds, " << num_colors() << " colors used";
+    if (prev != 0)
+        std::cout << ", " << num_recolored_ << " of " << num_tetra << " tetras recolored";
+    std::cout << ".\n";
+}
+
+int ColorClassesCL::color_of (Ulint id) const
+{
+    std::vector<std::pair<Ulint, int> >::const_iterator it=
+        std::lower_bound( id_color_.begin(), id_color_.end(), std::make_pair( id, -1));
+    return (it != id_color_.end() && it->first == id) ? it->second : -1;
 }
 
 const ColorClassesCL& MultiGridCL::GetColorClasses (int Level, match_fun match, const BndCondCL& Bnd) const
+/// If a triangulation has been colored before the last modification of the multigrid, the coloring is
+/// updated, i.e., only tetras, which are new or whose color is not admissible any more, are colored.
 {
     if (Level < 0)
         Level+= GetNumLevel();
 
-    if (_colors.find( Level) == _colors.end())
-        _colors[Level]= new ColorClassesCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd);
+    if (_colors.find( Level) == _colors.end()) {
+        // As the number of levels may have changed, the coloring of the nearest level is used.
+        std::map<int, ColorClassesCL*>::iterator prev= _prevColors.end();
+        for (std::map<int, ColorClassesCL*>::iterator it= _prevColors.begin(); it != _prevColors.end(); ++it)
+            if (prev == _prevColors.end() || std::abs( it->first - Level) <= std::abs( prev->first - Level))
+                prev= it;
+        if (prev == _prevColors.end())
+            _colors[Level]= new ColorClassesCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd);
+        else {
+            _colors[Level]= new ColorClassesCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd, prev->second);
+            delete prev->second;
+            _prevColors.erase( prev);
+        }
+    }
 
     return *_colors[Level];
 }
 
+const TetraGeometryCacheCL* MultiGridCL::GetGeometryCache (int Level) const
+{
+    if (!_cacheGeometry)
+        return 0;
+    if (Level < 0)
+        Level+= GetNumLevel();
+
+    TetraGeometryCacheCL*& cache= _geometry[Level];
+    if (cache == 0)
+        cache= new TetraGeometryCacheCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level));
+    return cache;
+}
+
+TetraGeometryCacheCL::TetraGeometryCacheCL (MultiGridCL::const_TriangTetraIteratorCL begin,
+                                            MultiGridCL::const_TriangTetraIteratorCL end)
+    : trafo_( 9*(end - begin)), det_( end - begin), tetra_( end - begin)
+{
+    const size_t n= end - begin;
+
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+    SMatrixCL<3,3> T;
+#   pragma omp parallel for private( T)
+    for (i= 0; i < n; ++i) {
+        DROPS::GetTrafoTr( T, det_[i], begin[i]); // not the member function
+        std::copy( T.begin(), T.end(), &trafo_[9*i]);
+        tetra_[i]= &begin[i];
+    }
+}
+
 } // end of namespace DROPS
@@ -147,6 +147,7 @@ class LbIteratorCL;
 #endif
 
 class ColorClassesCL; ///< forward declaration of the partitioning of the tetras in a triangulation into color classes
+class TetraGeometryCacheCL; ///< forward declaration of the affine maps of the tetras in a triangulation
 
 class MultiGridCL
 {
@@ -201,6 +202,10 @@ class MultiGridCL
     size_t         _version;                        // each modification of the multigrid increments this number
 
     mutable std::map<int, ColorClassesCL*> _colors; // map: level -> Color-classes of the tetra for that level
+    mutable std::map<int, ColorClassesCL*> _prevColors; // map: level -> Color-classes before the last modification, used for recoloring
+
+    bool                                         _cacheGeometry; // true, if GetGeometryCache shall store the affine maps of the tetras
+    mutable std::map<int, TetraGeometryCacheCL*> _geometry;      // map: level -> affine maps of the tetras of that level
 
 #ifdef _PAR
     bool killedGhostTetra_;                         // are there ghost tetras, that are marked for removement, but has not been removed so far
@@ -216,11 +221,16 @@ class MultiGridCL
     void RemoveLastLevel () { _Vertices.RemoveLastLevel(); _Edges.RemoveLastLevel(); _Faces.RemoveLastLevel(); _Tetras.RemoveLastLevel(); }
 
     void ClearTriangCache ();
+    void ClearPrevColors ();
+    void ClearGeometryCache () const;
 
     void RestrictMarks (Uint Level) { std::for_each( _Tetras[Level].begin(), _Tetras[Level].end(), std::mem_fun_ref(&TetraCL::RestrictMark)); }
     void CloseGrid     (Uint);
     void UnrefineGrid  (Uint);
     void RefineGrid    (Uint);
+#if !defined(_PAR) && defined(_OPENMP) && !defined(DROPS_WIN)
+    void RefineGridParallel (Uint);                 // creates the children of Level with OpenMP, called by RefineGrid
+#endif
 
     void BuildIndependentTetras( Uint Level) const;
 
@@ -229,7 +239,7 @@ class MultiGridCL
     MultiGridCL (const MultiGridCL&); // Dummy
     // default ctor
     ~MultiGridCL () // avoid leaking the ColorClasses.
-    { ClearTriangCache (); }
+    { ClearTriangCache (); ClearPrevColors(); }
 #ifdef _PAR
     bool KilledGhosts()      const              /// Check if there are ghost tetras, that are marked for removement, but has not been removed so far
         { return killedGhostTetra_; }
@@ -322,6 +332,14 @@ class MultiGridCL
 
     const ColorClassesCL& GetColorClasses (int Level, match_fun match, const BndCondCL& Bnd) const;
 
+    /// \brief Switch the caching of the affine maps of the tetras on or off; it is off by default.
+    void SetGeometryCaching (bool cache) { _cacheGeometry= cache; if (!cache) ClearGeometryCache(); }
+    bool GetGeometryCaching () const { return _cacheGeometry; }
+    /// \brief Affine maps of the tetras of the triangulation Level; 0, if the caching is off.
+    const TetraGeometryCacheCL* GetGeometryCache (int Level) const;
+    /// \brief Must be called after the coordinates of vertices are changed by VertexCL::ChangeCoord; deletes the cached affine maps.
+    void NotifyCoordChange () { ClearGeometryCache(); }
+
     bool IsSane (std::ostream&, int Level=-1) const;
 };
 
@@ -360,37 +378,108 @@ class PeriodicEdgesCL
 };
 
 /// \brief Storage of independend set of tetrahedra for assembling
+///
+/// Two tetras, which share a vertex, have different colors. The coloring is computed greedily in the
+/// serial case and by the Jones-Plassmann algorithm if more than one OpenMP thread is available.
+/// Afterwards, the color classes are balanced by moving tetras from large to small classes.
+///
+/// If the coloring of a previous triangulation is given, the tetras, which are still in the
+/// triangulation (identified by their id), keep their color and only the new tetras are colored.
 class ColorClassesCL
 {
   public:
     typedef std::vector<const TetraCL*> ColorClassT;
+    typedef std::vector<size_t>         PositionClassT; ///< positions of the tetras of a color class in the triangulation
     typedef std::vector<ColorClassT>::const_iterator const_iterator;
 
   private:
-    std::vector<ColorClassT> colors_;
+    std::vector<ColorClassT>    colors_;
+    std::vector<PositionClassT> positions_;        ///< positions_[c][j] is the position of colors_[c][j] in the triangulation
+    std::vector<std::pair<Ulint, int> > id_color_; ///< (id, color) of all tetras sorted by id; used for recoloring
+    size_t num_recolored_;                         ///< number of tetras colored by compute_color_classes
 
     typedef std::vector<size_t> TetraNumVecT;
-    typedef std::pair<size_t, size_t> ColorFreqT;
-
-    void compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin,
-                            MultiGridCL::const_TriangTetraIteratorCL end,
-                            std::vector<TetraNumVecT>& neighbors, match_fun match, const BndCondCL& Bnd);
-    void fill_pointer_arrays (const std::list<ColorFreqT>& color_list,
-        const std::vector<int>& color,
+    typedef DROPS_STD_UNORDERED_MAP<const VertexCL*, TetraNumVecT> VertexMapT;
+
+    void compute_vertex_map (MultiGridCL::const_TriangTetraIteratorCL begin,
+                             MultiGridCL::const_TriangTetraIteratorCL end,
+                             VertexMapT& vertexMap, match_fun match, const BndCondCL& Bnd);
+    /// \brief Compute the neighbors of the tetras in todo.
+    void compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin, const VertexMapT& vertexMap,
+                            const TetraNumVecT& todo, std::vector<TetraNumVecT>& neighbors);
+    /// \brief Remove colors taken over from a previous coloring, which are not admissible any more.
+    void check_old_colors (const VertexMapT& vertexMap, std::vector<int>& color);
+    /// \name Color the tetras in todo; the colors of the other tetras are fixed.
+    //@{
+    void color_greedy          (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color);
+    void color_jones_plassmann (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color);
+    void balance_colors        (const std::vector<TetraNumVecT>& neighbors, const TetraNumVecT& todo, std::vector<int>& color);
+    //@}
+    void fill_pointer_arrays (const std::vector<int>& color,
         MultiGridCL::const_TriangTetraIteratorCL begin,
         MultiGridCL::const_TriangTetraIteratorCL end);
 
   public:
+    /// \brief Compute the coloring; if prev is given, the colors of the tetras in prev are reused.
     ColorClassesCL (MultiGridCL::const_TriangTetraIteratorCL begin,
-                    MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd)
-    { compute_color_classes( begin, end, match, Bnd); }
+                    MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd,
+                    const ColorClassesCL* prev= 0)
+    { compute_color_classes( begin, end, match, Bnd, prev); }
 
     void compute_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
-                                MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd);
+                                MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd,
+                                const ColorClassesCL* prev= 0);
+
+    /// \brief Color of the tetra with the given id; -1, if there is no such tetra.
+    int color_of (Ulint id) const;
+    /// \brief Removes the pointers to the tetras; only the colors by id are kept for recoloring.
+    void clear_tetras () { colors_.clear(); positions_.clear(); }
 
     size_t num_colors () const { return colors_.size(); }
+    size_t num_recolored () const { return num_recolored_; } ///< number of tetras, which did not keep their color
     const_iterator begin () const { return colors_.begin(); }
     const_iterator end   () const { return colors_.end(); }
+    /// \brief Positions of the tetras of the color class cit in the triangulation, cf. TetraGeometryCacheCL.
+    const PositionClassT& positions (const_iterator cit) const { return positions_[cit - colors_.begin()]; }
+};
+
+
+/// \brief Transposed inverse Jacobians and determinants of the affine maps of the tetras of a triangulation.
+///
+/// The accumulators set up several matrices per time step on the same triangulation; each of them
+/// computes the affine map of each tetra. This class stores T and det from GetTrafoTr for all tetras
+/// of a triangulation in contiguous arrays, which are indexed by the position of the tetra in the
+/// triangulation. The position is passed by the accumulation, cf. AccumulatorCL::geom_pos_; the
+/// stored tetra addresses only serve to verify it. The cache is owned by MultiGridCL, cf.
+/// MultiGridCL::GetGeometryCache; it is deleted if the multigrid or the coordinates of its vertices are modified.
+class TetraGeometryCacheCL
+{
+  private:
+    std::vector<double>         trafo_; ///< T of the i-th tetra, row by row, in trafo_[9*i],...,trafo_[9*i+8]
+    std::vector<double>         det_;   ///< determinant of the affine map of the i-th tetra
+    std::vector<const TetraCL*> tetra_; ///< the i-th tetra of the triangulation
+
+  public:
+    TetraGeometryCacheCL (MultiGridCL::const_TriangTetraIteratorCL begin,
+                          MultiGridCL::const_TriangTetraIteratorCL end);
+
+    size_t size () const { return det_.size(); }
+    /// \brief True, if t is the i-th tetra of the triangulation.
+    bool Contains (const TetraCL& t, size_t i) const { return i < size() && tetra_[i] == &t; }
+
+    double GetDet (size_t i) const { return det_[i]; }
+    /// \brief The same values as GetTrafoTr( T, det, t) for the i-th tetra t.
+    void GetTrafoTr (SMatrixCL<3,3>& T, double& det, size_t i) const {
+        std::copy( &trafo_[9*i], &trafo_[9*i] + 9, T.begin());
+        det= det_[i];
+    }
+    /// \brief Returns false, if t is not the i-th tetra of the triangulation.
+    bool GetTrafoTr (SMatrixCL<3,3>& T, double& det, const TetraCL& t, size_t i) const {
+        if (!Contains( t, i))
+            return false;
+        GetTrafoTr( T, det, i);
+        return true;
+    }
 };
 
 
@@ -490,6 +579,8 @@ class LocationCL
         : _Tetra(t), _Coord(p) {}
     LocationCL(const LocationCL& loc)
         : _Tetra(loc._Tetra), _Coord(loc._Coord) {}
+    LocationCL& operator=(const LocationCL& loc)
+        { _Tetra= loc._Tetra; _Coord= loc._Coord; return *this; }
 
 #ifndef _PAR
     bool IsValid() const                        ///< Check if the tetrahedra is set
@@ -536,6 +627,57 @@ class LocatorCL
     static void
     Locate(LocationCL&, const MultiGridCL& MG, int, const Point3DCL&, double tol= 1e-14);
 };
+
+/// \brief Spatial index over the tetras of a triangulation level for the location of many points
+/** The index stores for each tetra of the triangulation level the affine map from world to barycentric
+    coordinates and sorts the tetras into the cells of a uniform grid over the bounding box of the
+    triangulation (a tetra is put into all cells, which its bounding box intersects). Locating a point
+    then requires only the evaluation of the affine maps of the few tetras in its cell instead of solving
+    a 4x4-system for each tetra on the way down the multigrid hierarchy as in LocatorCL::Locate.
+
+    The index is rebuilt by Update() if the version of the multigrid has changed.
+    Only the triangulation level is searched, hence, in contrast to LocatorCL, the results are only
+    valid for FE-functions on this level.
+    \note The batched Locate is parallelized by OpenMP.*/
+class LocatorIndexCL
+{
+  private:
+    const MultiGridCL&          mg_;
+    const int                   lvl_;           ///< triangulation level as given by the user
+    size_t                      version_;       ///< version of the multigrid the index was built for
+    std::vector<const TetraCL*> tetras_;        ///< tetras of the triangulation level
+    std::vector<double>         baryMap_;       ///< for each tetra: vertex 0 and the inverse of the matrix with columns v_i - v_0, i=1,2,3
+    Point3DCL                   bbmin_,         ///< bounding box of the triangulation
+                                bbmax_;
+    Point3DCL                   hinv_;          ///< inverse of the grid widths
+    Uint                        n_[3];          ///< number of cells in each direction
+    std::vector<size_t>         cellBegin_;     ///< cellTetra_[cellBegin_[c]..cellBegin_[c+1]) are the tetras in cell c
+    std::vector<Uint>           cellTetra_;     ///< tetra numbers sorted by cells
+
+    void Build();
+    /// \brief Index of the cell in direction d containing the coordinate x, clamped to the grid.
+    Uint Cell( double x, Uint d) const {
+        const double c= (x - bbmin_[d])*hinv_[d];
+        return c <= 0. ? 0 : (c >= n_[d] ? n_[d] - 1 : static_cast<Uint>( c));
+    }
+    /// \brief Computes the barycentric coordinates of p w.r.t. tetra number t.
+    void ToBary( Uint t, const Point3DCL& p, SVectorCL<4>& b) const;
+
+  public:
+    LocatorIndexCL (const MultiGridCL& mg, int lvl= -1)
+        : mg_( mg), lvl_( lvl), version_( static_cast<size_t>( -1)) { Update(); }
+
+    /// \brief Rebuild the index, if the multigrid has been modified.
+    void Update() { if (version_ != mg_.GetVersion()) Build(); }
+
+    /// \brief Find the tetra of the triangulation level that contains p; returns false, if there is none.
+    bool Locate (LocationCL& loc, const Point3DCL& p, double tol= 1e-14) const;
+    /// \brief Locate all points in p; loc is resized to p.size(). Points outside of the domain get an invalid location.
+    void Locate (std::vector<LocationCL>& loc, const std::vector<Point3DCL>& p, double tol= 1e-14) const;
+
+    size_t GetNumTetra() const { return tetras_.size(); } ///< number of indexed tetras
+    size_t memory() const;                                ///< memory of the index in byte
+};
 // inline functions
 
 template <class SimplexT>
@@ -643,6 +785,13 @@ inline void GetTrafoTr( SMatrixCL<3,3>& T, double& det, const TetraCL& t)
     T(2,2)= (M[0][0]*M[1][1] - M[1][0]*M[0][1])/det;
 }
 
+/// calculates the transpose of the transformation  Tetra -> RefTetra; the values are taken from cache, if t is its pos-th tetra
+inline void GetTrafoTr( SMatrixCL<3,3>& T, double& det, const TetraCL& t, const TetraGeometryCacheCL* cache, size_t pos)
+{
+    if (cache == 0 || !cache->GetTrafoTr( T, det, t, pos))
+        GetTrafoTr( T, det, t);
+}
+
 
 void MarkAll (MultiGridCL&);
 void UnMarkAll (MultiGridCL&);
@@ -779,11 +779,13 @@ if the face cannot be found, create it and link boundary, if necessary.
     }
 }
 
-void TetraCL::CollectAndLinkChildren (const RefRuleCL& refrule, TetraContT& tcont)
+void TetraCL::CollectAndLinkChildren (const RefRuleCL& refrule, TetraContT& tcont, bool newIds)
 /**
 The child tetras for new refinement are stored in the _Children array.
 First look for them in the recycle bin (maybe they are still left from the old rule),
 if the child cannot be found, create it.
+If newIds is false, the global id counter is not touched (this is not thread-safe)
+and the caller has to number the new children.
 */
 {
     if ( !_Children ) _Children= new SArrayCL<TetraCL*, MaxChildrenC>;
@@ -799,7 +801,7 @@ if the child cannot be found, create it.
 
         if (!( (*_Children)[ch]= vp0->FindTetra(vp1, vp2, vp3) ))
         {
-            tcont.push_back(TetraCL(vp0, vp1, vp2, vp3, this) );
+            tcont.push_back(TetraCL(vp0, vp1, vp2, vp3, this, newIds ? IdCL<TetraCL>() : IdCL<TetraCL>( 0)) );
             (*_Children)[ch] = &tcont.back();
         }
         (*_Children)[ch]->LinkEdges(childdat);
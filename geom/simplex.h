@@ -251,7 +251,7 @@ class VertexCL
     void                  SetPrio(PrioT p)      { _dddH.prio=p;}                         ///< set priority of this vertex (danger: no notification to DDD, use PrioChange!)
 #endif
     const Point3DCL&      GetCoord        () const { return _Coord; }                       ///< get coordinate of this vertex
-    void                  ChangeCoord     (Point3DCL& p) { _Coord = p; }                    ///change the coordinate of the vertex, e.g. ALE method in poisson problem
+    void                  ChangeCoord     (Point3DCL& p) { _Coord = p; }                    ///change the coordinate of the vertex, e.g. ALE method in poisson problem; call MultiGridCL::NotifyCoordChange afterwards
     bool                  IsOnBoundary    () const { return _BndVerts; }                    ///< check if this vertex lies on domain boundary
     const_BndVertIt       GetBndVertBegin () const { return _BndVerts->begin(); }
     const_BndVertIt       GetBndVertEnd   () const { return _BndVerts->end(); }
@@ -583,6 +583,9 @@ class TetraCL
     // static arrays for computations
     static SArrayCL<EdgeCL*, NumAllEdgesC> _ePtrs;                      // EdgePointers for linking edges within refinement
     static SArrayCL<FaceCL*, NumAllFacesC> _fPtrs;                      // FacePointers for linking faces within refinement
+#if defined(_OPENMP) && !defined(DROPS_WIN)
+#   pragma omp threadprivate(_ePtrs, _fPtrs)                           // each thread refines its own tetras, cf. MultiGridCL::RefineGridParallel
+#endif
 
     IdCL<TetraCL> _Id;                                                  // id-number (locally numbered on one proc)
     Usint          _RefRule;                                            // actual refinement of the tetrahedron
@@ -658,7 +661,7 @@ class TetraCL
     void        CollectFaces           (const RefRuleCL&, FaceContT&);                                  ///< build or unrecycle faces that are needed for refinement
     inline void LinkEdges              (const ChildDataCL&);                                            ///< link edges from "_ePtrs" to the tetra according to the ChildDataCL
     inline void LinkFaces              (const ChildDataCL&);                                            ///< link faces from "_fPtrs" to the tetra according to the ChildDataCL
-    void CollectAndLinkChildren (const RefRuleCL&, TetraContT&);                                 ///< build, unrecycle and link children
+    void CollectAndLinkChildren (const RefRuleCL&, TetraContT&, bool newIds= true);              ///< build, unrecycle and link children; if newIds==false, new children get the id 0 and must be numbered by the caller
     void        UnlinkFromFaces        ()                                                               ///< remove link from faces to the tetra
       { for (Uint face=0; face<NumFacesC; ++face) _Faces[face]->UnlinkTetra(this); }
 
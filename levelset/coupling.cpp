@@ -26,6 +26,8 @@
 #define DROPS_COUPLING_CPP
 
 #include "levelset/coupling.h"
+#include <limits>
+#include <cmath>
 
 namespace DROPS
 {
@@ -39,7 +41,8 @@ TimeDisc2PhaseCL::TimeDisc2PhaseCL (StokesT& Stokes, LevelsetP2CL& ls, LevelsetM
     cplN_( new VelVecDescCL), old_cplN_( new VelVecDescCL),
     curv_( new VelVecDescCL), old_curv_(new VelVecDescCL),
     rhs_( Stokes.b.RowIdx->NumUnknowns()), ls_rhs_( ls.Phi.RowIdx->NumUnknowns()),
-    mat_( new MLMatrixCL( Stokes.vel_idx.size())), L_( new MatrixCL()), dt_(dt), nonlinear_( nonlinear), lsetmod_( lsetmod)
+    mat_( new MLMatrixCL( Stokes.vel_idx.size())), L_( new MatrixCL()), dt_(dt), nonlinear_( nonlinear), lsetmod_( lsetmod),
+    ispc_( 0), fpIter_( 1), fpConverged_( true)
 {
     Stokes_.SetLevelSet( ls);
     LB_.Data.resize( Stokes.vel_idx.size());
@@ -57,6 +60,79 @@ TimeDisc2PhaseCL::~TimeDisc2PhaseCL()
     delete curv_; delete old_curv_;
 }
 
+// ==============================================
+//              TimeStepControlCL
+// ==============================================
+
+double TimeStepControlCL::Compute (const StokesT& Stokes, const LevelsetP2CL& lset, double dt, bool fpConverged, const VectorCL& vel_old)
+{
+    const VectorCL& v= Stokes.v.Data;
+    double bound= growth_*dt;
+
+    // CFL and capillary bound
+    dtCFL_= dtCap_= -1.;
+    if (cfl_ > 0. || cap_ > 0.) {
+        const double inf= std::numeric_limits<double>::max();
+        double hu= inf,   // min h_T/|u|_T
+               hcut= inf; // smallest edge of the cut tetras
+        const StokesT::const_DiscVelSolCL vel( Stokes.GetVelSolution());
+        const LevelsetP2CL::const_DiscSolCL phi( lset.GetSolution());
+        LocalP2CL<Point3DCL> locv;
+        LocalP2CL<> locphi;
+        DROPS_FOR_TRIANG_CONST_TETRA( Stokes.GetMG(), Stokes.v.GetLevel(), it) {
+            double h= inf;
+            for (Uint e= 0; e < NumEdgesC; ++e)
+                h= std::min( h, (it->GetEdge( e)->GetVertex( 1)->GetCoord() - it->GetEdge( e)->GetVertex( 0)->GetCoord()).norm());
+            if (cfl_ > 0.) {
+                locv.assign( *it, vel);
+                double umax= 0.;
+                for (Uint i= 0; i < FE_P2CL::NumDoFC; ++i)
+                    umax= std::max( umax, locv[i].norm());
+                if (umax > 0.)
+                    hu= std::min( hu, h/umax);
+            }
+            if (cap_ > 0. && h < hcut) {
+                locphi.assign( *it, phi);
+                if (locphi.min() < 0. && locphi.max() > 0.)
+                    hcut= h;
+            }
+        }
+#ifdef _PAR
+        hu=   ProcCL::GlobalMin( hu);
+        hcut= ProcCL::GlobalMin( hcut);
+#endif
+        if (cfl_ > 0. && hu < inf)
+            bound= std::min( bound, dtCFL_= cfl_*hu);
+        if (cap_ > 0. && sigma_ > 0. && hcut < inf)
+            bound= std::min( bound, dtCap_= cap_*std::sqrt( rhoSum_*hcut*hcut*hcut/(4.*M_PI*sigma_)));
+    }
+
+    // error controller: compare with the linear extrapolation of the last two steps
+    err_= -1.;
+    if (tol_ > 0. && dtOld_ > 0. && vOld_.size() == v.size() && vel_old.size() == v.size()) {
+        const VectorCL diff( v - (vel_old + (dt/dtOld_)*(vel_old - vOld_)));
+#ifndef _PAR
+        const double nd= norm( diff), nv= norm( v);
+#else
+        const ExchangeCL& ex= Stokes.v.RowIdx->GetEx();
+        const double nd= ex.Norm( diff, true), nv= ex.Norm( v, true);
+#endif
+        err_= nv > 0. ? nd/nv : 0.;
+        if (err_ > 0.)
+            bound= std::min( bound, 0.9*dt*std::sqrt( tol_/err_));
+    }
+    vOld_.resize( vel_old.size());
+    vOld_= vel_old;
+    dtOld_= dt;
+
+    if (!fpConverged)
+        bound= std::min( bound, 0.5*dt);
+
+    // keep the step size, unless it must be reduced or can be enlarged considerably
+    const double dtNew= (bound < dt || bound >= hysteresis_*dt) ? bound : dt;
+    return std::max( dtMin_, std::min( dtMax_, dtNew));
+}
+
 void cplDeltaSquaredPolicyCL::Update( VecDescCL& v)
 {
     if (firststep_) {
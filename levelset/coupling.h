@@ -63,6 +63,9 @@ class TimeDisc2PhaseCL
 
     SchurPreBaseCL* ispc_;             // pointer to preconditioner for the schur complement
 
+    int          fpIter_;              // number of coupling iterations of the last time step
+    bool         fpConverged_;         // the coupling iteration of the last time step converged
+
   public:
     TimeDisc2PhaseCL( StokesT& Stokes, LevelsetP2CL& ls, LevelsetModifyCL& lsetmod, double dt, double nonlinear=1.);
     virtual ~TimeDisc2PhaseCL();
@@ -81,11 +84,23 @@ class TimeDisc2PhaseCL
     LevelsetP2CL& GetLset() { return LvlSet_; }
     //@}
 
-    virtual void SetTimeStep (double dt) {dt_= dt;}
+    /// \brief Sets the step size; the weight 1/dt of the Schur complement preconditioner is updated, too.
+    virtual void SetTimeStep (double dt) {
+        dt_= dt;
+        if (ispc_)
+            ispc_->SetWeights( 1.0/dt, ispc_->GetWeightM());
+    }
     virtual void DoStep( int maxFPiter= -1) = 0;
 
+    /// \brief Number of coupling (fixed point) iterations of the last time step; 1 for non-iterative schemes.
+    int  GetFPIter()     const { return fpIter_; }
+    /// \brief Returns false, if the coupling iteration of the last time step stopped at the maximal number of iterations.
+    bool FPConverged()   const { return fpConverged_; }
+
     // update after grid has changed
     virtual void Update() = 0;
+    /// \brief Change tracking of the assembly in the fixed point iteration; only used by the coupled schemes.
+    virtual void SetChangeTracking( double) {}
     
     void SetSchurPrePtr( SchurPreBaseCL* ptr) { ispc_ = ptr; }
 };
@@ -194,6 +209,15 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
     double         stab_;
     double         alpha_;
 
+    /// \name change tracking of the assembly in the fixed point iteration
+    //@{
+    double         trackTol_;        ///< relative tolerance; negative: complete setup in each iteration
+    VecDescCL      trackPhi_;        ///< level set function of A, M, b, cplM
+    VelVecDescCL   trackVel_;        ///< velocity of E, H
+    size_t         trackAVersion_,   ///< versions of A and E after the last setup
+                   trackEVersion_;
+    //@}
+
     virtual void InitStep();
     virtual void CommitStep();
     virtual void SetupNavStokesSystem() = 0;
@@ -203,6 +227,10 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
     void MaybeStabilize  ( VectorCL&);
     void EvalLsetNavStokesEquations();
     void SetupStokesMatVec();
+    /// \brief Sets up E and H of the level set equation for the current velocity; updates them, if change tracking is on.
+    void SetupLevelsetMatrices();
+    /// \brief Forgets the data of the last setup, e.g. at the beginning of a time step.
+    void ResetChangeTracking() { trackAVersion_= trackEVersion_= 0; }
 
   public:
     CoupledTimeDisc2PhaseBaseCL( StokesT& Stokes, LevelsetP2CL& ls, StokesSolverT& solver,
@@ -212,6 +240,15 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
 
     void DoStep( int maxFPiter= -1);
 
+    /// \brief Switches the change tracking of the assembly in the fixed point iteration on (tol >= 0) or off (tol < 0).
+    ///
+    /// After the first fixed point iteration of a time step, A, M, b, cplM and E, H are not set up anew, but the
+    /// existing matrices are patched: Only the contributions of tetras are recomputed, on which the level set
+    /// function (for A, M, b) or the velocity (for E, H) changed by more than tol times its maximum norm. For A,
+    /// M, b, tetras which stay in the same phase are skipped in any case, so tol= 0 yields the same matrices as the
+    /// complete setup up to round-off. If the velocity changed in most degrees of freedom, E, H are set up anew.
+    void SetChangeTracking( double tol) { trackTol_= tol; ResetChangeTracking(); }
+
     virtual void Update();
 };
 
@@ -682,6 +719,51 @@ class cplBroydenPolicyCL
     void Update( VecDescCL&);
 };
 
+/// \brief Adaptive choice of the time step between the steps of a TimeDisc2PhaseCL.
+///
+/// After each time step Compute() proposes the size of the next step as the minimum of
+/// - the convective CFL bound  cfl * min_T h_T/|u|_T,
+/// - the capillary bound (Brackbill et al.)  cap * sqrt( (rho_1+rho_2) h^3/(4 pi sigma)), h the smallest edge of the tetras cut by the interface,
+/// - the bound of an error controller: the velocity is predicted by linear extrapolation from the last two steps, the relative
+///   difference err to the computed velocity estimates the local error and the step is scaled by safety*(tol/err)^(1/2),
+/// - growth times the last step size; if the coupling iteration did not converge, the step is halved instead.
+/// The result is clipped to [dtMin, dtMax]. To keep matrices and preconditioners, which depend on the step size, unchanged
+/// over several steps, the step is only enlarged if the bound exceeds the last step by the factor hysteresis; smaller
+/// bounds are always accepted. No step is rejected, i.e. the controller acts between steps.
+class TimeStepControlCL
+{
+  private:
+    double dtMin_, dtMax_;     ///< range of the step size
+    double cfl_, cap_;         ///< safety factors of the CFL and capillary bounds (0: not used)
+    double rhoSum_, sigma_;    ///< sum of the densities and surface tension for the capillary bound
+    double tol_;               ///< tolerance of the error controller (0: not used)
+    double growth_;            ///< maximal growth of the step size
+    double hysteresis_;        ///< minimal growth of the step size
+
+    VectorCL vOld_;            ///< velocity before the last step
+    double   dtOld_;           ///< size of the step before the last step (0: no history)
+    double   dtCFL_, dtCap_, err_;
+
+  public:
+    TimeStepControlCL (double dtMin, double dtMax, double cfl, double cap, double rhoSum, double sigma,
+                       double tol= 0., double growth= 2., double hysteresis= 1.25)
+        : dtMin_( dtMin), dtMax_( dtMax), cfl_( cfl), cap_( cap), rhoSum_( rhoSum), sigma_( sigma), tol_( tol),
+          growth_( growth), hysteresis_( hysteresis), dtOld_( 0.), dtCFL_( -1.), dtCap_( -1.), err_( -1.) {}
+
+    /// \brief Proposes the next step size after a step of timedisc; vel_old is the velocity before this step.
+    double Compute (const TimeDisc2PhaseCL& timedisc, const VectorCL& vel_old) {
+        return Compute( timedisc.GetStokes(), timedisc.GetLset(), timedisc.GetTimeStep(), timedisc.FPConverged(), vel_old);
+    }
+    /// \brief Proposes the next step size after a step of size dt, which computed the velocity of Stokes and the level set lset
+    /// from vel_old; fpConverged tells, whether the coupling iteration of this step converged.
+    double Compute (const StokesT& Stokes, const LevelsetP2CL& lset, double dt, bool fpConverged, const VectorCL& vel_old);
+    /// \brief Discards the velocity history, e.g. after the grid or the numbering has changed.
+    void Reset () { dtOld_= 0.; vOld_.resize( 0); }
+
+    double GetCFLTimeStep ()       const { return dtCFL_; } ///< CFL bound of the last call of Compute, -1 if not computed
+    double GetCapillaryTimeStep () const { return dtCap_; } ///< capillary bound of the last call of Compute, -1 if not computed
+    double GetErrorEstimate ()     const { return err_; }   ///< relative error estimate of the last call of Compute, -1 if not computed
+};
 
 } // end of namespace DROPS
 
@@ -489,7 +489,8 @@ CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::CoupledTimeDisc2Phas
     ( StokesT& Stokes, LevelsetP2CL& ls, StokesSolverT& solver, LsetSolverT& lsetsolver, LevelsetModifyCL& lsetmod, double dt, double tol,
             double nonlinear, bool withProjection, double stab)
   : base_( Stokes, ls, lsetmod, dt, nonlinear),
-    solver_( solver), lsetsolver_( lsetsolver), tol_(tol), withProj_( withProjection), stab_( stab), alpha_( nonlinear_)
+    solver_( solver), lsetsolver_( lsetsolver), tol_(tol), withProj_( withProjection), stab_( stab), alpha_( nonlinear_),
+    trackTol_( -1.), trackAVersion_( 0), trackEVersion_( 0)
 {
     Update();
 }
@@ -524,6 +525,7 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::InitStep()
 {
     lsetmod_.init();
     dphi_ = 0;
+    ResetChangeTracking(); // b_, cplM_ are swapped in CommitStep
     std::cout << "InitStep-dt_: " << dt_ << std::endl;
     Stokes_.v.t+= dt_;
     Stokes_.p.t+= dt_;
@@ -597,7 +599,31 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetupStokesMatV
     curv_->Clear( Stokes_.v.t);
     LvlSet_.AccumulateBndIntegral( *curv_);
 
-    Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, b_, b_, cplM_, LvlSet_, Stokes_.v.t);
+    if (trackTol_ >= 0. && trackAVersion_ == Stokes_.A.Data.Version() && trackPhi_.RowIdx == LvlSet_.Phi.RowIdx
+        && trackPhi_.Data.size() == LvlSet_.Phi.Data.size()) {
+#ifndef _PAR
+        const double phimax= supnorm( LvlSet_.Phi.Data);
+#else
+        const double phimax= ProcCL::GlobalMax( supnorm( LvlSet_.Phi.Data));
+#endif
+        // The matrices are updated exactly to the level set function, which takes the changes above the
+        // tolerance; thus they do not drift away from a complete setup over several updates.
+        const VectorCL phi( LvlSet_.Phi.Data);
+        LvlSet_.Phi.Data= trackPhi_.Data;
+        AdvanceTrackingReference( LvlSet_.Phi.Data, phi, trackTol_*phimax);
+        Stokes_.UpdateSystem1( &Stokes_.A, &Stokes_.M, b_, b_, cplM_, LvlSet_, trackPhi_, 0., Stokes_.v.t);
+        trackPhi_.Data= LvlSet_.Phi.Data;
+        LvlSet_.Phi.Data= phi;
+    }
+    else {
+        Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, b_, b_, cplM_, LvlSet_, Stokes_.v.t);
+        if (trackTol_ >= 0.) {
+            trackPhi_.SetIdx( LvlSet_.Phi.RowIdx);
+            trackPhi_.Data= LvlSet_.Phi.Data;
+        }
+    }
+    if (trackTol_ >= 0.)
+        trackAVersion_= Stokes_.A.Data.Version();
     if (Stokes_.UsesXFEM()) {
         Stokes_.UpdateXNumbering( &Stokes_.pr_idx, LvlSet_);
         Stokes_.UpdatePressure( &Stokes_.p);
@@ -618,6 +644,45 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetupStokesMatV
     Stokes_.SetupPrMass ( &Stokes_.prM, LvlSet_);
 }
 
+template <class LsetSolverT, class RelaxationPolicyT>
+void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetupLevelsetMatrices()
+{
+    bool update= trackTol_ >= 0. && trackEVersion_ == LvlSet_.E.Version() && trackVel_.RowIdx == Stokes_.v.RowIdx
+        && trackVel_.Data.size() == Stokes_.v.Data.size();
+    double tol= 0.;
+    if (update) {
+#ifndef _PAR
+        tol= trackTol_*supnorm( Stokes_.v.Data);
+#else
+        tol= trackTol_*ProcCL::GlobalMax( supnorm( Stokes_.v.Data));
+#endif
+        // patching is only cheaper than a complete setup, if the velocity changed in few degrees of freedom
+        size_t numChanged= 0;
+        for (size_t i= 0; i < Stokes_.v.Data.size(); ++i)
+            if (std::fabs( Stokes_.v.Data[i] - trackVel_.Data[i]) > tol)
+                ++numChanged;
+        update= numChanged < Stokes_.v.Data.size()/4;
+    }
+    if (update) {
+        // exact update to the velocity, which takes the changes above the tolerance, cf. SetupStokesMatVec
+        VelVecDescCL vel( trackVel_.RowIdx);
+        vel.Data= trackVel_.Data;
+        AdvanceTrackingReference( vel.Data, Stokes_.v.Data, tol, 3);
+        vel.t= Stokes_.v.t;
+        LvlSet_.UpdateSystem( Stokes_.GetVelSolution( vel), Stokes_.GetVelSolution( trackVel_), 0., dt_);
+        trackVel_.Data= vel.Data;
+    }
+    else {
+        LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
+        if (trackTol_ >= 0.) {
+            trackVel_.SetIdx( Stokes_.v.RowIdx);
+            trackVel_.Data= Stokes_.v.Data;
+        }
+    }
+    if (trackTol_ >= 0.)
+        trackEVersion_= LvlSet_.E.Version();
+}
+
 template <class LsetSolverT, class RelaxationPolicyT>
 void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::CommitStep()
 {
@@ -631,6 +696,7 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::CommitStep()
 template <class LsetSolverT, class RelaxationPolicyT>
 void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int maxFPiter)
 {
+    DROPS_REGION( "Coupling");
     if (maxFPiter==-1)
         maxFPiter= 99;
 
@@ -641,14 +707,18 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
     ExchangeCL& ExVel  = Stokes_.v.RowIdx->GetEx();
 #endif
     double res_u = 0.0;
+    fpConverged_= false;
     for (int i=0; i<maxFPiter; ++i)
     {
         std::cout << "~~~~~~~~~~~~~~~~ FP-Iter " << i+1 << '\n';
+        DROPS_COUNT( "fixed point iterations", 1.);
+        fpIter_= i+1;
         const VectorCL v( Stokes_.v.Data);
         EvalLsetNavStokesEquations();
         if (solver_.GetIter()==0 && lsetsolver_.GetResid()<lsetsolver_.GetTol()) // no change of vel -> no change of Phi
         {
             std::cout << "Convergence after " << i+1 << " fixed point iterations!" << std::endl;
+            fpConverged_= true;
             break;
         }
         Stokes_.v.Data = v - Stokes_.v.Data;
@@ -668,6 +738,7 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
 
         if (res_u < tol_) {
             std::cout << "Convergence after " << i+1 << " fixed point iterations!" << std::endl;
+            fpConverged_= true;
             break;
         }
     }
@@ -677,12 +748,14 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
 template <class LsetSolverT, class RelaxationPolicyT>
 void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::Update()
 {
+    DROPS_REGION( "CouplingUpdate");
     MLIdxDescCL* const vidx= &Stokes_.vel_idx;
 
     Stokes_.ClearMat();
     LvlSet_.ClearMat();
     mat_->clear();
     L_->clear();
+    ResetChangeTracking();
 
     // IndexDesc setzen
     b_->SetIdx( vidx);       old_b_->SetIdx( vidx);
@@ -793,7 +866,7 @@ void MidPointTimeDisc2PhaseCL<LsetSolverT,RelaxationPolicyT>::SetupLevelsetSyste
     const VectorCL tmpv( Stokes_.v.Data);
     Stokes_.v.Data = 0.5 * VectorCL( Stokes_.v.Data + oldv_);
     // setup system for levelset eq.
-    LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
+    base_::SetupLevelsetMatrices();
     Stokes_.v.Data = tmpv;
 
     L_->LinComb( 2./dt_, LvlSet_.E, 1.0, LvlSet_.H);
@@ -927,7 +1000,7 @@ template <class LsetSolverT, class RelaxationPolicyT>
 void SpaceTimeDiscTheta2PhaseCL<LsetSolverT,RelaxationPolicyT>::SetupLevelsetSystem()
 {
     // setup system for levelset eq.
-    LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
+    base_::SetupLevelsetMatrices();
 
     L_->LinComb( ls_theta_/dt_, LvlSet_.E, (1.0-ls_theta_)/dt_, *Eold_, ls_theta_, LvlSet_.H);
     ls_rhs_ = (1.0 - ls_theta_) * fixed_ls_rhs_ + (ls_theta_/dt_) * (LvlSet_.E * oldphi_);
@@ -1004,7 +1077,7 @@ template <class LsetSolverT, class RelaxationPolicyT>
 void EulerBackwardScheme2PhaseCL<LsetSolverT,RelaxationPolicyT>::SetupLevelsetSystem()
 {
     // setup system for levelset eq.
-    LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
+    base_::SetupLevelsetMatrices();
 
     L_->LinComb( 1./dt_, LvlSet_.E, 1.0, LvlSet_.H);
     ls_rhs_ = LvlSet_.E * fixed_ls_rhs_;
@@ -1187,7 +1260,7 @@ template <class LsetSolverT, class RelaxationPolicyT>
 void RecThetaScheme2PhaseCL<LsetSolverT,RelaxationPolicyT>::SetupLevelsetSystem()
 {
     // setup system for levelset eq.
-    LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
+    base_::SetupLevelsetMatrices();
 
     L_->LinComb( 1./dt_, LvlSet_.E, ls_theta_, LvlSet_.H);
     ls_rhs_ = LvlSet_.E * fixed_ls_rhs_;
@@ -28,6 +28,7 @@
 #include "misc/kd-tree/tree_builder.h"
 #include "misc/kd-tree/search.h"
 #include "num/solver.h"
+#include "misc/instrument.h"
 #include <fstream>
 #include <cstring>
 #ifdef _OPENMP
@@ -1651,6 +1652,7 @@ void ReparamCL::RestoreSigns()
 
 void ReparamCL::Perform()
 {
+    DROPS_REGION( "Reparametrization");
     std::cout << "Reparametrize level set function\n";
 #pragma omp parallel
 {
@@ -1668,12 +1670,18 @@ void ReparamCL::Perform()
 #endif
 
     timer.Reset();
-    initZero_->Perform();
+    {
+        DROPS_REGION( "InitFrontier");
+        initZero_->Perform();
+    }
     timer.Stop();
     std::cout << " * Init frontier set by " << initZero_->GetName() << " took " << timer.GetTime() << " sec." << std::endl;
 
     timer.Reset();
-    propagate_->Perform();
+    {
+        DROPS_REGION( "Propagation");
+        propagate_->Perform();
+    }
     timer.Stop();
     std::cout << " * Propagation by " << propagate_->GetName() << " took " << timer.GetTime() << " sec." << std::endl;
     RestoreSigns();
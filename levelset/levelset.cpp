@@ -214,7 +214,7 @@ void NaiveLaplaceBeltramiAccuCL::visit( const TetraCL& t)
     const Uint  idx_f= f.RowIdx->GetIdx();
     double det;
 
-    GetTrafoTr( T, det, t);
+    GetTrafoTr( T, det, t, geom_cache_, geom_pos_);
     P2DiscCL::GetGradients( Grad, GradRef, T); // Gradienten auf aktuellem Tetraeder
 
     for (int v=0; v<10; ++v)
@@ -298,7 +298,7 @@ void ImprovedLaplaceBeltramiAccuCL::visit ( const TetraCL& t)
     const bool velXfem= f.RowIdx->IsExtended();
     double det;
 
-    GetTrafoTr( T, det, t);
+    GetTrafoTr( T, det, t, geom_cache_, geom_pos_);
     P2DiscCL::GetGradients( Grad, GradRef, T); // Gradienten auf aktuellem Tetraeder
     LocalP1CL<Point3DCL> n;
 
@@ -482,7 +482,7 @@ void VarImprovedLaplaceBeltramiAccuCL::visit( const TetraCL& t)
         const UnknownHandleCL& unk= v<4 ? t.GetVertex(v)->Unknowns : t.GetEdge(v-4)->Unknowns;
         Numb[v]= unk.Exist( idx_f) ? unk( idx_f) : NoIdx;
     }
-    GetTrafoTr( T, det, t);
+    GetTrafoTr( T, det, t, geom_cache_, geom_pos_);
     P2DiscCL::GetGradients( Grad, GradRef, T);
 
     for (int ch= 0; ch < 8; ++ch)
@@ -593,86 +593,152 @@ void LevelsetP2CL::AccumulateBndIntegral( VecDescCL& f) const
     }
     TetraAccumulatorTupleCL accus;
     accus.push_back( accu);
-    accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
+    if (curvDiff_ > 0) // the smoothed level set function is cut by the interface on other tetras
+        accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
+    else
+        accumulate( accus, GetInterfaceBand(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
 
     delete accu;
 }
 
-double LevelsetP2CL::GetVolume( double translation, int l) const
+LevelsetVolumeCL::LevelsetVolumeCL (const LevelsetP2CL& ls, int l)
+    : l_( l == 0 ? 1 : l), smin_( 1.), smax_( -1.), negVol_( 0.)
 {
-    if (l==0)
-        ++l;
-    double Volume= l > 0 ? GetVolume_Composite( translation, l)
-                         : GetVolume_Extrapolation( translation, -l);
-
-#ifdef _PAR
-    Volume = ProcCL::GlobalSum(Volume);
-#endif
-    return Volume;
+    const MultiGridCL& mg= ls.GetMG();
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, ls.idx.TriangLevel(), it)
+        tetra_.push_back( &*it);
+    const int n= tetra_.size();
+    phi_.resize( 10*n);
+    min_.resize( n);
+    max_.resize( n);
+    vol_.resize( n);
+
+#   pragma omp parallel
+    {
+        LocalP2CL<> loc_phi;
+#       pragma omp for schedule(static)
+        for (int t= 0; t < n; ++t) {
+            loc_phi.assign( *tetra_[t], ls.Phi, ls.GetBndData());
+            std::copy( &loc_phi[0], &loc_phi[0] + 10, &phi_[10*t]);
+            GetBernsteinBounds( loc_phi, min_[t], max_[t]);
+            vol_[t]= tetra_[t]->GetVolume();
+        }
+    }
 }
 
-double LevelsetP2CL::GetVolume_Extrapolation( double translation, int l) const
+void LevelsetVolumeCL::Init (double smin, double smax)
 {
-    double vol = 0.;
-    QuadDomainCL qdom;
-    DROPS::ExtrapolationToZeroCL extra( l, DROPS::RombergSubdivisionCL());
-    // DROPS::ExtrapolationToZeroCL extra( l, DROPS::HarmonicSubdivisionCL());
-    LocalP2CL<> loc_phi;
-    DROPS_FOR_TRIANG_TETRA( MG_, idx.TriangLevel(), it) {
-        loc_phi.assign(*it,Phi,GetBndData());
-        loc_phi+= translation;
-        make_ExtrapolatedQuad5Domain( qdom, loc_phi, extra);
-        DROPS::GridFunctionCL<> integrand( 1., qdom.vertex_size());
-        vol+=quad( integrand, it->GetVolume()*6., qdom, NegTetraC);
+    smin_= smin;
+    smax_= smax;
+    band_.clear();
+    negVol_= 0.;
+    for (size_t t= 0; t < tetra_.size(); ++t) {
+        if (max_[t] + smax < 0.)
+            negVol_+= vol_[t];
+        else if (min_[t] + smin <= 0.)
+            band_.push_back( t);
     }
-    return vol;
 }
 
-double LevelsetP2CL::GetVolume_Composite( double translation, int l) const
+double LevelsetVolumeCL::GetVolume (double s, double* area) const
 {
-    const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance ( l);
-    double vol = 0.;
-    std::valarray<double> ls_values (lat.vertex_size());
-    QuadDomainCL qdom;
-    LocalP2CL<> loc_phi;
-    TetraPartitionCL partition;
-    DROPS_FOR_TRIANG_TETRA( MG_, idx.TriangLevel(), it) {
-        loc_phi.assign(*it,Phi,GetBndData());
-        loc_phi+= translation;
-        evaluate_on_vertexes (loc_phi, lat, Addr(ls_values));
-        partition.make_partition< SortedVertexPolicyCL,MergeCutPolicyCL>(lat, ls_values);
-        make_CompositeQuad5Domain( qdom, partition);
-        DROPS::GridFunctionCL<> integrand( 1., qdom.vertex_size());
-        vol+=quad( integrand, it->GetVolume()*6., qdom, NegTetraC);
+    Assert( InRange( s), DROPSErrCL( "LevelsetVolumeCL::GetVolume: translation out of range of Init()"), DebugNumericC);
+
+    const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( l_ > 0 ? l_ : 1);
+    std::auto_ptr<ExtrapolationToZeroCL> extra( l_ > 0 ? 0 : new ExtrapolationToZeroCL( -l_, RombergSubdivisionCL()));
+    const int n= band_.size();
+    double vol= 0., surf= 0.;
+
+#   pragma omp parallel reduction(+: vol, surf)
+    {
+        LocalP2CL<> loc_phi;
+        std::valarray<double> ls_values( lat.vertex_size());
+        TetraPartitionCL partition;
+        SurfacePatchCL patch;
+        QuadDomainCL qdom;
+        QuadDomain2DCL qdom2D;
+#       pragma omp for schedule(dynamic, 64)
+        for (int i= 0; i < n; ++i) {
+            const size_t t= band_[i];
+            for (Uint j= 0; j < 10; ++j)
+                loc_phi[j]= phi_[10*t + j] + s;
+            if (extra.get() != 0) {
+                make_ExtrapolatedQuad5Domain( qdom, loc_phi, *extra);
+                if (area != 0)
+                    make_ExtrapolatedQuad5Domain2D( qdom2D, loc_phi, *tetra_[t], *extra);
+            }
+            else {
+                evaluate_on_vertexes( loc_phi, lat, Addr( ls_values));
+                partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_values);
+                make_CompositeQuad5Domain( qdom, partition);
+                if (area != 0) {
+                    patch.make_patch<MergeCutPolicyCL>( lat, ls_values);
+                    make_CompositeQuad5Domain2D( qdom2D, patch, *tetra_[t]);
+                }
+            }
+            vol+= quad( GridFunctionCL<>( 1., qdom.vertex_size()), 6.*vol_[t], qdom, NegTetraC);
+            if (area != 0)
+                surf+= quad_2D( GridFunctionCL<>( 1., qdom2D.vertex_size()), qdom2D);
+        }
     }
+    vol+= negVol_;
+
+#ifdef _PAR
+    vol= ProcCL::GlobalSum( vol);
+    if (area != 0)
+        surf= ProcCL::GlobalSum( surf);
+#endif
+    if (area != 0)
+        *area= surf;
     return vol;
 }
 
+double LevelsetP2CL::GetVolume( double translation, int l) const
+{
+    LevelsetVolumeCL volume( *this, l);
+    volume.Init( translation, translation);
+    return volume.GetVolume( translation);
+}
+
+/** The tetras are classified once for the expected range of translations; this range is only widened, if an
+    iterate leaves it. As dV/ds = -|Gamma| for a signed distance function phi, the area of the interface is
+    used as derivative in Newton's method. As soon as the sign of the volume error changes, the root is
+    bracketed and the Anderson-Bjoerck method is used. */
 double LevelsetP2CL::AdjustVolume (double vol, double tol, double surface, int l) const
 {
     tol*=vol;
 
-    double v0=GetVolume(0., l)-vol;
+    LevelsetVolumeCL volume( *this, l);
+    volume.Init( 0., 0.);
+    double area;
+    double d0=0, v0=volume.GetVolume( 0., &area)-vol;
     if (std::abs(v0)<=tol) return 0;
 
-    double d0=0, d1=v0*(surface != 0. ? 1.1/surface : 0.23/std::pow(vol,2./3.));
     // Hinweis: surf(Kugel) = [3/4/pi*vol(Kugel)]^(2/3) * 4pi
-    double v1=GetVolume(d1, l)-vol;
+    if (area <= 0.)
+        area= surface != 0. ? surface/1.1 : std::pow(vol,2./3.)/0.23;
+    double d1=v0/area;
+    volume.Init( std::min( 0., 2.*d1), std::max( 0., 2.*d1));
+    double v1=volume.GetVolume( d1, &area)-vol;
     if (std::abs(v1)<=tol) return d1;
 
-    // Sekantenverfahren fuer Startwert
+    // Newton-Verfahren, bis der Fehler das Vorzeichen wechselt; Sekantenverfahren, falls das Interface leer ist
     while (v1*v0 > 0) // gleiches Vorzeichen
     {
-        const double d2=d1-1.2*v1*(d1-d0)/(v1-v0);
-        d0=d1; d1=d2; v0=v1; v1=GetVolume(d1, l)-vol;
+        const double d2= area > 0. ? d1+v1/area : d1-1.2*v1*(d1-d0)/(v1-v0);
+        if (!volume.InRange( d2))
+            volume.Init( std::min( d1, 2.*d2-d1), std::max( d1, 2.*d2-d1));
+        d0=d1; d1=d2; v0=v1; v1=volume.GetVolume(d1, &area)-vol;
         if (std::abs(v1)<=tol) return d1;
     }
 
     // Anderson-Bjoerk fuer genauen Wert
+    if (!volume.InRange( d0) || !volume.InRange( d1))
+        volume.Init( std::min( d0, d1), std::max( d0, d1));
     while (true)
     {
         const double d2=(v1*d0-v0*d1)/(v1-v0),
-                     v2=GetVolume(d2,l)-vol;
+                     v2=volume.GetVolume(d2)-vol;
         if (std::abs(v2)<=tol) return d2;
 
         if (v2*v1 < 0) // ungleiches Vorzeichen
@@ -89,9 +89,8 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     SurfaceTensionCL&   sf_;      ///< data for surface tension
     void SetupSmoothSystem ( MatrixCL&, MatrixCL&)               const;
     void SmoothPhi( VectorCL& SmPhi, double diff)                const;
-    double GetVolume_Composite( double translation, int l)    const;
-    double GetVolume_Extrapolation( double translation, int l) const;
     perDirSetT* perDirections;    ///< periodic directions
+    mutable InterfaceBandCL band_; ///< tetras cut by the interface
 
   public:
     MatrixCL            E, H;
@@ -117,6 +116,10 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     /// \remarks call SetupSystem \em before calling SetTimeStep!
     template<class DiscVelSolT>
     void SetupSystem( const DiscVelSolT&, const double);
+    /// \brief Updates E and H, which were set up for the velocity oldvel, to the velocity vel.
+    /// Only tetras, on which the velocity changed by more than tol in a degree of freedom, are reassembled.
+    template<class DiscVelSolT>
+    void UpdateSystem( const DiscVelSolT& vel, const DiscVelSolT& oldvel, double tol, const double dt);
     /// Reparametrization of the level set function.
     void Reparam( int method=03, bool Periodic= false);
 
@@ -134,6 +137,7 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     /// l < 0 : extrapolation from current level lvl to lvl - l - 1
     double GetVolume( double translation= 0, int l= 2) const;
     /// volume correction to ensure no loss or gain of mass. The parameter l is passed to GetVolume().
+    /// Newton's method with the interface area as derivative of the volume is safeguarded by the Anderson-Bjoerck method. surf is only used as estimate of the area, if the interface is empty.
     double AdjustVolume( double vol, double tol, double surf= 0., int l= 2) const;
     /// Apply smoothing to \a SmPhi, if curvDiff_ > 0
     void MaybeSmooth( VectorCL& SmPhi) const { if (curvDiff_>0) SmoothPhi( SmPhi, curvDiff_); }
@@ -141,8 +145,11 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     void   SetSurfaceForce( SurfaceForceT SF) { SF_= SF; }
     /// Get type of surface force.
     SurfaceForceT GetSurfaceForce() const { return SF_; }
-    /// Discretize surface force
+    /// Discretize surface force; without smoothing of phi, only the tetras cut by the interface are visited.
     void   AccumulateBndIntegral( VecDescCL& f) const;
+    /// \brief Tetras cut by the interface and the given number of layers around them; the set is only rebuilt, if the multigrid or Phi has changed.
+    const InterfaceBandCL& GetInterfaceBand( Uint rings= 0) const
+        { band_.SetRings( rings); band_.Update( MG_, Phi, BndData_); return band_; }
     /// Clear all matrices, should be called after grid change to avoid reuse of matrix pattern
     void   ClearMat() { E.clear(); H.clear(); }
     /// \name Evaluate Solution
@@ -163,6 +170,39 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
 };
 
 
+/// \brief Volume of the negative part of the translated level set function phi + s for many translations s.
+/** The local values of phi and bounds of phi on each tetra are computed once in the constructor; the bounds
+    are the extremal coefficients of the local P2-function in the Bernstein basis. Init() classifies the tetras
+    for a range of translations: Tetras with phi + s < 0 (> 0) for all s in the range contribute their whole
+    volume (nothing) and are never integrated; only the remaining band tetras are integrated by GetVolume().
+    The tetras are processed with OpenMP. The parameter l is interpreted as in LevelsetP2CL::GetVolume(). */
+class LevelsetVolumeCL
+{
+  private:
+    int                        l_;
+    std::vector<const TetraCL*> tetra_;   ///< all tetras of the triangulation of the level set function
+    std::valarray<double>      phi_,      ///< local P2-values of phi on the tetras, 10 per tetra
+                               min_, max_,///< lower and upper bound of phi on the tetras
+                               vol_;      ///< volume of the tetras
+    double                     smin_, smax_; ///< range of translations of the classification
+    std::vector<size_t>        band_;     ///< band tetras of the classification
+    double                     negVol_;   ///< volume of the tetras in the negative phase for the whole range
+
+  public:
+    LevelsetVolumeCL (const LevelsetP2CL& ls, int l= 2);
+
+    /// \brief Classify the tetras for translations in [smin, smax].
+    void Init (double smin, double smax);
+    /// \brief True, if s is in the range of the last call of Init().
+    bool InRange (double s) const { return smin_ <= s && s <= smax_; }
+    /// \brief Volume of the negative part of phi + s; the area of the interface {phi + s = 0} is returned in area, if area != 0.
+    /// \pre InRange( s)
+    double GetVolume (double s, double* area= 0) const;
+
+    size_t GetNumTetra () const { return tetra_.size(); } ///< number of local tetras
+    size_t GetNumBand  () const { return band_.size(); }  ///< number of local band tetras of the classification
+};
+
 /// \brief Observes the MultiGridCL-changes by AdapTriangCL to repair the Function ls.Phi.
 ///
 /// Sequential: The actual work is done in post_refine().<br>
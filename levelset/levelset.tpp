@@ -125,22 +125,38 @@ void LevelsetP2CL::GetInfo( double& maxGradPhi, double& Volume, Point3DCL& bary,
 }
 
 /// \brief Accumulator to set up the matrices E and H for the level set equation.
+///
+/// If oldvel is given, E and H are not set up, but updated from the velocity oldvel to vel: Only the contributions
+/// of tetras, on which the velocity changed by more than tol in a degree of freedom, are subtracted and added again.
 template<class DiscVelSolT>
 class LevelsetAccumulator_P2CL : public TetraAccumulatorCL
 {
     LevelsetP2CL& ls_;
     const DiscVelSolT& vel_;
     const double SD_;
+    const DiscVelSolT* oldvel_; ///< velocity of the matrices to be updated; 0 for a complete setup
+    const double tol_;
+    size_t  numPatched_;
+    size_t* numPatchedPtr_;     ///< number of updated tetras, shared by the clones
     SparseMatBuilderCL<double> *bE_, *bH_;
+    SparseMatPatchCL<double>   *pE_, *pH_;
 
-    Quad5CL<Point3DCL> Grad[10], GradRef[10], u_loc;
-    Quad5CL<double> u_Grad[10]; // fuer u grad v_i
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10], u_loc;
+    SQuad5CL<double> u_Grad[10]; // fuer u grad v_i
+    LocalP2CL<Point3DCL> v_new, v_old;
     SMatrixCL<3,3> T;
+    double absdet, h_T;
     LocalNumbP2CL n;
 
+    ///\brief Adds s times the contributions of the tetra for the velocity vel to the matrices.
+    template <class BuilderT>
+    void update_global_system (const TetraCL& t, const DiscVelSolT& vel, BuilderT& bE, BuilderT& bH, double s= 1.);
+
   public:
-    LevelsetAccumulator_P2CL( LevelsetP2CL& ls, const DiscVelSolT& vel, double SD, __UNUSED__ double dt)
-      : ls_(ls), vel_(vel), SD_(SD)
+    LevelsetAccumulator_P2CL( LevelsetP2CL& ls, const DiscVelSolT& vel, double SD, __UNUSED__ double dt,
+                              const DiscVelSolT* oldvel= 0, double tol= 0.)
+      : ls_(ls), vel_(vel), SD_(SD), oldvel_( oldvel), tol_( tol), numPatched_( 0), numPatchedPtr_( &numPatched_),
+        bE_( 0), bH_( 0), pE_( 0), pH_( 0)
     { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     ///\brief Initializes matrix-builders and load-vectors
@@ -156,6 +172,12 @@ class LevelsetAccumulator_P2CL : public TetraAccumulatorCL
 template<class DiscVelSolT>
 void LevelsetAccumulator_P2CL<DiscVelSolT>::begin_accumulation ()
 {
+    if (oldvel_ != 0) {
+        numPatched_= 0;
+        pE_= new SparseMatPatchCL<double>( &ls_.E);
+        pH_= new SparseMatPatchCL<double>( &ls_.H);
+        return;
+    }
     const IdxT num_unks= ls_.Phi.RowIdx->NumUnknowns();
     bE_= new SparseMatBuilderCL<double>(&ls_.E, num_unks, num_unks);
     bH_= new SparseMatBuilderCL<double>(&ls_.H, num_unks, num_unks);
@@ -171,6 +193,15 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::begin_accumulation ()
 template<class DiscVelSolT>
 void LevelsetAccumulator_P2CL<DiscVelSolT>::finalize_accumulation ()
 {
+    if (oldvel_ != 0) {
+        pE_->Build();
+        delete pE_;
+        pH_->Build();
+        delete pH_;
+        Comment( numPatched_ << " tetras updated in E, H" << std::endl, DebugDiscretizeC);
+        DROPS_COUNT( "updated tetras", numPatched_);
+        return;
+    }
     bE_->Build();
     delete bE_;
     bH_->Build();
@@ -188,18 +219,39 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::visit (const TetraCL& t)
    where v_i, v_j denote the ansatz functions.
    \todo: implementation of other boundary conditions
 */
+{
+    if (oldvel_ == 0) {
+        update_global_system( t, vel_, *bE_, *bH_);
+        return;
+    }
+    v_new.assign( t, vel_);
+    v_old.assign( t, *oldvel_);
+    bool changed= false;
+    for (Uint i= 0; i < 10 && !changed; ++i)
+        changed= (v_new[i] - v_old[i]).norm() > tol_;
+    if (!changed)
+        return;
+    update_global_system( t, *oldvel_, *pE_, *pH_, -1.);
+    update_global_system( t, vel_, *pE_, *pH_);
+#   pragma omp atomic
+    ++*numPatchedPtr_;
+}
+
+template<class DiscVelSolT>
+  template <class BuilderT>
+void LevelsetAccumulator_P2CL<DiscVelSolT>::update_global_system (const TetraCL& t, const DiscVelSolT& vel, BuilderT& bE, BuilderT& bH, double s)
 {
     double det;
-    GetTrafoTr( T, det, t);
+    GetTrafoTr( T, det, t, geom_cache_, geom_pos_);
     P2DiscCL::GetGradients( Grad, GradRef, T);
-    const double absdet= std::fabs( det),
-            h_T= std::pow( absdet, 1./3.);
+    absdet= std::fabs( det);
+    h_T= std::pow( absdet, 1./3.);
 
     // save information about the edges and verts of the tetra in Numb
     n.assign( t, *ls_.Phi.RowIdx, ls_.GetBndData());
 
     // save velocities inside tetra for quadrature in u_loc
-    u_loc.assign( t, vel_);
+    u_loc.assign( t, vel);
 
     for(int i=0; i<10; ++i)
         u_Grad[i]= dot( u_loc, Grad[i]);
@@ -212,17 +264,16 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::visit (const TetraCL& t)
     maxV= std::max( maxV, limit/h_T); // no scaling for extremely small velocities
     //double maxV= 1; // no scaling
 
-    SparseMatBuilderCL<double> &bE= *bE_, &bH= *bH_;
     for(int i=0; i<10; ++i)    // assemble row Numb[i]
         for(int j=0; j<10; ++j)
         {
             // E is of mass matrix type:    E_ij = ( v_j       , v_i + SD * u grad v_i )
-            bE( n.num[i], n.num[j])+= P2DiscCL::GetMass(i,j) * absdet
-                                 + u_Grad[i].quadP2(j, absdet)*SD_/maxV*h_T;
+            bE( n.num[i], n.num[j])+= s*(P2DiscCL::GetMass(i,j) * absdet
+                                 + u_Grad[i].quadP2(j, absdet)*SD_/maxV*h_T);
 
             // H describes the convection:  H_ij = ( u grad v_j, v_i + SD * u grad v_i )
-            bH( n.num[i], n.num[j])+= u_Grad[j].quadP2(i, absdet)
-                                 + Quad5CL<>(u_Grad[i]*u_Grad[j]).quad( absdet) * SD_/maxV*h_T;
+            bH( n.num[i], n.num[j])+= s*(u_Grad[j].quadP2(i, absdet)
+                                 + SQuad5CL<>(u_Grad[i]*u_Grad[j]).quad( absdet) * SD_/maxV*h_T);
         }
 }
 
@@ -236,6 +287,16 @@ void LevelsetP2CL::SetupSystem( const DiscVelSolT& vel, __UNUSED__ const double
     accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
 }
 
+template<class DiscVelSolT>
+void LevelsetP2CL::UpdateSystem( const DiscVelSolT& vel, const DiscVelSolT& oldvel, double tol, __UNUSED__ const double dt)
+/// Update level set matrices E, H from oldvel to vel
+{
+    LevelsetAccumulator_P2CL<DiscVelSolT> accu( *this, vel, SD_, dt, &oldvel, tol);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &accu);
+    accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
+}
+
 template <class DiscVelSolT>
 PermutationT LevelsetP2CL::downwind_numbering (const DiscVelSolT& vel, IteratedDownwindCL dw)
 {
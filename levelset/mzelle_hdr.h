@@ -36,6 +36,9 @@
 #include "levelset/coupling.h"
 
 #include "misc/bndmap.h"
+#ifdef _PAR
+#include "parallel/parmgserialization.h"
+#endif
 
 namespace DROPS
 {
@@ -460,6 +463,8 @@ class TwoPhaseStoreCL
     bool                 binary_;
     const PermutationT&  vel_downwind_;
     const PermutationT&  lset_downwind_;
+    bool                 sharded_;    ///< parallel runs: each process writes a shard, cf. ParMGSerializationCL::WriteMGShards
+    std::string          lastPrefix_; ///< file prefix of the last call of Write
 
     /// \brief Write time info
     void WriteTime( std::string filename)
@@ -470,6 +475,19 @@ class TwoPhaseStoreCL
         file.close();
     }
 
+#ifdef _PAR
+    /// \brief Write the multigrid and the numerical data without gathering them on the master
+    void WriteShards( const std::string& prefix, const VecDescCL& vel, const VecDescCL& ls)
+    {
+        ParMGSerializationCL ser( mg_, prefix);
+        ser.WriteMGShards();
+        ser.WriteDOFShards( &vel,       "velocity");
+        ser.WriteDOFShards( &ls,        "levelset");
+        ser.WriteDOFShards( &Stokes_.p, "pressure");
+        if (transp_) ser.WriteDOFShards( &transp_->ct, "concentrationTransf");
+    }
+#endif
+
   public:
       /// \brief Construct a class for storing a two-phase flow problem in files
       /** This class generates multiple files, all with prefix path, for storing
@@ -481,11 +499,13 @@ class TwoPhaseStoreCL
        *  \param transp mass transport concentration field
        *  \param path location for storing output
        *  \param binary save output  binary?
+       *  \param sharded parallel runs: write one shard per process, which are merged by MergeShards
        *  */
     TwoPhaseStoreCL(MultiGridCL& mg, const StokesT& Stokes, const LevelsetP2CL& lset, const TransportP1CL* transp,
-                    const std::string& path, Uint recoverySteps=2, bool binary= false, const PermutationT& vel_downwind= PermutationT(), const PermutationT& lset_downwind= PermutationT())
+                    const std::string& path, Uint recoverySteps=2, bool binary= false, const PermutationT& vel_downwind= PermutationT(), const PermutationT& lset_downwind= PermutationT(),
+                    bool sharded= false)
       : mg_(mg), Stokes_(Stokes), lset_(lset), transp_(transp), path_(path), numRecoverySteps_(recoverySteps),
-        recoveryStep_(0), binary_( binary), vel_downwind_( vel_downwind), lset_downwind_( lset_downwind){}
+        recoveryStep_(0), binary_( binary), vel_downwind_( vel_downwind), lset_downwind_( lset_downwind), sharded_( sharded) {}
 
     /// \brief Write all information in a file
     void Write()
@@ -494,24 +514,53 @@ class TwoPhaseStoreCL
         std::stringstream filename;
         const size_t postfix= numRecoverySteps_==0 ? recoveryStep_++ : (recoveryStep_++)%numRecoverySteps_;
         filename << path_ << postfix;
+        lastPrefix_= filename.str();
         // first master writes time info
         IF_MASTER
             WriteTime( filename.str() + "time");
 
+        VecDescCL vel= Stokes_.v;
+        permute_Vector( vel.Data, invert_permutation( vel_downwind_), 3);
+        VecDescCL ls= lset_.Phi;
+        permute_Vector( ls.Data, invert_permutation( lset_downwind_));
+#ifdef _PAR
+        if (sharded_) {
+            WriteShards( filename.str(), vel, ls);
+            return;
+        }
+#endif
+
         // write multigrid
         MGSerializationCL ser( mg_, filename.str());
         ser.WriteMG();
 
         // write numerical data
-        VecDescCL vel= Stokes_.v;
-        permute_Vector( vel.Data, invert_permutation( vel_downwind_), 3);
         WriteFEToFile( vel, mg_, filename.str() + "velocity", binary_);
-        VecDescCL ls= lset_.Phi;
-        permute_Vector( ls.Data, invert_permutation( lset_downwind_));
         WriteFEToFile( ls, mg_, filename.str() + "levelset", binary_);
         WriteFEToFile(Stokes_.p, mg_, filename.str() + "pressure", binary_, &lset_.Phi); // pass also level set, as p may be extended
         if (transp_) WriteFEToFile(transp_->ct, mg_, filename.str() + "concentrationTransf", binary_);
     }
+
+    /// \brief Merge the shards of the last call of Write into the files of ParMGSerializationCL::WriteMG and WriteDOF
+    /** Only the master reads the shards; the other processes return at once. Nothing is done
+     *  in serial runs, if the shards are not written or if Write has not been called.
+     *  A restart reads the merged files on the master; the shards are not read in parallel.
+     */
+    void MergeShards()
+    {
+#ifdef _PAR
+        if (!sharded_ || lastPrefix_.empty())
+            return;
+        IF_MASTER {
+            ParMGSerializationCL ser( mg_, lastPrefix_);
+            ser.MergeShards();
+            ser.MergeDOFShards( "velocity");
+            ser.MergeDOFShards( "levelset");
+            ser.MergeDOFShards( "pressure");
+            if (transp_) ser.MergeDOFShards( "concentrationTransf");
+        }
+#endif
+    }
 };
 
 }   // end of namespace DROPS
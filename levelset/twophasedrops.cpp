@@ -32,6 +32,7 @@
 #include "out/output.h"
 #include "out/ensightOut.h"
 #include "out/vtkOut.h"
+#include "out/insituOut.h"
 //levelset
 #include "levelset/coupling.h"
 #include "levelset/adaptriang.h"
@@ -41,6 +42,7 @@
 #include "surfactant/ifacetransp.h"
 //function map
 #include "misc/bndmap.h"
+#include "misc/instrument.h"
 //solver factory for stokes
 #include "num/stokessolverfactory.h"
 #ifndef _PAR
@@ -53,6 +55,7 @@
 //general: streams
 #include <fstream>
 #include <sstream>
+#include <limits>
 
 DROPS::ParamCL P;
 
@@ -286,6 +289,7 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     TimeDisc2PhaseCL* timedisc= CreateTimeDisc(Stokes, lset, navstokessolver, gm, P, lsetmod);
     if (P.get<int>("Time.NumSteps") != 0){
         timedisc->SetSchurPrePtr( stokessolverfactory.GetSchurPrePtr() );
+        timedisc->SetChangeTracking( P.get<double>("Coupling.ChangeTracking"));
     }
     if (P.get<double>("NavStokes.Nonlinear")!=0.0 || P.get<int>("Time.NumSteps") == 0) {
         stokessolverfactory.SetMatrixA( &navstokessolver->GetAN()->GetFinest());
@@ -324,7 +328,8 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
                                                         P.get<std::string>("Restart.Outputfile"),
                                                         P.get<int>("Restart.Overwrite"),
                                                         P.get<int>("Restart.Binary"),
-                                                        vel_downwind, lset_downwind);
+                                                        vel_downwind, lset_downwind,
+                                                        P.get<int>("Restart.Sharded"));
     Stokes.v.t += GetTimeOffset();
     // Output-Registrations:
     Ensight6OutCL* ensight = NULL;
@@ -381,20 +386,54 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
         vtkwriter->Write(Stokes.v.t);
     }
 
+    // in-situ output: interface, probes and integral quantities
+    InSituOutCL * insituwriter = NULL;
+    if (P.get<int>("InSitu.InSituOut",0)){
+        insituwriter = new InSituOutCL( MG, lset.Phi, lset.GetBndData(),
+                                        P.get<std::string>("InSitu.InSituDir"), P.get<std::string>("InSitu.InSituName"),
+                                        P.get<int>("Time.NumSteps")/P.get("InSitu.InSituOut", 0)+1);
+        insituwriter->Register( make_InSituVector( Stokes.GetVelSolution(), "velocity") );
+        insituwriter->Register( make_InSituScalar( Stokes.GetPrSolution(), "pressure") );
+        insituwriter->Register( make_InSituLsetInfo( lset, Stokes.GetVelSolution()) );
+        const ParamCL::ptree_type& probes= P.get_child( "InSitu.Probes");
+        for (ParamCL::ptree_type::const_iterator it= probes.begin(); it != probes.end(); ++it)
+            insituwriter->AddProbe( ParamCL( it->second).get<Point3DCL>( ""));
+        insituwriter->Write( Stokes.v.t);
+    }
+
     // if (P.get("Restart.Serialization", 0))
     //     ser.Write();
 
+    if (P.get<int>("Instrumentation.Enable")) {
+        InstrumentCL::Enable( P.get<std::string>("Instrumentation.Trace") != "");
+        if (P.get<std::string>("Instrumentation.CSV") != "")
+            InstrumentCL::OpenCSV( P.get<std::string>("Instrumentation.CSV"));
+    }
+
     const int nsteps = P.get<int>("Time.NumSteps");
-    const double dt = P.get<double>("Time.StepSize");
-    for (int step= 1; step<=nsteps; ++step)
+    double dt = P.get<double>("Time.StepSize");
+    // adaptive time step control: the number of steps is an upper bound, the simulation ends at Time.FinalTime
+    const bool adaptiveDt= P.get<int>("Time.Adaptive.Enable");
+    const double tEnd= adaptiveDt ? P.get<double>("Time.FinalTime") : std::numeric_limits<double>::max();
+    TimeStepControlCL dtControl( P.get<double>("Time.Adaptive.DtMin"), P.get<double>("Time.Adaptive.DtMax"),
+        P.get<double>("Time.Adaptive.CFL"), P.get<double>("Time.Adaptive.Capillary"),
+        Stokes.GetCoeff().rho( -1.) + Stokes.GetCoeff().rho( 1.), Stokes.GetCoeff().SurfTens,
+        P.get<double>("Time.Adaptive.Tol"), P.get<double>("Time.Adaptive.Growth"), P.get<double>("Time.Adaptive.Hysteresis"));
+    VectorCL vel_old;
+    for (int step= 1; step<=nsteps && Stokes.v.t < tEnd*(1. - 1e-12); ++step)
     {
         std::cout << "============================================================ step " << step << std::endl;
         const double time_old = Stokes.v.t;
         const double time_new = Stokes.v.t + dt;
+        InstrumentCL::BeginStep( step, time_new);
         IFInfo.Update( lset, Stokes.GetVelSolution());
         IFInfo.Write(time_old);
 
         if (P.get("SurfTransp.DoTransp", 0)) surfTransp.InitOld();
+        if (adaptiveDt) {
+            vel_old.resize( Stokes.v.Data.size());
+            vel_old= Stokes.v.Data;
+        }
         timedisc->DoStep( P.get<int>("Coupling.Iter"));
         if (massTransp) massTransp->DoStep( time_new);
         if (P.get("SurfTransp.DoTransp", 0)) {
@@ -409,6 +448,7 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
         const bool doGridMod= P.get<int>("AdaptRef.Freq") && step%P.get<int>("AdaptRef.Freq") == 0;
         bool gridChanged= false;
         if (doGridMod) {
+            DROPS_REGION( "GridModification");
             adap.UpdateTriang( lset);
             gridChanged= adap.WasModified();
         }
@@ -440,13 +480,41 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
                 if (massTransp) massTransp->Update();
         }
 
+        // size of the next time step
+        if (adaptiveDt) {
+            double dtNew= (gridChanged || doNSDownwindNumbering) ? dt : dtControl.Compute( *timedisc, vel_old);
+            if (gridChanged || doNSDownwindNumbering) // the velocity history refers to the old numbering
+                dtControl.Reset();
+            dtNew= std::min( dtNew, tEnd - time_new);
+            std::cout << "time step control: CFL bound " << dtControl.GetCFLTimeStep() << ", capillary bound "
+                      << dtControl.GetCapillaryTimeStep() << ", error estimate " << dtControl.GetErrorEstimate()
+                      << ", FP iterations " << timedisc->GetFPIter() << ", next step " << dtNew << std::endl;
+            if (dtNew > 0. && dtNew != dt) {
+                dt= dtNew;
+                timedisc->SetTimeStep( dt);
+                if (massTransp) massTransp->SetTimeStep( dt);
+                if (P.get("SurfTransp.DoTransp", 0)) surfTransp.SetTimeStep( dt);
+            }
+        }
+
         if (ensight && step%P.get("Ensight.EnsightOut", 0)==0)
             ensight->Write( time_new);
         if (vtkwriter && step%P.get("VTK.VTKOut", 0)==0)
             vtkwriter->Write( time_new);
+        if (insituwriter && step%P.get("InSitu.InSituOut", 0)==0)
+            insituwriter->Write( time_new);
         if (P.get("Restart.Serialization", 0) && step%P.get("Restart.Serialization", 0)==0)
             ser.Write();
+        InstrumentCL::EndStep();
+    }
+    if (InstrumentCL::IsEnabled()) {
+        InstrumentCL::WriteSummary( std::cout);
+        if (P.get<std::string>("Instrumentation.Trace") != "")
+            InstrumentCL::WriteChromeTrace( P.get<std::string>("Instrumentation.Trace"));
+        InstrumentCL::CloseCSV();
     }
+    if (P.get<int>("Restart.MergeShards"))
+        ser.MergeShards();
     IFInfo.Update( lset, Stokes.GetVelSolution());
     IFInfo.Write(Stokes.v.t);
     std::cout << std::endl;
@@ -458,6 +526,7 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     if (transprepair) delete transprepair;
     if (ensight) delete ensight;
     if (vtkwriter) delete vtkwriter;
+    if (insituwriter) delete insituwriter;
     if (infofile) delete infofile;
 //     delete stokessolver1;
 }
@@ -470,6 +539,8 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
 void SetMissingParameters(DROPS::ParamCL& P){
     P.put_if_unset<int>("Transp.DoTransp",0);
     P.put_if_unset<std::string>("Restart.Inputfile","none");
+    P.put_if_unset<int>("Restart.Sharded", 0);
+    P.put_if_unset<int>("Restart.MergeShards", 0);
     P.put_if_unset<int>("NavStokes.Downwind.Frequency", 0);
     P.put_if_unset<double>("NavStokes.Downwind.MaxRelComponentSize", 0.05);
     P.put_if_unset<double>("NavStokes.Downwind.WeakEdgeRatio", 0.2);
@@ -478,6 +549,32 @@ void SetMissingParameters(DROPS::ParamCL& P){
     P.put_if_unset<double>("Levelset.Downwind.MaxRelComponentSize", 0.05);
     P.put_if_unset<double>("Levelset.Downwind.WeakEdgeRatio", 0.2);
     P.put_if_unset<double>("Levelset.Downwind.CrosswindLimit", std::cos( M_PI/6.));
+    P.put_if_unset<int>("InSitu.InSituOut", 0);
+    P.put_if_unset<std::string>("InSitu.InSituDir", "insitu");
+    P.put_if_unset<std::string>("InSitu.InSituName", "twophasedrops");
+    P.put_if_unset<std::string>("InSitu.Probes", "");
+    P.put_if_unset<int>("Instrumentation.Enable", 0);
+    P.put_if_unset<std::string>("Instrumentation.Trace", "");
+    P.put_if_unset<std::string>("Instrumentation.CSV", "");
+    P.put_if_unset<double>("Coupling.ChangeTracking", -1.);
+    P.put_if_unset<double>("Stokes.PcRefreshTol", 0.);
+    P.put_if_unset<int>("Stokes.PcRefreshMaxSkip", 10);
+    P.put_if_unset<int>("Stokes.Recycle", 0);
+    P.put_if_unset<int>("Stokes.SinglePrecisionPc", 0);
+    P.put_if_unset<int>("Stokes.ChebyshevDegree", 2);
+    P.put_if_unset<int>("Stokes.MGCycle", 1);
+    P.put_if_unset<double>("Stokes.MGSmoothGrowth", 1.);
+    P.put_if_unset<int>("Stokes.DirectCoarseSolver", 0);
+    P.put_if_unset<int>("Stokes.MGAgglomerationSize", 20000);
+    P.put_if_unset<int>("Time.Adaptive.Enable", 0);
+    P.put_if_unset<double>("Time.Adaptive.DtMin", 1e-3*P.get<double>("Time.StepSize"));
+    P.put_if_unset<double>("Time.Adaptive.DtMax", 1e3*P.get<double>("Time.StepSize"));
+    P.put_if_unset<double>("Time.Adaptive.CFL", 0.5);
+    P.put_if_unset<double>("Time.Adaptive.Capillary", 0.5);
+    P.put_if_unset<double>("Time.Adaptive.Tol", 0.);
+    P.put_if_unset<double>("Time.Adaptive.Growth", 2.);
+    P.put_if_unset<double>("Time.Adaptive.Hysteresis", 1.25);
+    P.put_if_unset<double>("Time.FinalTime", P.get<int>("Time.NumSteps")*P.get<double>("Time.StepSize"));
 }
 
 int main (int argc, char** argv)
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <list>
+#include <deque>
 #include <cmath>
 #include <iostream>
 #include <valarray>
@@ -1168,14 +1169,22 @@ template <class T>
 //**************************************************************************
 // Class:   MLDataCL                                                       *
 //**************************************************************************
+/// \brief Container for the data of all levels, the coarsest level first.
+/// The levels are stored in a std::deque: The access to a level by its index is O(1) and
+/// the iterators are random access iterators. As adding or removing levels at the ends
+/// (push_back, pop_back, resize) does not move the other levels, pointers and references
+/// to the data of a level stay valid. Iterators, however, are invalidated by push_back and
+/// resize, unlike with the std::list used before; an iterator must not be held across these
+/// calls. Therefore, the multigrid methods (MGM, FMG, StokesMGM) access the levels by their
+/// index (GetLevel).
 template <class T>
-class MLDataCL : public std::list<T>
+class MLDataCL : public std::deque<T>
 {
   public:
     explicit MLDataCL ()
-        : std::list<T>() {}
+        : std::deque<T>() {}
     explicit MLDataCL (size_t n, const T& val= T())
-        : std::list<T>( n, val) {}
+        : std::deque<T>( n, val) {}
 
     T&       GetFinest()      { return this->back();  }
     T&       GetCoarsest()    { return this->front(); }
@@ -1189,6 +1198,10 @@ class MLDataCL : public std::list<T>
     typename MLDataCL::const_iterator GetFinestIter()   const { return --this->end(); }
     typename MLDataCL::iterator       GetCoarsestIter()       { return this->begin(); }
     typename MLDataCL::const_iterator GetCoarsestIter() const { return this->begin(); }
+
+    ///\brief Data of level i; level 0 is the coarsest one stored.
+    T&       GetLevel (size_t i)       { return (*this)[i]; }
+    const T& GetLevel (size_t i) const { return (*this)[i]; }
 };
 
 ///\brief Designates the part of the domain, usually on tetras at the interface, one is interested in.
@@ -0,0 +1,394 @@
+/// \file instrument.cpp
+/// \brief hierarchical instrumentation: named regions, counters, per-step summaries and trace export
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/instrument.h"
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#ifdef __GNUC__
+#  include <cxxabi.h>
+#endif
+#ifndef _OPENMP
+#  include <ctime>
+#  ifndef DROPS_WIN
+#    include <sys/time.h>
+#  endif
+#endif
+#ifdef _PAR
+#  include "parallel/parallel.h"
+#endif
+
+namespace DROPS
+{
+
+bool                         InstrumentCL::enabled_=   false;
+bool                         InstrumentCL::trace_=     false;
+size_t                       InstrumentCL::maxEvents_= 0;
+int                          InstrumentCL::rank_=      0;
+double                       InstrumentCL::t0_=        0.;
+std::vector<InstrumentCL::ThreadDataCL> InstrumentCL::data_;
+int                          InstrumentCL::step_=      -1;
+double                       InstrumentCL::simTime_=   0.;
+std::ofstream*               InstrumentCL::csv_=       0;
+std::vector<InstrumentCL::CounterEventCL> InstrumentCL::counterEvents_;
+
+namespace {
+
+/// \brief Returns the last component of a path.
+inline std::string basename_of_path (const std::string& path)
+{
+    const size_t pos= path.rfind( '/');
+    return pos == std::string::npos ? path : path.substr( pos + 1);
+}
+
+/// \brief Returns the number of '/' in path.
+inline int depth_of_path (const std::string& path)
+{
+    return std::count( path.begin(), path.end(), '/');
+}
+
+/// \brief Writes s as JSON string.
+void write_json_string (std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (std::string::const_iterator c= s.begin(); c != s.end(); ++c) {
+        if (*c == '"' || *c == '\\')
+            os << '\\';
+        os << *c;
+    }
+    os << '"';
+}
+
+/// \brief Writes s as quoted CSV field.
+void write_csv_string (std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (std::string::const_iterator c= s.begin(); c != s.end(); ++c) {
+        if (*c == '"')
+            os << '"';
+        os << *c;
+    }
+    os << '"';
+}
+
+} // end of anonymous namespace
+
+bool InstrumentCL::PathLessCL::operator() (const std::string& a, const std::string& b) const
+/** Lexicographic order with '/' as smallest character: "A" < "A/B" < "A-B".*/
+{
+    const size_t n= std::min( a.size(), b.size());
+    for (size_t i= 0; i < n; ++i)
+        if (a[i] != b[i]) {
+            if (a[i] == '/') return true;
+            if (b[i] == '/') return false;
+            return static_cast<unsigned char>( a[i]) < static_cast<unsigned char>( b[i]);
+        }
+    return a.size() < b.size();
+}
+
+InstrumentCL::ThreadDataCL* InstrumentCL::GetThreadData()
+{
+#ifdef _OPENMP
+    if (omp_get_level() > 1) // nested parallel region: the thread number is not unique
+        return 0;
+    const size_t t= omp_get_thread_num();
+#else
+    const size_t t= 0;
+#endif
+    return t < data_.size() ? &data_[t] : 0;
+}
+
+std::string InstrumentCL::ChildPath( const ThreadDataCL& d, const std::string& name)
+{
+    return d.stack.empty() ? name : d.stack.back().first->first + '/' + name;
+}
+
+double InstrumentCL::Now()
+{
+#ifdef _OPENMP
+    return omp_get_wtime();
+#elif !defined(DROPS_WIN)
+    timeval tv;
+    gettimeofday( &tv, 0);
+    return tv.tv_sec + 1e-6*tv.tv_usec;
+#else
+    return static_cast<double>( std::clock())/CLOCKS_PER_SEC;
+#endif
+}
+
+void InstrumentCL::Enable( bool trace, size_t maxEvents)
+/** The slots for the threads are created at the first call after construction or Reset(), as the open regions refer to them.*/
+{
+    if (data_.empty()) {
+#ifdef _OPENMP
+        data_.resize( omp_get_max_threads());
+#else
+        data_.resize( 1);
+#endif
+        t0_= Now();
+    }
+#ifdef _PAR
+    rank_= ProcCL::MyRank();
+#endif
+    trace_= trace;
+    maxEvents_= maxEvents;
+    enabled_= true;
+}
+
+void InstrumentCL::Reset()
+{
+    data_.clear();
+    counterEvents_.clear();
+    step_= -1;
+}
+
+void InstrumentCL::Begin( const std::string& name)
+{
+    ThreadDataCL* d= GetThreadData();
+    if (d == 0)
+        return;
+    RegionMapT::iterator it= d->regions.insert( std::make_pair( ChildPath( *d, name), RegionDataCL())).first;
+    d->stack.push_back( std::make_pair( it, Now()));
+}
+
+void InstrumentCL::End()
+{
+    ThreadDataCL* d= GetThreadData();
+    if (d == 0 || d->stack.empty())
+        return;
+    const double t= Now(),
+                 begin= d->stack.back().second;
+    RegionDataCL& r= d->stack.back().first->second;
+    ++r.calls;
+    ++r.stepCalls;
+    r.time+=     t - begin;
+    r.stepTime+= t - begin;
+    if (trace_) {
+        if (d->events.size() < maxEvents_)
+            d->events.push_back( EventCL( &d->stack.back().first->first, begin, t));
+        else
+            ++d->dropped;
+    }
+    d->stack.pop_back();
+}
+
+void InstrumentCL::AddTime( const std::string& name, double time, Ulint calls)
+{
+    ThreadDataCL* d= GetThreadData();
+    if (d == 0)
+        return;
+    RegionDataCL& r= d->regions[ChildPath( *d, name)];
+    r.calls+=     calls;
+    r.stepCalls+= calls;
+    r.time+=      time;
+    r.stepTime+=  time;
+}
+
+void InstrumentCL::Count( const std::string& name, double val)
+{
+    ThreadDataCL* d= GetThreadData();
+    if (d == 0)
+        return;
+    CounterDataCL& c= d->counters[ChildPath( *d, name)];
+    c.value+=     val;
+    c.stepValue+= val;
+}
+
+std::string InstrumentCL::TypeName( const std::type_info& t)
+{
+#ifdef __GNUC__
+    int status= 0;
+    char* name= abi::__cxa_demangle( t.name(), 0, 0, &status);
+    if (status == 0 && name != 0) {
+        const std::string ret( name);
+        std::free( name);
+        return ret;
+    }
+#endif
+    return t.name();
+}
+
+void InstrumentCL::Merge( RegionMapT& regions, CounterMapT& counters)
+{
+    regions.clear();
+    counters.clear();
+    for (size_t t= 0; t < data_.size(); ++t) {
+        for (RegionMapT::const_iterator it= data_[t].regions.begin(); it != data_[t].regions.end(); ++it) {
+            RegionDataCL& r= regions[it->first];
+            r.calls+=     it->second.calls;
+            r.stepCalls+= it->second.stepCalls;
+            r.time+=      it->second.time;
+            r.stepTime+=  it->second.stepTime;
+        }
+        for (CounterMapT::const_iterator it= data_[t].counters.begin(); it != data_[t].counters.end(); ++it) {
+            CounterDataCL& c= counters[it->first];
+            c.value+=     it->second.value;
+            c.stepValue+= it->second.stepValue;
+        }
+    }
+}
+
+void InstrumentCL::BeginStep( int step, double simTime)
+{
+    if (!enabled_)
+        return;
+    step_= step;
+    simTime_= simTime;
+    for (size_t t= 0; t < data_.size(); ++t) {
+        for (RegionMapT::iterator it= data_[t].regions.begin(); it != data_[t].regions.end(); ++it) {
+            it->second.stepCalls= 0;
+            it->second.stepTime= 0.;
+        }
+        for (CounterMapT::iterator it= data_[t].counters.begin(); it != data_[t].counters.end(); ++it)
+            it->second.stepValue= 0.;
+    }
+    Begin( "TimeStep");
+}
+
+void InstrumentCL::EndStep()
+{
+    if (!enabled_ || step_ < 0)
+        return;
+    End();
+
+    RegionMapT  regions;
+    CounterMapT counters;
+    Merge( regions, counters);
+    if (csv_ != 0) {
+        std::ostream& os= *csv_;
+        for (RegionMapT::const_iterator it= regions.begin(); it != regions.end(); ++it)
+            if (it->second.stepCalls > 0) {
+                os << step_ << ',' << simTime_ << ',' << rank_ << ",region,";
+                write_csv_string( os, it->first);
+                os << ',' << it->second.stepCalls << ',' << it->second.stepTime << '\n';
+            }
+        for (CounterMapT::const_iterator it= counters.begin(); it != counters.end(); ++it)
+            if (it->second.stepValue != 0.) {
+                os << step_ << ',' << simTime_ << ',' << rank_ << ",counter,";
+                write_csv_string( os, it->first);
+                os << ",," << it->second.stepValue << '\n';
+            }
+        os.flush();
+    }
+    if (trace_) {
+        // sum the counters with the same name in all regions
+        std::map<std::string, double> values;
+        for (CounterMapT::const_iterator it= counters.begin(); it != counters.end(); ++it)
+            values[basename_of_path( it->first)]+= it->second.stepValue;
+        counterEvents_.push_back( CounterEventCL());
+        counterEvents_.back().time= Now();
+        counterEvents_.back().values.assign( values.begin(), values.end());
+    }
+    step_= -1;
+}
+
+void InstrumentCL::OpenCSV( const std::string& filename)
+{
+    CloseCSV();
+    std::string name( filename);
+#ifdef _PAR
+    ProcCL::AppendProcNum( name);
+#endif
+    csv_= new std::ofstream( name.c_str());
+    if (!*csv_) {
+        CloseCSV();
+        throw DROPSErrCL( "InstrumentCL::OpenCSV: error while opening file!");
+    }
+    *csv_ << std::setprecision( 10) << "step,time,rank,kind,path,calls,value\n";
+}
+
+void InstrumentCL::CloseCSV()
+{
+    delete csv_;
+    csv_= 0;
+}
+
+void InstrumentCL::WriteSummary( std::ostream& os)
+{
+    RegionMapT  regions;
+    CounterMapT counters;
+    Merge( regions, counters);
+
+    const std::ios_base::fmtflags flags= os.flags();
+    const std::streamsize prec= os.precision();
+    os << "Instrumentation of process " << rank_ << " (" << data_.size() << " thread slots), times summed over the threads:\n"
+       << std::left << std::setw( 60) << "region" << std::right << std::setw( 12) << "calls"
+       << std::setw( 14) << "time [s]" << '\n' << std::fixed << std::setprecision( 4);
+    for (RegionMapT::const_iterator it= regions.begin(); it != regions.end(); ++it)
+        os << std::left << std::setw( 60) << (std::string( 2*depth_of_path( it->first), ' ') + basename_of_path( it->first))
+           << std::right << std::setw( 12) << it->second.calls << std::setw( 14) << it->second.time << '\n';
+    if (!counters.empty()) {
+        os.flags( flags);
+        os << std::left << std::setw( 60) << "counter" << std::right << std::setw( 26) << "value" << '\n';
+        for (CounterMapT::const_iterator it= counters.begin(); it != counters.end(); ++it)
+            os << std::left << std::setw( 60) << it->first << std::right << std::setw( 26) << it->second.value << '\n';
+    }
+    Ulint dropped= 0;
+    for (size_t t= 0; t < data_.size(); ++t)
+        dropped+= data_[t].dropped;
+    if (dropped > 0)
+        os << dropped << " trace events were dropped.\n";
+    os.flags( flags);
+    os.precision( prec);
+}
+
+void InstrumentCL::WriteChromeTrace( const std::string& filename)
+/** The times are given in microseconds since the first call of Enable.*/
+{
+    std::string name( filename);
+#ifdef _PAR
+    ProcCL::AppendProcNum( name);
+#endif
+    std::ofstream os( name.c_str());
+    if (!os)
+        throw DROPSErrCL( "InstrumentCL::WriteChromeTrace: error while opening file!");
+
+    os << std::fixed << std::setprecision( 3) << "{\"traceEvents\":[\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank_ << ",\"args\":{\"name\":\"process " << rank_ << "\"}}";
+    for (size_t t= 0; t < data_.size(); ++t)
+        for (std::vector<EventCL>::const_iterator it= data_[t].events.begin(); it != data_[t].events.end(); ++it) {
+            os << ",\n{\"name\":";
+            write_json_string( os, basename_of_path( *it->path));
+            os << ",\"cat\":\"region\",\"ph\":\"X\",\"pid\":" << rank_ << ",\"tid\":" << t
+               << ",\"ts\":" << 1e6*(it->begin - t0_) << ",\"dur\":" << 1e6*(it->end - it->begin) << ",\"args\":{\"path\":";
+            write_json_string( os, *it->path);
+            os << "}}";
+        }
+    for (size_t i= 0; i < counterEvents_.size(); ++i)
+        for (size_t j= 0; j < counterEvents_[i].values.size(); ++j) {
+            os << ",\n{\"name\":";
+            write_json_string( os, counterEvents_[i].values[j].first);
+            os << ",\"cat\":\"counter\",\"ph\":\"C\",\"pid\":" << rank_ << ",\"ts\":" << 1e6*(counterEvents_[i].time - t0_)
+               << ",\"args\":{\"value\":";
+            os.unsetf( std::ios_base::floatfield);
+            os << counterEvents_[i].values[j].second << "}}";
+            os.setf( std::ios_base::fixed, std::ios_base::floatfield);
+        }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    if (!os)
+        throw DROPSErrCL( "InstrumentCL::WriteChromeTrace: error while writing file!");
+}
+
+} // end of namespace DROPS
@@ -0,0 +1,196 @@
+/// \file instrument.h
+/// \brief hierarchical instrumentation: named regions, counters, per-step summaries and trace export
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#ifndef DROPS_INSTRUMENT_H
+#define DROPS_INSTRUMENT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iosfwd>
+#include <typeinfo>
+#include "misc/utils.h"
+
+namespace DROPS
+{
+
+/// \brief Collects the run time of nested, named regions and the values of named counters.
+/**
+    Regions are opened and closed by InstrumentRegionCL (usually via the macro DROPS_REGION); a region opened while
+    another one is open on the same thread becomes its child, so the data are stored per path, e.g.
+    "TimeStep/Coupling/GMRES". Counters (DROPS_COUNT) such as the number of matrix-vector products, the transferred
+    bytes or solver iterations are attributed to the path in which they are incremented.
+
+    Every OpenMP thread records into its own slot without locking; a worker thread starts its paths at the root.
+    Regions opened in nested parallel regions are ignored. In the parallel version each process collects its own
+    data, the process number is the "pid" of the trace and a column of the CSV file.
+
+    The data are summarized per time step (BeginStep/EndStep, one CSV row per region and counter and step) and
+    in total (WriteSummary). If tracing is switched on, each region instance is stored as an event and can be
+    written as JSON in the Chrome trace event format (chrome://tracing, Perfetto).
+
+    As long as the instrumentation is not enabled, a region costs one test of a static flag; defining
+    DROPS_NO_INSTRUMENT removes the macros completely.
+*/
+class InstrumentCL
+{
+  public:
+    /// \brief Data of a region (per thread)
+    struct RegionDataCL
+    {
+        Ulint  calls, stepCalls;      ///< number of calls, total and in the current time step
+        double time, stepTime;        ///< inclusive time in seconds, total and in the current time step
+        RegionDataCL() : calls( 0), stepCalls( 0), time( 0.), stepTime( 0.) {}
+    };
+    /// \brief Data of a counter (per thread)
+    struct CounterDataCL
+    {
+        double value, stepValue;      ///< total value and value in the current time step
+        CounterDataCL() : value( 0.), stepValue( 0.) {}
+    };
+
+    /// \brief Orders the paths such that each region is followed by its children.
+    struct PathLessCL
+    {
+        bool operator() (const std::string& a, const std::string& b) const;
+    };
+    typedef std::map<std::string, RegionDataCL,  PathLessCL> RegionMapT;
+    typedef std::map<std::string, CounterDataCL, PathLessCL> CounterMapT;
+
+  private:
+    /// \brief A closed region for the trace
+    struct EventCL
+    {
+        const std::string* path;      ///< key of the region in the RegionMapT of the thread
+        double begin, end;
+        EventCL( const std::string* p, double b, double e) : path( p), begin( b), end( e) {}
+    };
+    /// \brief Counter values at the end of a time step for the trace
+    struct CounterEventCL
+    {
+        double time;
+        std::vector<std::pair<std::string, double> > values;
+    };
+    /// \brief Everything recorded by one thread
+    struct ThreadDataCL
+    {
+        std::vector<std::pair<RegionMapT::iterator, double> > stack; ///< open regions with their start time
+        RegionMapT            regions;
+        CounterMapT           counters;
+        std::vector<EventCL>  events;
+        Ulint                 dropped;                              ///< number of events not stored due to maxEvents_
+        char pad_[64];                                              ///< keeps the slots of the threads apart
+        ThreadDataCL() : dropped( 0) {}
+    };
+
+    static bool                      enabled_;      ///< instrumentation switched on
+    static bool                      trace_;        ///< store events for the trace
+    static size_t                    maxEvents_;    ///< maximal number of events per thread
+    static int                       rank_;         ///< process number
+    static double                    t0_;           ///< time of Enable()
+    static std::vector<ThreadDataCL> data_;         ///< one slot per thread
+    static int                       step_;         ///< current time step, -1 outside of a time step
+    static double                    simTime_;      ///< simulated time passed to BeginStep
+    static std::ofstream*            csv_;          ///< per-step summary
+    static std::vector<CounterEventCL> counterEvents_; ///< counter values at the end of the time steps
+
+    /// \brief Returns the slot of the calling thread or 0, if nothing is recorded for it.
+    static ThreadDataCL* GetThreadData();
+    /// \brief Returns the path of the open region of the calling thread with "/" + name appended.
+    static std::string ChildPath( const ThreadDataCL& d, const std::string& name);
+    /// \brief Sums the regions and counters of all threads.
+    static void Merge( RegionMapT& regions, CounterMapT& counters);
+
+  public:
+    /// \brief Switches the instrumentation on; if trace is true, every region instance is stored for WriteChromeTrace.
+    static void Enable( bool trace= false, size_t maxEvents= 1000000);
+    /// \brief Switches the instrumentation off; the collected data are kept.
+    static void Disable() { enabled_= false; }
+    /// \brief Returns true, if the instrumentation is switched on.
+    static bool IsEnabled() { return enabled_; }
+    /// \brief Deletes all collected data.
+    static void Reset();
+
+    /// \brief Returns the wall clock time in seconds.
+    static double Now();
+
+    /// \brief Opens a region as child of the open region of the calling thread.
+    static void Begin( const std::string& name);
+    /// \brief Closes the innermost open region of the calling thread.
+    static void End();
+    /// \brief Adds time and calls to a child region of the open region without opening it, e.g. for times measured per element.
+    static void AddTime( const std::string& name, double time, Ulint calls= 1);
+    /// \brief Adds val to the counter name in the open region of the calling thread.
+    static void Count( const std::string& name, double val= 1.);
+    /// \brief Returns a readable name of a type (demangled, if supported by the compiler).
+    static std::string TypeName( const std::type_info& t);
+
+    /// \brief Opens the region "TimeStep" and resets the per-step data; call from the master thread outside of parallel regions.
+    static void BeginStep( int step, double simTime);
+    /// \brief Closes the region "TimeStep" and appends the data of the step to the CSV file.
+    static void EndStep();
+
+    /// \brief Opens the per-step CSV summary; in the parallel version the process number is appended to filename.
+    /** Columns: step, simulated time, rank, kind (region or counter), path, calls (regions only), value
+        (seconds summed over the threads for regions). */
+    static void OpenCSV( const std::string& filename);
+    /// \brief Closes the CSV file.
+    static void CloseCSV();
+
+    /// \brief Writes the totals of all regions and counters as indented tree.
+    static void WriteSummary( std::ostream& os);
+    /// \brief Writes the stored events in the Chrome trace event format; in the parallel version the process number is appended to filename.
+    static void WriteChromeTrace( const std::string& filename);
+
+    /// \brief Returns the merged data of all threads (for tests and custom output).
+    static void GetData( RegionMapT& regions, CounterMapT& counters) { Merge( regions, counters); }
+};
+
+/// \brief Opens a region in the constructor and closes it in the destructor, if the instrumentation is enabled.
+class InstrumentRegionCL
+{
+  private:
+    bool active_;
+
+  public:
+    InstrumentRegionCL( const char* name)
+        : active_( InstrumentCL::IsEnabled()) { if (active_) InstrumentCL::Begin( name); }
+    ~InstrumentRegionCL() { if (active_) InstrumentCL::End(); }
+};
+
+} // end of namespace DROPS
+
+#ifndef DROPS_NO_INSTRUMENT
+#  define DROPS_INSTRUMENT_CAT_(a, b) a ## b
+#  define DROPS_INSTRUMENT_CAT(a, b) DROPS_INSTRUMENT_CAT_( a, b)
+/// \brief Instruments the rest of the enclosing scope as region name.
+#  define DROPS_REGION(name) DROPS::InstrumentRegionCL DROPS_INSTRUMENT_CAT( drops_region_, __LINE__)( name)
+/// \brief Adds val to the counter name.
+#  define DROPS_COUNT(name, val) do { if (DROPS::InstrumentCL::IsEnabled()) DROPS::InstrumentCL::Count( name, val); } while (false)
+#else
+#  define DROPS_REGION(name)
+#  define DROPS_COUNT(name, val) do {} while (false)
+#endif
+
+#endif
@@ -34,9 +34,10 @@ namespace DROPS
 
 const Uint        IdxDescCL::InvalidIdx = std::numeric_limits<Uint>::max();
 std::vector<bool> IdxDescCL::IdxFree;
+size_t            IdxDescCL::LastVersion= 0;
 
 IdxDescCL::IdxDescCL( FiniteElementT fe, const BndCondCL& bnd, match_fun match, double omit_bound)
-    : FE_InfoCL( fe), Idx_( GetFreeIdx()), TriangLevel_( 0), NumUnknowns_( 0), Bnd_(bnd), match_(match),
+    : FE_InfoCL( fe), Idx_( GetFreeIdx()), TriangLevel_( 0), NumUnknowns_( 0), version_( 0), Bnd_(bnd), match_(match),
       extIdx_( omit_bound != -99 ? omit_bound : IsExtended() ? 1./32. : -1.) // default value is 1./32. for XFEM and -1 otherwise
 {
 #ifdef _PAR
@@ -66,7 +67,7 @@ Uint IdxDescCL::GetFreeIdx()
 }
 
 IdxDescCL::IdxDescCL( const IdxDescCL& orig)
- : FE_InfoCL(orig), Idx_(orig.Idx_), TriangLevel_(orig.TriangLevel_), NumUnknowns_(orig.NumUnknowns_),
+ : FE_InfoCL(orig), Idx_(orig.Idx_), TriangLevel_(orig.TriangLevel_), NumUnknowns_(orig.NumUnknowns_), version_(orig.version_),
    Bnd_(orig.Bnd_), match_(orig.match_), extIdx_(orig.extIdx_)
 {
     // invalidate orig
@@ -84,6 +85,7 @@ void IdxDescCL::swap( IdxDescCL& obj)
         std::swap( Idx_,         obj.Idx_);
     std::swap( TriangLevel_, obj.TriangLevel_);
     std::swap( NumUnknowns_, obj.NumUnknowns_);
+    std::swap( version_,     obj.version_);
     std::swap( Bnd_,         obj.Bnd_);
     std::swap( match_,       obj.match_);
     std::swap( extIdx_,      obj.extIdx_);
@@ -436,6 +438,7 @@ void IdxDescCL::CreateNumbering( Uint level, MultiGridCL& mg, const VecDescCL* l
 #ifdef _PAR
     ex_->CreateList(mg, this, true, true);
 #endif
+    IncrementVersion();
 }
 
 void IdxDescCL::UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd)
@@ -445,6 +448,7 @@ void IdxDescCL::UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const
 #ifdef _PAR
         ex_->CreateList(mg, this, true, true);
 #endif
+        IncrementVersion();
     }
 }
 
@@ -469,6 +473,7 @@ void IdxDescCL::DeleteNumbering(MultiGridCL& MG)
 #ifdef _PAR
     ex_->clear();
 #endif
+    IncrementVersion();
 }
 
 IdxT ExtIdxDescCL::UpdateXNumbering( IdxDescCL* Idx, const MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd, bool NumberingChanged)
@@ -678,6 +683,7 @@ void permute_fe_basis (MultiGridCL& mg, IdxDescCL& idx, const PermutationT& p)
         break;
       default: throw DROPSErrCL("permute_fe_basis: unknown FE type\n");
     }
+    idx.IncrementVersion();
 }
 
 void
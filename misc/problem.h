@@ -213,10 +213,12 @@ class IdxDescCL: public FE_InfoCL
   private:
     static const Uint        InvalidIdx;   ///< Constant representing an invalid index.
     static std::vector<bool> IdxFree;      ///< Cache for unused indices; reduces memory-usage.
+    static size_t            LastVersion;  ///< Last version given to a numbering.
 
     Uint                     Idx_;         ///< The unique index.
     Uint                     TriangLevel_; ///< Triangulation of the index.
     IdxT                     NumUnknowns_; ///< total number of unknowns on the triangulation
+    size_t                   version_;     ///< each (re-)numbering sets a new, globally unique version
     BndCondCL                Bnd_;         ///< boundary conditions
     match_fun                match_;       ///< matching function for periodic boundaries
     ExtIdxDescCL             extIdx_;      ///< extended index for XFEM
@@ -269,6 +271,11 @@ class IdxDescCL: public FE_InfoCL
     Uint TriangLevel() const { return TriangLevel_; }
     /// \brief total number of unknowns on the triangulation
     IdxT NumUnknowns() const { return NumUnknowns_; }
+    /// \brief Changed by CreateNumbering, UpdateXNumbering and DeleteNumbering; used to detect outdated operators.
+    /// The versions are unique among all IdxDescCL-objects; 0 means never numbered.
+    size_t GetVersion() const { return version_; }
+    /// \brief Sets a new version; to be called by functions, which change the numbering, e.g. permute_fe_basis.
+    void IncrementVersion() { version_= ++LastVersion; }
     /// \brief Compare two IdxDescCL-objects. If a multigrid is given via mg, the
     ///     unknown-numbers on it are compared, too.
     static bool
@@ -307,14 +314,16 @@ class IdxDescCL: public FE_InfoCL
 };
 
 /// \brief multilevel IdxDescCL
+///
+/// In parallel builds, only one level is allowed unless _PAR_MG is defined; the parallel multigrid (ParMGSolverCL) is experimental.
 class MLIdxDescCL : public MLDataCL<IdxDescCL>
 {
   public:
     MLIdxDescCL( FiniteElementT fe= P1_FE, size_t numLvl=1, const BndCondCL& bnd= BndCondCL(0), match_fun match=0, double omit_bound=1./32.)
     {
-#ifdef _PAR
+#if defined(_PAR) && !defined(_PAR_MG)
         if ( numLvl>1 )
-            throw DROPSErrCL("MLIdxDescCL::MLIdxDescCL: No multilevel implemented in parDROPS, yet, sorry");
+            throw DROPSErrCL("MLIdxDescCL::MLIdxDescCL: No multilevel implemented in parDROPS, yet, sorry (experimental: compile with _PAR_MG)");
 #endif
         for (size_t i=0; i< numLvl; ++i)
             this->push_back(IdxDescCL( fe, bnd, match, omit_bound));
@@ -322,9 +331,9 @@ class MLIdxDescCL : public MLDataCL<IdxDescCL>
 
     void resize( size_t numLvl=1, FiniteElementT fe= P1_FE, const BndCondCL& bnd= BndCondCL(0), match_fun match=0, double omit_bound=1./32.)
     {
-#ifdef _PAR
+#if defined(_PAR) && !defined(_PAR_MG)
         if ( numLvl>1 )
-            throw DROPSErrCL("MLIdxDescCL::resize: No multilevel implemented in parDROPS, yet, sorry");
+            throw DROPSErrCL("MLIdxDescCL::resize: No multilevel implemented in parDROPS, yet, sorry (experimental: compile with _PAR_MG)");
 #endif
         while (this->size() > numLvl)
             this->pop_back();
@@ -24,6 +24,7 @@
 
 #include "navstokes/instatnavstokes2phase.h"
 #include "num/renumber.h"
+#include "misc/instrument.h"
 
 namespace DROPS
 {
@@ -40,8 +41,8 @@ class LocalNonlConvSystemOnePhase_P2CL
   private:
     double rho_;
 
-    Quad5CL<Point3DCL> Grad[10], GradRef[10];
-    Quad5CL<Point3DCL> vel_;
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10];
+    SQuad5CL<Point3DCL> vel_;
     const SVectorCL<Quad2DataCL::NumNodesC> Ones;
 
   public:
@@ -50,7 +51,7 @@ class LocalNonlConvSystemOnePhase_P2CL
     { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     void   velocity  (const LocalP2CL<Point3DCL> & velp2)          { vel_.assign(velp2); }
-    const Quad5CL<Point3DCL> & velocity  () const { return vel_;        }
+    const SQuad5CL<Point3DCL> & velocity  () const { return vel_;        }
 
     void   rho (double new_rho)                   { rho_= new_rho;      }
     double rho () const                           { return rho_;        }
@@ -61,10 +62,10 @@ class LocalNonlConvSystemOnePhase_P2CL
 void LocalNonlConvSystemOnePhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc)
 {
     P2DiscCL::GetGradients( Grad, GradRef, T);
-    for (Uint i= 0; i < 10; ++i) {
-        for (Uint j= 0; j < 10; ++j) {
-            loc.C[i][j]= rho() * Quad5CL<>( dot(velocity(),Grad[j])).quadP2(i,absdet);
-        }
+    for (Uint j= 0; j < 10; ++j) {
+        const SQuad5CL<> u_Grad_j( dot( velocity(), Grad[j]));
+        for (Uint i= 0; i < 10; ++i)
+            loc.C[i][j]= rho() * u_Grad_j.quadP2(i,absdet);
     }
 }
 
@@ -76,10 +77,10 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
   private:
     const SmoothedJumpCL & rho_;
     
-    Quad5CL<Point3DCL> Grad[10], GradRef[10];
-    Quad5CL<Point3DCL> vel_;
-    Quad5CL<double> lset_;
-    Quad5CL<double> qrho_;
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10];
+    SQuad5CL<Point3DCL> vel_;
+    SQuad5CL<double> lset_;
+    SQuad5CL<double> qrho_;
     const SVectorCL<Quad2DataCL::NumNodesC> Ones;
 
   public:
@@ -91,15 +92,15 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
     }
 
     void   velocity  (const LocalP2CL<Point3DCL> & velp2) { vel_.assign(velp2); }
-    const Quad5CL<Point3DCL> & velocity  () const   { return vel_;        }
+    const SQuad5CL<Point3DCL> & velocity  () const   { return vel_;        }
 
     void   levelset  (const LocalP2CL<double> & lsetp2) { 
         lset_.assign(lsetp2); 
-        qrho_ = lset_;
-        qrho_.apply( rho_);
+        for (Uint i= 0; i < Quad5DataCL::NumNodesC; ++i)
+            qrho_[i]= rho_( lset_[i]);
     }
-    const Quad5CL<double> & levelset () const     { return lset_;  }
-    const Quad5CL<double> & smoothed_rho () const { return qrho_; }
+    const SQuad5CL<double> & levelset () const    { return lset_;  }
+    const SQuad5CL<double> & smoothed_rho () const { return qrho_; }
 
     void setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc);
 };
@@ -107,10 +108,10 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
 void LocalNonlConvSystemSmoothedJumps_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc)
 {
     P2DiscCL::GetGradients( Grad, GradRef, T);
-    for (Uint i= 0; i < 10; ++i) {
-        for (Uint j= 0; j < 10; ++j) {
-            loc.C[i][j]= Quad5CL<>( smoothed_rho() * dot(velocity(),Grad[j])) .quadP2(i,absdet);
-        }
+    for (Uint j= 0; j < 10; ++j) {
+        const SQuad5CL<> rho_u_Grad_j( smoothed_rho() * dot( velocity(), Grad[j]));
+        for (Uint i= 0; i < 10; ++i)
+            loc.C[i][j]= rho_u_Grad_j.quadP2(i,absdet);
     }
 }
 
@@ -264,7 +265,7 @@ void NonlConvSystemAccumulator_P2CL::visit (const TetraCL& tet)
 
 void NonlConvSystemAccumulator_P2CL::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
+    GetTrafoTr( T, det, tet, geom_cache_, geom_pos_);
     absdet= std::fabs( det);
 
     n.assign( tet, RowIdx, BndData.Vel);
@@ -370,4 +371,246 @@ PermutationT InstatNavierStokes2PhaseP2P1CL::downwind_numbering (const LevelsetP
     return p;
 }
 
+//*****************************************************************************
+//                               MatrixFreeVelocityP2CL
+//*****************************************************************************
+
+MatrixFreeVelocityP2CL::MatrixFreeVelocityP2CL (const InstatNavierStokes2PhaseP2P1CL& ns, const LevelsetP2CL& lset)
+    : ns_( ns), lset_( lset), idx_( 0), a_( 1.), m_( 0.), c_( 0.), vel_( 0), version_( 0)
+{
+    Quad2CL<Point3DCL> grad2[10];
+    Quad5CL<Point3DCL> grad5[10];
+    P2DiscCL::GetGradientsOnRef( grad2);
+    P2DiscCL::GetGradientsOnRef( grad5);
+    for (int i= 0; i < 10; ++i) {
+        for (int q= 0; q < Quad2DataCL::NumNodesC; ++q)
+            gradRef2_[i][q]= grad2[i][q];
+        for (int q= 0; q < Quad5DataCL::NumNodesC; ++q)
+            gradRef5_[i][q]= grad5[i][q];
+    }
+}
+
+void MatrixFreeVelocityP2CL::Setup ()
+{
+    DROPS_REGION( "MatrixFreeVelocityP2CL::Setup");
+    idx_= &ns_.vel_idx.GetFinest();
+    const StokesBndDataCL::VelBndDataCL& bnd= ns_.GetBndData().Vel;
+    const ColorClassesCL& colors= ns_.GetMG().GetColorClasses( idx_->TriangLevel(), idx_->GetMatchingFunction(), idx_->GetBndInfo());
+
+    tetra_.clear();
+    cut_.clear();
+    colorBegin_.assign( 1, 0);
+    LocalNumbP2CL n;
+    LocalP2CL<> ls;
+    double det;
+    for (ColorClassesCL::const_iterator cit= colors.begin(); cit != colors.end(); ++cit) {
+        for (ColorClassesCL::ColorClassT::const_iterator it= cit->begin(); it != cit->end(); ++it) {
+            tetra_.push_back( TetraDataCL());
+            TetraDataCL& d= tetra_.back();
+            d.tet= *it;
+            n.assign( **it, *idx_, bnd);
+            std::copy( n.num, n.num + 10, d.num);
+            GetTrafoTr( d.T, det, **it);
+            d.absdet= std::fabs( det);
+            d.bnd= NoIdx;
+            ls.assign( **it, lset_.Phi, lset_.GetBndData());
+            if (equal_signs( ls)) {
+                d.phase= sign( ls[0]) > 0 ? 1 : -1;
+                d.cut= NoIdx;
+            }
+            else {
+                d.phase= 0;
+                d.cut= cut_.size();
+                cut_.push_back( CutDataCL());
+                SetupLocalSystem1_P2( ns_.GetCoeff(), d.T, d.absdet, ls, cut_.back().Ak, cut_.back().M);
+                std::fill( &cut_.back().C[0][0], &cut_.back().C[0][0] + 100, 0.);
+            }
+        }
+        colorBegin_.push_back( tetra_.size());
+    }
+    vel_= 0;
+    bndvel_.clear();
+    ++version_;
+    std::cout << "MatrixFreeVelocityP2CL::Setup: " << tetra_.size() << " tetras, " << cut_.size() << " cut tetras\n";
+}
+
+void MatrixFreeVelocityP2CL::SetCoeff (double a, double m, double c)
+{
+    a_= a;
+    m_= m;
+    c_= c;
+    ++version_;
+}
+
+void MatrixFreeVelocityP2CL::SetVelocity (const VelVecDescCL* vel)
+{
+    DROPS_REGION( "MatrixFreeVelocityP2CL::SetVelocity");
+    vel_= vel;
+    bndvel_.clear();
+    const TwoPhaseFlowCoeffCL& coeff= ns_.GetCoeff();
+    LocalNonlConvSystemTwoPhase_P2CL local_twophase( coeff.rho( 1.0), coeff.rho( -1.0));
+    LocalNonlConvDataCL loc;
+    LocalP2CL<Point3DCL> vel_loc;
+    LocalP2CL<> ls;
+    for (std::vector<TetraDataCL>::iterator d= tetra_.begin(); d != tetra_.end(); ++d) {
+        const bool dirichlet= std::find( d->num, d->num + 10, NoIdx) != d->num + 10;
+        if (!dirichlet && d->phase != 0)
+            continue;
+        vel_loc.assign( *d->tet, *vel, ns_.GetBndData().Vel);
+        if (dirichlet) {
+            d->bnd= bndvel_.size();
+            for (int i= 0; i < 10; ++i)
+                bndvel_.push_back( vel_loc[i]);
+        }
+        if (d->phase == 0) { // the convection on cut tetras requires the partition of the tetra
+            ls.assign( *d->tet, lset_.Phi, lset_.GetBndData());
+            local_twophase.setup( d->T, d->absdet, vel_loc, ls, loc);
+            std::copy( &loc.C[0][0], &loc.C[0][0] + 100, &cut_[d->cut].C[0][0]);
+        }
+    }
+    ++version_;
+}
+
+void MatrixFreeVelocityP2CL::local_velocity (const TetraDataCL& d, Point3DCL vl[10]) const
+{
+    for (int i= 0; i < 10; ++i)
+        if (d.num[i] != NoIdx)
+            vl[i]= MakePoint3D( vel_->Data[d.num[i]], vel_->Data[d.num[i] + 1], vel_->Data[d.num[i] + 2]);
+        else
+            vl[i]= bndvel_[d.bnd + i];
+}
+
+void MatrixFreeVelocityP2CL::apply_tetra (const TetraDataCL& d, const VectorCL& x, VectorCL& y) const
+{
+    Point3DCL xl[10], yl[10];
+    for (int i= 0; i < 10; ++i)
+        if (d.num[i] != NoIdx)
+            xl[i]= MakePoint3D( x[d.num[i]], x[d.num[i] + 1], x[d.num[i] + 2]);
+
+    if (d.phase == 0) {
+        const CutDataCL& loc= cut_[d.cut];
+        for (int i= 0; i < 10; ++i)
+            for (int j= 0; j < 10; ++j)
+                yl[i]+= a_*(loc.Ak[i][j]*xl[j]) + (m_*loc.M[i][j] + c_*loc.C[i][j])*xl[j];
+    }
+    else {
+        const double mu=  ns_.GetCoeff().mu( d.phase),
+                     rho= ns_.GetCoeff().rho( d.phase);
+        if (a_ != 0.) { // \int mu (grad u + grad u^T) : grad v, exact with the quadrature rule of degree 2
+            Point3DCL g[10];
+            SMatrixCL<3,3> G, Gt;
+            for (int q= 0; q < Quad2DataCL::NumNodesC; ++q) {
+                G= SMatrixCL<3,3>();
+                for (int j= 0; j < 10; ++j) {
+                    g[j]= d.T*gradRef2_[j][q];
+                    G+= outer_product( xl[j], g[j]);
+                }
+                assign_transpose( Gt, G);
+                G+= Gt;
+                G*= a_*mu*d.absdet*Quad2DataCL::Weight[q];
+                for (int i= 0; i < 10; ++i)
+                    yl[i]+= G*g[i];
+            }
+        }
+        if (m_ != 0.) { // the mass matrix on the reference tetra is known
+            const double s= m_*rho*d.absdet;
+            for (int i= 0; i < 10; ++i)
+                for (int j= 0; j < 10; ++j)
+                    yl[i]+= (s*P2DiscCL::GetMass( i, j))*xl[j];
+        }
+        if (c_ != 0. && vel_ != 0) { // \int rho (u_old . grad) u . v, exact with the quadrature rule of degree 5
+            Point3DCL vl[10], u, w;
+            local_velocity( d, vl);
+            for (int q= 0; q < Quad5DataCL::NumNodesC; ++q) {
+                u= Point3DCL();
+                w= Point3DCL();
+                for (int j= 0; j < 10; ++j)
+                    u+= Quad5DataCL::P2_Val[j][q]*vl[j];
+                for (int j= 0; j < 10; ++j)
+                    w+= inner_prod( u, d.T*gradRef5_[j][q])*xl[j];
+                w*= c_*rho*d.absdet*Quad5DataCL::Weight[q];
+                for (int i= 0; i < 10; ++i)
+                    yl[i]+= Quad5DataCL::P2_Val[i][q]*w;
+            }
+        }
+    }
+    for (int i= 0; i < 10; ++i)
+        if (d.num[i] != NoIdx)
+            add_to_global_vector( y, yl[i], d.num[i]);
+}
+
+void MatrixFreeVelocityP2CL::diag_tetra (const TetraDataCL& d, VectorCL& diag) const
+{
+    Point3DCL dl[10];
+    if (d.phase == 0) {
+        const CutDataCL& loc= cut_[d.cut];
+        for (int i= 0; i < 10; ++i)
+            for (int k= 0; k < 3; ++k)
+                dl[i][k]= a_*loc.Ak[i][i]( k, k) + m_*loc.M[i][i] + c_*loc.C[i][i];
+    }
+    else {
+        const double mu=  ns_.GetCoeff().mu( d.phase),
+                     rho= ns_.GetCoeff().rho( d.phase);
+        Point3DCL g;
+        for (int q= 0; q < Quad2DataCL::NumNodesC; ++q) // a_kk= mu (|g|^2 + g_k^2)
+            for (int i= 0; i < 10; ++i) {
+                g= d.T*gradRef2_[i][q];
+                const double s= a_*mu*d.absdet*Quad2DataCL::Weight[q];
+                for (int k= 0; k < 3; ++k)
+                    dl[i][k]+= s*(g.norm_sq() + g[k]*g[k]);
+            }
+        for (int i= 0; i < 10; ++i)
+            dl[i]+= Point3DCL( m_*rho*d.absdet*P2DiscCL::GetMass( i, i));
+        if (c_ != 0. && vel_ != 0) {
+            Point3DCL vl[10], u;
+            local_velocity( d, vl);
+            for (int q= 0; q < Quad5DataCL::NumNodesC; ++q) {
+                u= Point3DCL();
+                for (int j= 0; j < 10; ++j)
+                    u+= Quad5DataCL::P2_Val[j][q]*vl[j];
+                const double s= c_*rho*d.absdet*Quad5DataCL::Weight[q];
+                for (int i= 0; i < 10; ++i)
+                    dl[i]+= (s*Quad5DataCL::P2_Val[i][q]*inner_prod( u, d.T*gradRef5_[i][q]))*Point3DCL( 1.);
+            }
+        }
+    }
+    for (int i= 0; i < 10; ++i)
+        if (d.num[i] != NoIdx)
+            add_to_global_vector( diag, dl[i], d.num[i]);
+}
+
+void MatrixFreeVelocityP2CL::Apply (const VectorCL& x, VectorCL& y) const
+{
+    DROPS_REGION( "MatrixFreeVelocityP2CL::Apply");
+    resize_work( y, num_rows());
+    y= 0.;
+    // the tetras of a color class do not share unknowns
+    for (size_t c= 0; c + 1 < colorBegin_.size(); ++c) {
+#ifndef DROPS_WIN
+        size_t k;
+#else
+        int k;
+#endif
+#       pragma omp parallel for schedule(static)
+        for (k= colorBegin_[c]; k < colorBegin_[c + 1]; ++k)
+            apply_tetra( tetra_[k], x, y);
+    }
+}
+
+VectorCL MatrixFreeVelocityP2CL::GetDiag () const
+{
+    VectorCL diag( num_rows());
+    for (size_t c= 0; c + 1 < colorBegin_.size(); ++c) {
+#ifndef DROPS_WIN
+        size_t k;
+#else
+        int k;
+#endif
+#       pragma omp parallel for schedule(static)
+        for (k= colorBegin_[c]; k < colorBegin_[c + 1]; ++k)
+            diag_tetra( tetra_[k], diag);
+    }
+    return diag;
+}
+
 } // end of namespace DROPS
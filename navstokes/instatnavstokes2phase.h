@@ -77,6 +77,86 @@ class InstatNavierStokes2PhaseP2P1CL : public InstatStokes2PhaseP2P1CL
     PermutationT downwind_numbering (const LevelsetP2CL& lset, IteratedDownwindCL dw);
 };
 
+
+/// \brief Matrix-free application of a*A + m*M + c*N for the P2-velocity of two-phase flow.
+///
+/// Instead of the 3x3-block matrices A, M, N, only the numbering of the unknowns and the affine transformation are stored
+/// per tetra. On tetras in a single phase, the operators are applied at the quadrature points; the local matrices of the
+/// few tetras cut by the interface are stored, as their setup requires the partition of the tetra. The tetras are
+/// ordered by color classes, hence the application is OpenMP-parallel without write conflicts.
+///
+/// The class satisfies the Mat-interface of the Krylov solvers in num/solver.h (operator*, num_rows, num_cols, Version);
+/// GetDiag() can be used for Jacobi-type preconditioners, e.g. DiagPcCL. As for the matrices, the Dirichlet unknowns are
+/// eliminated; the couplings cplA, cplM, cplN are not computed.
+class MatrixFreeVelocityP2CL
+{
+  private:
+    struct TetraDataCL
+    {
+        const TetraCL* tet;
+        IdxT           num[10]; ///< numbering of the unknowns; NoIdx on Dirichlet boundaries
+        SMatrixCL<3,3> T;       ///< transformation of the gradients
+        double         absdet;
+        int            phase;   ///< sign of the level set function on tetras in a single phase, 0 on cut tetras
+        size_t         cut;     ///< index of the local matrices in cut_
+        size_t         bnd;     ///< index of the Dirichlet values of the velocity in bndvel_, NoIdx if there are none
+    };
+    /// \brief Local matrices of a cut tetra with the layout of the matrix accumulators
+    struct CutDataCL
+    {
+        SMatrixCL<3,3> Ak[10][10];
+        double         M[10][10],
+                       C[10][10];
+    };
+
+    const InstatNavierStokes2PhaseP2P1CL& ns_;
+    const LevelsetP2CL&                   lset_;
+    const IdxDescCL*                      idx_;
+
+    double a_, m_, c_;                   ///< the operator is a_*A + m_*M + c_*N
+    const VelVecDescCL*    vel_;         ///< velocity of the convection term N
+    std::vector<Point3DCL> bndvel_;      ///< local velocities of the tetras with Dirichlet unknowns
+    size_t                 version_;
+
+    std::vector<TetraDataCL> tetra_;
+    std::vector<size_t>      colorBegin_; ///< tetra_[colorBegin_[c]], ..., tetra_[colorBegin_[c+1]-1] have the color c
+    std::vector<CutDataCL>   cut_;
+
+    Point3DCL gradRef2_[10][Quad2DataCL::NumNodesC], ///< gradients of the P2-basis functions on the reference tetra
+              gradRef5_[10][Quad5DataCL::NumNodesC];
+
+    void local_velocity (const TetraDataCL& d, Point3DCL vl[10]) const;
+    void apply_tetra (const TetraDataCL& d, const VectorCL& x, VectorCL& y) const;
+    void diag_tetra  (const TetraDataCL& d, VectorCL& diag) const;
+
+  public:
+    MatrixFreeVelocityP2CL (const InstatNavierStokes2PhaseP2P1CL& ns, const LevelsetP2CL& lset);
+
+    /// \brief Stores the geometry of the finest velocity level and the local matrices of the cut tetras.
+    /// Must be called after changes of the grid or of the level set function.
+    void Setup ();
+    /// \brief The operator becomes a*A + m*M + c*N.
+    void SetCoeff (double a, double m, double c);
+    /// \brief Velocity of the convection term; must be called after each change of the velocity.
+    void SetVelocity (const VelVecDescCL* vel);
+
+    size_t num_rows () const { return idx_ == 0 ? 0 : idx_->NumUnknowns(); }
+    size_t num_cols () const { return num_rows(); }
+    size_t Version  () const { return version_; }
+    size_t GetNumCutTetras () const { return cut_.size(); }
+
+    /// \brief y= (a*A + m*M + c*N) x
+    void Apply (const VectorCL& x, VectorCL& y) const;
+    /// \brief Main diagonal of a*A + m*M + c*N
+    VectorCL GetDiag () const;
+
+    friend VectorCL operator* (const MatrixFreeVelocityP2CL& A, const VectorCL& x) {
+        VectorCL y;
+        A.Apply( x, y);
+        return y;
+    }
+};
+
 } // end of namespace DROPS
 
 #endif
@@ -291,8 +291,9 @@ template <class Coeff>
     const IdxT stride= 1;   // stride between unknowns on same simplex, which
                             // depends on numbering of the unknowns
 
-    Quad5CL<Point3DCL> Grad[10], GradRef[10];  // jeweils Werte des Gradienten in 5 Stuetzstellen
-    Quad5CL<Point3DCL> u_loc;
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10];  // jeweils Werte des Gradienten in 15 Stuetzstellen
+    SQuad5CL<Point3DCL> u_loc;
+    SQuad5CL<> u_Grad[10];                      // u grad phi_j
     SMatrixCL<3,3> T;
     double det, absdet;
     SVectorCL<3> tmp;
@@ -307,6 +308,8 @@ template <class Coeff>
         P2DiscCL::GetGradients(Grad, GradRef, T);
         absdet= std::fabs(det);
         u_loc.assign( *sit, u);
+        for (int j= 0; j < 10; ++j)
+            u_Grad[j]= dot( u_loc, Grad[j]);
 
         // collect some information about the edges and verts of the tetra
         // and save it in Numb and IsOnDirBnd
@@ -316,7 +319,7 @@ template <class Coeff>
             if (n.WithUnknowns( i)) // vert/edge i is not on a Dirichlet boundary
                 for (int j= 0; j < 10; ++j)
                 { // N(u)_ij = int( phi_i *( u1 phi_j_x + u2 phi_j_y + u3 phi_j_z ) )
-                    const double N_ij= Quad5CL<>(dot( u_loc, Grad[j])).quadP2( i, absdet);
+                    const double N_ij= u_Grad[j].quadP2( i, absdet);
                     if (n.WithUnknowns( j)) // vert/edge j is not on a Dirichlet boundary
                     {
                         N(n.num[i],          n.num[j])+=          N_ij;
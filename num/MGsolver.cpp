@@ -23,10 +23,28 @@
 */
 
 #include "num/MGsolver.h"
+#include <iomanip>
 
 namespace DROPS
 {
 
+double MGStatisticsCL::GetConvergenceRate () const
+{
+    if (resid_.size() < 2 || resid_.front() <= 0.)
+        return -1.;
+    return std::pow( resid_.back()/resid_.front(), 1./(resid_.size() - 1));
+}
+
+void MGStatisticsCL::Print (std::ostream& os) const
+{
+    os << "level  unknowns  visits  smooth steps  smoothing [s]  transfer [s]  coarse solve [s]\n";
+    for (size_t l= 0; l < level_.size(); ++l)
+        os << std::setw( 5) << l << std::setw( 10) << level_[l].unknowns << std::setw( 8) << level_[l].visits
+           << std::setw( 14) << level_[l].smoothSteps << std::setw( 15) << level_[l].smoothTime
+           << std::setw( 14) << level_[l].transferTime << std::setw( 18) << level_[l].coarseTime << '\n';
+    os << "average reduction of the error measure per cycle: " << GetConvergenceRate() << '\n';
+}
+
 void CheckMGData( const MLMatrixCL& A, const MLMatrixCL& P)
 {
     Uint lvl= 0;
@@ -30,43 +30,161 @@
 
 #include <list>
 #include <cstring>
+#include <iterator>
 
 namespace DROPS
 {
+/// \brief Cycle types of MGM: the coarse grid correction is computed with one (V-cycle) or two (W-cycle)
+/// recursive cycles; the F-cycle uses an F-cycle followed by a V-cycle on the coarser level.
+enum MGCycleT { MG_VCycle= 1, MG_WCycle= 2, MG_FCycle= 3 };
+
+/// \brief Timing and convergence statistics of the multigrid methods.
+/** The per-level data accumulates until Reset() is called; the residual history describes the last call of MG. */
+class MGStatisticsCL
+{
+  public:
+    /// \brief Data of one level; level 0 is the coarsest level.
+    struct LevelCL
+    {
+        size_t unknowns;     ///< number of unknowns
+        Uint   visits;       ///< number of visits of the level by the cycles
+        Uint   smoothSteps;  ///< number of smoothing steps (pre- and postsmoothing)
+        double smoothTime;   ///< time for the smoothing
+        double transferTime; ///< time for the residual, the restriction and the prolongation
+        double coarseTime;   ///< time for the coarse grid solves on this level
+        LevelCL() : unknowns( 0), visits( 0), smoothSteps( 0), smoothTime( 0.), transferTime( 0.), coarseTime( 0.) {}
+    };
+
+  private:
+    std::vector<LevelCL> level_;
+    std::vector<double>  resid_;  ///< error measure of MG: residual before the first and after each cycle or norm of the correction of each cycle
+
+  public:
+    void Reset () { level_.clear(); resid_.clear(); }
+
+    LevelCL& Level (size_t l) {
+        if (l >= level_.size())
+            level_.resize( l + 1);
+        return level_[l];
+    }
+    const std::vector<LevelCL>& GetLevels () const { return level_; }
+
+    void ClearResid () { resid_.clear(); }
+    void AddResid (double r) { resid_.push_back( r); }
+    const std::vector<double>& GetResid () const { return resid_; }
+    /// \brief Average reduction of the error measure per cycle in the last call of MG; -1, if there was no cycle.
+    double GetConvergenceRate () const;
+
+    /// \brief Writes a table with the per-level data and the convergence rate.
+    void Print (std::ostream& os) const;
+};
+
+/// \brief Parameters of the cycles of MGM and MG.
+struct MGCycleParamCL
+{
+    MGCycleT        cycle;        ///< cycle type
+    double          smoothGrowth; ///< the number of smoothing steps is multiplied by smoothGrowth on each coarser level (variable V-cycle)
+    bool            fullMG;       ///< MG starts with a full multigrid cycle (FMG)
+    double          adaptRate;    ///< MG doubles the number of smoothing steps, if a cycle reduces the error by less than this factor (0: off)
+    MGStatisticsCL* stat;         ///< if not 0, timings and convergence statistics are collected
+
+    MGCycleParamCL (MGCycleT c= MG_VCycle, double growth= 1., bool fmg= false, double adapt= 0., MGStatisticsCL* s= 0)
+        : cycle( c), smoothGrowth( growth), fullMG( fmg), adaptRate( adapt), stat( s) {}
+
+    /// \brief Number of smoothing steps on the next coarser level.
+    Uint CoarseSmoothSteps (Uint smoothSteps) const {
+        return smoothGrowth == 1. ? smoothSteps : static_cast<Uint>( std::ceil( smoothSteps*smoothGrowth - 1e-12));
+    }
+};
+
+/// \brief Index of the level of the hierarchy X, which corresponds to level l of the hierarchy A; the finest levels
+///     of both correspond to each other.
+template <class MLDataT, class OtherT>
+inline size_t CorrespondingLevel (const MLDataT& A, const OtherT& X, size_t l)
+{
+    return l + X.size() - A.size();
+}
+
 /**
-\brief  Multigrid method, V-cycle, beginning from level 'fine'
+\brief  Multigrid method, V-, W- or F-cycle, beginning from level 'fine'
 
  numLevel and numUnknDirect specify, when the direct solver 'Solver' is used:
  after 'numLevel' visited levels or if number of unknowns <= 'numUnknDirect'
  If one of the parameters is -1, it will be neglected.
- If the coarsest level 'begin' has been reached, the direct solver is used too.
+ If the coarsest level 0 has been reached, the direct solver is used too.
  NOTE: Assumes, that the levels are stored in an ascending order (first=coarsest, last=finest)
+ The levels are accessed by their index (GetLevel); an iterator into an MLDataCL would be invalidated, if
+ levels are added or removed.
 
- \param begin         coarsest level
- \param fine          actual level
- \param P             prolongation
+ \param A             matrices of all levels
+ \param P             prolongations of all levels; the finest levels of A and P correspond to each other
+ \param fine          index of the actual level in A
  \param x             approximation of the solution
  \param b             right hand side
  \param Smoother      multigrid smoother
  \param smoothSteps   number of smoothing steps
  \param Solver        coarse grid/direct solver with relative residual measurement
  \param numLevel      number of vidited levels
- \param numUnknDirect minimal number of unknowns for the direct solver */
-template<class SmootherCL, class DirectSolverCL, class ProlongationIteratorT>
-void MGM( const MLMatrixCL::const_iterator& begin, const MLMatrixCL::const_iterator& fine,
-          const ProlongationIteratorT& P, VectorCL& x, const VectorCL& b,
+ \param numUnknDirect minimal number of unknowns for the direct solver
+ \param param         cycle type, growth of the smoothing steps and statistics
+
+ The levels may be stored in single precision (MLFloatMatrixCL with FloatVectorCL), see MGSolverCL::SetSinglePrecision. */
+template<class SmootherCL, class DirectSolverCL, class MLMatT, class ProlongationT, class Vec>
+void MGM( const MLMatT& A, const ProlongationT& P, size_t fine, Vec& x, const Vec& b,
+          const SmootherCL& Smoother, Uint smoothSteps,
+          DirectSolverCL& Solver, int numLevel, int numUnknDirect,
+          const MGCycleParamCL& param= MGCycleParamCL());
+
+/**
+\brief Full multigrid: approximates the solution of the problem on level 'fine' without an initial guess.
+
+ The right hand side is restricted to the coarser levels; beginning with the coarse grid solution, the solution
+ of each level is prolongated to the next finer level and improved by 'cycles' cycles of MGM.
+ The parameters are those of MGM; the initial value of x is ignored. */
+template<class SmootherCL, class DirectSolverCL, class MLMatT, class ProlongationT, class Vec>
+void FMG( const MLMatT& A, const ProlongationT& P, size_t fine, Vec& x, const Vec& b,
           const SmootherCL& Smoother, Uint smoothSteps,
-          DirectSolverCL& Solver, int numLevel, int numUnknDirect);
+          DirectSolverCL& Solver, int numLevel, int numUnknDirect,
+          const MGCycleParamCL& param= MGCycleParamCL(), Uint cycles= 1);
+
+/// \brief Coarse grid solve of MGM and MGMPr.
+///
+/// The coarse grid problem of a single precision hierarchy is converted and solved in double precision.
+/// It is small and the Krylov solvers used as direct solvers are written for double precision.
+template <class DirectSolverCL, typename T>
+inline void MGCoarseSolve (DirectSolverCL& Solver, const SparseMatBaseCL<T>& A, VectorBaseCL<T>& x, const VectorBaseCL<T>& b)
+{
+    Solver.Solve( A, x, b);
+}
+
+template <class DirectSolverCL>
+void MGCoarseSolve (DirectSolverCL& Solver, const FloatMatrixCL& A, FloatVectorCL& x, const FloatVectorCL& b)
+{
+    MatrixCL Ad;
+    VectorCL xd, bd;
+    convert_matrix( Ad, A);
+    convert_vector( xd, x);
+    convert_vector( bd, b);
+    Solver.Solve( Ad, xd, bd);
+    convert_vector( x, xd);
+}
+
+/// \brief Single precision copy of the prolongation for MGSolverCL::SetSinglePrecision.
+inline const MLFloatMatrixCL& GetFloatProlongation (FloatMatrixCacheCL& Pf, const MLMatrixCL& P)
+{
+    return Pf.Get( P);
+}
 
 /**
 \brief Uses MGM for solving to tolerance tol or until maxiter iterations are reached.
 
  The error is measured as two-norm of dx for residerr=false, of Ax-b for residerr=true.
- sm controls the number of smoothing steps, lvl the number of used levels */
-template<class SmootherCL, class DirectSolverCL, class ProlongationT>
-void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL&,
-        DirectSolverCL&, VectorCL& x, const VectorCL& b, int& maxiter, double& tol,
-        const bool residerr= true, Uint sm=1, int lvl=-1);
+ sm controls the number of smoothing steps, lvl the number of used levels, param the cycles.
+ With param.fullMG, the first iteration is a full multigrid cycle for the residual equation. */
+template<class SmootherCL, class DirectSolverCL, class ProlongationT, typename T>
+void MG(const MLSparseMatBaseCL<T>& MGData, const ProlongationT& Prolong, const SmootherCL&,
+        DirectSolverCL&, VectorBaseCL<T>& x, const VectorBaseCL<T>& b, int& maxiter, double& tol,
+        const bool residerr= true, Uint sm=1, int lvl=-1, const MGCycleParamCL& param= MGCycleParamCL());
 
 
 /*******************************************************************
@@ -74,7 +192,12 @@ void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL
 *******************************************************************/
 /// \brief MultiGrid solver for a single matrix problem
 /** Uses a Multigrid structure for a single matrix, e.g.
-    a poisson problem or the A-block of a (navier-)stokes problem */
+    a poisson problem or the A-block of a (navier-)stokes problem.
+    In single precision mode, the hierarchy and the prolongation are converted to float,
+    if they change, and the cycles run in single precision; smoother and direct solver
+    must accept FloatMatrixCL and FloatVectorCL.
+    The cycle type, full multigrid and the smoothing steps are controlled by SetCycleParam;
+    per-level timings and the convergence history are collected after SetCollectStatistics( true). */
 /*******************************************************************
 *   M G S o l v e r  C L                                           *
 ********************************************************************/
@@ -88,6 +211,11 @@ class MGSolverCL : public SolverBaseCL
     const bool        residerr_;         ///< controls the error measuring: false : two-norm of dx, true: two-norm of residual
     Uint              smoothSteps_;      ///< number of smoothing steps
     int               usedLevels_;       ///< number of used levels (-1 = all)
+    bool              single_;           ///< run the cycles in single precision
+    FloatMatrixCacheCL Af_, Pf_;         ///< single precision copies of the hierarchy and the prolongation
+    FloatVectorCL     xf_, bf_;          ///< single precision copies of the vectors
+    MGCycleParamCL    param_;            ///< cycle type and smoothing steps
+    MGStatisticsCL    stat_;             ///< timings and convergence history
 
   public:
     /// constructor for MGSolverCL
@@ -101,20 +229,65 @@ class MGSolverCL : public SolverBaseCL
     MGSolverCL( const SmootherT& sm, DirectSolverT& ds, int maxiter,
                 double tol, const bool residerr= true, Uint smsteps= 1, int lvl= -1 )
         : SolverBaseCL(maxiter,tol), smoother_(sm), directSolver_(ds),
-          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl) {}
+          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl), single_( false) {}
 
     ProlongationT* GetProlongation() { return &P; }
+    /// \brief Switches the single precision mode; switching it off releases the single precision copies.
+    void SetSinglePrecision (bool single) {
+        single_= single;
+        if (!single) {
+            Af_.Clear();
+            Pf_.Clear();
+        }
+    }
+    bool GetSinglePrecision () const { return single_; }
+
+    /// \brief Sets cycle type, growth of the smoothing steps, full multigrid and adaptive smoothing; the statistics setting is kept.
+    void SetCycleParam (const MGCycleParamCL& param) {
+        MGStatisticsCL* stat= param_.stat;
+        param_= param;
+        param_.stat= stat;
+    }
+    const MGCycleParamCL& GetCycleParam () const { return param_; }
+    void SetCycle (MGCycleT cycle) { param_.cycle= cycle; }
+    void SetFullMG (bool fmg) { param_.fullMG= fmg; }
+    void SetSmoothSteps (Uint sm) { smoothSteps_= sm; }
+    Uint GetSmoothSteps () const { return smoothSteps_; }
+    /// \brief Switches the collection of timings and convergence statistics; switching it on resets the statistics.
+    void SetCollectStatistics (bool collect) {
+        param_.stat= collect ? &stat_ : 0;
+        stat_.Reset();
+    }
+    const MGStatisticsCL& GetStatistics () const { return stat_; }
     /// solve function: calls the MultiGrid-routine
     void Solve(const MLMatrixCL& A, VectorCL& x, const VectorCL& b)
     {
+        if (single_) {
+            convert_vector( xf_, x);
+            convert_vector( bf_, b);
+            Solve( Af_.Get( A), xf_, bf_);
+            convert_vector( x, xf_);
+            return;
+        }
         _res=  _tol;
         _iter= _maxiter;
-        MG( A, P, smoother_, directSolver_, x, b, _iter, _res, residerr_, smoothSteps_, usedLevels_);
+        MG( A, P, smoother_, directSolver_, x, b, _iter, _res, residerr_, smoothSteps_, usedLevels_, param_);
+    }
+    /// solve function for a single precision hierarchy
+    void Solve(const MLFloatMatrixCL& A, FloatVectorCL& x, const FloatVectorCL& b)
+    {
+        _res=  _tol;
+        _iter= _maxiter;
+        MG( A, GetFloatProlongation( Pf_, P), smoother_, directSolver_, x, b, _iter, _res, residerr_, smoothSteps_, usedLevels_, param_);
     }
     void Solve(const MatrixCL&, VectorCL&, const VectorCL&)
     {
         throw DROPSErrCL( "MGSolverCL::Solve: need multilevel data structure\n");
     }
+    void Solve(const FloatMatrixCL&, FloatVectorCL&, const FloatVectorCL&)
+    {
+        throw DROPSErrCL( "MGSolverCL::Solve: need multilevel data structure\n");
+    }
 
 };
 
@@ -127,15 +300,16 @@ void CheckMGData( const MLMatrixCL& A, const MLMatrixCL& P);
  numLevel and numUnknDirect specify, when the direct solver 'Solver' is used:
  after 'numLevel' visited levels or if number of unknowns <= 'numUnknDirect'
  If one of the parameters is -1, it will be neglected.
- If the coarsest level 'begin' has been reached, the direct solver is used too.
+ If the coarsest level 0 has been reached, the direct solver is used too.
  NOTE: Assumes, that the levels are stored in an ascending order (first=coarsest, last=finest)
- \param beginA        A on coarsest level
- \param fineA         A on actual level
- \param fineB         B on actual level
- \param fineBT        B^T on actual level
- \param fineprM       pressure mass matrix on actual level
+ The levels are accessed by their index, cf. MGM; the finest levels of all hierarchies correspond to each other.
+ \param A             A on all levels
+ \param B             B on all levels
+ \param BT            B^T on all levels
+ \param prM           pressure mass matrix on all levels
  \param PVel          prolongation for P2
  \param PPr           prolongation for P1
+ \param fine          index of the actual level in A
  \param u             velocity
  \param p             pressure
  \param b             rhs for velocity
@@ -146,11 +320,9 @@ void CheckMGData( const MLMatrixCL& A, const MLMatrixCL& P);
  \param Solver        coarse grid/direct solver with relative residual measurement
  \param numLevel      number of vidited levels
  \param numUnknDirect minimal number of unknowns for the direct solver */
-template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongItT1, class ProlongItT2>
-void StokesMGM( const MLMatrixCL::const_iterator& beginA,  const MLMatrixCL::const_iterator& fineA,
-                const MLMatrixCL::const_iterator& fineB,   const MLMatrixCL::const_iterator& fineBT,
-                const MLMatrixCL::const_iterator& fineprM, const ProlongItT1& PVel,
-                const ProlongItT2& PPr, VectorCL& u, VectorCL& p, const VectorCL& b,
+template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongT1, class ProlongT2>
+void StokesMGM( const MLMatrixCL& A, const MLMatrixCL& B, const MLMatrixCL& BT, const MLMatrixCL& prM,
+                const ProlongT1& PVel, const ProlongT2& PPr, size_t fine, VectorCL& u, VectorCL& p, const VectorCL& b,
                 const VectorCL& c, const StokesSmootherCL& Smoother, Uint smoothSteps, Uint cycleSteps,
                 StokesDirectSolverCL& Solver, int numLevel, int numUnknDirect);
 
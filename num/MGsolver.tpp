@@ -24,136 +24,202 @@
 
 namespace DROPS {
 
-template <class SmootherCL, class DirectSolverCL, class ProlongationIteratorT>
+template <class SmootherCL, class DirectSolverCL, class MLMatT, class ProlongationT, class Vec>
 void
-MGM(const MLMatrixCL::const_iterator& begin, const MLMatrixCL::const_iterator& fine,
-     const ProlongationIteratorT& P, VectorCL& x, const VectorCL& b,
+MGM(const MLMatT& A, const ProlongationT& P, size_t fine, Vec& x, const Vec& b,
      const SmootherCL& Smoother, Uint smoothSteps,
-     DirectSolverCL& Solver, int numLevel, int numUnknDirect)
+     DirectSolverCL& Solver, int numLevel, int numUnknDirect,
+     const MGCycleParamCL& param)
 {
-    MLMatrixCL::const_iterator coarse= fine;
-    ProlongationIteratorT      coarseP= P;
+    MGStatisticsCL::LevelCL* stat= 0;
+    TimerCL timer;
+    if (param.stat != 0) {
+        stat= &param.stat->Level( fine);
+        stat->unknowns= x.size();
+        ++stat->visits;
+    }
 
     if(  ( numLevel==-1      ? false : numLevel==0 )
        ||( numUnknDirect==-1 ? false : x.size() <= static_cast<Uint>(numUnknDirect) )
-       || fine==begin)
+       || fine==0)
     { // use direct solver
-        Solver.Solve( *fine, x, b);
+        MGCoarseSolve( Solver, A.GetLevel( fine), x, b);
 /*        std::cout << "MGM: direct solver: iterations: " << Solver.GetIter()
                   << "\tresiduum: " << Solver.GetResid() << '\n';*/
+        if (stat != 0) {
+            timer.Stop();
+            stat->coarseTime+= timer.GetTime();
+        }
         return;
     }
-    --coarse;
-    --coarseP;
-    VectorCL d( coarse->num_cols()), e( coarse->num_cols());
+    const size_t coarse= fine - 1,
+                 fineP= CorrespondingLevel( A, P, fine);
+    Vec d( A.GetLevel( coarse).num_cols()), e( A.GetLevel( coarse).num_cols());
     // presmoothing
-    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( *fine, x, b);
+    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( A.GetLevel( fine), x, b);
+    if (stat != 0) {
+        timer.Stop();
+        stat->smoothTime+= timer.GetTime();
+        timer.Reset();
+    }
     // restriction of defect
-    d= transp_mul( *P, VectorCL( b - *fine*x));
-    // calculate coarse grid correction
-    MGM( begin, coarse, coarseP, e, d, Smoother, smoothSteps, Solver, (numLevel==-1 ? -1 : numLevel-1), numUnknDirect);
+    d= transp_mul( P.GetLevel( fineP), Vec( b - A.GetLevel( fine)*x));
+    if (stat != 0) {
+        timer.Stop();
+        stat->transferTime+= timer.GetTime();
+    }
+    // calculate coarse grid correction: one cycle for the V-cycle, two for the W- and the F-cycle
+    const Uint coarseSteps= param.CoarseSmoothSteps( smoothSteps);
+    const int  coarseLevel= numLevel==-1 ? -1 : numLevel-1;
+    MGM( A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, param);
+    if (param.cycle == MG_WCycle)
+        MGM( A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, param);
+    else if (param.cycle == MG_FCycle) {
+        MGCycleParamCL vparam( param);
+        vparam.cycle= MG_VCycle;
+        MGM( A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, vparam);
+    }
     // add coarse grid correction
-    x+= (*P) * e;
+    if (stat != 0)
+        timer.Reset();
+    x+= P.GetLevel( fineP) * e;
+    if (stat != 0) {
+        timer.Stop();
+        stat->transferTime+= timer.GetTime();
+        timer.Reset();
+    }
     // postsmoothing
-    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( *fine, x, b);
+    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( A.GetLevel( fine), x, b);
+    if (stat != 0) {
+        timer.Stop();
+        stat->smoothTime+= timer.GetTime();
+        stat->smoothSteps+= 2*smoothSteps;
+    }
 }
 
-template<class SmootherCL, class DirectSolverCL, class ProlongationT>
-void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL& smoother,
-        DirectSolverCL& solver, VectorCL& x, const VectorCL& b, int& maxiter, double& tol,
-        const bool residerr, Uint sm, int lvl)
+template <class SmootherCL, class DirectSolverCL, class MLMatT, class ProlongationT, class Vec>
+void
+FMG(const MLMatT& A, const ProlongationT& P, size_t fine, Vec& x, const Vec& b,
+     const SmootherCL& Smoother, Uint smoothSteps,
+     DirectSolverCL& Solver, int numLevel, int numUnknDirect,
+     const MGCycleParamCL& param, Uint cycles)
 {
-    MLMatrixCL::const_iterator finest= MGData.GetFinestIter();
-    typename ProlongationT::const_iterator finestProlong= Prolong.GetFinestIter();
-    double resid= -1;
-//    double old_resid;
-    VectorCL tmp;
+    typedef typename Vec::value_type T;
+    x= T( 0.);
+    if(  ( numLevel==-1      ? false : numLevel==0 )
+       ||( numUnknDirect==-1 ? false : x.size() <= static_cast<Uint>(numUnknDirect) )
+       || fine==0)
+    { // MGM uses the direct solver
+        MGM( A, P, fine, x, b, Smoother, smoothSteps, Solver, numLevel, numUnknDirect, param);
+        return;
+    }
+    const size_t fineP= CorrespondingLevel( A, P, fine);
+    // solution on the coarser level as initial guess
+    Vec bc( transp_mul( P.GetLevel( fineP), b)), xc( bc.size());
+    FMG( A, P, fine - 1, xc, bc, Smoother, param.CoarseSmoothSteps( smoothSteps), Solver,
+         (numLevel==-1 ? -1 : numLevel-1), numUnknDirect, param, cycles);
+    x= P.GetLevel( fineP) * xc;
+    for (Uint i= 0; i < cycles; ++i)
+        MGM( A, P, fine, x, b, Smoother, smoothSteps, Solver, numLevel, numUnknDirect, param);
+}
+
+template<class SmootherCL, class DirectSolverCL, class ProlongationT, typename T>
+void MG(const MLSparseMatBaseCL<T>& MGData, const ProlongationT& Prolong, const SmootherCL& smoother,
+        DirectSolverCL& solver, VectorBaseCL<T>& x, const VectorBaseCL<T>& b, int& maxiter, double& tol,
+        const bool residerr, Uint sm, int lvl, const MGCycleParamCL& param)
+{
+    const SparseMatBaseCL<T>& finest= MGData.GetFinest();
+    const size_t fine= MGData.size() - 1;
+    double resid= -1, old_resid= -1;
+    VectorBaseCL<T> tmp;
+    if (param.stat != 0)
+        param.stat->ClearResid();
     if (residerr == true) {
-        resid= norm( b - *finest * x);
+        resid= norm( b - finest * x);
         //std::cout << "initial residual: " << resid << '\n';
+        if (param.stat != 0)
+            param.stat->AddResid( resid);
     }
     else
         tmp.resize( x.size());
 
+    Uint steps= sm; // may be increased by the adaptive smoothing
     int it;
     for (it= 0; it<maxiter; ++it) {
         if (residerr == true) {
             if (resid <= tol) break;
         }
         else tmp= x;
-        MGM( MGData.begin(), finest, finestProlong, x, b, smoother, sm, solver, lvl, -1);
-        if (residerr == true) {
-//            old_resid= resid;
-            resid= norm( b - *finest * x);
-//            std::cout << "iteration: " << it  << "\tresidual: " << resid;
-//            std::cout << "\treduction: " << resid/old_resid;
-//            std::cout << '\n';
+        if (it == 0 && param.fullMG) { // full multigrid for the residual equation
+            VectorBaseCL<T> e( x.size());
+            FMG( MGData, Prolong, fine, e, VectorBaseCL<T>( b - finest * x), smoother, steps, solver, lvl, -1, param);
+            x+= e;
         }
-        else if ((resid= norm( tmp - x)) <= tol) break;
+        else
+            MGM( MGData, Prolong, fine, x, b, smoother, steps, solver, lvl, -1, param);
+        old_resid= resid;
+        resid= residerr ? norm( b - finest * x) : norm( tmp - x);
+        if (param.stat != 0)
+            param.stat->AddResid( resid);
+        if (!residerr && resid <= tol) break;
+        if (param.adaptRate > 0. && old_resid > 0. && resid > param.adaptRate*old_resid && steps < 8*sm)
+            steps*= 2;
     }
     maxiter= it;
     tol= resid;
 }
 
-template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongItT1, class ProlongItT2>
-void StokesMGM( const MLMatrixCL::const_iterator& beginA,  const MLMatrixCL::const_iterator& fineA,
-                const MLMatrixCL::const_iterator& fineB,   const MLMatrixCL::const_iterator& fineBT, 
-                const MLMatrixCL::const_iterator& fineprM, const ProlongItT1& PVel,
-                const ProlongItT2& PPr, VectorCL& u, VectorCL& p, const VectorCL& b,
+template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongT1, class ProlongT2>
+void StokesMGM( const MLMatrixCL& A, const MLMatrixCL& B, const MLMatrixCL& BT, const MLMatrixCL& prM,
+                const ProlongT1& PVel, const ProlongT2& PPr, size_t fine, VectorCL& u, VectorCL& p, const VectorCL& b,
                 const VectorCL& c, const StokesSmootherCL& Smoother, Uint smoothSteps, Uint cycleSteps,
                 StokesDirectSolverCL& Solver, int numLevel, int numUnknDirect)
 {
-    MLMatrixCL::const_iterator coarseA   = fineA;
-    MLMatrixCL::const_iterator coarseB   = fineB;
-    MLMatrixCL::const_iterator coarseBT  = fineBT;
-    MLMatrixCL::const_iterator coarseprM = fineprM;
-    ProlongItT1 coarsePVel= PVel;
-    ProlongItT2 coarsePPr = PPr;
+    const MatrixCL& fineA  = A.GetLevel( fine);
+    const MatrixCL& fineB  = B.GetLevel( CorrespondingLevel( A, B, fine));
+    const MatrixCL& fineBT = BT.GetLevel( CorrespondingLevel( A, BT, fine));
+    const MatrixCL& fineprM= prM.GetLevel( CorrespondingLevel( A, prM, fine));
 
     if(  ( numLevel==-1      ? false : numLevel==0 )
        ||( numUnknDirect==-1 ? false : u.size() <= static_cast<Uint>(numUnknDirect) )
-       || fineA==beginA)
+       || fine==0)
     {
         // use direct solver
         std::cout << "P2P1:StokesMGM: use direct solver " << std::endl;
-        Solver.Solve( *fineA, *fineB, u, p, b, c);
+        Solver.Solve( fineA, fineB, u, p, b, c);
         //std::cout << "P2P1:StokesMGM: direct solver: iter: " << Solver.GetIter() << "\tresid: " << Solver.GetResid() << std::endl;
         return;
     }
-    --coarseA;
-    --coarseB;
-    --coarseBT;
-    --coarseprM;
-    --coarsePVel;
-    --coarsePPr;
+    const size_t finePVel= CorrespondingLevel( A, PVel, fine),
+                 finePPr = CorrespondingLevel( A, PPr, fine);
 
     // presmoothing
 //    std::cout << "P2P1:StokesMGM: presmoothing " << smoothSteps << " steps " << std::endl;
     for (Uint i=0; i<smoothSteps; ++i) {
-        Smoother.Apply( *fineA, *fineB, *fineBT, *fineprM, u, p, b, c );
+        Smoother.Apply( fineA, fineB, fineBT, fineprM, u, p, b, c );
     }
     // restriction of defect
     //std::cout << "P2P1:StokesMGM: restriction of defect " << std::endl;
 
-    VectorCL du (transp_mul( *PVel, VectorCL(b - (*fineA * u + transp_mul( *fineB, p ) )) ));
-    VectorCL dp (transp_mul( *PPr,  VectorCL(c - *fineB * u )));
+    VectorCL du (transp_mul( PVel.GetLevel( finePVel), VectorCL(b - (fineA * u + transp_mul( fineB, p ) )) ));
+    VectorCL dp (transp_mul( PPr.GetLevel( finePPr),  VectorCL(c - fineB * u )));
 
     // calculate coarse grid correction
 //    std::cout << "P2P1:StokesMGM: calculate coarse grid correction    " << cycleSteps << " times " << std::endl;
     VectorCL eu ( du.size());
     VectorCL ep ( dp.size());
     for (Uint i=0; i<cycleSteps; ++i) {
-      StokesMGM( beginA, coarseA, coarseB, coarseBT, coarseprM, coarsePVel, coarsePPr, eu, ep, du, dp, Smoother,
+      StokesMGM( A, B, BT, prM, PVel, PPr, fine - 1, eu, ep, du, dp, Smoother,
                  smoothSteps, cycleSteps, Solver, (numLevel==-1 ? -1 : numLevel-1), numUnknDirect);
     }
     // add coarse grid correction
 //    std::cout << "P2P1:StokesMGM: add coarse grid correction " << std::endl;
-    u+= *PVel * eu;
-    p+= *PPr * ep;
+    u+= PVel.GetLevel( finePVel) * eu;
+    p+= PPr.GetLevel( finePPr) * ep;
     // postsmoothing
 //    std::cout << "P2P1:StokesMGM: postsmoothing " << smoothSteps << " steps " << std::endl;
     for (Uint i=0; i<smoothSteps; ++i) {
-        Smoother.Apply( *fineA, *fineB, *fineBT, *fineprM, u, p, b, c );
+        Smoother.Apply( fineA, fineB, fineBT, fineprM, u, p, b, c );
     }
 }
 
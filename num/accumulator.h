@@ -26,6 +26,7 @@
 #define DROPS_ACCUMULATOR_H
 
 #include "../geom/multigrid.h"
+#include "../misc/instrument.h"
 
 #include <vector>
 #include <functional>
@@ -41,7 +42,18 @@ namespace DROPS
 template <class VisitedT>
 class AccumulatorCL
 {
+  protected:
+    const TetraGeometryCacheCL* geom_cache_; ///< affine maps of the visited tetras; may be 0, cf. GetTrafoTr
+    size_t                      geom_pos_;   ///< position of the visited tetra in the triangulation of geom_cache_
+
   public:
+    AccumulatorCL () : geom_cache_( 0), geom_pos_( 0) {}
+
+    /// \brief Set by accumulate for the duration of the accumulation; the clones copy the pointer.
+    void set_geometry_cache (const TetraGeometryCacheCL* cache) { geom_cache_= cache; }
+    /// \brief Set by AccumulatorTupleCL before each call of visit.
+    void set_geometry_position (size_t pos) { geom_pos_= pos; }
+
     /// \brief Called to initiate a new accumulation before any call of visit.
     virtual void begin_accumulation   () {}
     /// \brief Called to finalize the accumulation after all calls of visit.
@@ -88,6 +100,13 @@ class AccumulatorTupleCL
     /// \brief Deletes the clones defined from clone_accus; obviously, accus_ is not deleted
     void delete_clones(std::vector<ContainerT>& clones);
 
+    /// \brief Calls visit of each accumulator in accus for t, which is the pos-th object of the sequence.
+    static inline void visit (ContainerT& accus, const VisitedT& t, size_t pos);
+    /// \brief As visit; adds the time of each call to times.
+    static inline void visit_timed (ContainerT& accus, const VisitedT& t, size_t pos, std::vector<double>& times);
+    /// \brief Passes the times of the accumulators as child regions of the open region to InstrumentCL.
+    void report_times (const std::vector<double>& times, Ulint calls) const;
+
   public:
     /// \brief Deletes the objects in deletion_cache_.
     ~AccumulatorTupleCL ();
@@ -97,6 +116,14 @@ class AccumulatorTupleCL
     /// \brief Registers a new accumulator.
     void push_back_acquire (AccumulatorCL<VisitedT>* p) { push_back( p); deletion_cache_.push_back( p); }
 
+    /// \brief Passes the affine maps of the tetras to all accumulators; 0 switches the cache off.
+    /// The tetras are looked up by their position in the visited sequence, hence, the cache must belong to the
+    /// triangulation, which is accumulated, cf. accumulate.
+    void set_geometry_cache (const TetraGeometryCacheCL* cache) {
+        for (size_t i= 0; i < accus_.size(); ++i)
+            accus_[i]->set_geometry_cache( cache);
+    }
+
     /// \brief Calls the accumulators for each object in [begin, end).
     template <class ExternalIteratorCL>
     void operator() (ExternalIteratorCL begin, ExternalIteratorCL end);
@@ -134,6 +161,34 @@ void AccumulatorTupleCL<VisitedT>::delete_clones(std::vector<ContainerT>& clones
             delete clones[i][j];
 }
 
+template<class VisitedT>
+inline void AccumulatorTupleCL<VisitedT>::visit (ContainerT& accus, const VisitedT& t, size_t pos)
+{
+    for (size_t i= 0; i < accus.size(); ++i) {
+        accus[i]->set_geometry_position( pos);
+        accus[i]->visit( t);
+    }
+}
+
+template<class VisitedT>
+inline void AccumulatorTupleCL<VisitedT>::visit_timed (ContainerT& accus, const VisitedT& t, size_t pos, std::vector<double>& times)
+{
+    double t0= InstrumentCL::Now(), t1;
+    for (size_t i= 0; i < accus.size(); ++i, t0= t1) {
+        accus[i]->set_geometry_position( pos);
+        accus[i]->visit( t);
+        t1= InstrumentCL::Now();
+        times[i]+= t1 - t0;
+    }
+}
+
+template<class VisitedT>
+void AccumulatorTupleCL<VisitedT>::report_times (const std::vector<double>& times, Ulint calls) const
+{
+    for (size_t i= 0; i < accus_.size(); ++i)
+        InstrumentCL::AddTime( InstrumentCL::TypeName( typeid( *accus_[i])), times[i], calls);
+}
+
 template<class VisitedT>
 AccumulatorTupleCL<VisitedT>::~AccumulatorTupleCL ()
 {
@@ -145,24 +200,40 @@ template<class VisitedT>
 template <class ExternalIteratorCL>
 void AccumulatorTupleCL<VisitedT>::operator() (ExternalIteratorCL begin, ExternalIteratorCL end)
 {
+    DROPS_REGION( "Accumulation");
     begin_iteration();
-    for ( ; begin != end; ++begin)
-        std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
+    if (InstrumentCL::IsEnabled()) {
+        std::vector<double> times( accus_.size());
+        Ulint calls= 0;
+        for ( ; begin != end; ++begin, ++calls)
+            visit_timed( accus_, *begin, calls, times);
+        report_times( times, calls);
+    }
+    else
+        for (size_t pos= 0; begin != end; ++begin, ++pos)
+            visit( accus_, *begin, pos);
     finalize_iteration();
 }
 
 template<class VisitedT>
 void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
 {
+    DROPS_REGION( "Accumulation");
     begin_iteration();
 
     std::vector<ContainerT> clones( omp_get_max_threads());
     clone_accus( clones);
+    // times of the accumulators per thread, only used if the instrumentation is enabled
+    const bool timed= InstrumentCL::IsEnabled();
+    std::vector<std::vector<double> > times( timed ? clones.size() : 0, std::vector<double>( accus_.size()));
+    Ulint calls= 0;
     for (ColorClassesCL::const_iterator cit= colors.begin(); cit != colors.end() ;++cit) {
+        calls+= cit->size();
 #       pragma omp parallel
         {
             const int t_id= omp_get_thread_num();
             const ColorClassesCL::ColorClassT& cc= *cit;
+            const ColorClassesCL::PositionClassT& pos= colors.positions( cit);
 #ifndef DROPS_WIN
             size_t j;
 #else
@@ -170,10 +241,18 @@ void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
 #endif
 #           pragma omp for schedule(dynamic)
             for (j= 0; j < cc.size(); ++j)
-                std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *cc[j]));
+                if (timed)
+                    visit_timed( clones[t_id], *cc[j], pos[j], times[t_id]);
+                else
+                    visit( clones[t_id], *cc[j], pos[j]);
         }
     }
     delete_clones(clones);
+    if (timed) {
+        for (size_t t= 1; t < times.size(); ++t)
+            std::transform( times[0].begin(), times[0].end(), times[t].begin(), times[0].begin(), std::plus<double>());
+        report_times( times[0], calls);
+    }
 
     finalize_iteration();
 }
@@ -200,10 +279,12 @@ struct do_accumulateCL<AccumulatorTupleCL<VisitedT> >
 {
     static void accumulate (AccumulatorTupleCL<VisitedT>& accu, const MultiGridCL& mg, int lvl, match_fun match, const BndCondCL& Bnd)
     {
+        accu.set_geometry_cache( mg.GetGeometryCache( lvl));
         if (omp_get_max_threads() > 1)
             accu( mg.GetColorClasses( lvl, match, Bnd));
         else
             accu( mg.GetTriangTetraBegin( lvl), mg.GetTriangTetraEnd( lvl));
+        accu.set_geometry_cache( 0); // the cache is deleted by the next modification of mg
     }
 };
 
@@ -181,6 +181,7 @@ const double Quad5DataCL::Weight[NumNodesC]= {
 };
 
 std::valarray<double> Quad5DataCL::P2_Val[10]; // P2_Val[i] contains FE_P2CL::H_i( Node).
+double Quad5DataCL::P2_Weight[10][NumNodesC];
 
 Quad5DataCL::Quad5DataCL()
 {
@@ -207,6 +208,9 @@ Quad5DataCL::Quad5DataCL()
     Node[14]= MakeBaryCoord( B3,B3,A3,A3);
 
     FE_P2CL::ApplyAll( NumNodesC, Node, P2_Val);
+    for (Uint i= 0; i < 10; ++i)
+        for (Uint j= 0; j < NumNodesC; ++j)
+            P2_Weight[i][j]= Weight[j]*P2_Val[i][j];
 }
 
 BaryCoordCL*
@@ -310,6 +314,16 @@ void P2DiscCL::GetGradientsOnRef( Quad5CL<Point3DCL> GRef[10])
         }
 }
 
+void P2DiscCL::GetGradientsOnRef( SQuad5CL<Point3DCL> GRef[10])
+{
+    for (int i=0; i<10; ++i)
+        for (int j=0; j<Quad5DataCL::NumNodesC; ++j)
+        {
+            const BaryCoordCL& Node= Quad5DataCL::Node[j];
+            GRef[i].set( j, FE_P2CL::DHRef( i, Node[1], Node[2], Node[3]));
+        }
+}
+
 void P2DiscCL::GetGradientsOnRef( Quad5_2DCL<Point3DCL> GRef[10],
     const BaryCoordCL* const p)
 {
@@ -655,6 +655,7 @@ class Quad5DataCL
     static const double          Wght[4];         ///< quadrature weights
     static const double          Weight[NumNodesC];///< quadrature weight for each node
     static std::valarray<double> P2_Val[10];      ///< P2_Val[i] contains FE_P2CL::H_i( Node).
+    static double P2_Weight[10][NumNodesC];       ///< P2_Weight[i][j]= Weight[j]*P2_Val[i][j]
 
     /// \param M contains the barycentric coordinates of a tetrahedron;
     /// \param p array to be used for the quadrature points for this tetrahedron.
@@ -725,6 +726,250 @@ DROPS_DEFINE_VALARRAY_DERIVATIVE(Quad5CL, T, base_type)
     inline T quadP2 (int i, double absdet) const;
 };
 
+/// \brief Values of a function in N points; fixed size, stored on the stack.
+///
+/// In contrast to GridFunctionCL, there is no heap allocation on construction, so the class can
+/// be used for temporaries in the per-tetra kernels of the accumulators. The scalar version is a
+/// plain array; the specialization for Point3DCL stores the components in separate arrays
+/// (structure of arrays), such that the loops over the points are vectorized by the compiler.
+template <class T, Uint N>
+class SGridFunctionCL
+{
+  public:
+    typedef T value_type;
+    enum { NumValuesC= N };
+
+  protected:
+    typedef SGridFunctionCL<T, N> self_;
+
+    T v_[N];
+
+  public:
+    SGridFunctionCL () { *this= T(); }
+    explicit SGridFunctionCL (const T& t) { *this= t; }
+
+    Uint size () const { return N; }
+
+    T&       operator[] (Uint i)       { return v_[i]; }
+    const T& operator[] (Uint i) const { return v_[i]; }
+    void set (Uint i, const T& t) { v_[i]= t; }
+
+    self_& operator=  (const T& t)      { for (Uint i= 0; i < N; ++i) v_[i]= t;        return *this; }
+    self_& operator+= (const self_& a)  { for (Uint i= 0; i < N; ++i) v_[i]+= a.v_[i]; return *this; }
+    self_& operator-= (const self_& a)  { for (Uint i= 0; i < N; ++i) v_[i]-= a.v_[i]; return *this; }
+    self_& operator*= (const self_& a)  { for (Uint i= 0; i < N; ++i) v_[i]*= a.v_[i]; return *this; }
+    self_& operator*= (double s)        { for (Uint i= 0; i < N; ++i) v_[i]*= s;       return *this; }
+    /// \brief this+= s*a
+    self_& axpy (double s, const self_& a) { for (Uint i= 0; i < N; ++i) v_[i]+= s*a.v_[i]; return *this; }
+
+    T sum () const { T s= v_[0]; for (Uint i= 1; i < N; ++i) s+= v_[i]; return s; }
+    /// \brief sum_i w[i]*(*this)[i]
+    T weighted_sum (const double* w) const { T s= w[0]*v_[0]; for (Uint i= 1; i < N; ++i) s+= w[i]*v_[i]; return s; }
+};
+
+/// \brief Vector valued function in N points; the components are stored in separate arrays.
+///
+/// operator[] returns the value in a point by value; use set() or component() for write access.
+template <Uint N>
+class SGridFunctionCL<Point3DCL, N>
+{
+  public:
+    typedef Point3DCL value_type;
+    enum { NumValuesC= N };
+
+  protected:
+    typedef SGridFunctionCL<Point3DCL, N> self_;
+
+    double x_[3][N];
+
+  public:
+    SGridFunctionCL () { *this= Point3DCL(); }
+    explicit SGridFunctionCL (const Point3DCL& p) { *this= p; }
+
+    Uint size () const { return N; }
+
+    Point3DCL operator[] (Uint i) const { return MakePoint3D( x_[0][i], x_[1][i], x_[2][i]); }
+    void set (Uint i, const Point3DCL& p) { x_[0][i]= p[0]; x_[1][i]= p[1]; x_[2][i]= p[2]; }
+    ///@{ The values of the component c in all points.
+    double*       component (Uint c)       { return x_[c]; }
+    const double* component (Uint c) const { return x_[c]; }
+    ///@}
+
+    self_& operator= (const Point3DCL& p) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]= p[c];
+        return *this;
+    }
+    self_& operator+= (const self_& a) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]+= a.x_[c][i];
+        return *this;
+    }
+    self_& operator-= (const self_& a) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]-= a.x_[c][i];
+        return *this;
+    }
+    self_& operator*= (double s) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]*= s;
+        return *this;
+    }
+    self_& operator*= (const SGridFunctionCL<double, N>& a) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]*= a[i];
+        return *this;
+    }
+    /// \brief this+= s*a
+    self_& axpy (double s, const self_& a) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]+= s*a.x_[c][i];
+        return *this;
+    }
+    /// \brief this= T*a, i.e., the matrix T is applied in every point.
+    self_& assign_mul (const SMatrixCL<3,3>& T, const self_& a) {
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                x_[c][i]= T( c, 0)*a.x_[0][i] + T( c, 1)*a.x_[1][i] + T( c, 2)*a.x_[2][i];
+        return *this;
+    }
+
+    Point3DCL sum () const {
+        Point3DCL s;
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                s[c]+= x_[c][i];
+        return s;
+    }
+    /// \brief sum_i w[i]*(*this)[i]
+    Point3DCL weighted_sum (const double* w) const {
+        Point3DCL s;
+        for (Uint c= 0; c < 3; ++c)
+            for (Uint i= 0; i < N; ++i)
+                s[c]+= w[i]*x_[c][i];
+        return s;
+    }
+};
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator+ (const SGridFunctionCL<T, N>& a, const SGridFunctionCL<T, N>& b)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret+= b;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator- (const SGridFunctionCL<T, N>& a, const SGridFunctionCL<T, N>& b)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret-= b;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator* (double s, const SGridFunctionCL<T, N>& a)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret*= s;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator* (const SGridFunctionCL<double, N>& a, const SGridFunctionCL<T, N>& b)
+{
+    SGridFunctionCL<T, N> ret( b);
+    return ret*= a;
+}
+
+template <Uint N>
+inline SGridFunctionCL<double, N>
+dot (const SGridFunctionCL<Point3DCL, N>& a, const SGridFunctionCL<Point3DCL, N>& b)
+{
+    SGridFunctionCL<double, N> ret;
+    const double *ax= a.component( 0), *ay= a.component( 1), *az= a.component( 2),
+                 *bx= b.component( 0), *by= b.component( 1), *bz= b.component( 2);
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+    return ret;
+}
+
+template <Uint N>
+inline SGridFunctionCL<double, N>
+dot (const Point3DCL& a, const SGridFunctionCL<Point3DCL, N>& b)
+{
+    SGridFunctionCL<double, N> ret;
+    const double *bx= b.component( 0), *by= b.component( 1), *bz= b.component( 2);
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= a[0]*bx[i] + a[1]*by[i] + a[2]*bz[i];
+    return ret;
+}
+
+/// \brief Stack allocated counterpart of LocalP2CL: values in the 10 degrees of freedom.
+template <class T= double>
+class SLocalP2CL: public SGridFunctionCL<T, FE_P2CL::NumDoFC>
+{
+  public:
+    typedef SGridFunctionCL<T, FE_P2CL::NumDoFC> base_type;
+    typedef typename base_type::value_type value_type;
+
+  protected:
+    typedef SLocalP2CL<T> self_;
+
+  public:
+    SLocalP2CL () {}
+    explicit SLocalP2CL (const value_type& t): base_type( t) {}
+    SLocalP2CL (const base_type& f): base_type( f) {}
+    SLocalP2CL (const LocalP2CL<T>& f) { assign( f); }
+
+    inline self_& assign (const LocalP2CL<T>&);
+    /// \brief Values of the P2-function f on the tetra s; f lives on the level of s.
+    template <class P2FunT>
+      inline self_& assign (const TetraCL& s, const P2FunT& f);
+
+    // pointwise evaluation in barycentric coordinates
+    inline value_type operator() (const BaryCoordCL&) const;
+};
+
+/// \brief Stack allocated counterpart of Quad5CL; the nodes and weights are those of Quad5DataCL.
+template <class T= double>
+class SQuad5CL: public SGridFunctionCL<T, Quad5DataCL::NumNodesC>
+{
+  public:
+    typedef SGridFunctionCL<T, Quad5DataCL::NumNodesC> base_type;
+    typedef typename base_type::value_type value_type;
+
+  protected:
+    typedef SQuad5CL<T> self_;
+
+  public:
+    SQuad5CL () {}
+    explicit SQuad5CL (const value_type& t): base_type( t) {}
+    SQuad5CL (const base_type& f): base_type( f) {}
+    SQuad5CL (const SLocalP2CL<T>& f) { assign( f); }
+
+    /// \brief Values of the P2-function with the given degrees of freedom in the nodes.
+    inline self_& assign (const SLocalP2CL<T>&);
+    inline self_& assign (const LocalP2CL<T>& f) { return assign( SLocalP2CL<T>( f)); }
+    template <class _BndData, class _VD>
+      inline self_& assign (const TetraCL& s, const P2EvalCL<T, _BndData, _VD>& f)
+    { return assign( SLocalP2CL<T>().assign( s, f)); }
+
+    // Integration:
+    // absdet wird als Parameter uebergeben, damit dieser Faktor bei der
+    // Diskretisierung nicht vergessen wird (beliebter folgenschwerer Fehler :-)
+    T quad (double absdet) const { return absdet*this->weighted_sum( Quad5DataCL::Weight); }
+    // Quadraturformel zur Annaeherung von \int f*phi, phi = P2-Hutfunktion
+    T quadP2 (int i, double absdet) const { return absdet*this->weighted_sum( Quad5DataCL::P2_Weight[i]); }
+};
+
 /// \brief Contains the nodes and weights of a positive quadrature rule on the reference triangle. It uses 7 nodes an is exact up to degree 5.
 ///
 /// The data is initialized exactly once on program-startup by the global object in num/discretize.cpp.
@@ -966,6 +1211,8 @@ class P1DiscCL
     // the gradient of hat function i is in column i of H
     static inline void   GetGradients( SMatrixCL<3,4>& H, double& det, const TetraCL& t);
     static inline void   GetGradients( Point3DCL H[4],    double& det, const TetraCL& t);
+    // as above; the affine map is taken from cache, if t is its pos-th tetra
+    static inline void   GetGradients( Point3DCL H[4],    double& det, const TetraCL& t, const TetraGeometryCacheCL* cache, size_t pos);
     static inline void   GetGradients( SMatrixCL<3,4>& H, double& det, const Point3DCL pt[4]);
     static inline void   GetGradients( Point3DCL H[4], const SMatrixCL<3,3>& T);
     static void GetP1Basis( Quad5_2DCL<> p1[4], const BaryCoordCL* const p);
@@ -1006,6 +1253,7 @@ class P2DiscCL
     static void GetGradientsOnRef( LocalP1CL<Point3DCL> GRef[10]);
     static void GetGradientsOnRef( Quad2CL<Point3DCL> GRef[10]);
     static void GetGradientsOnRef( Quad5CL<Point3DCL> GRef[10]);
+    static void GetGradientsOnRef( SQuad5CL<Point3DCL> GRef[10]);
     // The 2nd arg points to 3 vertices of the triangle
     static void GetGradientsOnRef( Quad5_2DCL<Point3DCL> GRef[10], const BaryCoordCL* const);
     // p2[i] contains a Quad5_2DCL-object that is initialized with FE_P2CL::Hi
@@ -1017,6 +1265,8 @@ class P2DiscCL
     { for (int i=0; i<10; ++i) for (int j=0; j<5; ++j) G[i][j]= T*GRef[i][j]; }
     static void GetGradients( Quad5CL<Point3DCL> G[10], Quad5CL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
     { for (int i=0; i<10; ++i) for (int j=0; j<Quad5DataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
+    static void GetGradients( SQuad5CL<Point3DCL> G[10], const SQuad5CL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
+    { for (int i=0; i<10; ++i) G[i].assign_mul( T, GRef[i]); }
     static void GetGradients( Quad5_2DCL<Point3DCL> G[10], Quad5_2DCL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
     { for (int i=0; i<10; ++i) for (int j=0; j<Quad5_2DDataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
     static void GetGradient( Quad2CL<Point3DCL> &G, Quad2CL<Point3DCL> &GRef, const SMatrixCL<3,3> &T)
@@ -1361,6 +1611,18 @@ inline void P1DiscCL::GetGradients( Point3DCL H[4], double& det, const TetraCL&
     H[0]= -H[1]-H[2]-H[3];
 }
 
+inline void P1DiscCL::GetGradients( Point3DCL H[4], double& det, const TetraCL& t, const TetraGeometryCacheCL* cache, size_t pos)
+{
+    SMatrixCL<3,3> T;
+    if (cache == 0 || !cache->GetTrafoTr( T, det, t, pos)) {
+        GetGradients( H, det, t);
+        return;
+    }
+    for (Uint i= 0; i < 3; ++i)
+        H[i+1]= MakePoint3D( T(0,i), T(1,i), T(2,i));
+    H[0]= -H[1]-H[2]-H[3];
+}
+
 inline void P1DiscCL::GetGradients( Point3DCL H[4], const SMatrixCL<3,3>& T)
 {
     for(Uint i=0; i<4; ++i)
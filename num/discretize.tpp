@@ -667,6 +667,65 @@ template<class T>
 }
 
 
+template<class T>
+  inline SLocalP2CL<T>&
+  SLocalP2CL<T>::assign(const LocalP2CL<T>& f)
+{
+    for (Uint i= 0; i < 10; ++i)
+        this->set( i, f[i]);
+    return *this;
+}
+
+template<class T>
+  template<class P2FunT>
+    inline SLocalP2CL<T>&
+    SLocalP2CL<T>::assign(const TetraCL& s, const P2FunT& f)
+{
+    if (s.GetLevel() != f.GetLevel())
+        return assign( LocalP2CL<T>( s, f));
+    value_type dof[10];
+    f.GetDoF( s, dof);
+    for (Uint i= 0; i < 10; ++i)
+        this->set( i, dof[i]);
+    return *this;
+}
+
+template<class T>
+  inline typename SLocalP2CL<T>::value_type
+  SLocalP2CL<T>::operator() (const BaryCoordCL& p) const
+{
+    return FE_P2CL::val( *this, p);
+}
+
+/// The values in the nodes are the linear combinations of the columns of Quad5DataCL::P2_Val.
+template<class T>
+  inline SQuad5CL<T>&
+  SQuad5CL<T>::assign(const SLocalP2CL<T>& f)
+{
+    for (Uint i= 0; i < Quad5DataCL::NumNodesC; ++i)
+        (*this)[i]= f[0]*Quad5DataCL::P2_Val[0][i];
+    for (Uint j= 1; j < 10; ++j)
+        for (Uint i= 0; i < Quad5DataCL::NumNodesC; ++i)
+            (*this)[i]+= f[j]*Quad5DataCL::P2_Val[j][i];
+    return *this;
+}
+
+template<>
+  inline SQuad5CL<Point3DCL>&
+  SQuad5CL<Point3DCL>::assign(const SLocalP2CL<Point3DCL>& f)
+{
+    for (Uint c= 0; c < 3; ++c) {
+        const double* fc= f.component( c);
+        double* qc= this->component( c);
+        for (Uint i= 0; i < Quad5DataCL::NumNodesC; ++i)
+            qc[i]= fc[0]*Quad5DataCL::P2_Val[0][i];
+        for (Uint j= 1; j < 10; ++j)
+            for (Uint i= 0; i < Quad5DataCL::NumNodesC; ++i)
+                qc[i]+= fc[j]*Quad5DataCL::P2_Val[j][i];
+    }
+    return *this;
+}
+
 template <class RAIterT>
   void
   Quad5_2DDataCL::SetInterface (const BaryCoordCL*const p, RAIterT NodeInTetra)
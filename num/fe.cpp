@@ -371,4 +371,218 @@ void SetupP2ProlongationMatrix(const MultiGridCL& mg, MLMatrixCL& P, MLIdxDescCL
         SetupP2ProlongationMatrix( mg, *itProlong, *itcIdx, *itfIdx);
 }
 
+//**************************************************************************
+// Prolongation set up on demand                                           *
+//**************************************************************************
+
+/// \brief Index of the unknown idx on a simplex with the unknowns unk; NoIdx, if there is none.
+inline IdxT GetUnknownIdx (const UnknownHandleCL& unk, Uint idx)
+{
+    return unk.Exist() && unk.Exist( idx) ? unk( idx) : NoIdx;
+}
+
+/// \brief As CollectChildUnknownsP2, but without std::map: the fine unknowns on the vertices and edges
+///     of the children of t, sorted by their numbers in the refinement rule.
+void CollectChildUnknownsP2 (const TetraCL& t, const Uint f_idx, IdxT fUnknowns[NumAllVertsC + MaxEdgesC])
+{
+    const RefRuleCL& rule= t.GetRefData();
+    IdxT vert[NumAllVertsC], edge[NumAllEdgesC];
+    bool hasVert[NumAllVertsC]= { false }, hasEdge[NumAllEdgesC]= { false };
+    for (Uint j= 0; j < rule.ChildNum; ++j) {
+        const ChildDataCL& child= GetChildData( rule.Children[j]);
+        const TetraCL* const childp= t.GetChild( j);
+        for (Uint k= 0; k < 4; ++k) {
+            vert[child.Vertices[k]]= GetUnknownIdx( childp->GetVertex( k)->Unknowns, f_idx);
+            hasVert[child.Vertices[k]]= true;
+        }
+        for (Uint k= 0; k < 6; ++k) {
+            edge[child.Edges[k]]= GetUnknownIdx( childp->GetEdge( k)->Unknowns, f_idx);
+            hasEdge[child.Edges[k]]= true;
+        }
+    }
+    Uint n= 0;
+    for (Uint i= 0; i < NumAllVertsC; ++i)
+        if (hasVert[i])
+            fUnknowns[n++]= vert[i];
+    for (Uint i= 0; i < NumAllEdgesC; ++i)
+        if (hasEdge[i])
+            fUnknowns[n++]= edge[i];
+}
+
+void ProlongationCL::Init (const MultiGridCL& mg, IdxDescCL& cIdx, IdxDescCL& fIdx, ModeT mode)
+{
+    const FiniteElementT fe= cIdx.GetFE();
+    if (fe != P1_FE && fe != P2_FE && fe != vecP2_FE)
+        throw DROPSErrCL( "ProlongationCL::Init: FE type not supported, yet");
+    if (&mg != mg_ || &cIdx != cIdx_ || &fIdx != fIdx_) {
+        mg_= &mg;
+        cIdx_= &cIdx;
+        fIdx_= &fIdx;
+        built_= false;
+        P_.clear();
+    }
+    SetMode( mode);
+}
+
+void ProlongationCL::SetMode (ModeT mode)
+{
+    mode_= mode;
+    if (mode_ == MatrixFreeC) {
+        built_= false;
+        P_.clear();
+    }
+}
+
+const MatrixCL& ProlongationCL::GetMatrix () const
+{
+    if (mode_ != AssembledC)
+        throw DROPSErrCL( "ProlongationCL::GetMatrix: there is no matrix in the mode MatrixFreeC");
+    if (!IsUpToDate()) {
+        if (IsP1())
+            SetupP1ProlongationMatrix( *mg_, P_, *cIdx_, *fIdx_);
+        else
+            SetupP2ProlongationMatrix( *mg_, P_, *cIdx_, *fIdx_);
+        built_= true;
+        mgVersion_= mg_->GetVersion();
+        cVersion_= cIdx_->GetVersion();
+        fVersion_= fIdx_->GetVersion();
+        ++numBuilds_;
+    }
+    return P_;
+}
+
+void ProlongationCL::Apply (VectorCL& y, const VectorCL& x) const
+{
+    if (mode_ == AssembledC)
+        y= GetMatrix()*x;
+    else if (IsP1())
+        ApplyP1MatrixFree( y, x, false);
+    else
+        ApplyP2MatrixFree( y, x, false);
+}
+
+void ProlongationCL::ApplyTransp (VectorCL& y, const VectorCL& x) const
+{
+    if (mode_ == AssembledC)
+        y= transp_mul( GetMatrix(), x);
+    else if (IsP1())
+        ApplyP1MatrixFree( y, x, true);
+    else
+        ApplyP2MatrixFree( y, x, true);
+}
+
+/// Each fine unknown, that is not on the coarse triangulation, is the midvertex of exactly one refined edge;
+/// hence, every entry of the matrix is visited once.
+void ProlongationCL::ApplyP1MatrixFree (VectorCL& y, const VectorCL& x, bool transp) const
+{
+    const Uint c_level= cIdx_->TriangLevel();
+    const Uint c_idx= cIdx_->GetIdx();
+    const Uint f_idx= fIdx_->GetIdx();
+    y.resize( transp ? num_cols() : num_rows());
+    y= 0.;
+
+    for (MultiGridCL::const_EdgeIterator sit= mg_->GetAllEdgeBegin( c_level),
+         theend= mg_->GetAllEdgeEnd( c_level); sit != theend; ++sit)
+        if (sit->IsRefined() && sit->GetMidVertex()->Unknowns.Exist()
+            && !sit->GetMidVertex()->Unknowns.Exist( c_idx)) {
+            const IdxT i= sit->GetMidVertex()->Unknowns( f_idx);
+            for (Uint v= 0; v < 2; ++v)
+                if (sit->GetVertex( v)->Unknowns.Exist()) {
+                    const IdxT j= sit->GetVertex( v)->Unknowns( c_idx);
+                    if (transp)
+                        y[j]+= 0.5*x[i];
+                    else
+                        y[i]+= 0.5*x[j];
+                }
+        }
+    for (MultiGridCL::const_TriangVertexIteratorCL sit= mg_->GetTriangVertexBegin( c_level),
+         theend= mg_->GetTriangVertexEnd( c_level); sit != theend; ++sit)
+        if (sit->Unknowns.Exist() && sit->Unknowns.Exist( c_idx)) {
+            if (transp)
+                y[sit->Unknowns( c_idx)]+= x[sit->Unknowns( f_idx)];
+            else
+                y[sit->Unknowns( f_idx)]= x[sit->Unknowns( c_idx)];
+        }
+}
+
+/// A fine unknown can be on several coarse tetras; its row in the local prolongations of all these tetras is the
+/// same, as the value of a P2-function on a face or an edge depends only on the unknowns on the face or edge.
+/// Hence, the rows are assigned for y= P x; for y= P^T x, each row is applied once, which is recorded in done.
+void ProlongationCL::ApplyP2MatrixFree (VectorCL& y, const VectorCL& x, bool transp) const
+{
+    const Uint c_level= cIdx_->TriangLevel();
+    const Uint f_level= fIdx_->TriangLevel();
+    const Uint c_idx= cIdx_->GetIdx();
+    const Uint f_idx= fIdx_->GetIdx();
+    const Uint ndofs= fIdx_->NumUnknownsVertex();
+    y.resize( transp ? num_cols() : num_rows());
+    y= 0.;
+    std::vector<bool> done( transp ? num_rows() : 0);
+
+    IdxT cUnknowns[10], fUnknowns[NumAllVertsC + MaxEdgesC];
+    for (MultiGridCL::const_TriangTetraIteratorCL sit= mg_->GetTriangTetraBegin( c_level),
+         theend= mg_->GetTriangTetraEnd( c_level); sit != theend; ++sit) {
+        for (Uint i= 0; i < 4; ++i)
+            cUnknowns[i]= GetUnknownIdx( sit->GetVertex( i)->Unknowns, c_idx);
+        for (Uint i= 0; i < 6; ++i)
+            cUnknowns[i+4]= GetUnknownIdx( sit->GetEdge( i)->Unknowns, c_idx);
+
+        if (sit->IsInTriang( f_level)) { // coarse and fine tetra are identical; the prolongation is trivial.
+            for (Uint i= 0; i < 10; ++i) {
+                const IdxT c= cUnknowns[i],
+                           f= GetUnknownIdx( i < 4 ? sit->GetVertex( i)->Unknowns : sit->GetEdge( i - 4)->Unknowns, f_idx);
+                if (c == NoIdx || f == NoIdx || (transp && done[f]))
+                    continue;
+                for (Uint k= 0; k < ndofs; ++k)
+                    if (transp)
+                        y[c+k]+= x[f+k];
+                    else
+                        y[f+k]= x[c+k];
+                if (transp)
+                    done[f]= true;
+            }
+            continue;
+        }
+
+        CollectChildUnknownsP2( *sit, f_idx, fUnknowns);
+        // As in SetupP2ProlongationMatrix, & 63 cuts off the bit that distinguishes the green rule for
+        // regular refinement and the regular rule.
+        const Uint rule= sit->GetRefRule() & 63;
+        for (Uint i= P2_local_prolongation_mat_beg[rule]; i != P2_local_prolongation_mat_beg[rule+1]; ++i) {
+            const IdxT f= fUnknowns[i - P2_local_prolongation_mat_beg[rule]];
+            if (f == NoIdx || (transp && done[f]))
+                continue;
+            const Uint row= P2_local_prolongation_rows[i];
+            for (Uint k= 0; k < ndofs; ++k) {
+                double sum= 0.;
+                for (Uint j= P2_prolongation_row_beg[row]; j != P2_prolongation_row_beg[row+1]; ++j) {
+                    const IdxT c= cUnknowns[P2_prolongation_col_ind[j]];
+                    if (c == NoIdx)
+                        continue;
+                    const double coeff= P2_prolongation_coeff[P2_prolongation_coeff_idx[j]];
+                    if (transp)
+                        y[c+k]+= coeff*x[f+k];
+                    else
+                        sum+= coeff*x[c+k];
+                }
+                if (!transp)
+                    y[f+k]= sum;
+            }
+            if (transp)
+                done[f]= true;
+        }
+    }
+}
+
+void MLProlongationCL::Sync () const
+{
+    if (ColIdx_ == 0)
+        throw DROPSErrCL( "MLProlongationCL: Init has not been called");
+    P_.resize( ColIdx_->size());
+    if (P_.size() < 2)
+        return;
+    for (size_t lvl= 1; lvl < P_.size(); ++lvl)
+        P_.GetLevel( lvl).Init( *mg_, ColIdx_->GetLevel( lvl - 1), RowIdx_->GetLevel( lvl), mode_);
+}
+
 } // end of namespace DROPS
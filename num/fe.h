@@ -1188,7 +1188,162 @@ void SetupP2ProlongationMatrix(const MultiGridCL& mg, MLMatrixCL& P,
                                MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx);
 
 
+/// \brief Prolongation from the triangulation of cIdx to the triangulation of fIdx for P1, P2 and vecP2 FE, set up on demand.
+///
+/// The operator is the one of SetupP1ProlongationMatrix and SetupP2ProlongationMatrix.
+/// In the mode AssembledC, the matrix is set up by the first application and kept until the version of the
+/// multigrid or of one of the numberings changes.
+/// In the mode MatrixFreeC, no matrix is stored: each application visits the edges (P1) or the tetras (P2) of
+/// the coarse triangulation and applies the local prolongation of the refinement rule (RefRuleCL) of each tetra.
+/// This saves the memory and the setup after each adaptive step at the expense of slower applications.
+class ProlongationCL
+{
+  public:
+    enum ModeT { AssembledC, MatrixFreeC };
+
+  private:
+    const MultiGridCL* mg_;
+    IdxDescCL*         cIdx_;        ///< numbering on the coarse triangulation
+    IdxDescCL*         fIdx_;        ///< numbering on the fine triangulation
+    ModeT              mode_;
+    mutable MatrixCL   P_;           ///< the matrix in the mode AssembledC
+    mutable bool       built_;       ///< true, if P_ was set up for the versions below
+    mutable size_t     mgVersion_,   ///< version of the multigrid for P_
+                       cVersion_,    ///< version of the coarse numbering for P_
+                       fVersion_;    ///< version of the fine numbering for P_
+    mutable size_t     numBuilds_;   ///< number of setups of P_
+
+    bool IsP1 () const { return cIdx_->GetFE() == P1_FE; }
+    /// \brief y= P x or, if transp, y= P^T x without a matrix.
+    void ApplyP1MatrixFree (VectorCL& y, const VectorCL& x, bool transp) const;
+    void ApplyP2MatrixFree (VectorCL& y, const VectorCL& x, bool transp) const;
+
+  public:
+    ProlongationCL ()
+        : mg_( 0), cIdx_( 0), fIdx_( 0), mode_( AssembledC), built_( false),
+          mgVersion_( 0), cVersion_( 0), fVersion_( 0), numBuilds_( 0) {}
+
+    /// \brief Stores the arguments; nothing is set up. The matrix is kept, if the arguments are unchanged.
+    void Init (const MultiGridCL& mg, IdxDescCL& cIdx, IdxDescCL& fIdx, ModeT mode= AssembledC);
+    bool IsInitialized () const { return mg_ != 0; }
+
+    /// \brief Switching to MatrixFreeC releases the matrix.
+    void  SetMode (ModeT mode);
+    ModeT GetMode () const { return mode_; }
+
+    /// \brief True, if the matrix is set up for the current multigrid and numberings.
+    bool IsUpToDate () const {
+        return built_ && mgVersion_ == mg_->GetVersion() && cVersion_ == cIdx_->GetVersion() && fVersion_ == fIdx_->GetVersion();
+    }
+    /// \brief The matrix, which is set up if necessary; only in the mode AssembledC.
+    const MatrixCL& GetMatrix () const;
+    /// \brief Number of setups of the matrix.
+    size_t GetNumBuilds () const { return numBuilds_; }
+
+    size_t num_rows () const { return fIdx_->NumUnknowns(); }
+    size_t num_cols () const { return cIdx_->NumUnknowns(); }
+
+    /// \brief y= P x
+    void Apply      (VectorCL& y, const VectorCL& x) const;
+    /// \brief y= P^T x, the restriction
+    void ApplyTransp (VectorCL& y, const VectorCL& x) const;
+};
+
+inline VectorCL operator* (const ProlongationCL& P, const VectorCL& x)
+{
+    VectorCL y( P.num_rows());
+    P.Apply( y, x);
+    return y;
+}
+
+inline VectorCL transp_mul (const ProlongationCL& P, const VectorCL& x)
+{
+    VectorCL y( P.num_cols());
+    P.ApplyTransp( y, x);
+    return y;
+}
+
+/// \brief Prolongations of a multilevel numbering for MGSolverCL, as SetupP1ProlongationMatrix and SetupP2ProlongationMatrix
+///     for MLMatrixCL, but set up on demand.
+///
+/// Level l > 0 prolongates from level l-1 of ColIdx to level l of RowIdx; level 0 is not used. The levels are
+/// (re-)initialized, whenever they are accessed and the numberings have been resized, such that no observer for
+/// the refinement is needed: the matrices are set up by the first application after a change of the versions.
+class MLProlongationCL
+{
+  public:
+    typedef MLDataCL<ProlongationCL>::const_iterator const_iterator;
+
+  private:
+    const MultiGridCL*               mg_;
+    MLIdxDescCL*                     ColIdx_;
+    MLIdxDescCL*                     RowIdx_;
+    ProlongationCL::ModeT            mode_;
+    mutable MLDataCL<ProlongationCL> P_;
+
+    void Sync () const;
+
+  public:
+    MLProlongationCL (ProlongationCL::ModeT mode= ProlongationCL::AssembledC)
+        : mg_( 0), ColIdx_( 0), RowIdx_( 0), mode_( mode) {}
+
+    /// \brief Stores the arguments; nothing is set up.
+    void Init (const MultiGridCL& mg, MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx) {
+        mg_= &mg;
+        ColIdx_= ColIdx;
+        RowIdx_= RowIdx;
+    }
+    void SetMode (ProlongationCL::ModeT mode) {
+        mode_= mode;
+        for (MLDataCL<ProlongationCL>::iterator it= P_.begin(); it != P_.end(); ++it)
+            it->SetMode( mode);
+    }
+    ProlongationCL::ModeT GetMode () const { return mode_; }
+
+    size_t         size          () const { Sync(); return P_.size(); }
+    const_iterator begin         () const { Sync(); return P_.begin(); }
+    const_iterator end           () const { Sync(); return P_.end(); }
+    const_iterator GetFinestIter () const { Sync(); return P_.GetFinestIter(); }
+    const ProlongationCL& GetFinest () const { Sync(); return P_.GetFinest(); }
+    const ProlongationCL& GetLevel  (size_t i) const { Sync(); return P_.GetLevel( i); }
+};
+
+/// \brief MGSolverCL::SetSinglePrecision is not supported for MLProlongationCL; throws DROPSErrCL.
+inline const MLFloatMatrixCL& GetFloatProlongation (FloatMatrixCacheCL&, const MLProlongationCL&)
+{
+    throw DROPSErrCL( "GetFloatProlongation: single precision multigrid needs the prolongation as MLMatrixCL");
+}
+
+/// \brief Sets the mode of the prolongation of a multigrid solver; an MLMatrixCL is always assembled, hence,
+///     MatrixFreeC throws DROPSErrCL.
+inline void SetProlongationMode (MLMatrixCL&, ProlongationCL::ModeT mode)
+{
+    if (mode != ProlongationCL::AssembledC)
+        throw DROPSErrCL( "SetProlongationMode: the matrix-free prolongation needs MLProlongationCL");
+}
+
+inline void SetProlongationMode (MLProlongationCL& P, ProlongationCL::ModeT mode)
+{
+    P.SetMode( mode);
+}
+
+/// \brief Counterparts of SetupP1ProlongationMatrix and SetupP2ProlongationMatrix for MLProlongationCL: the levels are
+///     set up on demand, such that only the multigrid and the numberings are stored.
+inline void SetupP1ProlongationMatrix (const MultiGridCL& mg, MLProlongationCL& P, MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx)
+{
+    P.Init( mg, ColIdx, RowIdx);
+}
+
+inline void SetupP2ProlongationMatrix (const MultiGridCL& mg, MLProlongationCL& P, MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx)
+{
+    P.Init( mg, ColIdx, RowIdx);
+}
+
+
 /// \brief Observes the MultiGridCL-changes by AdapTriangCL to repair the prolongation for velocity.
+///
+/// An MLMatrixCL is set up again after each refinement sequence. An MLProlongationCL is only initialized: it
+/// follows the versions of the multigrid and of the numberings by itself.
 class UpdateProlongationCL : public MGObserverCL
 {
   private:
@@ -1199,6 +1354,8 @@ class UpdateProlongationCL : public MGObserverCL
   public:
     UpdateProlongationCL( const MultiGridCL& MG, MLMatrixCL* P, MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx)
         : MG_( MG), P_( P), ColIdx_( ColIdx), RowIdx_( RowIdx) { post_refine_sequence (); }
+    UpdateProlongationCL( const MultiGridCL& MG, MLProlongationCL* P, MLIdxDescCL* ColIdx, MLIdxDescCL* RowIdx)
+        : MG_( MG), P_( 0), ColIdx_( ColIdx), RowIdx_( RowIdx) { if (P != 0) P->Init( MG, ColIdx, RowIdx); }
 
     void pre_refine  () {}
     void post_refine () {}
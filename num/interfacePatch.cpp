@@ -617,7 +617,101 @@ LocalP2CL<double> ProjectIsoP2ChildToParentP1 (LocalP2CL<double> lpin, Uint chil
 
 
 
+//*****************************************************************************
+//                               InterfaceBandCL
+//*****************************************************************************
+
+InterfaceBandCL& InterfaceBandCL::operator= (const InterfaceBandCL& b)
+{
+    if (&b == this)
+        return *this;
+    rings_=     b.rings_;
+    mgVersion_= b.mgVersion_;
+    idx_=       b.idx_;
+    phi_.resize( b.phi_.size());
+    phi_=       b.phi_;
+    tetras_=    b.tetras_;
+    numCut_=    b.numCut_;
+    version_=   b.version_;
+    delete colors_;
+    colors_= 0;
+    return *this;
+}
+
+bool InterfaceBandCL::Update (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsbnd)
+{
+    if (idx_ == ls.RowIdx && mgVersion_ == mg.GetVersion() && phi_.size() == ls.Data.size()
+        && std::equal( Addr( ls.Data), Addr( ls.Data) + ls.Data.size(), Addr( phi_)))
+        return false;
+
+    Build( mg, ls, lsbnd);
+    idx_= ls.RowIdx;
+    mgVersion_= mg.GetVersion();
+    phi_.resize( ls.Data.size());
+    phi_= ls.Data;
+    ++version_;
+    delete colors_;
+    colors_= 0;
+    return true;
+}
+
+/// The cut tetras get the mark 1, the tetras of the i-th layer around them the mark i+1.
+void InterfaceBandCL::Build (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsbnd)
+{
+    const Uint lvl= ls.GetLevel();
+    const const_iterator begin= mg.GetTriangTetraBegin( lvl);
+    const int n= std::distance( begin, mg.GetTriangTetraEnd( lvl));
+    std::vector<Uint> mark( n, 0);
+
+#   pragma omp parallel
+    {
+        LocalP2CL<> loc_phi;
+        double fmin, fmax;
+#       pragma omp for schedule(static)
+        for (int i= 0; i < n; ++i) {
+            loc_phi.assign( begin[i], ls, lsbnd);
+            GetBernsteinBounds( loc_phi, fmin, fmax);
+            if (InterfacePatchCL::Sign( fmin) != 1 && InterfacePatchCL::Sign( fmax) != -1)
+                mark[i]= 1;
+        }
+    }
+
+    std::vector<const VertexCL*> verts;
+    for (Uint r= 1; r <= rings_; ++r) {
+        verts.clear();
+        for (int i= 0; i < n; ++i)
+            if (mark[i] == r)
+                for (Uint j= 0; j < 4; ++j)
+                    verts.push_back( begin[i].GetVertex( j));
+        std::sort( verts.begin(), verts.end());
+        verts.erase( std::unique( verts.begin(), verts.end()), verts.end());
+#       pragma omp parallel for schedule(static)
+        for (int i= 0; i < n; ++i)
+            if (mark[i] == 0)
+                for (Uint j= 0; j < 4; ++j)
+                    if (std::binary_search( verts.begin(), verts.end(), begin[i].GetVertex( j))) {
+                        mark[i]= r + 1;
+                        break;
+                    }
+    }
+
+    tetras_.clear();
+    numCut_= 0;
+    for (int i= 0; i < n; ++i)
+        if (mark[i] != 0) {
+            tetras_.push_back( &begin[i]);
+            if (mark[i] == 1)
+                ++numCut_;
+        }
+    tetras_.push_back( 0);
+}
 
+const ColorClassesCL& InterfaceBandCL::GetColorClasses (match_fun match, const BndCondCL& Bnd) const
+{
+    if (colors_ == 0)
+        colors_= new ColorClassesCL( begin(), end(), match, Bnd);
+    return *colors_;
+}
 
 } // end of namespace DROPS
 
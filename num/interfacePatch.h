@@ -26,6 +26,7 @@
 #define DROPS_INTERFACEPATCH_H
 
 #include "num/discretize.h"
+#include "num/accumulator.h"
 
 namespace DROPS
 {
@@ -171,6 +172,89 @@ class InterfaceTriangleCL : public InterfacePatchCL
 
 LocalP2CL<double> ProjectIsoP2ChildToParentP1 (LocalP2CL<double> lpin, Uint child);
 
+/// \brief Lower and upper bound of a P2-function on a tetra: the extremal coefficients in the Bernstein basis.
+/// All values of the function on the tetra, in particular on any principal lattice, lie between the bounds.
+inline void GetBernsteinBounds (const LocalP2CL<>& f, double& fmin, double& fmax)
+{
+    fmin= fmax= f[0];
+    for (Uint i= 1; i < 4; ++i) {
+        fmin= std::min( fmin, f[i]);
+        fmax= std::max( fmax, f[i]);
+    }
+    for (Uint e= 0; e < 6; ++e) {
+        const double b= 2.*f[4+e] - 0.5*(f[VertOfEdge( e, 0)] + f[VertOfEdge( e, 1)]);
+        fmin= std::min( fmin, b);
+        fmax= std::max( fmax, b);
+    }
+}
+
+/// \brief The tetras of a triangulation, which are cut by the zero level of a P2 level set function, and a band of neighbors.
+/** A tetra is cut, if the level set function can vanish on it according to GetBernsteinBounds; this includes
+    all tetras, for which InterfacePatchCL finds a patch on a child, and all tetras cut on any principal lattice.
+    The band consists of rings() layers of tetras around the cut tetras; each layer shares a vertex with the
+    previous one. The tetras are in the order of the triangulation.
+
+    Update() rebuilds the set only, if the version of the multigrid, the numbering or the values of the level
+    set function (a copy is kept for comparison) have changed. The coloring for the OpenMP-parallel accumulation
+    is computed on demand for the tetras of the set only. */
+class InterfaceBandCL
+{
+  public:
+    typedef MultiGridCL::const_TriangTetraIteratorCL const_iterator;
+
+  private:
+    Uint                        rings_;     ///< number of layers around the cut tetras
+    size_t                      mgVersion_; ///< version of the multigrid for the current set
+    const IdxDescCL*            idx_;       ///< numbering of the level set function for the current set
+    VectorCL                    phi_;       ///< values of the level set function for the current set
+    std::vector<const TetraCL*> tetras_;    ///< cut tetras and band; as in TriangCL, the last entry is 0
+    size_t                      numCut_;    ///< number of cut tetras
+    size_t                      version_;   ///< incremented by each rebuild
+    mutable ColorClassesCL*     colors_;    ///< coloring of tetras_
+
+    void Build (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsbnd);
+
+  public:
+    InterfaceBandCL (Uint rings= 0)
+        : rings_( rings), mgVersion_( 0), idx_( 0), tetras_( 1, static_cast<const TetraCL*>( 0)), numCut_( 0), version_( 0), colors_( 0) {}
+    InterfaceBandCL (const InterfaceBandCL& b)
+        : rings_( b.rings_), mgVersion_( b.mgVersion_), idx_( b.idx_), phi_( b.phi_), tetras_( b.tetras_),
+          numCut_( b.numCut_), version_( b.version_), colors_( 0) {}
+    InterfaceBandCL& operator= (const InterfaceBandCL& b);
+    ~InterfaceBandCL () { delete colors_; }
+
+    /// \brief Rebuild the set for the level set function ls, if necessary; returns true, if the set was rebuilt.
+    bool Update (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsbnd);
+    /// \brief Set the number of layers around the cut tetras; the set is rebuilt by the next Update().
+    void SetRings (Uint rings) { if (rings != rings_) { rings_= rings; idx_= 0; } }
+    Uint rings () const { return rings_; }
+
+    const_iterator begin () const { return const_iterator( const_cast<const TetraCL**>( &tetras_[0])); }
+    const_iterator end   () const { return const_iterator( const_cast<const TetraCL**>( &tetras_.back())); }
+    size_t size        () const { return tetras_.size() - 1; } ///< number of tetras of the set
+    size_t GetNumCut   () const { return numCut_; }            ///< number of cut tetras
+    size_t GetVersion  () const { return version_; }           ///< number of rebuilds of the set
+
+    /// \brief Coloring of the tetras of the set for the OpenMP-parallel accumulation.
+    const ColorClassesCL& GetColorClasses (match_fun match, const BndCondCL& Bnd) const;
+};
+
+/// \brief Loop over the tetras of the InterfaceBandCL band; if band == 0, over all tetras of the triangulation level lvl of mg.
+#define DROPS_FOR_BAND_CONST_TETRA( band, mg, lvl, it) \
+for (DROPS::InterfaceBandCL::const_iterator it( (band) != 0 ? (band)->begin() : static_cast<const DROPS::MultiGridCL&>( mg).GetTriangTetraBegin( lvl)), \
+     end__( (band) != 0 ? (band)->end() : static_cast<const DROPS::MultiGridCL&>( mg).GetTriangTetraEnd( lvl)); it != end__; ++it)
+
+/// \brief Perform the accumulation only for the tetras of band in an OpenMP-aware manner.
+/// OpenMP is only used if omp_get_max_threads() > 1; cf. accumulate for a whole triangulation.
+inline void
+accumulate (TetraAccumulatorTupleCL& accus, const InterfaceBandCL& band, match_fun match, const BndCondCL& Bnd)
+{
+    if (omp_get_max_threads() > 1)
+        accus( band.GetColorClasses( match, Bnd));
+    else
+        accus( band.begin(), band.end());
+}
+
 
 } // end of namespace DROPS
 
@@ -0,0 +1,112 @@
+/// \file parMGsolver.cpp
+/// \brief parallel geometric multigrid with agglomeration of the coarse levels
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#ifdef _PAR
+
+#include "num/parMGsolver.h"
+#include <numeric>
+
+namespace DROPS
+{
+
+/** The exclusive unknowns of each process are numbered consecutively; the numbers
+    of the distributed unknowns are obtained by accumulation. The root process receives
+    the global numbers of all local unknowns of all processes once, such that the
+    vectors can be gathered and scattered without further index information.*/
+void CoarseAgglomerationCL::Init (const IdxDescCL& idx)
+{
+    ex_= &idx.GetEx();
+    const size_t n= idx.NumUnknowns();
+
+    global_.resize( n);
+    global_= 0;
+    int numEx= 0;
+    for (size_t i= 0; i < n; ++i)
+        if (ex_->IsExclusive( i))
+            global_[i]= numEx++;
+    const std::vector<int> numExAll= ProcCL::Gather( numEx, -1);
+    const int offset= std::accumulate( numExAll.begin(), numExAll.begin() + ProcCL::MyRank(), 0);
+    numGlobal_= std::accumulate( numExAll.begin(), numExAll.end(), 0);
+    for (size_t i= 0; i < n; ++i)
+        if (ex_->IsExclusive( i))
+            global_[i]+= offset;
+    ex_->Accumulate( global_);
+
+    cnt_= ProcCL::Gather( int( n), root_);
+    displ_.assign( cnt_.size(), 0);
+    for (size_t p= 1; p < displ_.size(); ++p)
+        displ_[p]= displ_[p-1] + cnt_[p-1];
+    recvIdx_.resize( IamRoot() ? displ_.back() + cnt_.back() : 0);
+    ProcCL::Gatherv( Addr( global_), int( n), Addr( recvIdx_), Addr( cnt_), Addr( displ_), root_);
+    buf_.resize( std::max( recvIdx_.size(), n));
+}
+
+void CoarseAgglomerationCL::GatherMatrix (const MatrixCL& A)
+{
+    std::vector<int>    row, col;
+    std::vector<double> val;
+    row.reserve( A.num_nonzeros());
+    col.reserve( A.num_nonzeros());
+    val.reserve( A.num_nonzeros());
+    for (size_t i= 0; i < A.num_rows(); ++i)
+        for (size_t k= A.row_beg( i); k < A.row_beg( i + 1); ++k) {
+            row.push_back( global_[i]);
+            col.push_back( global_[A.col_ind( k)]);
+            val.push_back( A.val( k));
+        }
+    const std::valarray<int>    r= ProcCL::Gatherv( row, root_),
+                                c= ProcCL::Gatherv( col, root_);
+    const std::valarray<double> v= ProcCL::Gatherv( val, root_);
+    if (!IamRoot())
+        return;
+
+    MatrixBuilderCL B( &A_, numGlobal_, numGlobal_);
+    for (size_t k= 0; k < r.size(); ++k)
+        B( r[k], c[k])+= v[k];
+    B.Build();
+}
+
+void CoarseAgglomerationCL::GatherVector (const VectorCL& b, VectorCL& b_glob) const
+{
+    ProcCL::Gatherv( Addr( b), int( b.size()), Addr( buf_), Addr( cnt_), Addr( displ_), root_);
+    if (!IamRoot())
+        return;
+    b_glob.resize( numGlobal_);
+    b_glob= 0.;
+    for (size_t k= 0; k < recvIdx_.size(); ++k)
+        b_glob[recvIdx_[k]]+= buf_[k];
+}
+
+void CoarseAgglomerationCL::ScatterVector (const VectorCL& x_glob, VectorCL& x) const
+{
+    if (IamRoot())
+        for (size_t k= 0; k < recvIdx_.size(); ++k)
+            buf_[k]= x_glob[recvIdx_[k]];
+    x.resize( global_.size());
+    ProcCL::Scatterv( Addr( buf_), Addr( cnt_), Addr( displ_), Addr( x), int( x.size()), root_);
+}
+
+} // end of namespace DROPS
+
+#endif
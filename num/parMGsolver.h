@@ -0,0 +1,290 @@
+/// \file parMGsolver.h
+/// \brief parallel geometric multigrid with agglomeration of the coarse levels
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+/// As in all parallel solvers, the solution x is accumulated and the right hand
+/// side b is distributed. The matrices and prolongations of all levels are the
+/// local parts of the distributed hierarchy, the ExchangeCL of the level is taken
+/// from the corresponding IdxDescCL of the MLIdxDescCL.
+///
+/// The parallel multigrid is experimental: MLIdxDescCL provides more than one level in parallel builds only,
+/// if _PAR_MG is defined. The coarse level is agglomerated on a single root process; an agglomeration onto a
+/// subset of the processes is not implemented.
+
+#ifndef DROPS_PARMGSOLVER_H
+#define DROPS_PARMGSOLVER_H
+
+#include "num/parsolver.h"
+#include "parallel/exchange.h"
+#include <vector>
+
+namespace DROPS
+{
+
+/*******************************************************************
+*   C O A R S E A G G L O M E R A T I O N   C L                    *
+*******************************************************************/
+/// \brief Gathers a distributed linear system on one process and distributes the solution back.
+/** The unknowns get a global number by their exclusive process. The local matrices are summed up on
+    the root process, which holds the assembled matrix afterwards; the right hand sides are summed up
+    the same way. The solution on the root process is scattered back such that each process receives
+    the values of all its local unknowns, i.e., the solution is accumulated.
+    The global numbering and the communication pattern are kept until Init is called again, e.g.,
+    after the ParMultiGridCL has migrated the multigrid and the numbering has changed. */
+/*******************************************************************
+*   C O A R S E A G G L O M E R A T I O N   C L                    *
+*******************************************************************/
+class CoarseAgglomerationCL
+{
+  private:
+    int               root_;        ///< process, that holds the agglomerated system
+    const ExchangeCL* ex_;          ///< exchange of the distributed system
+    VectorBaseCL<int> global_;      ///< global numbers of the local unknowns
+    size_t            numGlobal_;   ///< number of global unknowns
+    std::vector<int>  cnt_, displ_; ///< number of local unknowns of each process and the displacements (root only)
+    std::valarray<int> recvIdx_;    ///< global numbers of the received values (root only)
+    MatrixCL          A_;           ///< agglomerated matrix (root only)
+    mutable std::valarray<double> buf_; ///< send and receive buffer of the vectors
+
+  public:
+    CoarseAgglomerationCL (int root= ProcCL::Master())
+        : root_( root), ex_( 0), numGlobal_( 0) {}
+
+    /// \brief Generates the global numbering of the unknowns of idx; collective operation.
+    void Init (const IdxDescCL& idx);
+    /// \brief Sums up the distributed matrix A on the root process; collective operation.
+    void GatherMatrix (const MatrixCL& A);
+    /// \brief Sums up the distributed vector b on the root process; b_glob is resized on the root process only.
+    void GatherVector (const VectorCL& b, VectorCL& b_glob) const;
+    /// \brief Distributes x_glob of the root process; x is accumulated afterwards.
+    void ScatterVector (const VectorCL& x_glob, VectorCL& x) const;
+
+    bool   IamRoot      () const { return ProcCL::MyRank() == root_; }
+    int    GetRoot      () const { return root_; }
+    size_t GetNumGlobal () const { return numGlobal_; }
+    /// \brief Agglomerated matrix; valid on the root process.
+    const MatrixCL& GetMatrix () const { return A_; }
+};
+
+/*******************************************************************
+*   P A R J O R S M O O T H   C L                                  *
+*******************************************************************/
+/// \brief Damped Jacobi smoother for distributed matrices.
+/** The smoother uses the accumulated diagonal of the level, which is
+    stored by ParMGSolverCL; so no diagonal has to be set from outside. */
+class ParJORsmoothCL
+{
+  private:
+    double omega_;
+
+  public:
+    ParJORsmoothCL (double omega= 0.8) : omega_( omega) {}
+
+    /// \brief steps damped Jacobi iterations; x accumulated, b distributed, diag accumulated.
+    void Apply (const MatrixCL& A, VectorCL& x, const VectorCL& b, const VectorCL& diag,
+                const ExchangeCL& ex, Uint steps) const
+    {
+        for (Uint i= 0; i < steps; ++i) {
+            VectorCL r( b - A*x);
+            ex.Accumulate( r);
+            x+= omega_*r/diag;
+        }
+    }
+
+    /// \name Interface of SolverAsPreCL; the smoother determines the diagonal of each level itself
+    //@{
+    bool NeedDiag () const { return false; }
+    template<typename Mat>
+    void SetDiag (const Mat&) {}
+    //@}
+};
+
+/*******************************************************************
+*   P A R M G S O L V E R   C L                                    *
+*******************************************************************/
+/// \brief Parallel multigrid solver (V-cycle), whose coarse levels are agglomerated on one process.
+/** On a distributed multigrid the coarse levels have only a few unknowns per process, such that
+    the latency of the communication dominates the cycle. The finest level, whose global number of
+    unknowns does not exceed the agglomeration size, is gathered on the root process and solved there
+    by the serial solver CoarseSolverT, e.g., CoarseGridSolverCL with the sparse direct solver. The
+    coarser levels are not visited at all. The correction is scattered back before the prolongation.
+    The levels are set up again, if a matrix of the hierarchy changes, e.g., after the ParMultiGridCL
+    has refined and migrated the multigrid. */
+/*******************************************************************
+*   P A R M G S O L V E R   C L                                    *
+*******************************************************************/
+template <class CoarseSolverT, class ProlongationT= MLMatrixCL>
+class ParMGSolverCL : public ParSolverBaseCL
+{
+  private:
+    typedef ParSolverBaseCL base_;
+
+    ProlongationT          P_;               ///< prolongation
+    const MLIdxDescCL&     idx_;             ///< indices of all levels; provide the ExchangeCL
+    ParJORsmoothCL         smoother_;        ///< multigrid smoother
+    CoarseSolverT&         coarseSolver_;    ///< serial coarse grid solver on the root process
+    Uint                   smoothSteps_;     ///< number of smoothing steps
+    size_t                 agglomSize_;      ///< maximal global number of unknowns of the agglomerated level
+    CoarseAgglomerationCL  agglom_;          ///< gathers the coarse level
+
+    /// \name Setup of the levels; index 0 is the agglomerated level
+    //@{
+    std::vector<const MatrixCL*>   A_;       ///< matrices
+    std::vector<const MatrixCL*>   Pl_;      ///< prolongations from level l-1 to l
+    std::vector<const ExchangeCL*> ex_;      ///< exchange of the levels
+    std::vector<VectorCL>          diag_;    ///< accumulated diagonals
+    std::vector<size_t>            version_; ///< versions of the matrices at setup
+    size_t                         numLevelsA_; ///< number of levels of the matrix at setup
+    //@}
+    VectorCL bc_, xc_;                       ///< agglomerated coarse grid vectors (root only)
+
+    /// \brief Checks the versions of the matrices and sets the levels up again, if necessary.
+    void Setup (const MLMatrixCL& A);
+    /// \brief One V-cycle on level l.
+    void Cycle (size_t l, VectorCL& x, const VectorCL& b);
+    /// \brief Solves the agglomerated coarse grid problem.
+    void CoarseSolve (VectorCL& x, const VectorCL& b);
+
+  public:
+    /// \param idx        indices of all levels (e.g. Stokes.vel_idx)
+    /// \param cs         serial coarse grid solver, called on the root process only
+    /// \param maxiter    maximal number of cycles
+    /// \param tol        tolerance for the residual
+    /// \param agglomSize maximal global number of unknowns of the agglomerated level
+    /// \param rel        measure the residual relative to the right hand side
+    /// \param smsteps    number of smoothing steps
+    /// \param omega      damping of the Jacobi smoother
+    ParMGSolverCL (const MLIdxDescCL& idx, CoarseSolverT& cs, int maxiter, double tol, size_t agglomSize= 20000,
+                   bool rel= true, Uint smsteps= 2, double omega= 0.8)
+        : base_( maxiter, tol, idx.GetFinest(), rel), idx_( idx), smoother_( omega), coarseSolver_( cs),
+          smoothSteps_( smsteps), agglomSize_( agglomSize), numLevelsA_( 0) {}
+
+    ProlongationT*  GetProlongation () { return &P_; }
+    ParJORsmoothCL& GetPC ()           { return smoother_; }  ///< needed by SolverAsPreCL
+    const ParJORsmoothCL& GetPC () const { return smoother_; }
+
+    void   SetAgglomerationSize (size_t n) { agglomSize_= n; A_.clear(); }
+    size_t GetAgglomerationSize () const   { return agglomSize_; }
+    /// \brief Number of levels used by the cycle, the agglomerated level included.
+    size_t GetNumLevels () const { return A_.size(); }
+    /// \brief Global number of unknowns of the agglomerated level.
+    size_t GetNumCoarseUnknowns () const { return agglom_.GetNumGlobal(); }
+
+    void Solve (const MLMatrixCL& A, VectorCL& x, const VectorCL& b);
+    void Solve (const MatrixCL&, VectorCL&, const VectorCL&)
+    {
+        throw DROPSErrCL( "ParMGSolverCL::Solve: need multilevel data structure\n");
+    }
+};
+
+template <class CoarseSolverT, class ProlongationT>
+void ParMGSolverCL<CoarseSolverT, ProlongationT>::Setup (const MLMatrixCL& A)
+{
+    // the used levels are the finest ones of A; a rebuilt or modified matrix changes address or version
+    bool changed= A_.empty() || A.size() != numLevelsA_;
+    MLMatrixCL::const_iterator a= A.GetFinestIter();
+    for (size_t i= A_.size(); !changed && i > 0; --i, --a)
+        changed= &*a != A_[i-1] || a->Version() != version_[i-1];
+    if (!ProcCL::GlobalOr( changed))
+        return;
+    if (A.size() > idx_.size() || A.size() > P_.size())
+        throw DROPSErrCL( "ParMGSolverCL::Setup: hierarchy of matrices, indices and prolongations does not match");
+
+    A_.clear(); Pl_.clear(); ex_.clear(); diag_.clear(); version_.clear();
+    numLevelsA_= A.size();
+    // walk from the finest level downwards up to the first level, that is small enough to be agglomerated
+    MLMatrixCL::const_iterator             ai= A.GetFinestIter();
+    MLIdxDescCL::const_iterator            ii= idx_.GetFinestIter();
+    typename ProlongationT::const_iterator pi= P_.GetFinestIter();
+    for (;; --ai, --ii, --pi) {
+        A_.push_back( &*ai);
+        Pl_.push_back( &*pi);
+        ex_.push_back( &ii->GetEx());
+        if (ai == A.begin() || ProcCL::GlobalSum( ii->GetEx().GetNumExclusive()) <= agglomSize_)
+            break;
+    }
+    std::reverse( A_.begin(), A_.end());
+    std::reverse( Pl_.begin(), Pl_.end());
+    std::reverse( ex_.begin(), ex_.end());
+    diag_.resize( A_.size());
+    for (size_t l= 0; l < A_.size(); ++l) {
+        version_.push_back( A_[l]->Version());
+        diag_[l].resize( A_[l]->num_rows());
+        diag_[l]= A_[l]->GetDiag();
+        ex_[l]->Accumulate( diag_[l]);
+    }
+    agglom_.Init( *ii);
+    agglom_.GatherMatrix( *A_[0]);
+}
+
+template <class CoarseSolverT, class ProlongationT>
+void ParMGSolverCL<CoarseSolverT, ProlongationT>::CoarseSolve (VectorCL& x, const VectorCL& b)
+{
+    agglom_.GatherVector( b, bc_);
+    if (agglom_.IamRoot()) {
+        xc_.resize( bc_.size());
+        xc_= 0.;
+        coarseSolver_.Solve( agglom_.GetMatrix(), xc_, bc_);
+    }
+    agglom_.ScatterVector( xc_, x);
+}
+
+template <class CoarseSolverT, class ProlongationT>
+void ParMGSolverCL<CoarseSolverT, ProlongationT>::Cycle (size_t l, VectorCL& x, const VectorCL& b)
+{
+    if (l == 0) {
+        CoarseSolve( x, b);
+        return;
+    }
+    smoother_.Apply( *A_[l], x, b, diag_[l], *ex_[l], smoothSteps_);
+    // restriction of the distributed residual gives the distributed coarse residual,
+    // the prolongation of the accumulated correction an accumulated vector
+    VectorCL rc( transp_mul( *Pl_[l], VectorCL( b - (*A_[l])*x)));
+    VectorCL ec( rc.size());
+    Cycle( l - 1, ec, rc);
+    x+= (*Pl_[l])*ec;
+    smoother_.Apply( *A_[l], x, b, diag_[l], *ex_[l], smoothSteps_);
+}
+
+template <class CoarseSolverT, class ProlongationT>
+void ParMGSolverCL<CoarseSolverT, ProlongationT>::Solve (const MLMatrixCL& A, VectorCL& x, const VectorCL& b)
+{
+    Setup( A);
+    const ExchangeCL& ex= *ex_.back();
+    const double normb= GetRelError() ? ex.Norm( b, false) : 1.;
+    double resid= ex.Norm( VectorCL( b - A.GetFinest()*x), false)/(normb > 0. ? normb : 1.);
+    int it= 0;
+    for (; it < _maxiter && resid > _tol; ++it) {
+        Cycle( A_.size() - 1, x, b);
+        resid= ex.Norm( VectorCL( b - A.GetFinest()*x), false)/(normb > 0. ? normb : 1.);
+        if (output_ != 0)
+            IF_MASTER
+                *output_ << "ParMGSolverCL: iteration " << it + 1 << "\tresidual: " << resid << std::endl;
+    }
+    _iter= it;
+    _res=  resid;
+}
+
+} // end of namespace DROPS
+
+#endif
@@ -457,11 +457,12 @@ void Jacobi(const Mat& A, const Vec& Diag, Vec& x, const Vec& b, const double om
     const size_t n= A.num_rows();
     Vec          y(x.size());
 
-    for (size_t i=0, nz=0; i<n; ++i)
+#   pragma omp parallel for if ((long)n > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)n; ++i)
     {
         double sum= b[i];
-        for (const size_t end= A.row_beg(i+1); nz<end; ++nz)
-            if (A.col_ind(nz) != i)
+        for (size_t nz= A.row_beg(i), end= A.row_beg(i+1); nz<end; ++nz)
+            if (A.col_ind(nz) != static_cast<size_t>(i))
                 sum-= A.val(nz)*x[A.col_ind(nz)];
         if (HasOmega)
             y[i]= (1.-omega)*x[i]+omega*sum/Diag[i];
@@ -483,7 +484,8 @@ void Jacobi0(const Mat&, const Vec& Diag, Vec& x, const Vec& b, const double ome
 
 {
     const size_t n = x.size();
-    for (size_t i=0; i<n; ++i)
+#   pragma omp parallel for if ((long)n > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)n; ++i)
     {
         if (HasOmega)
             x[i] = omega * b[i] / Diag[i];
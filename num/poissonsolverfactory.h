@@ -27,7 +27,9 @@
 #define POISSONSOLVERFACTORY_H_
 
 #include "num/solver.h"
+#include "num/fe.h"
 #include "misc/params.h"
+#include "num/sparsedirect.h"
 #ifdef _HYPRE
 #include "num/hypre.h"
 #endif
@@ -112,15 +114,17 @@ class PoissonSolverFactoryCL
     SORsmoothCL  sorsmoother_;   // Gauss-Seidel with over-relaxation
     SSORsmoothCL ssorsmoother_;  // symmetric Gauss-Seidel with over-relaxation
     PCG_SsorCL   coarsesolversymm_;
-    typedef MGSolverCL<JORsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmJORT;
+    typedef CoarseGridSolverCL<PCG_SsorCL> CoarseT;
+    CoarseT      coarse_;        // PCG or sparse direct solver
+    typedef MGSolverCL<JORsmoothCL, CoarseT, ProlongationT> MGSolversymmJORT;
     MGSolversymmJORT MGSolversymmJOR_;
-    typedef MGSolverCL<GSsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmGST;
+    typedef MGSolverCL<GSsmoothCL, CoarseT, ProlongationT> MGSolversymmGST;
     MGSolversymmGST MGSolversymmGS_;
-    typedef MGSolverCL<SGSsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmSGST;
+    typedef MGSolverCL<SGSsmoothCL, CoarseT, ProlongationT> MGSolversymmSGST;
     MGSolversymmSGST MGSolversymmSGS_;
-    typedef MGSolverCL<SORsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmSORT;
+    typedef MGSolverCL<SORsmoothCL, CoarseT, ProlongationT> MGSolversymmSORT;
     MGSolversymmSORT MGSolversymmSOR_;
-    typedef MGSolverCL<SSORsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmSSORT;
+    typedef MGSolverCL<SSORsmoothCL, CoarseT, ProlongationT> MGSolversymmSSORT;
     MGSolversymmSSORT MGSolversymmSSOR_;
 
     //JAC-GMRes
@@ -134,6 +138,8 @@ class PoissonSolverFactoryCL
     PCGSolverT PCGSolver_;
 
   public:
+    /// Poisson.ProlongationMode (default 0) selects the assembled (0) or the matrix-free (1) prolongation of the
+    /// multigrid solvers; 1 needs ProlongationT= MLProlongationCL, cf. SetupP1ProlongationMatrix.
     PoissonSolverFactoryCL( ParamCL& P, MLIdxDescCL& idx);
     ~PoissonSolverFactoryCL() {}
 
@@ -149,16 +155,32 @@ PoissonSolverFactoryCL<ProlongationT>::
     PoissonSolverFactoryCL(ParamCL& P, MLIdxDescCL& idx)
     : P_(P), idx_(idx), prolongptr_( 0), JACPc_( P.get<double>("Poisson.Relax")), SSORPc_( P.get<double>("Poisson.Relax")),
         jorsmoother_( P.get<double>("Poisson.Relax")), gssmoother_( P.get<double>("Poisson.Relax")), sgssmoother_( P.get<double>("Poisson.Relax")), sorsmoother_( P.get<double>("Poisson.Relax")), ssorsmoother_( P.get<double>("Poisson.Relax")),
-        coarsesolversymm_( SSORPc_, 500, 1e-6, true),
-        MGSolversymmJOR_( jorsmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
-        MGSolversymmGS_( gssmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
-        MGSolversymmSGS_( sgssmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
-        MGSolversymmSOR_( sorsmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
-        MGSolversymmSSOR_( ssorsmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        coarsesolversymm_( SSORPc_, 500, 1e-6, true), coarse_( coarsesolversymm_, P.get<int>("Poisson.DirectCoarseSolver", 0) != 0),
+        MGSolversymmJOR_( jorsmoother_, coarse_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        MGSolversymmGS_( gssmoother_, coarse_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        MGSolversymmSGS_( sgssmoother_, coarse_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        MGSolversymmSOR_( sorsmoother_, coarse_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        MGSolversymmSSOR_( ssorsmoother_, coarse_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
         GMResSolver_( JACPc_, P.get<int>("Poisson.Restart"), P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         GMResSolverSSOR_( SSORPc_, P.get<int>("Poisson.Restart"), P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         PCGSolver_( SSORPc_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"))
-        {}
+{
+    // cycle type (1: V-, 2: W-, 3: F-cycle), growth of the smoothing steps, full multigrid and adaptive smoothing
+    const MGCycleParamCL cycle( MGCycleT( P.get<int>("Poisson.MGCycle", 1)), P.get<double>("Poisson.SmoothGrowth", 1.),
+        P.get<int>("Poisson.FullMG", 0) != 0, P.get<double>("Poisson.AdaptiveSmoothing", 0.));
+    MGSolversymmJOR_.SetCycleParam( cycle);
+    MGSolversymmGS_.SetCycleParam( cycle);
+    MGSolversymmSGS_.SetCycleParam( cycle);
+    MGSolversymmSOR_.SetCycleParam( cycle);
+    MGSolversymmSSOR_.SetCycleParam( cycle);
+    // prolongation (0: assembled, 1: matrix-free); the matrix-free mode needs ProlongationT= MLProlongationCL
+    const ProlongationCL::ModeT prmode= ProlongationCL::ModeT( P.get<int>("Poisson.ProlongationMode", 0));
+    SetProlongationMode( *MGSolversymmJOR_.GetProlongation(), prmode);
+    SetProlongationMode( *MGSolversymmGS_.GetProlongation(), prmode);
+    SetProlongationMode( *MGSolversymmSGS_.GetProlongation(), prmode);
+    SetProlongationMode( *MGSolversymmSOR_.GetProlongation(), prmode);
+    SetProlongationMode( *MGSolversymmSSOR_.GetProlongation(), prmode);
+}
 
 template <class ProlongationT>
 PoissonSolverBaseCL* PoissonSolverFactoryCL<ProlongationT>::CreatePoissonSolver()
@@ -26,6 +26,7 @@
 #define DROPS_SOLVER_H
 
 #include <vector>
+#include <algorithm>
 #include "misc/container.h"
 #include "num/spmat.h"
 #include "num/spblockmat.h"
@@ -81,10 +82,13 @@ template <PreBaseGS> class PreDummyCL {};
 //  Implementation of the methods
 //=============================================================================
 
+// The methods without SparseMatDiagCL accept matrices of any value type, e.g. the
+// single precision matrices of SinglePrecisionPcCL; the sums are accumulated in double.
+
 // One step of the Jacobi method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_JAC>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_JAC>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     Vec          y(x.size());
@@ -107,9 +111,9 @@ SolveGSstep(const PreDummyCL<PB_JAC>&, const MatrixCL& A, Vec& x, const Vec& b,
 }
 
 // One step of the Jacobi method with start vector 0
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_JAC0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_JAC0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     size_t nz;
@@ -125,9 +129,9 @@ SolveGSstep(const PreDummyCL<PB_JAC0>&, const MatrixCL& A, Vec& x, const Vec& b,
 }
 
 // One step of the Gauss-Seidel/SOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_GS>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_GS>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -148,9 +152,9 @@ SolveGSstep(const PreDummyCL<PB_GS>&, const MatrixCL& A, Vec& x, const Vec& b, d
 }
 
 // One step of the Gauss-Seidel/SOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_GS0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_GS0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -171,9 +175,9 @@ SolveGSstep(const PreDummyCL<PB_GS0>&, const MatrixCL& A, Vec& x, const Vec& b,
 
 
 // One step of the Symmetric-Gauss-Seidel/SSOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_SGS>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_SGS>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -212,9 +216,9 @@ SolveGSstep(const PreDummyCL<PB_SGS>&, const MatrixCL& A, Vec& x, const Vec& b,
 
 
 // One step of the Symmetric-Gauss-Seidel/SSOR method with start vector 0
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_SGS0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_SGS0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
 
@@ -277,9 +281,9 @@ SolveGSstep(const PreDummyCL<PB_SGS0>&, const MatrixCL& A, Vec& x, const Vec& b,
     }
 }
 
-template <bool HasOmega, typename  Vec, PreBaseGS PBT>
+template <bool HasOmega, typename  Vec, PreBaseGS PBT, typename T>
 void
-SolveGSstep(const PreDummyCL<PBT>& pd, const MLMatrixCL& M, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PBT>& pd, const MLSparseMatBaseCL<T>& M, Vec& x, const Vec& b, double omega)
 {
     SolveGSstep<HasOmega, Vec>( pd, M.GetFinest(), x, b, omega);
 }
@@ -1348,6 +1352,112 @@ BICGSTAB( const Mat& A, Vec& x, const Vec& b,
     return false;
 }
 
+/// \brief Krylov subspace, which is carried over from one solve to the next (recycling for GCR and GMRESR).
+/** The space consists of k pairs (u_i, c_i). At the beginning of a solve, c_i= A*u_i is recomputed for the
+    current matrix and the c_i are orthonormalized (the u_i are transformed accordingly); the initial residual is
+    projected onto their complement. During the solve, the new search directions are orthogonalized against the
+    c_i in addition (deflation in the spirit of GCRO-DR). At the end, the k directions with the largest
+    contributions |gamma| to the reduction of the residual are kept for the next solve; GCRO-DR uses harmonic Ritz
+    vectors instead, which are not available in the truncated GCR.
+    If the dimension of the system changes, the space is discarded. */
+template <class Vec>
+class KrylovRecycleCL
+{
+  private:
+    size_t k_;
+    std::vector<Vec>    u_, c_;       ///< recycled space
+    std::vector<Vec>    nu_, nc_;     ///< candidates for the next solve
+    std::vector<double> weight_;      ///< |gamma| of the candidates
+
+  public:
+    KrylovRecycleCL (size_t k= 0) : k_( k) {}
+
+    void   SetDim (size_t k) { k_= k; Clear(); }
+    size_t GetDim () const { return k_; }
+    /// \brief Number of vectors in the recycled space
+    size_t size () const { return u_.size(); }
+    void   Clear () { u_.clear(); c_.clear(); nu_.clear(); nc_.clear(); weight_.clear(); }
+
+    /// \brief Recompute c_i= A*u_i, orthonormalize and update x and r= b - A*x with the projection onto span(c_i).
+    template <class Mat>
+    void Prepare (const Mat& A, Vec& x, Vec& r);
+    /// \brief Orthogonalize the direction u with c= A*u against the recycled space.
+    void Orthogonalize (Vec& u, Vec& c) const {
+        for (size_t i= 0; i < c_.size(); ++i) {
+            const double alpha= dot( c, c_[i]);
+            c-= alpha*c_[i];
+            u-= alpha*u_[i];
+        }
+    }
+    /// \brief Offer the normalized direction u with c= A*u and coefficient gamma as candidate for the next solve.
+    void Collect (const Vec& u, const Vec& c, double gamma);
+    /// \brief Replace the recycled space by the best candidates.
+    void Finish () {
+        u_.swap( nu_);
+        c_.swap( nc_);
+        nu_.clear(); nc_.clear(); weight_.clear();
+    }
+};
+
+template <class Vec>
+  template <class Mat>
+void KrylovRecycleCL<Vec>::Prepare (const Mat& A, Vec& x, Vec& r)
+{
+    nu_.clear(); nc_.clear(); weight_.clear();
+    if (k_ == 0 || u_.empty())
+        return;
+    if (u_[0].size() != x.size()) {
+        u_.clear(); c_.clear();
+        return;
+    }
+    // modified Gram-Schmidt on c_i= A*u_i; nearly dependent directions are dropped.
+    std::vector<Vec> u, c;
+    for (size_t i= 0; i < u_.size(); ++i) {
+        Vec ui( u_[i]), ci( A*ui);
+        const double norm0= norm( ci);
+        for (size_t j= 0; j < c.size(); ++j) {
+            const double alpha= dot( ci, c[j]);
+            ci-= alpha*c[j];
+            ui-= alpha*u[j];
+        }
+        const double beta= norm( ci);
+        if (beta <= 1e-10*norm0 || beta == 0.)
+            continue;
+        ci/= beta;
+        ui/= beta;
+        u.push_back( ui);
+        c.push_back( ci);
+    }
+    u_.swap( u);
+    c_.swap( c);
+    for (size_t i= 0; i < c_.size(); ++i) {
+        const double gamma= dot( r, c_[i]);
+        x+= gamma*u_[i];
+        r-= gamma*c_[i];
+        Collect( u_[i], c_[i], gamma);
+    }
+}
+
+template <class Vec>
+void KrylovRecycleCL<Vec>::Collect (const Vec& u, const Vec& c, double gamma)
+{
+    if (k_ == 0)
+        return;
+    const double w= std::fabs( gamma);
+    if (nu_.size() < k_) {
+        nu_.push_back( u);
+        nc_.push_back( c);
+        weight_.push_back( w);
+        return;
+    }
+    const size_t min_idx= std::min_element( weight_.begin(), weight_.end()) - weight_.begin();
+    if (w <= weight_[min_idx])
+        return;
+    nu_[min_idx]= u;
+    nc_[min_idx]= c;
+    weight_[min_idx]= w;
+}
+
 //*****************************************************************
 // GCR
 //
@@ -1371,12 +1481,14 @@ BICGSTAB( const Mat& A, Vec& x, const Vec& b,
 //     new vector sn (min-alpha strategy).
 // measure_relative_tol -- If true, stop if |b - Ax|/|b| <= tol,
 //     if false, stop if |b - Ax| <= tol. ( |.| is the euclidean norm.)
+// rec -- If not 0, the recycled space is used for the initial guess and
+//     deflation and is updated for the next solve (cf. KrylovRecycleCL).
 //
 //*****************************************************************
 template <class Mat, class Vec, class Preconditioner>
 bool
 GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
-    int m, int& max_iter, double& tol, bool measure_relative_tol= true)
+    int m, int& max_iter, double& tol, bool measure_relative_tol= true, KrylovRecycleCL<Vec>* rec= 0)
 {
     m= (m <= max_iter) ? m : max_iter; // m > max_iter only wastes memory.
 
@@ -1387,16 +1499,22 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
 
     double normb= norm( b);
     if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
+    if (rec != 0)
+        rec->Prepare( A, x, r);
     double resid= norm( r)/normb;
     for (int k= 0; k < max_iter; ++k) {
         if (k%10==0) std::cout << "GCR: k: " << k << "\tresidual: " << resid << std::endl;
         if (resid < tol) {
             tol= resid;
             max_iter= k;
+            if (rec != 0)
+                rec->Finish();
             return true;
         }
         M.Apply( A, sn, r);
         vn= A*sn;
+        if (rec != 0)
+            rec->Orthogonalize( sn, vn);
         for (int i= 0; i < k && i < m; ++i) {
             const double alpha= dot( vn, v[i]);
             a[i]= alpha;
@@ -1409,6 +1527,8 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         const double gamma= dot( r, vn);
         x+= gamma*sn;
         r-= gamma*vn;
+        if (rec != 0)
+            rec->Collect( sn, vn, gamma);
         resid= norm( r)/normb;
         if (k < m) {
             s.push_back( sn);
@@ -1427,6 +1547,8 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         }
     }
     tol= resid;
+    if (rec != 0)
+        rec->Finish();
     return false;
 }
 
@@ -1449,23 +1571,29 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
 //
 // measure_relative_tol - If true, stop if |b - Ax|/|b| <= tol,
 //     if false, stop if |b - Ax| <= tol. ( |.| is the euclidean norm.)
+// rec - If not 0, the recycled space is used for the initial guess and
+//     deflation and is updated for the next solve (cf. KrylovRecycleCL).
 //
 //*****************************************************************
 template <class Mat, class Vec, class Preconditioner>
 bool
 GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
     int /*restart parameter m*/ m, int& max_iter, int& inner_max_iter, double& tol, double& inner_tol,
-    bool measure_relative_tol= true, PreMethGMRES method = RightPreconditioning)
+    bool measure_relative_tol= true, PreMethGMRES method = RightPreconditioning, KrylovRecycleCL<Vec>* rec= 0)
 {  Vec r( b - A*x);
     std::vector<Vec> u(1), c(1); // Positions u[0], c[0] are unused below.
     double normb= norm( b);
     if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
     double resid= -1.0;
+    if (rec != 0)
+        rec->Prepare( A, x, r);
 
     for (int k= 0; k < max_iter; ++k) {
         if ((resid= norm( r)/normb) < tol) {
             tol= resid;
             max_iter= k;
+            if (rec != 0)
+                rec->Finish();
             return true;
         }
         std::cout << "GMRESR: k: " << k << "\tresidual: " << resid << std::endl;
@@ -1483,6 +1611,8 @@ GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
             std::cout<<"LSQR switch!\n";
         }
         c.push_back( A*u[k+1]);
+        if (rec != 0)
+            rec->Orthogonalize( u[k+1], c[k+1]);
         for (int i= 1; i <= k; ++i) {
             const double alpha= dot( c[k+1], c[i]);
             c[k+1]-= alpha*c[i];
@@ -1494,8 +1624,12 @@ GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         const double gamma= dot( r, c[k+1]);
         x+= gamma*u[k+1];
         r-= gamma*c[k+1];
+        if (rec != 0)
+            rec->Collect( u[k+1], c[k+1], gamma);
     }
     tol= resid;
+    if (rec != 0)
+        rec->Finish();
     return false;
 }
 
@@ -1715,9 +1849,11 @@ class CGSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "CG");
         _res=  _tol;
         _iter= _maxiter;
         CG(A, x, b, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1746,9 +1882,11 @@ class PCGSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "PCG");
         _res=  _tol;
         _iter= _maxiter;
         PCG(A, x, b, _pc, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1779,9 +1917,11 @@ class PCGNESolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "PCGNE");
         _res=  _tol;
         _iter= _maxiter;
         PCGNE( A, x, b, pc_, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1802,9 +1942,11 @@ class MResSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "MINRES");
         _res=  _tol;
         _iter= _maxiter;
         MINRES( A, x, b, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1832,10 +1974,12 @@ class PMResSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "PMINRES");
         _res=  _tol;
         _iter= _maxiter;
         q_.new_basis( A, Vec( b - A*x));
         PMINRES( A, x, b, q_, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1870,9 +2014,11 @@ class GMResSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "GMRES");
         _res=  _tol;
         _iter= _maxiter;
         GMRES(A, x, b, pc_, restart_, _iter, _res, rel_, calculate2norm_, method_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1900,9 +2046,11 @@ class BiCGStabSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "BiCGStab");
         _res=  _tol;
         _iter= _maxiter;
         BICGSTAB( A, x, b, pc_, _iter, _res, rel_);
+        DROPS_COUNT( "iterations", _iter);
     }
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b, int& numIter, double& resid) const
@@ -1920,6 +2068,7 @@ class GCRSolverCL : public SolverBaseCL
   private:
     PC& pc_;
     int truncate_; // no effect atm.
+    KrylovRecycleCL<VectorCL> rec_;
 
   public:
     GCRSolverCL( PC& pc, int truncate, int maxiter, double tol,
@@ -1930,13 +2079,18 @@ class GCRSolverCL : public SolverBaseCL
     PC&       GetPc      ()       { return pc_; }
     const PC& GetPc      () const { return pc_; }
     int       GetTruncate() const { return truncate_; }
+    /// \brief Carry k search directions over to the next call of Solve (0: no recycling).
+    void      SetRecycle (int k) { rec_.SetDim( k); }
+    const KrylovRecycleCL<VectorCL>& GetRecycle() const { return rec_; }
 
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "GCR");
         _res=  _tol;
         _iter= _maxiter;
-        GCR( A, x, b, pc_, truncate_, _iter, _res, rel_);
+        GCR( A, x, b, pc_, truncate_, _iter, _res, rel_, rec_.GetDim() > 0 ? &rec_ : 0);
+        DROPS_COUNT( "iterations", _iter);
         if (output_ != 0)
             *output_ << "GCRSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
@@ -1962,6 +2116,7 @@ class GMResRSolverCL : public SolverBaseCL
     int          inner_maxiter_;
     double       inner_tol_;
     PreMethGMRES method_;
+    KrylovRecycleCL<VectorCL> rec_;
   public:
     GMResRSolverCL( PC& pc, int restart, int maxiter, int  inner_maxiter,
         double tol, double  inner_tol, bool relative= true, PreMethGMRES method = RightPreconditioning, std::ostream* output= 0)
@@ -1973,13 +2128,18 @@ class GMResRSolverCL : public SolverBaseCL
     int       GetRestart () const { return restart_; }
     void   SetInnerTol     (double tol) { inner_tol_= tol; }
     void   SetInnerMaxIter (int iter)   { inner_maxiter_= iter; }
+    /// \brief Carry k outer search directions over to the next call of Solve (0: no recycling).
+    void   SetRecycle      (int k)      { rec_.SetDim( k); }
+    const KrylovRecycleCL<VectorCL>& GetRecycle() const { return rec_; }
 
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "GMRESR");
         _res=  _tol;
         _iter= _maxiter;
-        GMRESR(A, x, b, pc_, restart_, _iter, inner_maxiter_, _res, inner_tol_, rel_, method_);
+        GMRESR(A, x, b, pc_, restart_, _iter, inner_maxiter_, _res, inner_tol_, rel_, method_, rec_.GetDim() > 0 ? &rec_ : 0);
+        DROPS_COUNT( "iterations", _iter);
         if (output_ != 0)
             *output_ << "GmresRSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
@@ -2019,9 +2179,11 @@ class IDRsSolverCL : public SolverBaseCL
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
+        DROPS_REGION( "IDRs");
         _res=  _tol;
         _iter= _maxiter;
         IDRS(A, x, b, pc_, _iter, _res, rel_, s_, omega_bound_);
+        DROPS_COUNT( "iterations", _iter);
         if (output_ != 0)
             *output_ << "IDRsSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
@@ -2038,6 +2200,164 @@ class IDRsSolverCL : public SolverBaseCL
     }
 };
 
+//=============================================================================
+//  Polynomial smoothers
+//=============================================================================
+
+/// \brief Largest eigenvalue of the symmetric tridiagonal matrix with diagonal a and off-diagonal b; bisection with Sturm sequences.
+inline double TridiagMaxEigenvalue (const std::vector<double>& a, const std::vector<double>& b)
+{
+    const size_t n= a.size();
+    double lo= a[0], hi= a[0];
+    for (size_t i= 0; i < n; ++i) { // Gershgorin discs
+        const double r= (i > 0 ? std::fabs( b[i-1]) : 0.) + (i + 1 < n ? std::fabs( b[i]) : 0.);
+        lo= std::min( lo, a[i] - r);
+        hi= std::max( hi, a[i] + r);
+    }
+    for (int k= 0; k < 60 && hi - lo > 1e-10*std::fabs( hi); ++k) {
+        const double mid= 0.5*(lo + hi);
+        size_t below= 0; // number of eigenvalues < mid
+        double q= 1.;
+        for (size_t i= 0; i < n; ++i) {
+            q= a[i] - mid - (i > 0 ? b[i-1]*b[i-1]/q : 0.);
+            if (q == 0.) q= 1e-300;
+            if (q < 0.) ++below;
+        }
+        if (below == n) hi= mid; else lo= mid;
+    }
+    return hi;
+}
+
+/// \brief Estimates the largest eigenvalue of D^{-1}A for symmetric positive definite A with steps steps of PLanczosONBCL; D is the diagonal of A.
+template <typename Mat>
+double EstimateJacobiMaxEigenvalue (const Mat& A, const VectorCL& dinv, int steps)
+{
+    DiagPcCL pc( dinv);
+    PLanczosONBCL<VectorCL, DiagPcCL> lanczos( pc);
+    VectorCL r0( dinv.size());
+    for (size_t i= 0; i < r0.size(); ++i)
+        r0[i]= 1. + 0.5*std::sin( 1. + i);
+    std::vector<double> a, b;
+    lanczos.new_basis( A, r0);
+    for (int k= 0; k < steps && k < static_cast<int>( r0.size()); ++k) {
+        a.push_back( lanczos.a0);
+        b.push_back( lanczos.b[0]);
+        if (lanczos.breakdown() || !lanczos.next( A))
+            break;
+    }
+    return TridiagMaxEigenvalue( a, b);
+}
+
+/// \brief For single precision matrices, the estimate is computed in double precision.
+inline double EstimateJacobiMaxEigenvalue (const FloatMatrixCL& A, const VectorCL& dinv, int steps)
+{
+    MatrixCL Ad;
+    convert_matrix( Ad, A);
+    return EstimateJacobiMaxEigenvalue( Ad, dinv, steps);
+}
+
+/// \brief Chebyshev-accelerated Jacobi smoother for symmetric positive definite matrices.
+///
+/// One application performs degree steps of the Chebyshev iteration for D^{-1}A, which damps the eigenvalues in
+/// [lmax/range, lmax]. The largest eigenvalue lmax of D^{-1}A is estimated with a few Lanczos steps and increased by
+/// 10 percent; the estimate and the diagonal are stored per matrix and recomputed, if its version changes. The
+/// versions of SparseMatBaseCL are globally unique, so a matrix rebuilt at the address of a destroyed one gets new data.
+/// Only matrix-vector products and the diagonal are needed; hence, the smoother is OpenMP-parallel and can be used
+/// with matrix-free operators (Mat needs operator*, GetDiag() and Version()).
+/// The smoother can be used for all levels of MGM as it stores the data for each matrix.
+class ChebyshevSmoothCL
+{
+  private:
+    template <typename T>
+    struct LevelCL
+    {
+        const void*     mat;
+        size_t          version;
+        double          lmax;
+        VectorBaseCL<T> dinv, r, d; ///< inverse diagonal and work vectors
+    };
+
+    int    degree_;
+    double range_;
+    int    lanczosSteps_;
+    mutable std::vector<LevelCL<double> > levels_;
+    mutable std::vector<LevelCL<float> >  levelsf_;
+
+    std::vector<LevelCL<double> >& levels (double) const { return levels_; }
+    std::vector<LevelCL<float> >&  levels (float)  const { return levelsf_; }
+
+    /// \brief Returns the data of A; the eigenvalue estimate is updated, if A changed.
+    template <typename Mat, typename T>
+    LevelCL<T>& GetLevel (const Mat& A, T) const {
+        std::vector<LevelCL<T> >& lv= levels( T());
+        typename std::vector<LevelCL<T> >::iterator it= lv.begin();
+        while (it != lv.end() && it->mat != &A)
+            ++it;
+        if (it == lv.end()) {
+            lv.push_back( LevelCL<T>());
+            it= lv.end() - 1;
+            it->mat= &A;
+        }
+        else if (it->version == A.Version() && it->dinv.size() == A.num_rows())
+            return *it;
+        const VectorBaseCL<T> diag( A.GetDiag());
+        VectorCL dinv( diag.size());
+        for (size_t i= 0; i < diag.size(); ++i)
+            dinv[i]= 1./diag[i];
+        it->version= A.Version();
+        it->lmax= 1.1*EstimateJacobiMaxEigenvalue( A, dinv, lanczosSteps_);
+        convert_vector( it->dinv, dinv);
+        return *it;
+    }
+
+  public:
+    ChebyshevSmoothCL (int degree= 2, double range= 20., int lanczosSteps= 10)
+        : degree_( degree), range_( range), lanczosSteps_( lanczosSteps) {}
+
+    int    GetDegree () const { return degree_; }
+    void   SetDegree (int degree) { degree_= degree; }
+    double GetRange  () const { return range_; }
+    void   SetRange  (double range) { range_= range; }
+    /// \brief Estimate of the largest eigenvalue of D^{-1}A, which is used for the matrix A.
+    template <typename Mat>
+    double GetMaxEigenvalue (const Mat& A) const { return GetLevel( A, double()).lmax; }
+    /// \brief Releases the stored data of all matrices.
+    void Clear () { levels_.clear(); levelsf_.clear(); }
+
+    template <typename Mat, typename Vec>
+    void Apply (const Mat& A, Vec& x, const Vec& b) const {
+        typedef typename Vec::value_type T;
+        LevelCL<T>& l= GetLevel( A, T());
+        const double lmax= l.lmax, lmin= lmax/range_,
+                     theta= 0.5*(lmax + lmin), delta= 0.5*(lmax - lmin), sigma= theta/delta;
+        const size_t n= x.size();
+        resize_work( l.r, n);
+        resize_work( l.d, n);
+        l.r= b - A*x;
+        double rho_old= 1./sigma;
+#ifndef DROPS_WIN
+        size_t i;
+#else
+        int i;
+#endif
+#       pragma omp parallel for
+        for (i= 0; i < n; ++i)
+            l.d[i]= l.dinv[i]*l.r[i]/theta;
+        for (int k= 1; k <= degree_; ++k) {
+            x+= l.d;
+            if (k == degree_)
+                break;
+            l.r= b - A*x;
+            const double rho= 1./(2.*sigma - rho_old),
+                         c0= rho*rho_old, c1= 2.*rho/delta;
+#           pragma omp parallel for
+            for (i= 0; i < n; ++i)
+                l.d[i]= c0*l.d[i] + c1*l.dinv[i]*l.r[i];
+            rho_old= rho;
+        }
+    }
+};
+
 //=============================================================================
 //  Typedefs
 //=============================================================================
@@ -2108,6 +2428,40 @@ class SolverAsPreCL: public PreBaseCL
 };
 
 
+//=============================================================================
+// Mixed precision: preconditioners in single precision for Krylov methods in
+// double precision.
+//=============================================================================
+/// \brief Applies the preconditioner PC in single precision.
+///
+/// The matrix is converted to float, if it or its version changes (see FloatMatrixCacheCL); the vectors
+/// are converted on each application. This halves the memory traffic of the preconditioner, while the outer
+/// Krylov method remains in double precision. PC must accept FloatMatrixCL (resp. MLFloatMatrixCL) and
+/// FloatVectorCL, e.g. the Jacobi and Gauss-Seidel type preconditioners without SparseMatDiagCL.
+template <class PC>
+class SinglePrecisionPcCL
+{
+  private:
+    const PC& pc_;
+    mutable FloatMatrixCacheCL A_;
+    mutable FloatVectorCL x_, b_;
+
+  public:
+    SinglePrecisionPcCL (const PC& pc) : pc_( pc) {}
+
+    /// \brief Releases the single precision copy of the matrix.
+    void Clear () { A_.Clear(); }
+
+    template <typename Mat>
+    void Apply (const Mat& A, VectorCL& x, const VectorCL& b) const {
+        convert_vector( x_, x);
+        convert_vector( b_, b);
+        pc_.Apply( A_.Get( A), x_, b_);
+        convert_vector( x, x_);
+    }
+};
+
+
 //*****************************************************************************
 //
 //  Non-iterative methods: Gauss solver with pivoting
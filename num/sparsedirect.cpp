@@ -0,0 +1,409 @@
+/// \file sparsedirect.cpp
+/// \brief sparse direct solver with nested dissection ordering and cached symbolic factorization
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/sparsedirect.h"
+#include "misc/instrument.h"
+#include <algorithm>
+#include <limits>
+
+namespace DROPS
+{
+
+namespace {
+
+const size_t NoNode= std::numeric_limits<size_t>::max();
+
+/// \brief Adjacency lists of the graph of A + A^T without the diagonal (compressed, sorted).
+void SymmetricGraph (const MatrixCL& A, std::vector<size_t>& ptr, std::vector<size_t>& adj)
+{
+    const size_t n= A.num_rows();
+    const size_t* row= A.raw_row();
+    const size_t* col= A.raw_col();
+    std::vector<size_t> cnt( n + 1, 0);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t k= row[i]; k < row[i+1]; ++k)
+            if (col[k] != i) {
+                ++cnt[i + 1];
+                ++cnt[col[k] + 1];
+            }
+    for (size_t i= 0; i < n; ++i)
+        cnt[i + 1]+= cnt[i];
+    std::vector<size_t> tmp( cnt[n]), pos( cnt.begin(), cnt.end() - 1);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t k= row[i]; k < row[i+1]; ++k)
+            if (col[k] != i) {
+                tmp[pos[i]++]= col[k];
+                tmp[pos[col[k]]++]= i;
+            }
+    // sort and remove duplicates
+    ptr.assign( n + 1, 0);
+    adj.clear();
+    adj.reserve( tmp.size());
+    for (size_t i= 0; i < n; ++i) {
+        std::sort( tmp.begin() + cnt[i], tmp.begin() + cnt[i+1]);
+        const std::vector<size_t>::iterator end= std::unique( tmp.begin() + cnt[i], tmp.begin() + cnt[i+1]);
+        adj.insert( adj.end(), tmp.begin() + cnt[i], end);
+        ptr[i + 1]= adj.size();
+    }
+}
+
+/// \brief Recursive bisection of the subgraph of the vertices v with part[v] == id.
+class DissectionCL
+{
+  private:
+    const std::vector<size_t>& ptr_, & adj_;
+    std::vector<int>&          part_;
+    std::vector<size_t>&       p_;
+    const size_t               minSize_;
+    int                        nextId_;
+    std::vector<size_t>        level_; ///< BFS level of the vertices
+
+    /// \brief Breadth first search in the subgraph from s; returns the vertices in the order of the search
+    /// and the beginning of the levels.
+    void BFS (size_t s, int id, std::vector<size_t>& order, std::vector<size_t>& levelBegin) {
+        order.clear();
+        levelBegin.clear();
+        order.push_back( s);
+        level_[s]= 0;
+        levelBegin.push_back( 0);
+        for (size_t k= 0; k < order.size(); ++k) {
+            const size_t v= order[k];
+            for (size_t e= ptr_[v]; e < ptr_[v+1]; ++e) {
+                const size_t w= adj_[e];
+                if (part_[w] != id || level_[w] != NoNode)
+                    continue;
+                level_[w]= level_[v] + 1;
+                if (level_[w] == levelBegin.size())
+                    levelBegin.push_back( order.size());
+                order.push_back( w);
+            }
+        }
+        levelBegin.push_back( order.size());
+        for (size_t k= 0; k < order.size(); ++k)
+            level_[order[k]]= NoNode;
+    }
+
+  public:
+    DissectionCL (const std::vector<size_t>& ptr, const std::vector<size_t>& adj, std::vector<int>& part,
+                  std::vector<size_t>& p, size_t minSize)
+        : ptr_( ptr), adj_( adj), part_( part), p_( p), minSize_( minSize), nextId_( 1), level_( part.size(), NoNode) {}
+
+    void Dissect (std::vector<size_t>& verts, int id) {
+        if (verts.size() <= minSize_) {
+            p_.insert( p_.end(), verts.begin(), verts.end());
+            return;
+        }
+        // pseudo-peripheral vertex: restart from a vertex of minimal degree in the last level
+        std::vector<size_t> order, levelBegin;
+        size_t s= verts[0];
+        BFS( s, id, order, levelBegin);
+        for (int iter= 0; iter < 4; ++iter) {
+            size_t t= order[levelBegin[levelBegin.size() - 2]];
+            for (size_t k= levelBegin[levelBegin.size() - 2]; k < order.size(); ++k)
+                if (ptr_[order[k]+1] - ptr_[order[k]] < ptr_[t+1] - ptr_[t])
+                    t= order[k];
+            std::vector<size_t> order2, levelBegin2;
+            BFS( t, id, order2, levelBegin2);
+            if (levelBegin2.size() <= levelBegin.size())
+                break;
+            order.swap( order2);
+            levelBegin.swap( levelBegin2);
+        }
+        const int id1= nextId_++, id2= nextId_++;
+        std::vector<size_t> part1, part2, sep;
+        if (order.size() < verts.size()) { // disconnected: the component of s and the rest
+            for (size_t k= 0; k < order.size(); ++k)
+                part_[order[k]]= id1;
+            for (size_t k= 0; k < verts.size(); ++k)
+                if (part_[verts[k]] == id1)
+                    part1.push_back( verts[k]);
+                else {
+                    part_[verts[k]]= id2;
+                    part2.push_back( verts[k]);
+                }
+        }
+        else {
+            const size_t numLevels= levelBegin.size() - 1;
+            if (numLevels < 3) { // no useful separator
+                p_.insert( p_.end(), verts.begin(), verts.end());
+                return;
+            }
+            // separator: the level, at which half of the vertices are reached
+            size_t sl= 1;
+            while (sl < numLevels - 2 && levelBegin[sl + 1] < order.size()/2)
+                ++sl;
+            for (size_t k= levelBegin[sl + 1]; k < order.size(); ++k)
+                part_[order[k]]= id2;
+            // only the vertices of the separator level with a neighbor in the second part are needed
+            for (size_t k= levelBegin[sl]; k < levelBegin[sl + 1]; ++k) {
+                const size_t v= order[k];
+                bool neighbor2= false;
+                for (size_t e= ptr_[v]; e < ptr_[v+1] && !neighbor2; ++e)
+                    neighbor2= part_[adj_[e]] == id2;
+                if (neighbor2)
+                    sep.push_back( v);
+            }
+            for (size_t k= 0; k < sep.size(); ++k)
+                part_[sep[k]]= -1; // removed from the graph
+            for (size_t k= 0; k < order.size(); ++k) {
+                const size_t v= order[k];
+                if (part_[v] == id2)
+                    part2.push_back( v);
+                else if (part_[v] == id) {
+                    part_[v]= id1;
+                    part1.push_back( v);
+                }
+            }
+        }
+        verts.clear();
+        Dissect( part1, id1);
+        Dissect( part2, id2);
+        p_.insert( p_.end(), sep.begin(), sep.end());
+    }
+};
+
+} // end of anonymous namespace
+
+void NestedDissection (const MatrixCL& A, std::vector<size_t>& p, size_t minSize)
+{
+    const size_t n= A.num_rows();
+    std::vector<size_t> ptr, adj;
+    SymmetricGraph( A, ptr, adj);
+    std::vector<int> part( n, 0);
+    std::vector<size_t> verts( n);
+    for (size_t i= 0; i < n; ++i)
+        verts[i]= i;
+    p.clear();
+    p.reserve( n);
+    DissectionCL( ptr, adj, part, p, std::max( minSize, size_t( 1))).Dissect( verts, 0);
+}
+
+void SparseDirectSolverCL::Clear ()
+{
+    n_= 0;
+    row_.clear(); col_.clear(); val_.clear();
+    perm_.clear(); iperm_.clear();
+    Ap_.clear(); Ai_.clear(); Amap_.clear();
+    Lp_.clear(); Li_.clear(); Up_.clear(); Ui_.clear();
+    Lx_.clear(); Ux_.clear(); Ud_.clear();
+    levelPtr_.clear(); levelCol_.clear();
+}
+
+void SparseDirectSolverCL::Factorize (const MatrixCL& A)
+{
+    if (A.num_rows() != A.num_cols())
+        throw DROPSErrCL( "SparseDirectSolverCL::Factorize: matrix is not square");
+    const size_t n= A.num_rows(), nnz= A.num_nonzeros();
+    const bool samePattern= n == n_ && nnz == col_.size() && !row_.empty()
+        && std::equal( A.raw_row(), A.raw_row() + n + 1, row_.begin())
+        && std::equal( A.raw_col(), A.raw_col() + nnz, col_.begin());
+    if (samePattern && std::equal( A.raw_val(), A.raw_val() + nnz, val_.begin()))
+        return;
+    if (!samePattern) {
+        Symbolic( A);
+        row_.assign( A.raw_row(), A.raw_row() + n + 1);
+        col_.assign( A.raw_col(), A.raw_col() + nnz);
+    }
+    val_.assign( A.raw_val(), A.raw_val() + nnz);
+    Numeric( A);
+}
+
+void SparseDirectSolverCL::Symbolic (const MatrixCL& A)
+{
+    DROPS_REGION( "SparseDirectSolverCL::Symbolic");
+    ++numSymbolic_;
+    const size_t n= A.num_rows();
+    n_= n;
+    NestedDissection( A, perm_);
+    iperm_.resize( n);
+    for (size_t i= 0; i < n; ++i)
+        iperm_[perm_[i]]= i;
+
+    // columns of the permuted matrix with the position of the entries in A
+    const size_t* row= A.raw_row();
+    const size_t* col= A.raw_col();
+    Ap_.assign( n + 1, 0);
+    for (size_t k= 0; k < A.num_nonzeros(); ++k)
+        ++Ap_[iperm_[col[k]] + 1];
+    for (size_t j= 0; j < n; ++j)
+        Ap_[j + 1]+= Ap_[j];
+    Ai_.resize( A.num_nonzeros());
+    Amap_.resize( A.num_nonzeros());
+    std::vector<size_t> pos( Ap_.begin(), Ap_.end() - 1);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t k= row[i]; k < row[i+1]; ++k) {
+            const size_t j= iperm_[col[k]];
+            Ai_[pos[j]]= iperm_[i];
+            Amap_[pos[j]++]= k;
+        }
+
+    // graph of the permuted A + A^T
+    std::vector<size_t> gptr, gadj;
+    SymmetricGraph( A, gptr, gadj);
+
+    // elimination tree (Liu) with path compression
+    std::vector<size_t> parent( n, NoNode), ancestor( n, NoNode);
+    for (size_t j= 0; j < n; ++j) {
+        const size_t old= perm_[j];
+        for (size_t e= gptr[old]; e < gptr[old+1]; ++e) {
+            size_t i= iperm_[gadj[e]];
+            while (i != NoNode && i < j) {
+                const size_t inext= ancestor[i];
+                ancestor[i]= j;
+                if (inext == NoNode)
+                    parent[i]= j;
+                i= inext;
+            }
+        }
+    }
+
+    // row patterns of L (= column patterns of U) by the reach of the rows in the elimination tree
+    std::vector<size_t> mark( n, NoNode), Lcnt( n + 1, 0);
+    Up_.assign( 1, 0);
+    Ui_.clear();
+    for (size_t j= 0; j < n; ++j) {
+        mark[j]= j;
+        const size_t old= perm_[j], begin= Ui_.size();
+        for (size_t e= gptr[old]; e < gptr[old+1]; ++e)
+            for (size_t i= iperm_[gadj[e]]; i < j && mark[i] != j; i= parent[i]) {
+                mark[i]= j;
+                Ui_.push_back( i);
+                ++Lcnt[i + 1];
+            }
+        std::sort( Ui_.begin() + begin, Ui_.end());
+        Up_.push_back( Ui_.size());
+    }
+    // columns of L by transposition; the row indices are sorted
+    Lp_.resize( n + 1);
+    Lp_[0]= 0;
+    for (size_t j= 0; j < n; ++j)
+        Lp_[j + 1]= Lp_[j] + Lcnt[j + 1];
+    Li_.resize( Lp_[n]);
+    std::vector<size_t> lpos( Lp_.begin(), Lp_.end() - 1);
+    for (size_t j= 0; j < n; ++j)
+        for (size_t k= Up_[j]; k < Up_[j+1]; ++k)
+            Li_[lpos[Ui_[k]]++]= j;
+
+    // height of the columns in the elimination tree; columns of equal height are independent
+    std::vector<size_t> height( n, 0);
+    size_t maxHeight= 0;
+    for (size_t j= 0; j < n; ++j) {
+        maxHeight= std::max( maxHeight, height[j]);
+        if (parent[j] != NoNode)
+            height[parent[j]]= std::max( height[parent[j]], height[j] + 1);
+    }
+    levelPtr_.assign( maxHeight + 2, 0);
+    for (size_t j= 0; j < n; ++j)
+        ++levelPtr_[height[j] + 1];
+    for (size_t l= 0; l <= maxHeight; ++l)
+        levelPtr_[l + 1]+= levelPtr_[l];
+    levelCol_.resize( n);
+    std::vector<size_t> hpos( levelPtr_.begin(), levelPtr_.end() - 1);
+    for (size_t j= 0; j < n; ++j)
+        levelCol_[hpos[height[j]]++]= j;
+
+    Lx_.resize( Li_.size());
+    Ux_.resize( Ui_.size());
+    Ud_.resize( n);
+}
+
+bool SparseDirectSolverCL::FactorColumn (size_t j, const double* a, std::vector<double>& w)
+{
+    for (size_t k= Ap_[j]; k < Ap_[j+1]; ++k)
+        w[Ai_[k]]= a[Amap_[k]];
+    // U(:,j) = L(0:j,0:j)^{-1} A(0:j,j); the pattern of U(:,j) is sorted, i.e., in topological order
+    for (size_t k= Up_[j]; k < Up_[j+1]; ++k) {
+        const size_t c= Ui_[k];
+        const double u= w[c];
+        Ux_[k]= u;
+        w[c]= 0.;
+        if (u == 0.)
+            continue;
+        for (size_t e= Lp_[c]; e < Lp_[c+1]; ++e)
+            w[Li_[e]]-= Lx_[e]*u;
+    }
+    // L(j+1:n,j) = (A(j+1:n,j) - L(j+1:n,0:j) U(0:j,j))/U(j,j)
+    const double d= w[j];
+    w[j]= 0.;
+    Ud_[j]= d;
+    const double dinv= d != 0. ? 1./d : 0.;
+    for (size_t e= Lp_[j]; e < Lp_[j+1]; ++e) {
+        Lx_[e]= w[Li_[e]]*dinv;
+        w[Li_[e]]= 0.;
+    }
+    return d != 0.;
+}
+
+void SparseDirectSolverCL::Numeric (const MatrixCL& A)
+{
+    DROPS_REGION( "SparseDirectSolverCL::Numeric");
+    ++numNumeric_;
+    const double* a= A.raw_val();
+    size_t zeroPivot= NoNode;
+#   pragma omp parallel
+    {
+        std::vector<double> w( n_, 0.);
+        for (size_t l= 0; l + 1 < levelPtr_.size(); ++l) {
+            const int begin= levelPtr_[l], end= levelPtr_[l + 1];
+#           pragma omp for schedule(dynamic, 8)
+            for (int k= begin; k < end; ++k)
+                if (!FactorColumn( levelCol_[k], a, w)) {
+#                   pragma omp critical
+                    zeroPivot= std::min( zeroPivot, levelCol_[k]);
+                }
+        }
+    }
+    if (zeroPivot != NoNode) {
+        val_.clear(); // the factors are invalid
+        throw DROPSErrCL( "SparseDirectSolverCL::Numeric: zero pivot");
+    }
+}
+
+void SparseDirectSolverCL::SolveFactorized (VectorCL& x, const VectorCL& b) const
+{
+    if (b.size() != n_)
+        throw DROPSErrCL( "SparseDirectSolverCL::SolveFactorized: incompatible dimensions");
+    y_.resize( n_);
+    for (size_t j= 0; j < n_; ++j)
+        y_[j]= b[perm_[j]];
+    // L y = Pb
+    for (size_t j= 0; j < n_; ++j) {
+        const double yj= y_[j];
+        if (yj != 0.)
+            for (size_t e= Lp_[j]; e < Lp_[j+1]; ++e)
+                y_[Li_[e]]-= Lx_[e]*yj;
+    }
+    // U z = y
+    for (size_t j= n_; j-- > 0; ) {
+        const double zj= (y_[j]/= Ud_[j]);
+        if (zj != 0.)
+            for (size_t e= Up_[j]; e < Up_[j+1]; ++e)
+                y_[Ui_[e]]-= Ux_[e]*zj;
+    }
+    x.resize( n_);
+    for (size_t j= 0; j < n_; ++j)
+        x[perm_[j]]= y_[j];
+}
+
+} // end of namespace DROPS
@@ -0,0 +1,148 @@
+/// \file sparsedirect.h
+/// \brief sparse direct solver with nested dissection ordering and cached symbolic factorization
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#ifndef DROPS_SPARSEDIRECT_H
+#define DROPS_SPARSEDIRECT_H
+
+#include "num/solver.h"
+#include <vector>
+
+namespace DROPS
+{
+
+/// \brief Nested dissection ordering of the graph of A + A^T.
+///
+/// The graph is split recursively by level sets of a breadth first search from a pseudo-peripheral vertex;
+/// the separators are numbered after the two parts. Subgraphs with at most minSize vertices are not split.
+/// \param p On exit, p[new number]= old number.
+void NestedDissection (const MatrixCL& A, std::vector<size_t>& p, size_t minSize= 32);
+
+/*******************************************************************
+*   S P A R S E D I R E C T S O L V E R   C L                      *
+*******************************************************************/
+/// \brief Sparse LU factorization for the coarse grid problems of the multigrid methods.
+/** The matrix is ordered by nested dissection and factorized without pivoting on the pattern of A + A^T;
+    this suits the finite element matrices on the coarsest level, which have a symmetric pattern and are
+    positive definite or dominated by their symmetric part.
+    The symbolic factorization (ordering, elimination tree, patterns of L and U) is kept as long as the
+    pattern of A does not change; a change of the values only triggers the numeric factorization, an
+    unchanged matrix none at all. The columns are factorized left-looking and in parallel (OpenMP) for
+    all columns with the same height in the elimination tree; nested dissection makes this tree wide. */
+/*******************************************************************
+*   S P A R S E D I R E C T S O L V E R   C L                      *
+*******************************************************************/
+class SparseDirectSolverCL : public SolverBaseCL
+{
+  private:
+    size_t              n_;                 ///< dimension of the factorized matrix
+    std::vector<size_t> row_, col_;         ///< pattern of the factorized matrix; used to detect changes
+    std::vector<double> val_;               ///< values of the factorized matrix; used to detect changes
+    std::vector<size_t> perm_, iperm_;      ///< perm_[new]= old, iperm_[old]= new
+    std::vector<size_t> Ap_, Ai_, Amap_;    ///< columns of the permuted matrix; Amap_ is the position of the entry in A
+    std::vector<size_t> Lp_, Li_;           ///< pattern of the strictly lower part of L (columns, sorted)
+    std::vector<size_t> Up_, Ui_;           ///< pattern of the strictly upper part of U (columns, sorted)
+    std::vector<double> Lx_, Ux_, Ud_;      ///< values of L (unit diagonal), U and the diagonal of U
+    std::vector<size_t> levelPtr_, levelCol_; ///< columns grouped by their height in the elimination tree
+    size_t              numSymbolic_,       ///< number of symbolic factorizations
+                        numNumeric_;        ///< number of numeric factorizations
+    mutable VectorCL    y_;                 ///< work vector of the triangular solves
+
+    void Symbolic (const MatrixCL& A);
+    void Numeric  (const MatrixCL& A);
+    /// \brief Left-looking factorization of column j; w is a zero work vector of size n_ and zero on exit.
+    bool FactorColumn (size_t j, const double* a, std::vector<double>& w);
+
+  public:
+    SparseDirectSolverCL ()
+        : SolverBaseCL( 1, 0.), n_( 0), numSymbolic_( 0), numNumeric_( 0) {}
+
+    /// \brief Factorizes A; the symbolic factorization is reused for an unchanged pattern, the factors for an unchanged matrix.
+    void Factorize (const MatrixCL& A);
+    /// \brief Solves with the factors of the last call of Factorize.
+    void SolveFactorized (VectorCL& x, const VectorCL& b) const;
+    /// \brief Factorizes A, if necessary, and solves Ax=b.
+    void Solve (const MatrixCL& A, VectorCL& x, const VectorCL& b) {
+        Factorize( A);
+        SolveFactorized( x, b);
+        _iter= 1;
+        _res= 0.;
+    }
+    /// \brief Releases the factors and the symbolic factorization.
+    void Clear ();
+
+    size_t GetNumSymbolic  () const { return numSymbolic_; }
+    size_t GetNumNumeric   () const { return numNumeric_; }
+    /// \brief Number of nonzeros of L and U including the diagonal.
+    size_t GetNumNonzeros  () const { return Li_.size() + Ui_.size() + n_; }
+    /// \brief Number of levels of the parallel factorization.
+    size_t GetNumLevels    () const { return levelPtr_.empty() ? 0 : levelPtr_.size() - 1; }
+};
+
+/*******************************************************************
+*   C O A R S E G R I D S O L V E R   C L                          *
+*******************************************************************/
+/// \brief Coarse grid solver of MGSolverCL: SparseDirectSolverCL or the iterative solver SolverT.
+/** The choice can be switched at runtime, e.g., from a parameter file. The direct solver keeps its
+    factorization between the cycles; it is only refactorized, if the coarse grid matrix changes. */
+/*******************************************************************
+*   C O A R S E G R I D S O L V E R   C L                          *
+*******************************************************************/
+template <class SolverT>
+class CoarseGridSolverCL : public SolverBaseCL
+{
+  private:
+    SolverT&             solver_;
+    SparseDirectSolverCL direct_;
+    bool                 useDirect_;
+
+  public:
+    CoarseGridSolverCL (SolverT& solver, bool useDirect= false)
+        : SolverBaseCL( solver.GetMaxIter(), solver.GetTol()), solver_( solver), useDirect_( useDirect) {}
+
+    void SetDirect (bool useDirect) {
+        useDirect_= useDirect;
+        if (!useDirect)
+            direct_.Clear();
+    }
+    bool GetDirect () const { return useDirect_; }
+    SparseDirectSolverCL& GetDirectSolver () { return direct_; }
+    SolverT&              GetIterativeSolver () { return solver_; }
+
+    void Solve (const MatrixCL& A, VectorCL& x, const VectorCL& b) {
+        if (useDirect_) {
+            direct_.Solve( A, x, b);
+            _iter= direct_.GetIter();
+            _res=  direct_.GetResid();
+        }
+        else {
+            solver_.Solve( A, x, b);
+            _iter= solver_.GetIter();
+            _res=  solver_.GetResid();
+        }
+    }
+};
+
+} // end of namespace DROPS
+
+#endif
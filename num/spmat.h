@@ -44,6 +44,7 @@
 #endif
 #include "misc/utils.h"
 #include "misc/container.h"
+#include "misc/instrument.h"
 #ifdef _PAR
 # include "parallel/parallel.h"
 #endif
@@ -332,6 +333,8 @@ struct BlockTraitsCL
     static inline sort_pair_type pair_copy (const std::pair<size_t, double>& p); // not defined
     ///\brief Return an entry, if the sparsity pattern is reused (only for block_type == double).
     static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*); // not defined
+    ///\brief Returns the entry (i,j) of a block.
+    static inline double component (const block_type&, Uint, Uint); // not defined
 };
 
 template <>
@@ -361,6 +364,8 @@ struct BlockTraitsCL<double>
         Assert( pos != col_idx_end, "SparseMatBuilderCL (): no such index", DebugNumericC);
         return val[pos - col_idx_begin];
     }
+    static inline double component (const block_type& b, Uint, Uint)
+        { return b; }
 };
 
 template <Uint Rows, Uint Cols>
@@ -394,6 +399,8 @@ struct BlockTraitsCL< SMatrixCL<Rows, Cols> >
         { return std::make_pair( p.first, &p.second); }
     static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*)
         { throw DROPSErrCL( "SparseMatBuilderCL: Cannot reuse the sparsity-pattern for SMatrixCL-blocks"); }
+    static inline double component (const block_type& b, Uint i, Uint j)
+        { return b( i, j); }
 };
 
 template <Uint Rows>
@@ -426,6 +433,8 @@ struct BlockTraitsCL< SDiagMatrixCL<Rows> >
         { return std::make_pair( p.first, &p.second); }
     static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*)
         { throw DROPSErrCL( "SparseMatBuilderCL: Cannot reuse the sparsity-pattern for SDiagMatrixCL-blocks"); }
+    static inline double component (const block_type& b, Uint i, Uint j)
+        { return i == j ? b( i) : 0.; }
 };
 ///@}
 
@@ -554,6 +563,84 @@ void SparseMatBuilderCL<T, BlockT>::Build()
     _coupl= 0;
 }
 
+/// \brief Adds contributions to the entries of an existing sparse matrix
+///
+/// The contributions are collected like in SparseMatBuilderCL, but Build() adds them to the values of the matrix
+/// instead of replacing it. The sparsity pattern is not changed; all nonzero contributions must belong to it.
+/// This is used to update a matrix, if only the element contributions of some tetras changed: The old contributions
+/// of these tetras are subtracted and the new ones are added.
+///
+/// \param T is the type of the matrix-entries
+/// \param BlockT is a T-valued container-type used in the builder
+template <typename T= double, typename BlockT= T>
+class SparseMatPatchCL
+{
+  private:
+    typedef BlockTraitsCL<BlockT> BlockTraitT;
+    typedef typename BlockTraitT::block_type block_type;
+
+  public:
+    typedef T                        valueT;
+    typedef SparseMatBaseCL<T>       spmatT;
+    typedef typename SparseMatBuilderCL<T, BlockT>::couplT couplT;
+
+  private:
+    spmatT* mat_;
+    couplT* coupl_;
+
+  public:
+    SparseMatPatchCL (spmatT* mat)
+        : mat_( mat), coupl_( new couplT[mat->num_rows()/BlockTraitT::num_rows]) {}
+    ~SparseMatPatchCL() { delete[] coupl_; }
+
+    block_type& operator() (size_t i, size_t j)
+    {
+        Assert( i < mat_->num_rows() && j < mat_->num_cols(), "SparseMatPatchCL (): index out of bounds", DebugNumericC);
+        return coupl_[i/BlockTraitT::num_rows][j/BlockTraitT::num_cols];
+    }
+
+    /// \brief Adds the collected contributions to the matrix; throws, if a nonzero contribution is not in the sparsity pattern.
+    void Build();
+};
+
+template <typename T, typename BlockT>
+void SparseMatPatchCL<T, BlockT>::Build()
+{
+    const size_t block_rows= mat_->num_rows()/BlockTraitT::num_rows;
+    const size_t* rb= mat_->raw_row();
+    const size_t* colind= mat_->raw_col();
+    T* val= mat_->raw_val();
+    bool missing= false;
+
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for reduction(||: missing)
+    for (i= 0; i < block_rows; ++i)
+        for (typename couplT::const_iterator it= coupl_[i].begin(); it != coupl_[i].end(); ++it)
+            for (Uint k= 0; k < BlockTraitT::num_rows; ++k) {
+                const size_t row= i*BlockTraitT::num_rows + k;
+                for (Uint l= 0; l < BlockTraitT::num_cols; ++l) {
+                    const double v= BlockTraitT::component( it->second, k, l);
+                    if (v == 0.)
+                        continue;
+                    const size_t col= it->first*BlockTraitT::num_cols + l;
+                    const size_t* pos= std::lower_bound( colind + rb[row], colind + rb[row + 1], col);
+                    if (pos == colind + rb[row + 1] || *pos != col)
+                        missing= true;
+                    else
+                        val[pos - colind]+= v;
+                }
+            }
+    delete[] coupl_;
+    coupl_= 0;
+    mat_->IncrementVersion();
+    if (missing)
+        throw DROPSErrCL( "SparseMatPatchCL::Build: The contributions do not match the sparsity pattern.");
+}
+
 ///\brief  SparseMatBaseCL: compressed row storage sparse matrix
 /// Use SparseMatBuilderCL for setting up.
 template <typename T>
@@ -564,7 +651,8 @@ private:
     size_t _cols; ///< number of columns
     size_t nnz_;  ///< number of non-zeros
 
-    size_t version_; ///< All modifications increment this. Starts with 1.
+    static size_t LastVersion; ///< Last version given to a matrix with entries of type T.
+    size_t version_; ///< All modifications set a new version, which is unique among all matrices with entries of type T.
 
     size_t* _rowbeg; ///< (_rows+1 entries, last entry must be <=_nz) index of first non-zero-entry in _val belonging to the row given as subscript
     size_t* _colind; ///< (nnz_ entries) column-number of corresponding entry in _val
@@ -573,6 +661,7 @@ private:
     void num_rows (size_t rows);    ///< Set _rows and resize _rowbeg
     void num_cols (size_t cols);    ///< Set _cols
     void num_nonzeros (size_t nnz); ///< Set nnz_ and resize _colind and _val
+    static size_t NewVersion (); ///< Returns a new, globally unique version
 
 public:
     typedef T value_type;
@@ -606,7 +695,7 @@ public:
     size_t col_ind (size_t i) const { return _colind[i]; }
     T      val     (size_t i) const { return _val[i]; }
 
-    void IncrementVersion() { ++version_; }      ///< Increment modification version number
+    void IncrementVersion() { version_= NewVersion(); } ///< Set a new modification version number
     size_t Version() const  { return version_; } ///< Get modification version number
 
     const size_t* GetFirstCol(size_t i) const { return _colind + _rowbeg[i]; }
@@ -628,6 +717,8 @@ public:
                               double, const SparseMatBaseCL<T>&,
                               double, const SparseMatBaseCL<T>&,
                               double, const SparseMatBaseCL<T>&);
+    /// \brief Linear combination of n<=4 matrices; used by LinComb for three and four matrices.
+    SparseMatBaseCL& LinCombN (Uint n, const double* coeff, const SparseMatBaseCL<T>* const* M);
 
     void insert_col (size_t c, const VectorBaseCL<T>& v);
 
@@ -673,9 +764,23 @@ template <typename T>
     _colind= new size_t[nnz];
 }
 
+template <typename T>
+  size_t SparseMatBaseCL<T>::LastVersion= 0;
+
+template <typename T>
+  size_t SparseMatBaseCL<T>::NewVersion ()
+/// The versions are unique such that a matrix, which is rebuilt at the address of a destroyed matrix, cannot
+/// match a version, which was stored for the destroyed matrix, e.g. by a preconditioner.
+{
+    size_t v;
+#   pragma omp atomic capture
+    v= ++LastVersion;
+    return v;
+}
+
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL ()
-    : _rows(0), _cols(0), nnz_( 0), version_(1), _rowbeg( new size_t[1]), _colind(0), _val(0)
+    : _rows(0), _cols(0), nnz_( 0), version_( NewVersion()), _rowbeg( new size_t[1]), _colind(0), _val(0)
 {
     _rowbeg[0]= 0;
 }
@@ -700,7 +805,7 @@ template <typename T>
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL (size_t rows, size_t cols, size_t nnz)
-    : _rows( rows), _cols( cols), nnz_( nnz), version_( 1),
+    : _rows( rows), _cols( cols), nnz_( nnz), version_( NewVersion()),
       _rowbeg( new size_t[rows+1]), _colind( new size_t[nnz]), _val( new T[nnz])
 {
     // std::memset( _rowbeg, 0, (_rows + 1)*sizeof( size_t));
@@ -711,7 +816,7 @@ template <typename T>
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL (size_t rows, size_t cols, size_t nnz,
     const T* valbeg , const size_t* rowbeg, const size_t* colindbeg)
-    : _rows(rows), _cols(cols), nnz_(nnz), version_( 1),
+    : _rows(rows), _cols(cols), nnz_(nnz), version_( NewVersion()),
       _rowbeg( new size_t[rows+1]), _colind( new size_t[nnz]), _val( new T[nnz])
 {
     std::copy( rowbeg, rowbeg + num_rows() + 1, raw_row());
@@ -721,7 +826,7 @@ template <typename T>
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL(const std::valarray<T>& v)
-      : _rows( v.size()), _cols( v.size()), nnz_( v.size()), version_( 1),
+      : _rows( v.size()), _cols( v.size()), nnz_( v.size()), version_( NewVersion()),
         _rowbeg( new size_t[v.size() + 1]), _colind( new size_t[v.size()]), _val( new T[v.size()])
 {
     for (size_t i= 0; i < _rows; ++i)
@@ -811,11 +916,16 @@ template <typename T>
 VectorBaseCL<T> SparseMatBaseCL<T>::GetSchurDiag( const VectorBaseCL<T>& W) const
 /// In parallel, this function may not work as expected
 {
-    const size_t n=num_rows(),
-        nnz=num_nonzeros();
+    const size_t n=num_rows();
     VectorBaseCL<T> diag(n);
-    for (size_t r= 0, nz= 0; nz < nnz; ++r)
-        for (; nz < _rowbeg[ r + 1]; ++nz) {
+#ifndef DROPS_WIN
+    size_t r;
+#else
+    int r;
+#endif
+#   pragma omp parallel for
+    for (r= 0; r < n; ++r)
+        for (size_t nz= _rowbeg[r]; nz < _rowbeg[r + 1]; ++nz) {
             const double v= _val[nz];
             diag[r]+= v*v*W[_colind[nz]];
         }
@@ -1229,9 +1339,9 @@ SparseMatBaseCL<T>& SparseMatBaseCL<T>::LinComb (double coeffA, const SparseMatB
                                                  double coeffB, const SparseMatBaseCL<T>& B,
                                                  double coeffC, const SparseMatBaseCL<T>& C)
 {
-    SparseMatBaseCL<T> tmp;
-    tmp.LinComb( coeffA, A, coeffB, B);
-    return this->LinComb( 1.0, tmp, coeffC, C);
+    const double coeff[3]= { coeffA, coeffB, coeffC };
+    const SparseMatBaseCL<T>* M[3]= { &A, &B, &C };
+    return LinCombN( 3, coeff, M);
 }
 
 /// \brief Compute the linear combination of four sparse matrices.
@@ -1241,9 +1351,75 @@ SparseMatBaseCL<T>& SparseMatBaseCL<T>::LinComb (double coeffA, const SparseMatB
                                                  double coeffC, const SparseMatBaseCL<T>& C,
                                                  double coeffD, const SparseMatBaseCL<T>& D)
 {
-    SparseMatBaseCL<T> tmp;
-    tmp.LinComb( coeffA, A, coeffB, B, coeffC, C);
-    return this->LinComb( 1.0, tmp, coeffD, D);
+    const double coeff[4]= { coeffA, coeffB, coeffC, coeffD };
+    const SparseMatBaseCL<T>* M[4]= { &A, &B, &C, &D };
+    return LinCombN( 4, coeff, M);
+}
+
+/// \brief Compute the linear combination of n<=4 sparse matrices without temporary matrices.
+/// The rows of the matrices are merged simultaneously; like LinComb for two matrices, the pattern
+/// is counted and filled in parallel.
+template <typename T>
+SparseMatBaseCL<T>& SparseMatBaseCL<T>::LinCombN (Uint n, const double* coeff, const SparseMatBaseCL<T>* const* M)
+{
+    for (Uint k= 1; k < n; ++k)
+        Assert( M[0]->num_rows()==M[k]->num_rows() && M[0]->num_cols()==M[k]->num_cols(),
+                "LinComb: incompatible dimensions", DebugNumericC);
+
+    IncrementVersion();
+    Comment( "LinComb: Creating NEW matrix" << std::endl, DebugNumericC);
+    num_rows( M[0]->num_rows());
+    num_cols( M[0]->num_cols());
+    _rowbeg[0]= 0;
+    size_t* t_sum= new size_t[omp_get_max_threads()];
+
+#ifndef DROPS_WIN
+    size_t row;
+#else
+    int row;
+#endif
+    const size_t none= std::numeric_limits<size_t>::max();
+#   pragma omp parallel
+    {
+        size_t pos[4], end[4];
+        for (int pass= 0; pass < 2; ++pass) {
+#           pragma omp for
+            for (row= 0; row < num_rows(); ++row) {
+                for (Uint k= 0; k < n; ++k) {
+                    pos[k]= M[k]->row_beg( row);
+                    end[k]= M[k]->row_beg( row + 1);
+                }
+                size_t i= pass == 0 ? 0 : _rowbeg[row];
+                for (;; ++i) {
+                    size_t col= none;
+                    for (Uint k= 0; k < n; ++k)
+                        if (pos[k] != end[k] && M[k]->col_ind( pos[k]) < col)
+                            col= M[k]->col_ind( pos[k]);
+                    if (col == none)
+                        break;
+                    T v= T();
+                    for (Uint k= 0; k < n; ++k)
+                        if (pos[k] != end[k] && M[k]->col_ind( pos[k]) == col)
+                            v+= coeff[k]*M[k]->val( pos[k]++);
+                    if (pass == 1) {
+                        _colind[i]= col;
+                        _val[i]= v;
+                    }
+                }
+                if (pass == 0)
+                    _rowbeg[row + 1]= i;
+            }
+            if (pass == 0) {
+                inplace_parallel_partial_sum( _rowbeg, _rowbeg + num_rows() + 1, t_sum);
+#               pragma omp barrier
+#               pragma omp master
+                    num_nonzeros( row_beg( num_rows()));
+#               pragma omp barrier
+            }
+        }
+    } // end of omp parallel
+    delete [] t_sum;
+    return *this;
 }
 
 /// \brief Inserts v as column c. The old columns [c, num_cols()) are shifted to the right.
@@ -1313,17 +1489,246 @@ SparseMatBaseCL<T>::insert_col (size_t c, const VectorBaseCL<T>& v)
 
 
 /// \brief Compute the transpose matrix of M explicitly.
-/// This could be handled more memory-efficient by exploiting
-/// that the column-indices in the rows of M are ascending.
+/// The rows of M are split into one contiguous chunk per thread. Each thread counts the entries of
+/// its chunk per column of M; from these counts, each thread obtains the positions of its entries in
+/// Mt and copies them there. As the chunks are ordered, the column indices of Mt are ascending.
 template <typename T>
 void
 transpose (const SparseMatBaseCL<T>& M, SparseMatBaseCL<T>& Mt)
 {
-    SparseMatBuilderCL<T> Tr( &Mt, M.num_cols(), M.num_rows());
-    for (size_t i= 0; i< M.num_rows(); ++i)
-        for (size_t nz= M.row_beg( i); nz < M.row_beg( i + 1); ++nz)
-            Tr( M.col_ind( nz), i)= M.val( nz);
-    Tr.Build();
+    const size_t rows= M.num_rows(),
+                 cols= M.num_cols();
+    Mt.resize( cols, rows, M.num_nonzeros());
+    size_t*  rb= Mt.raw_row();
+    size_t*  ci= Mt.raw_col();
+    T*       v=  Mt.raw_val();
+    rb[0]= 0;
+
+    std::vector<size_t> cnt( omp_get_max_threads()*cols);
+    size_t* t_sum= new size_t[omp_get_max_threads()];
+#   pragma omp parallel
+    {
+        const size_t num_threads= omp_get_num_threads(),
+                     tid= omp_get_thread_num(),
+                     rbegin= (tid*rows)/num_threads,
+                     rend= ((tid + 1)*rows)/num_threads,
+                     cbegin= (tid*cols)/num_threads,
+                     cend= ((tid + 1)*cols)/num_threads;
+        size_t* const t_cnt= Addr( cnt) + tid*cols;
+
+        // number of entries of the chunk of the thread in each column
+        for (size_t nz= M.row_beg( rbegin); nz < M.row_beg( rend); ++nz)
+            ++t_cnt[M.col_ind( nz)];
+#       pragma omp barrier
+        // offsets of the threads within the rows of Mt and the row lengths of Mt
+        for (size_t c= cbegin; c < cend; ++c) {
+            size_t sum= 0;
+            for (size_t t= 0; t < num_threads; ++t) {
+                const size_t tmp= cnt[t*cols + c];
+                cnt[t*cols + c]= sum;
+                sum+= tmp;
+            }
+            rb[c + 1]= sum;
+        }
+#       pragma omp barrier
+        inplace_parallel_partial_sum( rb, rb + cols + 1, t_sum);
+#       pragma omp barrier
+        for (size_t i= rbegin; i < rend; ++i)
+            for (size_t nz= M.row_beg( i); nz < M.row_beg( i + 1); ++nz) {
+                const size_t pos= rb[M.col_ind( nz)] + t_cnt[M.col_ind( nz)]++;
+                ci[pos]= i;
+                v[pos]= M.val( nz);
+            }
+    } // end of omp parallel
+    delete[] t_sum;
+}
+
+/*******************************************************************
+*   S P A R S E M A T P R O D U C T C L                            *
+*******************************************************************/
+/// \brief Sparse matrix-matrix product C= A*B in a symbolic and a numeric phase.
+/** The symbolic phase computes the sparsity pattern of C row by row with a marker array per thread;
+    the numeric phase computes the values with a dense accumulator per thread. The pattern is kept
+    and the symbolic phase is skipped as long as the patterns of A and B do not change, e.g., for the
+    Galerkin coarse grid operators P^T A P or the Schur complement approximations B M^{-1} B^T after
+    a change of the coefficients. Both phases are parallelized with OpenMP over the rows of C. */
+/*******************************************************************
+*   S P A R S E M A T P R O D U C T C L                            *
+*******************************************************************/
+template <typename T= double>
+class SparseMatProductCL
+{
+  private:
+    std::vector<size_t> Arow_, Acol_, Brow_, Bcol_; ///< patterns of A and B of the last symbolic phase
+    size_t              Bcols_;                     ///< number of columns of B
+    std::vector<size_t> Crow_, Ccol_;               ///< pattern of C
+    size_t              numSymbolic_,               ///< number of symbolic phases
+                        numNumeric_;                ///< number of numeric phases
+
+    /// \brief Count the entries of the rows of C (count==true) or store their column indices.
+    void Pattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, bool count);
+
+  public:
+    SparseMatProductCL () : Bcols_( 0), numSymbolic_( 0), numNumeric_( 0) {}
+
+    /// \brief True, if A and B have the patterns of the last symbolic phase.
+    bool SamePattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B) const;
+    /// \brief Computes the pattern of A*B.
+    void Symbolic (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B);
+    /// \brief Computes C= A*B with the pattern of the last symbolic phase.
+    void Numeric  (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C);
+    /// \brief Computes C= A*B; the symbolic phase is only performed, if the pattern of A or B has changed.
+    void Multiply (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C) {
+        if (!SamePattern( A, B))
+            Symbolic( A, B);
+        Numeric( A, B, C);
+    }
+    /// \brief Releases the pattern.
+    void Clear ();
+
+    size_t GetNumSymbolic () const { return numSymbolic_; }
+    size_t GetNumNumeric  () const { return numNumeric_; }
+};
+
+template <typename T>
+bool SparseMatProductCL<T>::SamePattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B) const
+{
+    return !Crow_.empty() && Bcols_ == B.num_cols()
+        && Arow_.size() == A.num_rows() + 1 && Acol_.size() == A.num_nonzeros()
+        && Brow_.size() == B.num_rows() + 1 && Bcol_.size() == B.num_nonzeros()
+        && std::equal( Arow_.begin(), Arow_.end(), A.raw_row()) && std::equal( Acol_.begin(), Acol_.end(), A.raw_col())
+        && std::equal( Brow_.begin(), Brow_.end(), B.raw_row()) && std::equal( Bcol_.begin(), Bcol_.end(), B.raw_col());
+}
+
+template <typename T>
+void SparseMatProductCL<T>::Pattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, bool count)
+{
+    const size_t rows= A.num_rows();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel
+    {
+        std::vector<size_t> mark( B.num_cols(), std::numeric_limits<size_t>::max());
+#       pragma omp for schedule(dynamic, 64)
+        for (i= 0; i < rows; ++i) {
+            size_t n= 0;
+            for (size_t k= A.row_beg( i); k < A.row_beg( i + 1); ++k) {
+                const size_t j= A.col_ind( k);
+                for (size_t l= B.row_beg( j); l < B.row_beg( j + 1); ++l)
+                    if (mark[B.col_ind( l)] != size_t( i)) {
+                        mark[B.col_ind( l)]= i;
+                        if (!count)
+                            Ccol_[Crow_[i] + n]= B.col_ind( l);
+                        ++n;
+                    }
+            }
+            if (count)
+                Crow_[i + 1]= n;
+            else
+                std::sort( Ccol_.begin() + Crow_[i], Ccol_.begin() + Crow_[i + 1]);
+        }
+    } // end of omp parallel
+}
+
+template <typename T>
+void SparseMatProductCL<T>::Symbolic (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B)
+{
+    Assert( A.num_cols() == B.num_rows(), DROPSErrCL( "SparseMatProductCL::Symbolic: incompatible dimensions"), DebugNumericC);
+    Arow_.assign( A.raw_row(), A.raw_row() + A.num_rows() + 1);
+    Acol_.assign( A.raw_col(), A.raw_col() + A.num_nonzeros());
+    Brow_.assign( B.raw_row(), B.raw_row() + B.num_rows() + 1);
+    Bcol_.assign( B.raw_col(), B.raw_col() + B.num_nonzeros());
+    Bcols_= B.num_cols();
+
+    Crow_.assign( A.num_rows() + 1, 0);
+    Pattern( A, B, /*count*/ true);
+    std::partial_sum( Crow_.begin(), Crow_.end(), Crow_.begin());
+    Ccol_.resize( Crow_.back());
+    Pattern( A, B, /*count*/ false);
+    ++numSymbolic_;
+}
+
+template <typename T>
+void SparseMatProductCL<T>::Numeric (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C)
+{
+    const size_t rows= A.num_rows();
+    if (C.num_rows() != rows || C.num_cols() != Bcols_ || C.num_nonzeros() != Ccol_.size()
+        || !std::equal( Crow_.begin(), Crow_.end(), C.raw_row()) || !std::equal( Ccol_.begin(), Ccol_.end(), C.raw_col())) {
+        C.resize( rows, Bcols_, Ccol_.size());
+        std::copy( Crow_.begin(), Crow_.end(), C.raw_row());
+        std::copy( Ccol_.begin(), Ccol_.end(), C.raw_col());
+    }
+    else
+        C.IncrementVersion();
+    T* const val= C.raw_val();
+
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel
+    {
+        std::vector<T> w( Bcols_, T());
+#       pragma omp for schedule(dynamic, 64)
+        for (i= 0; i < rows; ++i) {
+            for (size_t k= A.row_beg( i); k < A.row_beg( i + 1); ++k) {
+                const size_t j= A.col_ind( k);
+                const T a= A.val( k);
+                for (size_t l= B.row_beg( j); l < B.row_beg( j + 1); ++l)
+                    w[B.col_ind( l)]+= a*B.val( l);
+            }
+            for (size_t k= Crow_[i]; k < Crow_[i + 1]; ++k) {
+                val[k]= w[Ccol_[k]];
+                w[Ccol_[k]]= T();
+            }
+        }
+    } // end of omp parallel
+    ++numNumeric_;
+}
+
+template <typename T>
+void SparseMatProductCL<T>::Clear ()
+{
+    Arow_.clear(); Acol_.clear();
+    Brow_.clear(); Bcol_.clear();
+    Crow_.clear(); Ccol_.clear();
+    Bcols_= 0;
+}
+
+/// \brief Computes C= A*B, see SparseMatProductCL.
+template <typename T>
+inline void
+mat_mul (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C)
+{
+    SparseMatProductCL<T> prod;
+    prod.Multiply( A, B, C);
+}
+
+/// \brief Computes the Galerkin product Ac= P^T A P; Pt is the transpose of P.
+template <typename T>
+inline void
+galerkin_product (const SparseMatBaseCL<T>& Pt, const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& P,
+    SparseMatBaseCL<T>& Ac)
+{
+    SparseMatBaseCL<T> AP;
+    mat_mul( A, P, AP);
+    mat_mul( Pt, AP, Ac);
+}
+
+/// \brief Computes S= B diag(d) B^T; Bt is the transpose of B.
+///
+/// With d= diag(M)^{-1}, this is the usual approximation of the Schur complement B M^{-1} B^T.
+template <typename T>
+inline void
+BDBT (const SparseMatBaseCL<T>& B, const SparseMatBaseCL<T>& Bt, const VectorBaseCL<T>& d, SparseMatBaseCL<T>& S)
+{
+    SparseMatBaseCL<T> DBt( Bt);
+    ScaleRows( DBt, d);
+    mat_mul( B, DBt, S);
 }
 
 
@@ -1339,7 +1744,13 @@ BBTDiag (const SparseMatBaseCL<T>& B /*, const VectorBaseCL<T>& Mdiaginv*/)
     VectorBaseCL<T> ret( B.num_rows());
 
     T Bik;
-    for (size_t i= 0; i < B.num_rows(); ++i) {
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for private(Bik)
+    for (i= 0; i < B.num_rows(); ++i) {
         for (size_t l= B.row_beg( i); l < B.row_beg( i + 1); ++l) {
             Bik= B.val( l);
             ret[i]+= /*Mdiaginv[B.col_ind( l)]**/ Bik*Bik;
@@ -1382,11 +1793,22 @@ y_Ax(T* __restrict y,
 }
 
 
+/// \brief Counts a sparse matrix-vector product and the bytes of the matrix and the vectors it reads and writes.
+template <typename _MatEntry, typename _VecEntry>
+inline void
+count_spmv (const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>&)
+{
+    DROPS_COUNT( "SpMV", 1.);
+    DROPS_COUNT( "SpMV bytes", A.num_nonzeros()*(sizeof( _MatEntry) + sizeof( size_t))
+        + (A.num_rows() + 1)*sizeof( size_t) + (A.num_rows() + A.num_cols())*sizeof( _VecEntry));
+}
+
 template <typename _MatEntry, typename _VecEntry>
 VectorBaseCL<_VecEntry> operator * (const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
 {
     VectorBaseCL<_VecEntry> ret( A.num_rows());
     Assert( A.num_cols()==x.size(), "SparseMatBaseCL * VectorBaseCL: incompatible dimensions", DebugNumericC);
+    count_spmv( A, x);
     y_Ax( &ret[0],
           A.num_rows(),
           A.raw_val(),
@@ -1424,6 +1846,7 @@ VectorBaseCL<_VecEntry> transp_mul (const SparseMatBaseCL<_MatEntry>& A, const V
 {
     VectorBaseCL<_VecEntry> ret( A.num_cols());
     Assert( A.num_rows()==x.size(), "transp_mul: incompatible dimensions", DebugNumericC);
+    count_spmv( A, x);
     y_ATx( &ret[0],
            A.num_rows(),
            A.raw_val(),
@@ -1433,6 +1856,58 @@ VectorBaseCL<_VecEntry> transp_mul (const SparseMatBaseCL<_MatEntry>& A, const V
     return ret;
 }
 
+/// \brief Resizes v to n components, if its size differs from n; otherwise, the storage and the values are kept.
+///
+/// Used for work vectors, which persist across many calls of a preconditioner.
+template <typename T>
+inline void
+resize_work (VectorBaseCL<T>& v, size_t n)
+{
+    if (v.size() != n)
+        v.resize( n);
+}
+
+/// \brief y= A*x in the existing storage of y; y is only reallocated, if its size differs from the number of rows of A.
+///
+/// y and x must not alias.
+template <typename _MatEntry, typename _VecEntry>
+inline void
+y_Ax (VectorBaseCL<_VecEntry>& y, const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    Assert( A.num_cols()==x.size(), "y_Ax: incompatible dimensions", DebugNumericC);
+    resize_work( y, A.num_rows());
+    if (A.num_rows() == 0)
+        return;
+    count_spmv( A, x);
+    y_Ax( &y[0],
+          A.num_rows(),
+          A.raw_val(),
+          A.raw_row(),
+          A.raw_col(),
+          Addr( x));
+}
+
+/// \brief y= A^T*x in the existing storage of y; y is only reallocated, if its size differs from the number of columns of A.
+///
+/// y and x must not alias.
+template <typename _MatEntry, typename _VecEntry>
+inline void
+y_ATx (VectorBaseCL<_VecEntry>& y, const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    Assert( A.num_rows()==x.size(), "y_ATx: incompatible dimensions", DebugNumericC);
+    resize_work( y, A.num_cols());
+    y= _VecEntry();
+    if (A.num_rows() == 0)
+        return;
+    count_spmv( A, x);
+    y_ATx( &y[0],
+           A.num_rows(),
+           A.raw_val(),
+           A.raw_row(),
+           A.raw_col(),
+           Addr( x));
+}
+
 template <typename _VecEntry>
 VectorBaseCL<_VecEntry>
 operator* (const VectorAsDiagMatrixBaseCL<_VecEntry>& A,
@@ -1571,6 +2046,56 @@ VectorBaseCL<_VecEntry> operator* (const MLSparseMatBaseCL<_MatEntry>& A, const
     return A.GetFinest()*x;
 }
 
+template <typename _MatEntry, typename _VecEntry>
+inline void
+y_Ax (VectorBaseCL<_VecEntry>& y, const MLSparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    y_Ax( y, A.GetFinest(), x);
+}
+
+template <typename _MatEntry, typename _VecEntry>
+inline void
+y_ATx (VectorBaseCL<_VecEntry>& y, const MLSparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    y_ATx( y, A.GetFinest(), x);
+}
+
+//=============================================================================
+//  Conversion between value types, e.g. single precision copies for preconditioners
+//=============================================================================
+
+/// \brief Copies x into y, which may have another value type; y is only reallocated, if the sizes differ.
+template <typename T, typename U>
+inline void
+convert_vector (VectorBaseCL<T>& y, const VectorBaseCL<U>& x)
+{
+    resize_work( y, x.size());
+    if (x.size() > 0)
+        std::copy( Addr( x), Addr( x) + x.size(), &y[0]);
+}
+
+/// \brief Copies M into A, which may have another value type; the version of A is incremented.
+template <typename T, typename U>
+void
+convert_matrix (SparseMatBaseCL<T>& A, const SparseMatBaseCL<U>& M)
+{
+    A.resize( M.num_rows(), M.num_cols(), M.num_nonzeros());
+    std::copy( M.raw_row(), M.raw_row() + M.num_rows() + 1, A.raw_row());
+    std::copy( M.raw_col(), M.raw_col() + M.num_nonzeros(), A.raw_col());
+    std::copy( M.raw_val(), M.raw_val() + M.num_nonzeros(), A.raw_val());
+}
+
+/// \brief Copies all levels of M into A, which may have another value type.
+template <typename T, typename U>
+void
+convert_matrix (MLSparseMatBaseCL<T>& A, const MLSparseMatBaseCL<U>& M)
+{
+    A.resize( M.size());
+    typename MLSparseMatBaseCL<T>::iterator it= A.begin();
+    for (typename MLSparseMatBaseCL<U>::const_iterator mit= M.begin(); mit != M.end(); ++mit, ++it)
+        convert_matrix( *it, *mit);
+}
+
 //Human Readable
 template <typename T>
 std::ostream& operator << (std::ostream& os, const MLSparseMatBaseCL<T>& A)
@@ -1589,6 +2114,83 @@ typedef SparseMatBaseCL<double>          MatrixCL;
 typedef SparseMatBuilderCL<>             MatrixBuilderCL;
 typedef VectorAsDiagMatrixBaseCL<double> VectorAsDiagMatrixCL;
 typedef MLSparseMatBaseCL<double>        MLMatrixCL;
+
+typedef VectorBaseCL<float>              FloatVectorCL;   ///< single precision vectors for preconditioners
+typedef SparseMatBaseCL<float>           FloatMatrixCL;   ///< single precision matrices for preconditioners
+typedef MLSparseMatBaseCL<float>         MLFloatMatrixCL; ///< single precision multilevel matrices for preconditioners
+
+/// \brief Single precision copy of a (multilevel) matrix, e.g. for a preconditioner.
+///
+/// Get() converts the matrix, if it differs from the matrix of the last call or if the version of one of its levels changed.
+/// As the versions of SparseMatBaseCL are globally unique, a matrix rebuilt at the address of the converted one is converted again.
+class FloatMatrixCacheCL
+{
+  private:
+    const void*         src_;      ///< address of the converted matrix
+    std::vector<size_t> versions_; ///< versions of the levels of the converted matrix
+    MLFloatMatrixCL     mat_;
+
+    template <class MLMatT>
+    bool Changed (const MLMatT& M) const {
+        if (&M != src_ || M.size() != versions_.size())
+            return true;
+        std::vector<size_t>::const_iterator v= versions_.begin();
+        for (typename MLMatT::const_iterator it= M.begin(); it != M.end(); ++it, ++v)
+            if (it->Version() != *v)
+                return true;
+        return false;
+    }
+    template <class MLMatT>
+    void Store (const MLMatT& M) {
+        src_= &M;
+        versions_.clear();
+        for (typename MLMatT::const_iterator it= M.begin(); it != M.end(); ++it)
+            versions_.push_back( it->Version());
+    }
+
+  public:
+    FloatMatrixCacheCL () : src_( 0) {}
+
+    const FloatMatrixCL& Get (const MatrixCL& M) {
+        if (&M != src_ || versions_.size() != 1 || versions_[0] != M.Version()) {
+            mat_.resize( 1);
+            convert_matrix( mat_.GetFinest(), M);
+            src_= &M;
+            versions_.assign( 1, M.Version());
+        }
+        return mat_.GetFinest();
+    }
+    const MLFloatMatrixCL& Get (const MLMatrixCL& M) {
+        if (Changed( M)) {
+            convert_matrix( mat_, M);
+            Store( M);
+        }
+        return mat_;
+    }
+    /// \brief Returns the last converted copy without checking the versions of the source.
+    const MLFloatMatrixCL& GetLast () const { return mat_; }
+    /// \brief Releases the copy; the next call of Get() converts again.
+    void Clear () { src_= 0; versions_.clear(); mat_.resize( 1); mat_.GetFinest().clear(); }
+};
+
+/// \brief Advances the reference values ref of an update with SparseMatPatchCL towards the new values x.
+///
+/// Copies the blocks of blocksize unknowns (e.g. the three components of a velocity), in which x differs from ref by
+/// more than tol in the euclidean norm, to ref. An update from the old ref to the advanced ref with tolerance 0 is
+/// exact and differs from a complete setup for x only by the changes below tol; these changes cannot accumulate over
+/// several updates, as they stay in the difference between ref and x.
+inline void AdvanceTrackingReference (VectorCL& ref, const VectorCL& x, double tol, size_t blocksize= 1)
+{
+    for (size_t i= 0; i < x.size(); i+= blocksize) {
+        double d= 0.;
+        for (size_t j= i; j < i + blocksize; ++j)
+            d+= (x[j] - ref[j])*(x[j] - ref[j]);
+        if (d > tol*tol)
+            for (size_t j= i; j < i + blocksize; ++j)
+                ref[j]= x[j];
+    }
+}
+
 } // end of namespace DROPS
 
 #endif
@@ -355,17 +355,26 @@ class BlockMatrixSolverCL: public StokesSolverBaseCL
     }
 };
 
+/// Persistent work vectors of BlockPreCL; they are passed to the preconditioning strategies, such that repeated applications do not allocate memory.
+template <class Vec>
+struct BlockPreWorkCL
+{
+    Vec b0, b1, x0, x1; ///< blocks of the right hand side and of the solution for BlockMatrixBaseCL
+    Vec u, q, dp;       ///< velocity, pressure and pressure correction work vectors of the strategies
+};
+
 /// Upper block-triangular preconditioning strategy in BlockPreCL
 struct UpperBlockPreCL
 {
     template <class PC1T, class PC2T, class Mat, class Vec>
     static void
-    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) {
+    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c, BlockPreWorkCL<Vec>& w) {
         pc2.Apply( /*dummy*/ B, p, c);
         p*= -1.;
-        Vec b2( b);
-        b2-= transp_mul( B, p);
-        pc1.Apply( A, v, b2);
+        y_ATx( w.u, B, p);
+        w.u*= -1.;
+        w.u+= b;
+        pc1.Apply( A, v, w.u);
     }
 };
 
@@ -374,7 +383,7 @@ struct DiagBlockPreCL
 {
     template <class PC1T, class PC2T, class Mat, class Vec>
     static void
-    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) {
+    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c, BlockPreWorkCL<Vec>&) {
         pc1.Apply( A, v, b);
         pc2.Apply( /*dummy*/ B, p, c);
         p*= -1.;
@@ -386,7 +395,7 @@ struct DiagSpdBlockPreCL
 {
     template <class PC1T, class PC2T, class Mat, class Vec>
     static void
-    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) {
+    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c, BlockPreWorkCL<Vec>&) {
         pc1.Apply( A, v, b);
         pc2.Apply( /*dummy*/ B, p, c);
    }
@@ -397,13 +406,14 @@ struct LowerBlockPreCL
 {
     template <class PC1T, class PC2T, class Mat, class Vec>
     static void
-    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) {
+    Apply (const PC1T& pc1, const PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c, BlockPreWorkCL<Vec>& w) {
         pc1.Apply( A, v, b);
 #ifdef _PAR
         Assert(pc1.RetAcc(), DROPSErrCL("LowerBlockPreCL::Apply: Accumulation is missing"), DebugParallelNumC);
 #endif
-        Vec c2( B*v - c);
-        pc2.Apply( /*dummy*/ B, p, c2);
+        y_Ax( w.q, B, v);
+        w.q-= c;
+        pc2.Apply( /*dummy*/ B, p, w.q);
     }
 };
 
@@ -412,31 +422,46 @@ struct SIMPLERBlockPreCL
 {
     template <class PC1T, class PC2T, class Mat, class Vec>
     static void
-    Apply (PC1T& pc1, PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) {
-        Vec D( pc2.GetVelDiag()), dp(p);
-        
+    Apply (PC1T& pc1, PC2T& pc2, const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c, BlockPreWorkCL<Vec>& w) {
+        const Vec& Dinv= pc2.GetVelDiagInv();
+
         // find some initial pressure for the SIMPLER preconditioner (initial p=0 would result in SIMPLE)
-        pc2.Apply( B, p, Vec(B*Vec(b/D) - c));
+        resize_work( w.u, b.size());
+        w.u= b*Dinv;
+        y_Ax( w.q, B, w.u);
+        w.q-= c;
+        pc2.Apply( B, p, w.q);
         // from here on it's the SIMPLE preconditioner
-        pc1.Apply( A, v, Vec(b - transp_mul( B, p)));
+        y_ATx( w.u, B, p);
+        w.u*= -1.;
+        w.u+= b;
+        pc1.Apply( A, v, w.u);
 #ifdef _PAR
         Assert(pc1.RetAcc(), DROPSErrCL("SIMPLERBlockPreCL::Apply: Accumulation is missing"), DebugParallelNumC);
 #endif
-        pc2.Apply( /*dummy*/ B, dp, Vec(B*v - c));
-        v-= transp_mul( B, dp)/D;
-        p+= dp;
+        y_Ax( w.q, B, v);
+        w.q-= c;
+        resize_work( w.dp, p.size());
+        w.dp= p;
+        pc2.Apply( /*dummy*/ B, w.dp, w.q);
+        y_ATx( w.u, B, w.dp);
+        w.u*= Dinv;
+        v-= w.u;
+        p+= w.dp;
    }
 };
 
 // With BlockShapeT= DiagBlockPreCL, this is the diagonal PC ( pc1^(-1) 0 \\ 0 pc2^(-1) ),
 // else it is block-triangular:
 // Upper... ( pc1^(-1) B^T \\ 0 pc2^(-1) ), resp. lower: ( pc1^(-1) 0 \\ B pc2^(-1) )
+// The work vectors in work_ persist across the calls of Apply.
 template <class PC1T, class PC2T, class BlockShapeT= DiagBlockPreCL>
 class BlockPreCL
 {
   private:
     PC1T& pc1_; // Preconditioner for A.
     PC2T& pc2_; // Preconditioner for S.
+    mutable BlockPreWorkCL<VectorCL> work_;
 
   public:
     BlockPreCL (PC1T& pc1, PC2T& pc2)
@@ -445,19 +470,23 @@ class BlockPreCL
     template <typename Mat, typename Vec>
     void
     Apply(const Mat& A, const Mat& B, Vec& v, Vec& p, const Vec& b, const Vec& c) const {
-        BlockShapeT::Apply( pc1_, pc2_, A, B, v, p, b, c);
+        BlockShapeT::Apply( pc1_, pc2_, A, B, v, p, b, c, work_);
     }
 
     template <typename Mat, typename Vec>
     void
     Apply(const BlockMatrixBaseCL<Mat>& A, Vec& x, const Vec& b) const {
-        VectorCL b0( b[std::slice( 0, A.num_rows( 0), 1)]);
-        VectorCL b1( b[std::slice( A.num_rows( 0), A.num_rows( 1), 1)]);
-        VectorCL x0( A.num_cols( 0));
-        VectorCL x1( A.num_cols( 1));
-        BlockShapeT::Apply( pc1_, pc2_, *A.GetBlock( 0), *A.GetBlock( 2), x0, x1, b0, b1);
-        x[std::slice( 0, A.num_cols( 0), 1)]= x0;
-        x[std::slice( A.num_cols( 0), A.num_cols( 1), 1)]= x1;
+        resize_work( work_.b0, A.num_rows( 0));
+        resize_work( work_.b1, A.num_rows( 1));
+        work_.b0= b[std::slice( 0, A.num_rows( 0), 1)];
+        work_.b1= b[std::slice( A.num_rows( 0), A.num_rows( 1), 1)];
+        resize_work( work_.x0, A.num_cols( 0));
+        resize_work( work_.x1, A.num_cols( 1));
+        work_.x0= 0.;
+        work_.x1= 0.;
+        BlockShapeT::Apply( pc1_, pc2_, *A.GetBlock( 0), *A.GetBlock( 2), work_.x0, work_.x1, work_.b0, work_.b1, work_);
+        x[std::slice( 0, A.num_cols( 0), 1)]= work_.x0;
+        x[std::slice( A.num_cols( 0), A.num_cols( 1), 1)]= work_.x1;
     }
 
 #ifdef _PAR
@@ -541,6 +570,7 @@ class SchurComplMatrixCL
     PoissonSolverT& solver_;
     const Mat& A_;
     const Mat& B_;
+    mutable VectorCL x_, r_; ///< work vectors of operator*
 
   public:
     SchurComplMatrixCL(PoissonSolverT& solver, const Mat& A, const Mat& B)
@@ -554,11 +584,13 @@ class SchurComplMatrixCL
 template<class PoissonSolverT, class Mat>
 VectorCL operator*(const SchurComplMatrixCL<PoissonSolverT, Mat>& M, const VectorCL& v)
 {
-    VectorCL x( M.A_.num_cols());
-    M.solver_.Solve( M.A_, x, transp_mul( M.B_, v));
+    resize_work( M.x_, M.A_.num_cols());
+    M.x_= 0.;
+    y_ATx( M.r_, M.B_, v);
+    M.solver_.Solve( M.A_, M.x_, M.r_);
 //    std::cout << "> inner iterations: " << M.solver_.GetIter()
 //              << "\tresidual: " << M.solver_.GetResid() << std::endl;
-    return M.B_*x;
+    return M.B_*M.x_;
 }
 
 //=============================================================================
@@ -577,6 +609,7 @@ class SchurComplNoPcMatrixCL
     const Mat& _matA;
     const Mat&       _matB;
     double    _tol;
+    mutable VectorCL x_, r_; ///< work vectors of operator*
 
   public:
     SchurComplNoPcMatrixCL( const Mat& A, const Mat& B, double tol)
@@ -589,15 +622,17 @@ VectorCL operator* (const SchurComplNoPcMatrixCL<Mat>& M, const VectorCL& v)
 {
     double tol= M._tol;
     int maxiter= 1000;
-    VectorCL x( M._matA.num_cols());
+    resize_work( M.x_, M._matA.num_cols());
+    M.x_= 0.;
+    y_ATx( M.r_, M._matB, v);
 
-    CG(M._matA, x, transp_mul(M._matB, v), maxiter, tol);
+    CG(M._matA, M.x_, M.r_, maxiter, tol);
     if (maxiter > 990)
         Comment(     "VectorCL operator* (const SchurComplNoPcMatrixCL& M, const VectorCL& v): "
                   << "Needed more than 990 iterations! tol: " << tol << std::endl,
                   DebugNumericC);
 //    std::cout << "Inner iteration took " << maxiter << " steps, residuum is " << tol << std::endl;
-    return M._matB*x;
+    return M._matB*M.x_;
 }
 
 //=============================================================================
@@ -617,6 +652,7 @@ class ApproximateSchurComplMatrixCL
     const Mat& A_;
     APC& Apc_;
     const Mat& B_;
+    mutable VectorCL x_, r_; ///< work vectors of operator*
 
   public:
     ApproximateSchurComplMatrixCL(const Mat& A, APC& Apc, const Mat& B)
@@ -629,10 +665,11 @@ class ApproximateSchurComplMatrixCL
 template<typename APC, typename Mat>
 VectorCL operator*(const ApproximateSchurComplMatrixCL<APC, Mat>& M, const VectorCL& v)
 {
-    VectorCL x( 0.0, M.B_.num_cols());
-    VectorCL r= transp_mul( M.B_, v);
-    M.Apc_.Apply( M.A_, x, r);
-    return M.B_*x;
+    resize_work( M.x_, M.B_.num_cols());
+    M.x_= 0.;
+    y_ATx( M.r_, M.B_, v);
+    M.Apc_.Apply( M.A_, M.x_, M.r_);
+    return M.B_*M.x_;
 }
 
 //=============================================================================
@@ -1079,10 +1116,10 @@ UzawaPCG(const APC& Apc, const Mat& A, const Mat& B,
             z_xpay(p, z, (rho/rho_1), p); // p= z + (rho/rho_1)*p;
 
         // q= A*p;
-        q1= transp_mul( B, p);
+        y_ATx( q1, B, p);
         q2= 0.0;
         Apc.Apply( A, q2, q1);
-        q= B*q2;
+        y_Ax( q, B, q2);
 
         const double alpha= rho/dot( p, q);
         axpy(alpha, p, x);                // x+= alpha*p;
@@ -1126,6 +1163,7 @@ InexactUzawa(const Mat& A, const Mat& B, Vec& xu, Vec& xp, const Vec& f, const V
     VectorCL zhat( f.size());
     VectorCL du( f.size());
     VectorCL c( g.size());
+    VectorCL Adu( f.size());
     ApproximateSchurComplMatrixCL<PC1, Mat>* asc= apcmeth == APC_SYM_LINEAR ? 0 :
         new ApproximateSchurComplMatrixCL<PC1, Mat>( A, Apc, B);
     double innertol;
@@ -1147,7 +1185,8 @@ InexactUzawa(const Mat& A, const Mat& B, Vec& xu, Vec& xp, const Vec& f, const V
     for (int k= 1; k <= max_iter; ++k) {
         w= 0.0;
         Apc.Apply( A, w, ru);
-        c= B*w - rp;
+        y_Ax( c, B, w);
+        c-= rp;
         z= 0.0;
         z2= 0.0;
         inneriter= innermaxiter;
@@ -1172,7 +1211,7 @@ InexactUzawa(const Mat& A, const Mat& B, Vec& xu, Vec& xp, const Vec& f, const V
               break;
         }
         if (apcmeth != APC_SYM_LINEAR) {
-            zbar= transp_mul( B, z);
+            y_ATx( zbar, B, z);
             zhat= 0.0;
             Apc.Apply( A, zhat, zbar);
         }
@@ -1182,8 +1221,11 @@ InexactUzawa(const Mat& A, const Mat& B, Vec& xu, Vec& xp, const Vec& f, const V
         du= w - zhat;
         xu+= du;
         xp+= z;
-        ru-= A*du + zbar; // z_xpaypby2(ru, ru, -1.0, A*du, -1.0, zbar);
-        rp= g - B*xu;
+        y_Ax( Adu, A, du);
+        ru-= Adu + zbar; // z_xpaypby2(ru, ru, -1.0, A*du, -1.0, zbar);
+        y_Ax( rp, B, xu);
+        rp*= -1.;
+        rp+= g;
         resid= std::sqrt( norm_sq( ru) + norm_sq( rp));
         std::cout << "residual reduction (2-norm): " << resid/resid0
                   << "\nresidual (2-norm): " << resid
@@ -1430,8 +1472,6 @@ template <class ProlongationT>
 double
 EigenValueMaxMG(const MLMatrixCL& A, const ProlongationT& P, VectorCL& x, int iter, double  tol= 1e-3)
 {
-    MLMatrixCL::const_iterator finest= A.GetFinestIter();
-    typename ProlongationT::const_iterator finestP= P.GetFinestIter();
     Uint   sm   =  1; // how many smoothing steps?
     int    lvl  = -1; // how many levels? (-1=all)
     double omega= 1.; // relaxation parameter for smoother
@@ -1450,7 +1490,7 @@ EigenValueMaxMG(const MLMatrixCL& A, const ProlongationT& P, VectorCL& x, int it
     std::cout << "EigenValueMaxMG:\n";
     for (int i= 0; i<iter; ++i) {
         tmp= 0.0;
-        MGM( A.begin(), finest, finestP, tmp, A*x, smoother, sm, solver, lvl, -1);
+        MGM( A, P, A.size() - 1, tmp, A*x, smoother, sm, solver, lvl, -1);
         z= x - tmp;
         l= dot( x, z);
         std::cout << "iteration: " << i  << "\tlambda: " << l << "\trelative_change= : " << (i==0 ? -1 : std::fabs( (l-l_old)/l_old)) << '\n';
@@ -1497,13 +1537,11 @@ inline void
 ScaledMGPreCL<ProlongationT>::Apply( const MLMatrixCL& A, VectorCL& x, const VectorCL& r) const
 {
     x= 0.0;
-    MLMatrixCL::const_iterator finest = A.GetFinestIter();
-    typename ProlongationT::const_iterator finestP= P_.GetFinestIter();
     const double oldres= norm(r - A*x);
     for (Uint i= 0; i < iter_; ++i) {
         VectorCL r2( r - A*x);
         VectorCL dx( x.size());
-        MGM( A.begin(), finest, finestP, dx, r2, smoother_, sm_, solver_, lvl_, -1);
+        MGM( A, P_, A.size() - 1, dx, r2, smoother_, sm_, solver_, lvl_, -1);
         x+= dx*s_;
     }
     const double res= norm(r - A*x);
@@ -1560,20 +1598,13 @@ class StokesMGSolverCL: public StokesSolverBaseCL
         Uint   wc   = 1;   // how many W-cycle steps? (1=V-cycle)
 
 // define initial approximation
-        MLMatrixCL::const_iterator A_end   ( A.GetFinestIter());
-        MLMatrixCL::const_iterator B_end   ( B.GetFinestIter());
-        MLMatrixCL::const_iterator BT_end  ( BT_.GetFinestIter());
-        MLMatrixCL::const_iterator prM_end ( prM_.GetFinestIter());
-        typename PVelT::const_iterator PVel( PVel_.GetFinestIter());
-        typename PPrT::const_iterator  PPr ( PPr_.GetFinestIter());
-
         const double runorm0= norm_sq( A * v + transp_mul( B, p) - b);
         const double rpnorm0= norm_sq( B * v - c);
         const double resid0= std::sqrt(runorm0+rpnorm0);
         double resid;
         for (int j=0; j<_maxiter; ++j)
         {
-            StokesMGM( A.begin(), A_end, B_end, BT_end, prM_end, PVel, PPr, v, p, b, c, smoother_, smoothSteps_, wc, directSolver_, usedLevels_, -1);
+            StokesMGM( A, B, BT_, prM_, PVel_, PPr_, A.size() - 1, v, p, b, c, smoother_, smoothSteps_, wc, directSolver_, usedLevels_, -1);
             const double runorm= norm_sq( A * v + transp_mul(B, p ) - b);
             const double rpnorm= norm_sq( B * v - c);
             resid= std::sqrt(runorm+rpnorm);
@@ -24,14 +24,17 @@
 
 #ifndef _PAR
 #include "num/stokessolver.h"
+#include "num/fe.h"
 #else
 #include "num/parstokessolver.h"
+#include "num/parMGsolver.h"
 #ifdef _HYPRE
 #include "num/hypre.h"
 #endif
 #endif
 
 #include "misc/params.h"
+#include "num/sparsedirect.h"
 
 namespace DROPS {
 
@@ -42,7 +45,7 @@ enum OseenSolverE {
 
 /// codes for velocity preconditioners (also including smoothers for the StokesMGM_OS)
 enum APcE {
-    MG_APC= 1, MGsymm_APC= 2, PCG_APC= 3, GMRes_APC= 4, BiCGStab_APC= 5, VankaBlock_APC= 6, IDRs_APC=7, GS_GMRes_APC= 8, AMG_APC= 20, // preconditioners 
+    MG_APC= 1, MGsymm_APC= 2, PCG_APC= 3, GMRes_APC= 4, BiCGStab_APC= 5, VankaBlock_APC= 6, IDRs_APC=7, GS_GMRes_APC= 8, MGCheb_APC= 9, AMG_APC= 20, // preconditioners 
     PVanka_SM= 30, BraessSarazin_SM= 31 // smoothers, nevertheless listed here
 };
 
@@ -70,6 +73,7 @@ struct StokesSolverInfoCL
         switch(pre) {
             case MG_APC:           return "multigrid V-cycle";
             case MGsymm_APC:       return "symm. multigrid V-cycle";
+            case MGCheb_APC:       return "symm. multigrid V-cycle with Chebyshev smoother";
             case PCG_APC:          return "PCG iterations";
             case GMRes_APC:        return "Jacobi-GMRes iterations";
             case BiCGStab_APC:     return "BiCGStab iterations";
@@ -170,7 +174,7 @@ class StokesSolverFactoryHelperCL
     bool VelMGUsed ( const ParamCL& P) const
     {
         const int APc = GetAPc( P);
-        return (( APc == MG_APC) || (APc == MGsymm_APC) || (APc == PVanka_SM) || (APc == BraessSarazin_SM));
+        return (( APc == MG_APC) || (APc == MGsymm_APC) || (APc == MGCheb_APC) || (APc == PVanka_SM) || (APc == BraessSarazin_SM));
     }
     bool PrMGUsed  ( const ParamCL& P) const
     {
@@ -181,6 +185,17 @@ class StokesSolverFactoryHelperCL
 };
 
 #ifndef _PAR
+/// \brief The pressure prolongation of ISMGPreCL, which is always an MLMatrixCL; throws DROPSErrCL for MLProlongationCL.
+inline MLMatrixCL* GetISMGProlongation (ISMGPreCL& pc, MLMatrixCL*)
+{
+    return pc.GetProlongation();
+}
+
+inline MLProlongationCL* GetISMGProlongation (ISMGPreCL&, MLProlongationCL*)
+{
+    throw DROPSErrCL( "StokesSolverFactoryCL: ISMGPreCL needs the pressure prolongation as MLMatrixCL");
+}
+
 /*******************************************************************
 *   S t o k e s S o l v e r F a c t o r y  C L                     *
 ********************************************************************/
@@ -219,14 +234,24 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     // MultiGrid symm.
     SSORsmoothCL smoother_;
     PCG_SsorCL   coarsesolversymm_;
-    MGSolverCL<SSORsmoothCL, PCG_SsorCL, ProlongationVelT> MGSolversymm_;
-    typedef SolverAsPreCL<MGSolverCL<SSORsmoothCL, PCG_SsorCL, ProlongationVelT> > MGsymmPcT;
+    typedef CoarseGridSolverCL<PCG_SsorCL> CoarseSymmT;
+    CoarseSymmT  coarsesymm_;    // PCG or sparse direct solver
+    MGSolverCL<SSORsmoothCL, CoarseSymmT, ProlongationVelT> MGSolversymm_;
+    typedef SolverAsPreCL<MGSolverCL<SSORsmoothCL, CoarseSymmT, ProlongationVelT> > MGsymmPcT;
     MGsymmPcT MGPcsymm_;
 
+    // MultiGrid symm. with Chebyshev smoother
+    ChebyshevSmoothCL chebsmoother_;
+    MGSolverCL<ChebyshevSmoothCL, CoarseSymmT, ProlongationVelT> MGSolverCheb_;
+    typedef SolverAsPreCL<MGSolverCL<ChebyshevSmoothCL, CoarseSymmT, ProlongationVelT> > MGChebPcT;
+    MGChebPcT MGPcCheb_;
+
     // Multigrid nonsymm.
     GMResSolverCL<JACPcCL> coarsesolver_;
-    MGSolverCL<SSORsmoothCL, GMResSolverCL<JACPcCL>, ProlongationVelT > MGSolver_;
-    typedef SolverAsPreCL<MGSolverCL<SSORsmoothCL, GMResSolverCL<JACPcCL>, ProlongationVelT> > MGPcT;
+    typedef CoarseGridSolverCL<GMResSolverCL<JACPcCL> > CoarseT;
+    CoarseT coarse_;             // GMRes or sparse direct solver
+    MGSolverCL<SSORsmoothCL, CoarseT, ProlongationVelT > MGSolver_;
+    typedef SolverAsPreCL<MGSolverCL<SSORsmoothCL, CoarseT, ProlongationVelT> > MGPcT;
     MGPcT MGPc_;
 
     //JAC-GMRes
@@ -326,8 +351,15 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
 
     PreBaseCL*      CreateAPc();
     SchurPreBaseCL* CreateSPc();
+    /// Mode of the multigrid prolongations from Stokes.ProlongationMode
+    ProlongationCL::ModeT ProlongationMode() const { return ProlongationCL::ModeT( P_.template get<int>("Stokes.ProlongationMode", 0)); }
 
   public:
+    /// Besides the solver parameters, the optional parameters Stokes.PcRefreshTol and Stokes.PcRefreshMaxSkip (lazy refresh
+    /// of the Schur complement preconditioners and of the single precision copies of ISMGPreCL, cf. PcRefreshCL) and Stokes.Recycle (number of search directions of GCR and
+    /// GMResR recycled across solves, cf. KrylovRecycleCL) are read; their defaults 0, 10, 0 switch both off.
+    /// Stokes.ProlongationMode (default 0) selects the assembled (0) or the matrix-free (1) prolongation of the serial
+    /// multigrid solvers; 1 needs MLProlongationCL as ProlongationVelT and ProlongationPT, cf. UpdateProlongationCL.
     StokesSolverFactoryCL(StokesT& Stokes, ParamCL& P);
     ~StokesSolverFactoryCL();
 
@@ -369,10 +401,15 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
         isnonlinearpc_( isnonlinearprepc_, Stokes_.prA.Data.GetFinest(), Stokes_.prM.Data.GetFinest(), kA_, kM_),
         // preconditioner for A
         smoother_( 1.0), coarsesolversymm_( SSORPc_, 500, 1e-6, true),
-        MGSolversymm_ ( smoother_, coarsesolversymm_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), false),
+        coarsesymm_( coarsesolversymm_, P.get<int>("Stokes.DirectCoarseSolver", 0) != 0),
+        MGSolversymm_ ( smoother_, coarsesymm_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), false),
         MGPcsymm_( MGSolversymm_),
+        chebsmoother_( P.get<int>("Stokes.ChebyshevDegree", 2)),
+        MGSolverCheb_ ( chebsmoother_, coarsesymm_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), false),
+        MGPcCheb_( MGSolverCheb_),
         coarsesolver_( JACPc_, 500, 500, 1e-6, true),
-        MGSolver_ ( smoother_, coarsesolver_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), false), MGPc_( MGSolver_),
+        coarse_( coarsesolver_, P.get<int>("Stokes.DirectCoarseSolver", 0) != 0),
+        MGSolver_ ( smoother_, coarse_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), false), MGPc_( MGSolver_),
         GMResSolver_( JACPc_, P.get<int>("Stokes.PcAIter"), /*restart*/ 100, P.get<double>("Stokes.PcATol"), /*rel*/ true), GMResPc_( GMResSolver_),
         GS_GMResSolver_( GSPc_, P.get<int>("Stokes.PcAIter"), /*restart*/ 100, P.get<double>("Stokes.PcATol"), /*rel*/ true), GS_GMResPc_( GS_GMResSolver_),
         BiCGStabSolver_( JACPc_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), /*rel*/ true),BiCGStabPc_( BiCGStabSolver_),
@@ -400,6 +437,30 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
 {
     apc_= CreateAPc();
     spc_= CreateSPc();
+    // lazy refresh of the Schur complement preconditioners
+    const double refreshTol= P.get<double>( "Stokes.PcRefreshTol", 0.);
+    const int    maxSkip=    P.get<int>( "Stokes.PcRefreshMaxSkip", 10);
+    bbtispc_.SetRefreshTol( refreshTol, maxSkip);
+    mincommispc_.SetRefreshTol( refreshTol, maxSkip);
+    bdinvbtispc_.SetRefreshTol( refreshTol, maxSkip);
+    ismgpre_.SetRefreshTol( refreshTol, maxSkip);
+    // single precision multigrid and Schur complement preconditioners
+    const bool single= P.get<int>( "Stokes.SinglePrecisionPc", 0) != 0;
+    MGSolversymm_.SetSinglePrecision( single);
+    MGSolverCheb_.SetSinglePrecision( single);
+    MGSolver_.SetSinglePrecision( single);
+    isprepc_.SetSinglePrecision( single);
+    ismgpre_.SetSinglePrecision( single);
+    // cycle type of the multigrid preconditioners: 1: V-, 2: W-, 3: F-cycle
+    const MGCycleParamCL cycle( MGCycleT( P.get<int>( "Stokes.MGCycle", 1)), P.get<double>( "Stokes.MGSmoothGrowth", 1.));
+    MGSolversymm_.SetCycleParam( cycle);
+    MGSolverCheb_.SetCycleParam( cycle);
+    MGSolver_.SetCycleParam( cycle);
+    ismgpre_.SetCycleParam( cycle);
+    // prolongation (0: assembled, 1: matrix-free); the matrix-free mode needs ProlongationVelT= MLProlongationCL
+    SetProlongationMode( *MGSolversymm_.GetProlongation(), ProlongationMode());
+    SetProlongationMode( *MGSolverCheb_.GetProlongation(), ProlongationMode());
+    SetProlongationMode( *MGSolver_.GetProlongation(), ProlongationMode());
 }
 
 template <class StokesT, class ProlongationVelT, class ProlongationPT>
@@ -457,6 +518,7 @@ PreBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::Cre
     switch (APc_) {
         case MG_APC:       return &MGPc_;
         case MGsymm_APC:   return &MGPcsymm_;
+        case MGCheb_APC:   return &MGPcCheb_;
         case PCG_APC:      return &PCGPc_;
         case GMRes_APC:    return &GMResPc_;
         case GS_GMRes_APC: return &GS_GMResPc_;
@@ -503,7 +565,7 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
 
     switch (OseenSolver_) {
         case iUzawa_OS: {
-            if (APc_==MGsymm_APC) // symmetric A preconditionder -> use more efficient version of inexact Uzawa
+            if (APc_==MGsymm_APC || APc_==MGCheb_APC) // symmetric A preconditionder -> use more efficient version of inexact Uzawa
                 stokessolver= new InexactUzawaCL<PreBaseCL, SchurPreBaseCL, APC_SYM>  ( *apc_, *spc_, P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), P_.template get<double>("Stokes.InnerTol"), P_.template get<int>("Stokes.InnerIter"));
             else
                 stokessolver= new InexactUzawaCL<PreBaseCL, SchurPreBaseCL, APC_OTHER>( *apc_, *spc_, P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), P_.template get<double>("Stokes.InnerTol"), P_.template get<int>("Stokes.InnerIter"));
@@ -567,6 +629,8 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
                 else
                     mgvankasolver_ = new StokesMGSolverCL<PVankaSmootherCL, ProlongationVelT, ProlongationPT>
                                ( Stokes_.prM.Data, vankasmoother_, coarse_blockgcrsolver_, P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), false, 2);
+                SetProlongationMode( *mgvankasolver_->GetPVel(), ProlongationMode());
+                SetProlongationMode( *mgvankasolver_->GetPPr(),  ProlongationMode());
                 stokessolver = mgvankasolver_;
             }
             else if (APc_==BraessSarazin_SM) {
@@ -576,6 +640,8 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
                 else
                     mgbssolver_ = new StokesMGSolverCL<BSSmootherCL, ProlongationVelT, ProlongationPT>
                                ( Stokes_.prM.Data, bssmoother_, coarse_blockgcrsolver_, P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), false, 2);
+                SetProlongationMode( *mgbssolver_->GetPVel(), ProlongationMode());
+                SetProlongationMode( *mgbssolver_->GetPPr(),  ProlongationMode());
                 stokessolver = mgbssolver_;
             }
         }
@@ -602,6 +668,14 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
     }
     if (stokessolver==0)
         throw DROPSErrCL("StokesSolverFactoryCL: Sorry, this solver combination is not implemented, yet");
+
+    // search directions of GCR and GMResR carried over to the next solve
+    const int recycle= P_.template get<int>( "Stokes.Recycle", 0);
+    if (GCRLBlock_ != 0)    GCRLBlock_->SetRecycle( recycle);
+    if (GCRSBlock_ != 0)    GCRSBlock_->SetRecycle( recycle);
+    if (GCRVanka_ != 0)     GCRVanka_->SetRecycle( recycle);
+    if (GMResRLBlock_ != 0) GMResRLBlock_->SetRecycle( recycle);
+    if (GMResRVanka_ != 0)  GMResRVanka_->SetRecycle( recycle);
     return stokessolver;
 }
 
@@ -628,6 +702,7 @@ ProlongationVelT* StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationP
     switch ( APc_) {
         case MG_APC           : return MGSolver_.GetProlongation();     break;  // general MG
         case MGsymm_APC       : return MGSolversymm_.GetProlongation(); break;  // symm. MG
+        case MGCheb_APC       : return MGSolverCheb_.GetProlongation(); break;  // symm. MG, Chebyshev smoother
         case PVanka_SM        : return mgvankasolver_->GetPVel(); break;
         case BraessSarazin_SM : return mgbssolver_->GetPVel();    break;
         default: return 0;
@@ -643,7 +718,7 @@ ProlongationPT* StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>
         default: /*silence warning*/;
     }
     if (SPc_ == ISMG_SPC )
-        return ismgpre_.GetProlongation();
+        return GetISMGProlongation( ismgpre_, static_cast<ProlongationPT*>( 0));
     return 0;
 }
 
@@ -716,12 +791,25 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     PCGSolverT PCGSolver_;
     PCGPcT PCGPc_;
 
+    //MG with agglomerated coarse levels, solved by PCG or the sparse direct solver on the master process
+    SSORPcCL   SSORPc_;
+    PCG_SsorCL coarsesolver_;
+    typedef CoarseGridSolverCL<PCG_SsorCL> CoarseT;
+    CoarseT coarse_;
+    typedef ParMGSolverCL<CoarseT, ProlongationVelT> MGSolverT;
+    typedef SolverAsPreCL<MGSolverT> MGPcT;
+    MGSolverT MGSolver_;
+    MGPcT MGPc_;
+
 // BlockPC
     typedef BlockPreCL<GMResPcT, ISBBTPreCL, LowerBlockPreCL> LBlockGMResBBTOseenPcT;
     LBlockGMResBBTOseenPcT LBlockGMResBBTOseenPc_;
+    typedef BlockPreCL<MGPcT, ISBBTPreCL, LowerBlockPreCL> LBlockMGBBTOseenPcT;
+    LBlockMGBBTOseenPcT LBlockMGBBTOseenPc_;
 
 //GCR solver
     ParPreGCRSolverCL<LBlockGMResBBTOseenPcT> GCRGMResBBT_;
+    ParPreGCRSolverCL<LBlockMGBBTOseenPcT>    GCRMGBBT_;
 
 #ifdef _HYPRE
      //Algebraic MG solver
@@ -741,8 +829,8 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     void       SetMatrixA ( const MatrixCL*)  {};
     /// Nothing is to be done in parallel, because special preconditioners does not exist
     void       SetMatrices( const MLMatrixCL*, const MLMatrixCL*, const MLMatrixCL*, const MLMatrixCL*, const MLIdxDescCL*){}
-    /// Nothing is to be done in parallel, because special preconditioners does not exist
-    ProlongationVelT* GetPVel() { return 0; }
+    /// Returns pointer to prolongation for velocity, if the multigrid preconditioner is used
+    ProlongationVelT* GetPVel() { return (APc_ == MG_APC || APc_ == MGsymm_APC) ? MGSolver_.GetProlongation() : 0; }
     /// Nothing is to be done in parallel, because special preconditioners does not exist
     ProlongationPT*   GetPPr()  { return 0; }
     /// Returns a stokes solver with specifications from ParamsT C
@@ -766,8 +854,15 @@ template <class StokesT, class ProlongationVelT, class ProlongationPT>
       PCGSolver_(P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), Stokes.vel_idx.GetFinest(), JACVelPc_,
                  /*rel*/ true, /*acc*/ true),
       PCGPc_(PCGSolver_),
+      coarsesolver_( SSORPc_, 500, 1e-6, true),
+      coarse_( coarsesolver_, P.get<int>("Stokes.DirectCoarseSolver", 0) != 0),
+      MGSolver_( Stokes.vel_idx, coarse_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"),
+                 P.get<int>("Stokes.MGAgglomerationSize", 20000)),
+      MGPc_( MGSolver_),
       LBlockGMResBBTOseenPc_( GMResPc_, bbtispc_),
-      GCRGMResBBT_( P.get<int>("Stokes.OuterIter"), P.get<int>("Stokes.OuterIter"), P.get<double>("Stokes.OuterTol"), LBlockGMResBBTOseenPc_, true, false, true, &std::cout)
+      LBlockMGBBTOseenPc_( MGPc_, bbtispc_),
+      GCRGMResBBT_( P.get<int>("Stokes.OuterIter"), P.get<int>("Stokes.OuterIter"), P.get<double>("Stokes.OuterTol"), LBlockGMResBBTOseenPc_, true, false, true, &std::cout),
+      GCRMGBBT_( P.get<int>("Stokes.OuterIter"), P.get<int>("Stokes.OuterIter"), P.get<double>("Stokes.OuterTol"), LBlockMGBBTOseenPc_, true, false, true, &std::cout)
 #ifdef _HYPRE
       , hypreAMG_( Stokes.vel_idx.GetFinest(), P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol")), AMGPc_(hypreAMG_),
       LBlockAMGBBTOseenPc_( AMGPc_, bbtispc_),
@@ -781,6 +876,15 @@ template <class StokesT, class ProlongationVelT, class ProlongationPT>
     StokesSolverBaseCL* stokessolver = 0;
     switch (P_.template get<int>("Stokes.StokesMethod"))
     {
+        case 20201 :
+            stokessolver = new ParInexactUzawaCL<MGPcT, ISBBTPreCL, APC_SYM>
+                        ( MGPc_, bbtispc_, Stokes_.vel_idx.GetFinest(), Stokes_.pr_idx.GetFinest(),
+                          P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), P_.template get<double>("Stokes.InnerTol"), P_.template get<int>("Stokes.InnerIter"), &std::cout);
+        break;
+        case 10101 :
+            stokessolver = new BlockMatrixSolverCL<ParPreGCRSolverCL<LBlockMGBBTOseenPcT> >
+                        ( GCRMGBBT_, Stokes_.vel_idx.GetFinest(), Stokes_.pr_idx.GetFinest());
+        break;
         case 20301 :
             stokessolver = new ParInexactUzawaCL<PCGPcT, ISBBTPreCL, APC_SYM>
                         ( PCGPc_, bbtispc_, Stokes_.vel_idx.GetFinest(), Stokes_.pr_idx.GetFinest(),
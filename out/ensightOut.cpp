@@ -24,6 +24,7 @@
 
 #include "out/ensightOut.h"
 #include "num/discretize.h"
+#include "misc/instrument.h"
 
 namespace DROPS{
 
@@ -660,6 +661,7 @@ void Ensight6OutCL::DescribeVariable (std::string varName, bool isscalar)
 void
 Ensight6OutCL::Write (double t)
 {
+    DROPS_REGION( "EnsightOut");
     if (!putTime( t)) return;
     for( std::map<std::string,Ensight6VariableCL*>::iterator it= vars_.begin(); it != vars_.end(); ++it) {
         if (!it->second->is_geom()) continue;
@@ -0,0 +1,257 @@
+/// \file insituOut.cpp
+/// \brief in-situ reduced output: interface triangulation with sampled fields, point probes and integral quantities
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "out/insituOut.h"
+#include "misc/instrument.h"
+#include <cstdio>
+
+namespace DROPS
+{
+
+namespace {
+
+/// \brief Write the binary representation of n objects of type T to os.
+template <class T>
+inline void write_binary (std::ostream& os, const T* p, size_t n= 1)
+{
+    os.write( reinterpret_cast<const char*>( p), n*sizeof( T));
+}
+
+} // end of anonymous namespace
+
+InSituOutCL::InSituOutCL (const MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd,
+    const std::string& dirname, const std::string& filename, Uint numsteps, int lvl)
+    : mg_( mg), lset_( lset), lsetbnd_( lsetbnd), dirname_( dirname), filename_( filename),
+      timestep_( 0), lvl_( lvl), mgVersion_( 0), lsetIdx_( 0), lsetUnknowns_( 0)
+{
+    if (!dirname.empty() && *dirname.rbegin()!='/' )
+        dirname_+= '/';
+    decDigits_= 1;
+    while( numsteps>9){ ++decDigits_; numsteps/=10; }
+}
+
+InSituOutCL::~InSituOutCL ()
+{
+    for (VarContT::iterator it= vars_.begin(); it != vars_.end(); ++it)
+        delete *it;
+    for (IntegralContT::iterator it= integrals_.begin(); it != integrals_.end(); ++it)
+        delete *it;
+}
+
+void InSituOutCL::Register (InSituVariableCL& var)
+{
+    for (VarContT::const_iterator it= vars_.begin(); it != vars_.end(); ++it)
+        if ((*it)->varName() == var.varName()) {
+            std::cout << "Error! Variable name is used twice! No registration of the variable is carried out!" << std::endl;
+            return;
+        }
+    vars_.push_back( &var);
+}
+
+void InSituOutCL::Register (InSituIntegralCL& integral)
+{
+    integrals_.push_back( &integral);
+}
+
+void InSituOutCL::AddProbe (const Point3DCL& p)
+{
+    if (timestep_ != 0)
+        throw DROPSErrCL( "InSituOutCL::AddProbe: Probes must be added before the first call of Write.");
+    probes_.push_back( p);
+}
+
+void InSituOutCL::AppendTimecode( std::string& str) const
+/** Appends a time-code to the filename*/
+{
+    char format[]= "%0Xi",
+         postfix[8];
+    format[2]= '0' + char(decDigits_);
+    std::sprintf( postfix, format, timestep_);
+    str+= postfix;
+}
+
+void InSituOutCL::OpenFile( std::ofstream& os, const std::string& name, std::ios_base::openmode mode) const
+{
+    os.open( (dirname_+name).c_str(), mode);
+    if (!os) {
+        CreateDirectory( dirname_);
+        os.open( (dirname_+name).c_str(), mode);
+    }
+    if (!os)
+        throw DROPSErrCL( "InSituOutCL: error while opening file!");
+}
+
+void InSituOutCL::WriteDescriptor() const
+/** The descriptor lists the variables with their dimension, the probe points and the names of the integral quantities.*/
+{
+    std::ofstream os;
+    OpenFile( os, filename_ + ".isd", std::ios_base::out);
+    os << "# DROPS in-situ data set, step files: " << filename_ << "_<timecode>.ist\n";
+    os << "variables " << vars_.size() << '\n';
+    for (VarContT::const_iterator it= vars_.begin(); it != vars_.end(); ++it)
+        os << (*it)->varName() << ' ' << (*it)->GetDim() << '\n';
+    os << "probes " << probes_.size() << '\n';
+    for (Uint i= 0; i < probes_.size(); ++i)
+        os << i << ' ' << probes_[i] << '\n';
+    std::vector<std::string> names;
+    for (IntegralContT::const_iterator it= integrals_.begin(); it != integrals_.end(); ++it)
+        (*it)->names( names);
+    os << "integrals " << names.size() << '\n';
+    for (Uint i= 0; i < names.size(); ++i)
+        os << names[i] << '\n';
+}
+
+void InSituOutCL::ExtractInterface()
+/** For each child of each cut tetra the (one or two) triangles of the planar interface patch are stored
+    with unshared vertices; all variables are evaluated in these vertices.*/
+{
+    const int lvl= lvl_ < 0 ? static_cast<int>( lset_.GetLevel()) : lvl_;
+    InterfaceTriangleCL triangle;
+    std::vector<float> coords;
+    std::vector<std::vector<float> > values( vars_.size());
+    std::vector<float> buf;
+
+    DROPS_FOR_TRIANG_CONST_TETRA( mg_, lvl, it) {
+        triangle.Init( *it, lset_, lsetbnd_);
+        if (!triangle.Intersects())
+            continue;
+        for (VarContT::iterator var= vars_.begin(); var != vars_.end(); ++var)
+            (*var)->SetTetra( *it);
+
+        for (int ch= 0; ch < 8; ++ch) {
+            if (!triangle.ComputeForChild( ch)) // no patch for this child
+                continue;
+            for (int tri= 0; tri < triangle.GetNumTriangles(); ++tri)
+                for (int i= tri; i < tri + 3; ++i) {
+                    const Point3DCL& p= triangle.GetPoint( i);
+                    coords.insert( coords.end(), p.begin(), p.end());
+                    for (Uint v= 0; v < vars_.size(); ++v) {
+                        buf.resize( vars_[v]->GetDim());
+                        float* vals= &buf[0];
+                        vars_[v]->put( triangle.GetBary( i), vals);
+                        values[v].insert( values[v].end(), buf.begin(), buf.end());
+                    }
+                }
+        }
+    }
+    coords_.resize( coords.size());
+    std::copy( coords.begin(), coords.end(), Addr( coords_));
+    values_.resize( vars_.size());
+    for (Uint v= 0; v < vars_.size(); ++v) {
+        values_[v].resize( values[v].size());
+        std::copy( values[v].begin(), values[v].end(), Addr( values_[v]));
+    }
+}
+
+void InSituOutCL::MaybeLocateProbes()
+/** The locations are cached; they are recomputed only if the multigrid or the numbering of the level set function changed.
+    All probes are located at once by a LocatorIndexCL of the triangulation level. The index is not kept, as it is
+    outdated by the next change of the multigrid anyway.*/
+{
+    if (locations_.size() == probes_.size() && mgVersion_ == mg_.GetVersion()
+        && lsetIdx_ == lset_.RowIdx && lsetUnknowns_ == lset_.RowIdx->NumUnknowns())
+        return;
+
+    const int lvl= lvl_ < 0 ? static_cast<int>( lset_.GetLevel()) : lvl_;
+    const LocatorIndexCL index( mg_, lvl);
+    index.Locate( locations_, probes_);
+    mgVersion_= mg_.GetVersion();
+    lsetIdx_= lset_.RowIdx;
+    lsetUnknowns_= lset_.RowIdx->NumUnknowns();
+}
+
+void InSituOutCL::Write (double time)
+{
+    DROPS_REGION( "InSituOut");
+    if (timestep_ == 0) {
+        IF_MASTER
+            WriteDescriptor();
+    }
+
+    ExtractInterface();
+    MaybeLocateProbes();
+
+    // sample the variables in the probes
+    __UNUSED__ const int lvl= lvl_ < 0 ? static_cast<int>( lset_.GetLevel()) : lvl_;
+    Uint probeDim= 0;
+    for (VarContT::const_iterator it= vars_.begin(); it != vars_.end(); ++it)
+        probeDim+= (*it)->GetDim();
+    std::vector<Uint>  probeIdx;
+    std::vector<float> probeVals;
+    for (Uint i= 0; i < locations_.size(); ++i) {
+#ifndef _PAR
+        if (!locations_[i].IsValid())
+#else
+        if (!locations_[i].IsValid( lvl))
+#endif
+            continue;
+        probeIdx.push_back( i);
+        probeVals.resize( probeVals.size() + probeDim);
+        float* vals= &probeVals[probeVals.size() - probeDim];
+        for (VarContT::iterator var= vars_.begin(); var != vars_.end(); ++var) {
+            (*var)->SetTetra( locations_[i].GetTetra());
+            (*var)->put( locations_[i].GetBaryCoord(), vals);
+        }
+    }
+
+    // all processes take part in the computation of the integrals
+    std::vector<double> integrals;
+    for (IntegralContT::const_iterator it= integrals_.begin(); it != integrals_.end(); ++it)
+        (*it)->put( integrals);
+    IF_NOT_MASTER
+        integrals.clear();
+
+    std::string filename( filename_);
+#ifdef _PAR
+    ProcCL::AppendProcNum( filename);
+#endif
+    filename+= "_";
+    AppendTimecode( filename);
+    filename+= ".ist";
+    std::ofstream os;
+    OpenFile( os, filename, std::ios_base::out | std::ios_base::binary);
+
+    const Uint header[4]= { timestep_, static_cast<Uint>( coords_.size()/9),
+        static_cast<Uint>( probeIdx.size()), static_cast<Uint>( integrals.size()) };
+    os.write( "DROPSIST", 8);
+    write_binary( os, &time);
+    write_binary( os, header, 4);
+    if (coords_.size() > 0)
+        write_binary( os, Addr( coords_), coords_.size());
+    for (Uint v= 0; v < values_.size(); ++v)
+        if (values_[v].size() > 0)
+            write_binary( os, Addr( values_[v]), values_[v].size());
+    for (Uint i= 0; i < probeIdx.size(); ++i) {
+        write_binary( os, &probeIdx[i]);
+        if (probeDim > 0)
+            write_binary( os, &probeVals[i*probeDim], probeDim);
+    }
+    if (!integrals.empty())
+        write_binary( os, &integrals[0], integrals.size());
+    if (!os)
+        throw DROPSErrCL( "InSituOutCL::Write: error while writing file!");
+    ++timestep_;
+}
+
+} // end of namespace DROPS
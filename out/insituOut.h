@@ -0,0 +1,270 @@
+/// \file insituOut.h
+/// \brief in-situ reduced output: interface triangulation with sampled fields, point probes and integral quantities
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#ifndef DROPS_INSITUOUT_H
+#define DROPS_INSITUOUT_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include "geom/multigrid.h"
+#include "misc/problem.h"
+#include "num/fe.h"
+#include "num/interfacePatch.h"
+
+#ifdef _PAR
+# include "parallel/parallel.h"
+#endif
+
+namespace DROPS
+{
+
+class InSituVariableCL;  // forward declarations
+class InSituIntegralCL;
+
+/// \brief Writes a reduced data set of a two-phase simulation in a compact binary format.
+/** Instead of the full volume fields, only
+    - the piecewise planar interface \f$\Gamma_h=\{\varphi_h=0\}\f$ (one or two triangles per child of each cut tetra,
+      computed by InterfaceTriangleCL) together with the registered variables sampled in the triangle vertices,
+    - the registered variables in a list of probe points, which are located once by LocatorIndexCL and re-located
+      only after the multigrid or the level set numbering has changed,
+    - integral quantities, e.g. volume and surface area of the droplet (cf. InSituLsetInfoCL),
+    are written. Each call of Write() produces one file <dirname>/<filename>_<timecode>.ist (in the parallel
+    version each process writes its own file with the process number appended to the filename). The names and
+    dimensions of the variables, the probe coordinates and the names of the integral quantities are written
+    once to the ASCII descriptor <dirname>/<filename>.isd.
+
+    Binary layout of a step file (native byte order, Uint is 32 bit):
+    \code
+    char[8]  magic "DROPSIST"
+    double   time
+    Uint     timestep, numTriangles, numProbes, numIntegrals
+    float    coordinates[numTriangles][3][3]                  (unshared triangle vertices)
+    float    values[numTriangles][3][dim]                     (for each variable in order of registration)
+    {Uint    probe; float values[sum of dims]}[numProbes]     (only the probes located on this process)
+    double   integrals[numIntegrals]                          (only written by the master process)
+    \endcode
+*/
+class InSituOutCL
+{
+  private:
+    typedef std::vector<InSituVariableCL*> VarContT;
+    typedef std::vector<InSituIntegralCL*> IntegralContT;
+
+    const MultiGridCL&     mg_;                 ///< reference to the multigrid
+    const VecDescCL&       lset_;               ///< level set function defining the interface
+    const BndDataCL<>&     lsetbnd_;            ///< boundary data of the level set function
+    std::string            dirname_,            ///< directory of the output files
+                           filename_;           ///< prefix of the output files
+    char                   decDigits_;          ///< number of digits for encoding the time step in the filename
+    Uint                   timestep_;           ///< actual time step
+    int                    lvl_;                ///< triangulation level
+    VarContT               vars_;               ///< variables in order of registration
+    IntegralContT          integrals_;          ///< integral quantities in order of registration
+    std::vector<Point3DCL> probes_;             ///< coordinates of the probe points
+    std::vector<LocationCL> locations_;         ///< cached locations of the probe points
+    size_t                 mgVersion_;          ///< version of the multigrid when the probes were located
+    const IdxDescCL*       lsetIdx_;            ///< index of the level set function when the probes were located
+    Uint                   lsetUnknowns_;       ///< number of level set unknowns when the probes were located
+
+    VectorBaseCL<float>    coords_;             ///< triangle vertices of the interface
+    std::vector<VectorBaseCL<float> > values_;  ///< sampled variables in the triangle vertices
+
+    /// Puts time-code as a post-fix to the filename
+    void AppendTimecode( std::string&) const;
+    /// Opens a file in dirname_, creates the directory if necessary
+    void OpenFile( std::ofstream&, const std::string&, std::ios_base::openmode) const;
+    /// Writes the ASCII descriptor of the data set
+    void WriteDescriptor() const;
+    /// Computes the interface triangles and samples the variables in their vertices
+    void ExtractInterface();
+    /// Locates the probe points, if the multigrid or the level set numbering has changed
+    void MaybeLocateProbes();
+
+  public:
+    /// \brief Constructor
+    /// \param mg       multigrid
+    /// \param lset     level set function defining the interface
+    /// \param lsetbnd  boundary data of the level set function
+    /// \param dirname  directory of the output files
+    /// \param filename prefix of the output files
+    /// \param numsteps number of time steps (determines the digits of the time code)
+    /// \param lvl      triangulation level; -1 means the level of the level set function
+    InSituOutCL (const MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd,
+                 const std::string& dirname, const std::string& filename, Uint numsteps, int lvl= -1);
+    ~InSituOutCL ();
+
+    /// \brief Register a variable for sampling on the interface and in the probes.
+    ///
+    /// The class takes ownership of the objects, i. e. it destroys them with delete in its destructor.
+    void Register ( InSituVariableCL& var);
+    /// \brief Register an integral quantity; the class takes ownership.
+    void Register ( InSituIntegralCL& integral);
+    /// \brief Add a probe point, must be called before the first call of Write().
+    void AddProbe ( const Point3DCL& p);
+
+    /// Number of interface triangles written by the last call of Write().
+    Uint GetNumTriangles () const { return coords_.size()/9; }
+
+    /// Writes interface, probes and integral quantities of the current time step.
+    void Write ( double time);
+};
+
+/// \brief Base-class for a function, which is sampled by InSituOutCL on the interface and in the probe points.
+class InSituVariableCL
+{
+  private:
+    std::string varName_;
+
+  public:
+    InSituVariableCL (std::string varName)
+        : varName_( varName) {}
+    virtual ~InSituVariableCL () {}
+
+    std::string varName() const { return varName_; }  ///< Name of the variable; also used as identifier in InSituOutCL.
+
+    /// \brief Number of components.
+    virtual Uint GetDim() const= 0;
+    /// \brief Sets up the local representation of the function on the tetra t.
+    virtual void SetTetra( const TetraCL& t)= 0;
+    /// \brief Appends the values in the barycentric coordinates b w.r.t. the tetra passed to SetTetra to vals.
+    virtual void put( const BaryCoordCL& b, float*& vals) const= 0;
+};
+
+///\brief Represents a scalar Drops-function (P1 or P2, given as PXEvalCL) as in-situ variable.
+template <class DiscScalarT>
+class InSituScalarCL : public InSituVariableCL
+{
+  private:
+    const DiscScalarT f_;
+    typename DiscScalarT::LocalFET loc_;
+
+  public:
+    InSituScalarCL( const DiscScalarT& f, std::string varName)
+        : InSituVariableCL( varName), f_( f) {}
+
+    Uint GetDim() const { return 1; }
+    void SetTetra( const TetraCL& t) { loc_.assign( t, f_); }
+    void put( const BaryCoordCL& b, float*& vals) const { *vals++= static_cast<float>( loc_( b)); }
+};
+
+///\brief Create an InSituScalarCL<> with operator new.
+///
+/// This function does the template parameter deduction for user code.
+template <class DiscScalarT>
+  InSituScalarCL<DiscScalarT>&
+    make_InSituScalar( const DiscScalarT& f, std::string varName)
+{
+    return *new InSituScalarCL<DiscScalarT>( f, varName);
+}
+
+///\brief Represents a vector Drops-function (P1 or P2, given as PXEvalCL) as in-situ variable.
+template <class DiscVectorT>
+class InSituVectorCL : public InSituVariableCL
+{
+  private:
+    const DiscVectorT f_;
+    typename DiscVectorT::LocalFET loc_;
+
+  public:
+    InSituVectorCL( const DiscVectorT& f, std::string varName)
+        : InSituVariableCL( varName), f_( f) {}
+
+    Uint GetDim() const { return 3; }
+    void SetTetra( const TetraCL& t) { loc_.assign( t, f_); }
+    void put( const BaryCoordCL& b, float*& vals) const {
+        const Point3DCL val= loc_( b);
+        for (int j=0; j<3; ++j)
+            *vals++= static_cast<float>( val[j]);
+    }
+};
+
+///\brief Create an InSituVectorCL<> with operator new.
+///
+/// This function does the template parameter deduction for user code.
+template <class DiscVectorT>
+  InSituVectorCL<DiscVectorT>&
+    make_InSituVector( const DiscVectorT& f, std::string varName)
+{
+    return *new InSituVectorCL<DiscVectorT>( f, varName);
+}
+
+/// \brief Base-class for a set of integral quantities, which are written by InSituOutCL in every time step.
+///
+/// In the parallel version put() is called by all processes and must return the global values.
+class InSituIntegralCL
+{
+  public:
+    virtual ~InSituIntegralCL () {}
+
+    /// \brief Appends the names of the quantities to names.
+    virtual void names( std::vector<std::string>& names) const= 0;
+    /// \brief Appends the values of the quantities to vals in the same order as names().
+    virtual void put( std::vector<double>& vals) const= 0;
+};
+
+/// \brief The integral quantities of LevelsetP2CL::GetInfo as in-situ integrals.
+template <class LevelsetT, class DiscVelSolT>
+class InSituLsetInfoCL : public InSituIntegralCL
+{
+  private:
+    const LevelsetT&  ls_;
+    const DiscVelSolT vel_;
+
+  public:
+    InSituLsetInfoCL( const LevelsetT& ls, const DiscVelSolT& vel)
+        : ls_( ls), vel_( vel) {}
+
+    void names( std::vector<std::string>& names) const {
+        const char* n[]= { "maxGradPhi", "volume", "bary_x", "bary_y", "bary_z", "vel_x", "vel_y", "vel_z",
+            "min_x", "min_y", "min_z", "max_x", "max_y", "max_z", "surfArea" };
+        names.insert( names.end(), n, n + sizeof( n)/sizeof( n[0]));
+    }
+    void put( std::vector<double>& vals) const {
+        double maxGradPhi, Volume, surfArea;
+        Point3DCL bary, vel, minCoord, maxCoord;
+        ls_.GetInfo( maxGradPhi, Volume, bary, vel, vel_, minCoord, maxCoord, surfArea);
+        vals.push_back( maxGradPhi);
+        vals.push_back( Volume);
+        vals.insert( vals.end(), bary.begin(), bary.end());
+        vals.insert( vals.end(), vel.begin(), vel.end());
+        vals.insert( vals.end(), minCoord.begin(), minCoord.end());
+        vals.insert( vals.end(), maxCoord.begin(), maxCoord.end());
+        vals.push_back( surfArea);
+    }
+};
+
+///\brief Create an InSituLsetInfoCL<> with operator new.
+///
+/// This function does the template parameter deduction for user code.
+template <class LevelsetT, class DiscVelSolT>
+  InSituLsetInfoCL<LevelsetT, DiscVelSolT>&
+    make_InSituLsetInfo( const LevelsetT& ls, const DiscVelSolT& vel)
+{
+    return *new InSituLsetInfoCL<LevelsetT, DiscVelSolT>( ls, vel);
+}
+
+} // end of namespace DROPS
+
+#endif
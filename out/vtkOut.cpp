@@ -23,6 +23,7 @@
 */
 
 #include "out/vtkOut.h"
+#include "misc/instrument.h"
 
 namespace DROPS
 {
@@ -65,6 +66,7 @@ void VTKOutCL::Register (VTKVariableCL& var)
 
 void VTKOutCL::Write ( double time, bool writeDistribution)
 {
+    DROPS_REGION( "VTKOut");
     PutGeom( time, writeDistribution);
     for( std::map<std::string, VTKVariableCL*>::iterator it= vars_.begin(); it != vars_.end(); ++it) {
         it->second->put( *this);
@@ -462,11 +462,13 @@ void ExchangeCL::CreateList(const MultiGridCL& mg, IdxDescCL *RowIdx, bool Creat
     tmpSysProc_.resize(numUnk);
 
       // Collect distributed sysnums and put them into the lists
+    // the simplices of the triangulation of the index, which may be a coarser level of a multilevel index
+    const int lvl= RowIdx_->TriangLevel();
     if (numUnkVert>0){
-        CollectSendSysNums(mg.GetTriangVertexBegin(), mg.GetTriangVertexEnd(), DistSysnums);
+        CollectSendSysNums(mg.GetTriangVertexBegin(lvl), mg.GetTriangVertexEnd(lvl), DistSysnums);
     }
     if (numUnkEdge>0){
-        CollectSendSysNums(mg.GetTriangEdgeBegin(), mg.GetTriangEdgeEnd(), DistSysnums);
+        CollectSendSysNums(mg.GetTriangEdgeBegin(lvl), mg.GetTriangEdgeEnd(lvl), DistSysnums);
     }
 
       // sort the sysnums, to create the ExchangeDataCLs
@@ -45,6 +45,9 @@ class ExchangeCL;
 class ExchangeBlockCL;
 class AccumulateMatrixCL;
 
+/// \brief Minimal number of entries, for which the local loops of the exchange classes start an OpenMP thread team
+const long ExchangeOmpMinSizeC= 10000;
+
 /****************************************************************************
 * E X C H A N G E  D A T A  S E N D  C L A S S                              *
 ****************************************************************************/
@@ -142,6 +145,10 @@ class ExchangeDataCL : public ExchangeDataSendCL
     an inner product of a distributed and a accumulated vector can be performed
     effective. Between sending and recieving the numerical data, the local
     inner product can be done. <br>
+    In the hybrid MPI+OpenMP mode (cf. ProcCL) the master thread sends and receives,
+    while the local inner products and the accumulation of the received values are
+    computed by all threads of the proc. Hence, the member functions must not be
+    called within a parallel region. <br>
     On the other hand the class can give information about all sysnums. So the
     class can decide whether a sysnum is just local on one proc or the sysnum can
     be found on different procs (and how many). It can also compute the external
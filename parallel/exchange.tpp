@@ -75,8 +75,10 @@ void ExchangeDataCL::Accumulate(VectorBaseCL<T>& v, Ulint offsetV, VectorBaseCL<
     \pre Communication has to be done before entering this procedure
 */
 {
-    // add the data to the positions described by Sysnums_
-    for (Uint i=0; i<GetNumRecvEntries(); ++i)
+    // add the data to the positions described by Sysnums_; the sysnums of one neighbor are distinct
+    const int n= GetNumRecvEntries();
+#   pragma omp parallel for if (n > ExchangeOmpMinSizeC)
+    for (int i=0; i<n; ++i)
         v[Sysnums_[i]+offsetV] += recvBuf[i+offsetRecv];
 }
 
@@ -423,12 +425,15 @@ double ExchangeCL::LocDot_(const VectorCL& x, const VectorCL& y, VectorCL* x_acc
         *x_acc=x;
     }
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)    // do local summation
+    // local summation by all threads, while the messages are on their way
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
     AccFromAllProc(*x_acc, SendRecvReq_);   // recieve values from neighbors and sum them up
 
-    for (Ulint i=0; i<numDistrIdx_; ++i)    // do summation of distributed entries
+#   pragma omp parallel for reduction(+: dist_sum) if ((long)numDistrIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numDistrIdx_; ++i)    // do summation of distributed entries
         dist_sum += (*x_acc)[DistrIndex[i]] * y[DistrIndex[i]];
 
 
@@ -459,12 +464,14 @@ double ExchangeCL::AccurLocDotNoAcc_(const VectorCL& x, const VectorCL& y) const
            acc_sum=0;       // sum of distributed entries
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += x[AccDistIndex[i]] * y[AccDistIndex[i]];
 
     return loc_sum+acc_sum;
@@ -503,13 +510,15 @@ double ExchangeCL::AccurLocDotOneAcc_(const VectorCL& x_acc, const VectorCL& y,
     }
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x_acc[LocalIndex[i]] * y[LocalIndex[i]];
 
     AccFromAllProc(*y_acc, SendRecvReq_);   // recieve values from neighbors and sum them up
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += x_acc[AccDistIndex[i]] * (*y_acc)[AccDistIndex[i]];
 
     // free memory
@@ -566,14 +575,16 @@ double ExchangeCL::AccurLocDotBothAcc_(const VectorCL& x, const VectorCL& y, Vec
     }
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
     AccFromAllProc(*x_acc, SendRecvReq_);                   // recieve values from neighbors and sum them up
     AccFromAllProc(*y_acc, req_y, 0, &secondRecvBuf);       // recieve values from neighbors and sum them up
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += (*x_acc)[AccDistIndex[i]] * (*y_acc)[AccDistIndex[i]];
 
     // free memory
@@ -891,7 +902,8 @@ double ExchangeCL::ParDotAcc(VectorCL& x, const VectorCL& y)const
     InitCommunication(x, SendRecvReq_);
 
     // while sending, we can sum up unshared entries
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
     // now we need the accumulated values
@@ -923,7 +935,8 @@ inline double ExchangeCL::DotAcc(VectorCL& x, const VectorCL& y) const
     RequestCT req(ExList_.size());
     InitCommunication(x, SendRecvReq_);
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
     AccFromAllProc(x, SendRecvReq_);
@@ -991,7 +1004,8 @@ double ExchangeCL::AccParDot(const VectorCL& x, const VectorCL& y, VectorCL& x_a
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
 
     // now we need the accumulated values
@@ -999,7 +1013,8 @@ double ExchangeCL::AccParDot(const VectorCL& x, const VectorCL& y, VectorCL& x_a
     AccFromAllProc(y_acc, req_y, 0, &secondRecvBuf);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
 
     return ProcCL::GlobalSum(loc_sum+acc_sum);
@@ -1018,12 +1033,14 @@ double ExchangeCL::LocAccDot(const VectorCL& x_acc, const VectorCL& y_acc) const
     acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x_acc[LocalIndex[i]] * y_acc[LocalIndex[i]];
 
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
 
     return loc_sum+acc_sum;
@@ -1057,14 +1074,16 @@ double ExchangeCL::LocAccNorm_sq(const VectorCL& r, VectorCL& r_acc) const
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += r[LocalIndex[i]] * r[LocalIndex[i]];
 
     // now we need the accumulated values
     AccFromAllProc(r_acc, SendRecvReq_, 0);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
 
     return loc_sum+acc_sum;
@@ -1078,11 +1097,13 @@ double ExchangeCL::LocAccNorm_sq(const VectorCL& r_acc) const
     double loc_sum=0,
            acc_sum=0;
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += r_acc[LocalIndex[i]] * r_acc[LocalIndex[i]];
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
 
     return loc_sum+acc_sum;
@@ -1108,14 +1129,16 @@ double ExchangeCL::AccParDot(const VectorCL &x, const VectorCL& y_acc, VectorCL&
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += x[LocalIndex[i]] * y_acc[LocalIndex[i]];
 
     // now we need the accumulated values
     AccFromAllProc(x_acc, SendRecvReq_, 0);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
 
     return ProcCL::GlobalSum(loc_sum+acc_sum);
@@ -1133,11 +1156,13 @@ double ExchangeCL::AccNorm_sq(const VectorCL& r_acc) const
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
+#   pragma omp parallel for reduction(+: loc_sum) if ((long)numLocalIdx_ > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)numLocalIdx_; ++i)
         loc_sum += r_acc[LocalIndex[i]] * r_acc[LocalIndex[i]];
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
+#   pragma omp parallel for reduction(+: acc_sum) if ((long)AccDistIndex.size() > ExchangeOmpMinSizeC)
+    for (long i=0; i<(long)AccDistIndex.size(); ++i)
         acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
 
     double norm_sq = ProcCL::GlobalSum(loc_sum+acc_sum);
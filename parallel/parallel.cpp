@@ -37,6 +37,7 @@ Uint    ProcCL::size_   =0;             // if _size==0, then this proc has not c
 int     ProcCL::procDigits_=0;
 ProcCL* ProcCL::instance_=0;            // only one instance of ProcCL may exist (Singleton-Pattern)
 MuteStdOstreamCL* ProcCL::mute_=0;
+int     ProcCL::threadLevel_=0;
 
 #ifdef _MPICXX_INTERFACE
     const ProcCL::CommunicatorT& ProcCL::Communicator_ = MPI::COMM_WORLD;
@@ -76,7 +77,16 @@ ProcCL::ProcCL(int* argc, char*** argv)
 {
     Assert(size_==0, DROPSErrCL("ProcCL instanciated multiple times"), DebugParallelC);
 
+#ifdef _MPI_INIT_THREAD
+    // Request thread support before DDD is initialized. Only for a PPIF, which does not call MPI_Init, if MPI
+    // has been initialized before; otherwise MPI_Init would be called twice.
+    int initialized;
+    MPI_Initialized( &initialized);
+    if (!initialized)
+        MPI_Init_thread( argc, argv, MPI_THREAD_FUNNELED, &initialized);
+#endif
     DynamicDataInterfaceCL::Init(argc, argv);               // DDD Initialisieren und die Informationen beziehen
+    MPI_Query_thread( &threadLevel_);                       // thread support actually provided by MPI
     my_rank_ = DynamicDataInterfaceCL::InfoMe();
     size_    = DynamicDataInterfaceCL::InfoProcs();
     procDigits_= 1;
@@ -86,6 +96,21 @@ ProcCL::ProcCL(int* argc, char*** argv)
     }
     mute_    = new MuteStdOstreamCL();
     MuteStdOstreams();
+#if defined(_OPENMP) && defined(_MPI_INIT_THREAD)
+    if (threadLevel_ < MPI_THREAD_FUNNELED && omp_get_max_threads() > 1) {
+        std::cout << "ProcCL: MPI does not provide MPI_THREAD_FUNNELED, using one thread per proc\n";
+        omp_set_num_threads( 1);
+    }
+#endif
+}
+
+int ProcCL::NumThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
 }
 
 ProcCL::~ProcCL()
@@ -30,6 +30,7 @@
 #include <string>
 #include <numeric>
 #include "misc/utils.h"
+#include "misc/instrument.h"
 #include "parallel/distributeddatatypes.h"
 #ifdef HAVE_ZOLTAN
 #include <zoltan.h>
@@ -76,7 +77,15 @@ class ProcInitCL; //forward declaration
 ***************************************************************************/
 /// \brief Manage several procs
 class ProcCL
-/** This class acts as an interface to MPI. */
+/** This class acts as an interface to MPI.
+
+    Hybrid MPI+OpenMP: With the thread level MPI_THREAD_FUNNELED each rank may run multithreaded
+    kernels (assembly via accumulate, y_Ax, vector kernels, the local parts of ExchangeCL), but all
+    MPI calls including the DDD communication are issued by the master thread outside of parallel
+    regions. By default, MPI is initialized by DDD, i.e. by MPI_Init, and the number of threads is
+    left to OpenMP as before; the thread level is only queried (GetThreadLevel). With _MPI_INIT_THREAD,
+    MPI_Init_thread is called before DDD; this requires a PPIF, which does not call MPI_Init again.
+    In this case the ranks run single-threaded, if MPI does not provide MPI_THREAD_FUNNELED. */
 {
     friend class ProcInitCL;
 
@@ -110,8 +119,12 @@ class ProcCL
     static int  procDigits_;                    // How many digits are necessary to decode rank of process?
     static const CommunicatorT& Communicator_;  // communicator (=MPI_COMM_WORLD, MPI::COMM_WORLD)
     static MuteStdOstreamCL* mute_;             // for muting std::cout, std::cout, std::clog
+    static int  threadLevel_;                   // thread support provided by MPI
 
     static ProcCL* instance_;                   ///< only one instance of ProcCL may exist (Singleton-Pattern)
+
+    /// \brief Counts a sent message and its size for the instrumentation (cf. InstrumentCL)
+    static inline void CountSend(int count, const DatatypeT&);
     ProcCL(int*, char***);                      ///< constructor, mutes all non-master standard output streams
     ~ProcCL();                                  ///< destructor
 
@@ -132,6 +145,10 @@ class ProcCL
     static int MyRank()     { return my_rank_; }
       /// \brief check how many procs are used by this program
     static int Size()       { return size_; }
+      /// \brief thread support provided by MPI (MPI_THREAD_SINGLE, ..., MPI_THREAD_MULTIPLE)
+    static int GetThreadLevel() { return threadLevel_; }
+      /// \brief number of OpenMP threads of each proc
+    static int NumThreads();
     /// \name Parallel output
     //@{
       // \brief Mute output of standard output streams for all non-master procs
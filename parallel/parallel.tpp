@@ -91,7 +91,10 @@ template <typename T>
 
 template <typename T>
   inline void ProcCL::AllReduce(const T* myData, T* globalData, int size, const ProcCL::OperationT& op)
-  { Communicator_.Allreduce(myData, globalData, size, ProcCL::MPI_TT<T>::dtype, op); }
+{
+    DROPS_COUNT( "MPI reductions", 1.);
+    Communicator_.Allreduce(myData, globalData, size, ProcCL::MPI_TT<T>::dtype, op);
+}
 
 template <typename T>
   inline void ProcCL::Gather(const T* myData, T* globalData, int size, int root)
@@ -139,13 +142,21 @@ template <typename T>
   inline ProcCL::RequestT ProcCL::Irecv(T* data, int count, int source, int tag)
   { return Communicator_.Irecv(data, count, ProcCL::MPI_TT<T>::dtype, source, tag); }
 
+inline void ProcCL::CountSend(int count, const DatatypeT& type)
+{
+    if (InstrumentCL::IsEnabled()) {
+        InstrumentCL::Count( "MPI messages");
+        InstrumentCL::Count( "MPI bytes sent", static_cast<double>( count)*type.Get_size());
+    }
+}
+
 template <typename T>
   inline void ProcCL::Send(const T* data, int count, const DatatypeT& type, int dest, int tag)
-  { Communicator_.Send(data, count, type, dest, tag); }
+  { CountSend(count, type); Communicator_.Send(data, count, type, dest, tag); }
 
 template <typename T>
   inline ProcCL::RequestT ProcCL::Isend(const T* data, int count, const ProcCL::DatatypeT& datatype, int dest, int tag)
-  { return Communicator_.Isend(data, count, datatype, dest, tag); }
+  { CountSend(count, datatype); return Communicator_.Isend(data, count, datatype, dest, tag); }
 
 template <typename T>
   inline ProcCL::AintT ProcCL::Get_address(T* data)
@@ -195,7 +206,10 @@ template <typename T>
 
 template <typename T>
   inline void ProcCL::AllReduce(const T* myData, T* globalData, int size, const ProcCL::OperationT& op)
-  { MPI_Allreduce(const_cast<T*>(myData), globalData, size, ProcCL::MPI_TT<T>::dtype, op, Communicator_); }
+{
+    DROPS_COUNT( "MPI reductions", 1.);
+    MPI_Allreduce(const_cast<T*>(myData), globalData, size, ProcCL::MPI_TT<T>::dtype, op, Communicator_);
+}
 
 template <typename T>
   inline void ProcCL::Gather(const T* myData, T* globalData, int size, int root)
@@ -255,12 +269,23 @@ template <typename T>
     return req;
 }
 
+inline void ProcCL::CountSend(int count, const DatatypeT& type)
+{
+    if (InstrumentCL::IsEnabled()) {
+        int size;
+        MPI_Type_size(type, &size);
+        InstrumentCL::Count( "MPI messages");
+        InstrumentCL::Count( "MPI bytes sent", static_cast<double>( count)*size);
+    }
+}
+
 template <typename T>
   inline void ProcCL::Send(const T* data, int count, const DatatypeT& type, int dest, int tag)
-  { MPI_Send(const_cast<T*>(data), count, type, dest, tag, Communicator_); }
+  { CountSend(count, type); MPI_Send(const_cast<T*>(data), count, type, dest, tag, Communicator_); }
 
 template <typename T>
   inline ProcCL::RequestT ProcCL::Isend(const T* data, int count, const ProcCL::DatatypeT& datatype, int dest, int tag){
+    CountSend(count, datatype);
     RequestT req;
     MPI_Isend(const_cast<T*>(data), count, datatype, dest, tag, Communicator_, &req);
     return req;
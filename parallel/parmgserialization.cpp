@@ -32,6 +32,8 @@
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <limits>
 #include "parallel/parmgserialization.h"
 
 namespace DROPS
@@ -1163,6 +1165,110 @@ void ParMGSerializationCL::ExpandDOFMap(const DofVecCL* pBuffer,Uint bufferSize
 }
 
 
+void ParMGSerializationCL::WriteDOFFiles(Uint numUnkVertex, const std::string& name, const std::string& path)
+/** Writes the dofs stored in dofScalMap_ or dofVecMap_ in the order of the
+    simplices within vertexBuffer_ and edgeBuffer_ into the files of WriteDOF.
+    \param numUnkVertex number of unknowns on a vertex
+    \param name         name of the unknowns
+    \param path         output path
+*/
+{
+    // Open files
+
+    const std::string commentStr("# Written Dofs: ");
+    std::string placeHolder ="#";
+
+    placeHolder.resize(72 ,' ');
+
+    std::ofstream vertexDofFile((path+name+"_Vertices").c_str());
+    // Reserve some bytes at the beginning of file
+    vertexDofFile<<placeHolder<< std::endl;
+    std::ofstream edgeDofFile((path+name+"_Edges").c_str());
+    edgeDofFile<<placeHolder<< std::endl;
+
+    Uint writtenVertexDofCnt = 0,writtenEdgeDofCnt = 0 ;
+
+    // Write out scalar or vectorial data
+    switch(numUnkVertex)
+    {
+        // scalar data
+        case 1:
+            // vertices
+            for ( std::vector<VertexInfoCL>::iterator it=vertexBuffer_.begin() ; it != vertexBuffer_.end(); it++)
+            {
+                vertexDofFile << std::scientific << std::setprecision(16) << dofScalMap_[it->gid] << std::endl << std::flush;
+                writtenVertexDofCnt++;
+            }
+
+            // edges
+            for (std::vector<EdgeInfoCL>::iterator it=edgeBuffer_.begin() ; it != edgeBuffer_.end(); it++)
+            {
+
+                Uint gid = it->gid; //  AddrMap_getLocalId(addrMapEdge_,it->gid) ;
+
+                // skip edge is no unknowns on it
+                if(dofScalMap_[gid]==0)
+                    continue;
+
+                edgeDofFile << std::scientific << std::setprecision(16) << dofScalMap_[gid]<< std::endl << std::flush ;
+                writtenEdgeDofCnt++;
+            }
+
+
+            break;
+
+        // vectorial data
+        case 3:
+
+            // vertices
+            for ( std::vector<VertexInfoCL>::iterator it=vertexBuffer_.begin() ; it != vertexBuffer_.end(); it++ )
+            {
+
+                Uint gid = it->gid ; //  AddrMap_getLocalId(addrMapVertex_,it->gid) ;
+
+                if(dofVecMap_[gid] == 0 )
+                    continue;
+
+                vertexDofFile << std::scientific << std::setprecision(16) << dofVecMap_[gid][0] << " "
+                         <<dofVecMap_[gid][1]<<" "
+                         <<dofVecMap_[gid][2] <<std::endl;
+
+                writtenVertexDofCnt++;
+            }
+
+
+            // edges
+            for (std::vector<EdgeInfoCL>::iterator it=edgeBuffer_.begin() ; it != edgeBuffer_.end(); it++)
+            {
+
+                Uint gid = it->gid;
+
+                // skip edge is no unknowns on it
+                if(dofVecMap_[gid]==0)
+                    continue;
+
+
+                edgeDofFile << std::scientific << std::setprecision(16) << dofVecMap_[gid][0] << " "
+                         << dofVecMap_[gid][1]<<" "
+                         << dofVecMap_[gid][2] <<std::endl;
+
+                writtenEdgeDofCnt++;
+            }
+
+
+
+            break;
+
+    }; // END OF SWITCH
+
+    // Move put-pointer back to the file beginning
+    vertexDofFile.seekp(0);
+    vertexDofFile <<commentStr << writtenVertexDofCnt << std::flush;
+
+    edgeDofFile.seekp(0);
+    edgeDofFile << commentStr<< writtenEdgeDofCnt << std::flush;
+}
+
 void ParMGSerializationCL::WriteDOF(const VecDescCL* vec, const std::string& name,const std::string path)
 /** This procedure writes out the values of the DOF given by the vec into a file
     specified by the name that is also given as a parameter. I.e. all information
@@ -1210,118 +1316,257 @@ void ParMGSerializationCL::WriteDOF(const VecDescCL* vec, const std::string& nam
             RecieveDOF(vec, p);
         }
 
-       // Open files
-
-        const std::string commentStr("# Written Dofs: ");
-        std::string placeHolder ="#";
-
-        placeHolder.resize(72 ,' ');
-
+        // Write all dofs to disk
         std::string outputPath = path_;
         if(path.length()>0)
                 outputPath = path;
+        WriteDOFFiles(vec->RowIdx->NumUnknownsVertex(), name, outputPath);
+    }
+    //
+    //  Worker-Procs
+    //
+    else
+    {
+        // collect all dof data
+        CollectDOF(vec);
+        // send data back to master
+        SendDOF();
+    }
 
-        std::ofstream vertexDofFile((outputPath+name+"_Vertices").c_str());
-        // Reserve some bytes at the beginning of file
-        vertexDofFile<<placeHolder<< std::endl;
-        std::ofstream edgeDofFile((outputPath+name+"_Edges").c_str());
-        edgeDofFile<<placeHolder<< std::endl;
-
-        Uint writtenVertexDofCnt = 0,writtenEdgeDofCnt = 0 ;
-
-        // Write out scalar or vectorial data
-        switch(vec->RowIdx->NumUnknownsVertex())
-        {
-            // scalar data
-            case 1:
-                // vertices
-                for ( std::vector<VertexInfoCL>::iterator it=vertexBuffer_.begin() ; it != vertexBuffer_.end(); it++)
-                {
-                    vertexDofFile << std::scientific << std::setprecision(16) << dofScalMap_[it->gid] << std::endl << std::flush;
-                    writtenVertexDofCnt++;
-                }
-
-                // edges
-                for (std::vector<EdgeInfoCL>::iterator it=edgeBuffer_.begin() ; it != edgeBuffer_.end(); it++)
-                {
-
-                    Uint gid = it->gid; //  AddrMap_getLocalId(addrMapEdge_,it->gid) ;
-
-                    // skip edge is no unknowns on it
-                    if(dofScalMap_[gid]==0)
-                        continue;
+    // free local dof buffers
+    FreeLocalDOFBuffer();
+}
 
-                    edgeDofFile << std::scientific << std::setprecision(16) << dofScalMap_[gid]<< std::endl << std::flush ;
-                    writtenEdgeDofCnt++;
-                }
+/// \brief Name of the file of a shard written by process \a rank
+inline std::string ShardFileName(const std::string& prefix, int rank)
+{
+    std::ostringstream name;
+    name << prefix << "Shard." << rank;
+    return name.str();
+}
 
+template <typename T>
+  void ParMGSerializationCL::WriteBuffer(std::ofstream& os, const std::vector<T>& buf)
+{
+    if (!buf.empty())
+        os.write(reinterpret_cast<const char*>(&buf[0]), buf.size()*sizeof(T));
+}
 
-                break;
+template <typename T>
+  void ParMGSerializationCL::ReadBuffer(std::ifstream& is, std::vector<T>& buf, Uint num)
+/// Appends \a num elements read from \a is to \a buf.
+{
+    const size_t oldSize= buf.size();
+    buf.resize(oldSize+num);
+    if (num>0)
+        is.read(reinterpret_cast<char*>(&buf[oldSize]), num*sizeof(T));
+    if (!is)
+        throw ParSerializeErrCL("ParMGSerializationCL::ReadBuffer: Shard is too short", 1);
+}
 
-            // vectorial data
-            case 3:
+void ParMGSerializationCL::WriteMGShards(const std::string path)
+/** Each process writes the simplices, it is responsible for, in binary format
+    into the file "Shard.<rank>" in the output directory. The simplices are
+    identified by their global ids, which are mapped to consecutive numbers not
+    until MergeShards. The master process writes the index file "ShardIndex",
+    that contains the names of all shards and the number of the simplices in
+    each shard. Apart from these numbers, no data is transfered between the
+    processes.
+    \pre The output directory must be accessible by all processes.
+*/
+{
+    // Clean up memory allocated by former use of WriteMG
+    Clear();
 
-                // vertices
-                for ( std::vector<VertexInfoCL>::iterator it=vertexBuffer_.begin() ; it != vertexBuffer_.end(); it++ )
-                {
+    std::string outputPath= path_;
+    if(path.length()>0)
+        outputPath = path ;
 
-                    Uint gid = it->gid ; //  AddrMap_getLocalId(addrMapVertex_,it->gid) ;
+    MoveVertices();
+    MoveEdges();
+    MoveFaces();
+    MoveTetras();
 
-                    if(dofVecMap_[gid] == 0 )
-                        continue;
+    std::valarray<Uint> num(6);
+    num[0]= vertexBuffer_.size();
+    num[1]= bndVertexBuffer_.size();
+    num[2]= edgeBuffer_.size();
+    num[3]= faceBuffer_.size();
+    num[4]= tetraBuffer_.size();
+    num[5]= tetraChildsBuffer_.size();
+
+    const std::string shardName= ShardFileName("", ProcCL::MyRank());
+    std::ofstream shard((outputPath+shardName).c_str(), std::ios::binary);
+    if (!shard)
+        throw ParSerializeErrCL("Cannot create files in given directory!", 1);
+    shard.write(reinterpret_cast<const char*>(&num[0]), num.size()*sizeof(Uint));
+    WriteBuffer(shard, vertexBuffer_);
+    WriteBuffer(shard, bndVertexBuffer_);
+    WriteBuffer(shard, edgeBuffer_);
+    WriteBuffer(shard, faceBuffer_);
+    WriteBuffer(shard, tetraBuffer_);
+    WriteBuffer(shard, tetraChildsBuffer_);
+    if (!shard)
+        throw ParSerializeErrCL("ParMGSerializationCL::WriteMGShards: Error while writing shard", 1);
+
+    const std::valarray<Uint> allNum= ProcCL::Gather(num, masterProc_);
+    if (ProcCL::MyRank()==masterProc_){
+        std::ofstream index((outputPath+"ShardIndex").c_str());
+        if (!index)
+            throw ParSerializeErrCL("Cannot create files in given directory!", 1);
+        index << ProcCL::Size() << '\n';
+        for (int p=0; p<ProcCL::Size(); ++p){
+            index << ShardFileName("", p);
+            for (Uint i=0; i<num.size(); ++i)
+                index << ' ' << allNum[p*num.size()+i];
+            index << '\n';
+        }
+    }
+}
 
-                    vertexDofFile << std::scientific << std::setprecision(16) << dofVecMap_[gid][0] << " "
-                             <<dofVecMap_[gid][1]<<" "
-                             <<dofVecMap_[gid][2] <<std::endl;
+void ParMGSerializationCL::WriteDOFShards(const VecDescCL* vec, const std::string& name, const std::string path)
+/** Each process writes the dofs on the vertices and edges, it is responsible
+    for, together with the global ids of the simplices in binary format into the
+    file "<name>_Shard.<rank>". The master process writes the index file
+    "<name>_ShardIndex".
+    \param vec  describer of the dof
+    \param name name of the unknowns
+*/
+{
+    std::string outputPath= path_;
+    if(path.length()>0)
+        outputPath = path ;
 
-                    writtenVertexDofCnt++;
-                }
+    CollectDOF(vec);
 
+    std::valarray<Uint> num(4);
+    num[0]= vec->RowIdx->NumUnknownsVertex();
+    num[1]= vec->RowIdx->NumUnknownsEdge();
+    num[2]= dofScalBuffer_.size();
+    num[3]= dofVecBuffer_.size();
 
-                // edges
-                for (std::vector<EdgeInfoCL>::iterator it=edgeBuffer_.begin() ; it != edgeBuffer_.end(); it++)
-                {
+    std::ofstream shard((outputPath+ShardFileName(name+"_", ProcCL::MyRank())).c_str(), std::ios::binary);
+    if (!shard)
+        throw ParSerializeErrCL("Cannot create files in given directory!", 1);
+    shard.write(reinterpret_cast<const char*>(&num[0]), num.size()*sizeof(Uint));
+    WriteBuffer(shard, dofScalBuffer_);
+    WriteBuffer(shard, dofVecBuffer_);
+    if (!shard)
+        throw ParSerializeErrCL("ParMGSerializationCL::WriteDOFShards: Error while writing shard", 1);
 
-                    Uint gid = it->gid;
+    const std::valarray<Uint> allNum= ProcCL::Gather(num, masterProc_);
+    if (ProcCL::MyRank()==masterProc_){
+        std::ofstream index((outputPath+name+"_ShardIndex").c_str());
+        if (!index)
+            throw ParSerializeErrCL("Cannot create files in given directory!", 1);
+        index << ProcCL::Size() << '\n';
+        for (int p=0; p<ProcCL::Size(); ++p){
+            index << ShardFileName(name+"_", p);
+            for (Uint i=0; i<num.size(); ++i)
+                index << ' ' << allNum[p*num.size()+i];
+            index << '\n';
+        }
+    }
 
-                    // skip edge is no unknowns on it
-                    if(dofVecMap_[gid]==0)
-                        continue;
+    FreeLocalDOFBuffer();
+}
 
+std::vector<std::string> ParMGSerializationCL::ReadShardIndex(const std::string& file)
+/// The first entry of each line is the name of the shard; the numbers of objects are checked while reading the shards.
+{
+    std::ifstream index(file.c_str());
+    if (!index)
+        throw ParSerializeErrCL("Error while reading file '"  + file + "'", 1);
+    int numShards= 0;
+    index >> numShards;
+    index.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::vector<std::string> names(numShards);
+    std::string line;
+    for (int p=0; p<numShards && std::getline(index, line); ++p){
+        std::istringstream is(line);
+        is >> names[p];
+    }
+    if (!index)
+        throw ParSerializeErrCL("Error while reading file '"  + file + "'", 1);
+    return names;
+}
 
-                    edgeDofFile << std::scientific << std::setprecision(16) << dofVecMap_[gid][0] << " "
-                             << dofVecMap_[gid][1]<<" "
-                             << dofVecMap_[gid][2] <<std::endl;
+void ParMGSerializationCL::ReadShard(const std::string& file)
+{
+    std::ifstream shard(file.c_str(), std::ios::binary);
+    if (!shard)
+        throw ParSerializeErrCL("Error while reading file '"  + file + "'", 1);
+    Uint num[6];
+    shard.read(reinterpret_cast<char*>(num), sizeof(num));
+    ReadBuffer(shard, vertexBuffer_,      num[0]);
+    ReadBuffer(shard, bndVertexBuffer_,   num[1]);
+    ReadBuffer(shard, edgeBuffer_,        num[2]);
+    ReadBuffer(shard, faceBuffer_,        num[3]);
+    ReadBuffer(shard, tetraBuffer_,       num[4]);
+    ReadBuffer(shard, tetraChildsBuffer_, num[5]);
+}
 
-                    writtenEdgeDofCnt++;
-                }
+void ParMGSerializationCL::MergeShards(const std::string path)
+/** The shards listed in the index file are read into the buffers, as if they
+    were received by FetchData. Then the files of WriteMG are written. Hence,
+    the number of processes calling this function does not have to coincide
+    with the number of processes that have written the shards. The buffers are
+    kept for MergeDOFShards.
+*/
+{
+    Clear();
 
+    std::string outputPath= path_;
+    if(path.length()>0)
+        outputPath = path ;
 
+    const std::vector<std::string> shards= ReadShardIndex(outputPath+"ShardIndex");
+    for (Uint p=0; p<shards.size(); ++p)
+        ReadShard(outputPath+shards[p]);
+    Comment(shards.size()<<" shards read\n", DebugOutPutC);
 
-                break;
+    PrepareData();
+#if DROPSDebugC&DebugOutPutC
+    printStat();
+#endif
 
-        }; // END OF SWITCH
+    WriteVertices (outputPath);
+    WriteEdges(outputPath);
+    WriteFaces(outputPath);
+    WriteTetras(outputPath);
+}
 
-        // Move put-pointer back to the file beginning
-        vertexDofFile.seekp(0);
-        vertexDofFile <<commentStr << writtenVertexDofCnt << std::flush;
+void ParMGSerializationCL::MergeDOFShards(const std::string& name, const std::string path)
+/** The dofs of all shards listed in the index file are written in the order
+    of the simplices of the last call of MergeShards into the files of WriteDOF.
+    \param name name of the unknowns
+*/
+{
+    if (vertexBuffer_.empty())
+        throw ParSerializeErrCL("ParMGSerializationCL::MergeDOFShards: Call MergeShards first", 1);
 
-        edgeDofFile.seekp(0);
-        edgeDofFile << commentStr<< writtenEdgeDofCnt << std::flush;
+    std::string outputPath= path_;
+    if(path.length()>0)
+        outputPath = path ;
 
+    const std::vector<std::string> shards= ReadShardIndex(outputPath+name+"_ShardIndex");
+    Uint numUnkVertex= 0;
+    for (Uint p=0; p<shards.size(); ++p){
+        std::ifstream shard((outputPath+shards[p]).c_str(), std::ios::binary);
+        if (!shard)
+            throw ParSerializeErrCL("Error while reading file '"  + outputPath+shards[p] + "'", 1);
+        Uint num[4];
+        shard.read(reinterpret_cast<char*>(num), sizeof(num));
+        numUnkVertex= num[0];
+        ReadBuffer(shard, dofScalBuffer_, num[2]);
+        ReadBuffer(shard, dofVecBuffer_,  num[3]);
     }
-    //
-    //  Worker-Procs
-    //
-    else
-    {
-        // collect all dof data
-        CollectDOF(vec);
-        // send data back to master
-        SendDOF();
-    }
+    if(dofScalBuffer_.size()>0)
+        ExpandDOFMap(&dofScalBuffer_[0],dofScalBuffer_.size());
+    if (dofVecBuffer_.size()>0)
+        ExpandDOFMap(&dofVecBuffer_[0],dofVecBuffer_.size());
 
-    // free local dof buffers
+    WriteDOFFiles(numUnkVertex, name, outputPath);
     FreeLocalDOFBuffer();
 }
 
@@ -31,6 +31,7 @@
 #include "misc/utils.h"
 #include "misc/problem.h"
 #include <istream>
+#include <fstream>
 #include <vector>
 #include <map>
 #include <cmath>
@@ -97,6 +98,20 @@ class ParMGSerializationCL
     This class is also capable to write out degrees of freedom (dof) on vertices
     and edges. This can be done by the function \a WriteDOF. This procedure
     follows the same scheme as the procedures to serialize the multigrid.
+    <p>
+    For large numbers of processes, the transfer to the master is a bottleneck.
+    Therefore, WriteMGShards and WriteDOFShards let every process write the
+    simplices and dof it is responsible for into an own binary file (shard),
+    which are identified by their global ids. Only the number of objects per
+    shard is gathered by the master, which writes an index file. MergeShards
+    and MergeDOFShards read the shards of an arbitrary number of processes and
+    write the same files as WriteMG and WriteDOF; thus, a run can be restarted
+    on a different number of processes by the usual deserialization, where the
+    multigrid is distributed by the LoadBalHandlerCL.
+    Only the writing of the checkpoints avoids the master: The merge runs on
+    one process and reads all shards, and the deserialization builds the whole
+    multigrid on the master, too. A parallel reader of the shards is not
+    implemented.
 */
 {
   public:
@@ -412,6 +427,19 @@ class ParMGSerializationCL
     **/
 	void ExpandDOFMap(const DofVecCL* pBuffer,Uint bufferSize );
 
+    /// \brief Write the dof of the maps dofScalMap_ or dofVecMap_ in the order of vertexBuffer_ and edgeBuffer_
+    void WriteDOFFiles(Uint numUnkVertex, const std::string& name, const std::string& path);
+
+    // Binary output and input of the shards
+    template <typename T>
+    static void WriteBuffer(std::ofstream&, const std::vector<T>&);
+    template <typename T>
+    static void ReadBuffer(std::ifstream&, std::vector<T>&, Uint num);
+    // Read the names of the shards from the index file
+    static std::vector<std::string> ReadShardIndex(const std::string& file);
+    // Append the simplices of a shard to the buffers
+    void ReadShard(const std::string& file);
+
   public:
   	/// \brief Constructor
     ParMGSerializationCL(const MultiGridCL& mg, const std::string& path, int master=Drops_MasterC)
@@ -447,6 +475,17 @@ class ParMGSerializationCL
 
     /// \brief Write dofs into a file
     void WriteDOF(const VecDescCL*, const std::string&,const std::string path ="");
+
+    /// \brief Each process writes its simplices into an own file, the master writes an index file
+    /// \param path An alternative output-path
+    void WriteMGShards (const std::string path="");
+    /// \brief Each process writes its dofs into an own file, the master writes an index file
+    void WriteDOFShards(const VecDescCL*, const std::string&, const std::string path="");
+
+    /// \brief Read the shards written by WriteMGShards on an arbitrary number of processes and write the files of WriteMG; only called by one process, which reads all shards
+    void MergeShards   (const std::string path="");
+    /// \brief Read the shards written by WriteDOFShards and write the files of WriteDOF; MergeShards has to be called before
+    void MergeDOFShards(const std::string&, const std::string path="");
 };
 
 /// \brief Read dof from a file
@@ -468,16 +507,18 @@ class TwoPhaseSerializationCL : public ParMGSerializationCL
     std::string format_;
     int         digits_;
     LevelsetT&  Levelset_;
+    bool        sharded_;
     using base::path_;
 
   public:
+    /// \param sharded each process writes its own files, see WriteMGShards
     TwoPhaseSerializationCL(const MultiGridCL& mg, const std::string& path,
                             StokesT& Stokes, LevelsetT& Levelset,
-                            bool overwrite=true, Uint maxtimesteps=100)
+                            bool overwrite=true, Uint maxtimesteps=100, bool sharded=false)
       : base(mg, path, ProcCL::Master()), overwrite_(overwrite), Stokes_(Stokes), localTimeStep_(0),
         format_("%0*d"),
         digits_((int)std::ceil(std::log((double)(maxtimesteps!=0 ? maxtimesteps+1 : 2))/std::log((double)10))),
-        Levelset_(Levelset) {}
+        Levelset_(Levelset), sharded_(sharded) {}
 
     /// \brief Write information about geometry, pressure, velocity and level-set into files
     void Serialize(int timestep=-1);
@@ -503,15 +544,29 @@ template <typename StokesT, typename LevelsetT>
             char buffer[72];
             std::sprintf(buffer, format_.c_str(), digits_, (timestep<0 ? localTimeStep_++ : timestep));
             std::string new_path= path_+"/TimeStep_"+buffer+"/";
-            if (ProcCL::IamMaster()){
-                if (CreateDirectory(new_path)) throw ParSerializeErrCL("TwoPhaseSerializationCL::Serialize: Cannot create directory", 0);
+            int failed=0;
+            if (ProcCL::IamMaster())
+                failed= CreateDirectory(new_path);
+            // all processes throw, if the master cannot create the directory; otherwise,
+            // the directory exists, when the processes receive the broadcast
+            ProcCL::Bcast(&failed, 1, ProcCL::Master());
+            if (failed) throw ParSerializeErrCL("TwoPhaseSerializationCL::Serialize: Cannot create directory", 0);
+            // with sharded_ set, all processes write into the new directory
+            if (ProcCL::IamMaster() || sharded_)
                 path_=new_path;
-            }
         }
-        base::WriteMG();
-        base::WriteDOF(&(Stokes_.v),     "velocity");
-        base::WriteDOF(&(Stokes_.p),     "pressure");
-        base::WriteDOF(&(Levelset_.Phi), "level-set");
+        if (sharded_){
+            base::WriteMGShards();
+            base::WriteDOFShards(&(Stokes_.v),     "velocity");
+            base::WriteDOFShards(&(Stokes_.p),     "pressure");
+            base::WriteDOFShards(&(Levelset_.Phi), "level-set");
+        }
+        else{
+            base::WriteMG();
+            base::WriteDOF(&(Stokes_.v),     "velocity");
+            base::WriteDOF(&(Stokes_.p),     "pressure");
+            base::WriteDOF(&(Levelset_.Phi), "level-set");
+        }
         base::Clear();
         path_= old_path;
     }
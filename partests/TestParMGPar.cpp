@@ -0,0 +1,183 @@
+/// \file TestParMGPar.cpp
+/// \brief tests the parallel multigrid solver with agglomerated coarse levels for a P1 Poisson problem
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+// include parallel computing!
+#include "parallel/parallel.h"
+#include "parallel/parmultigrid.h"
+#include "parallel/loadbal.h"
+#include "parallel/exchange.h"
+
+ // include geometric computing
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+
+ // include numeric computing!
+#include "num/fe.h"
+#include "num/discretize.h"
+#include "num/bndData.h"
+#include "num/solver.h"
+#include "num/parsolver.h"
+#include "num/parprecond.h"
+#include "num/parMGsolver.h"
+#include "num/sparsedirect.h"
+
+ // include standards
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        IF_MASTER
+            std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief Local part of the P1 stiffness matrix of the Laplacian on the level of idx; if b!=0, the load vector of f=1 is set up, too.
+void SetupLaplace (const MultiGridCL& mg, const IdxDescCL& idx, MatrixCL& A, VectorCL* b)
+{
+    const Uint n= idx.NumUnknowns(), num= idx.GetIdx();
+    MatrixBuilderCL B( &A, n, n);
+    if (b)
+        b->resize( n);
+    Point3DCL G[4];
+    double det;
+    IdxT unk[4];
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, idx.TriangLevel(), it) {
+        P1DiscCL::GetGradients( G, det, *it);
+        const double absdet= std::fabs( det);
+        for (int i= 0; i < 4; ++i)
+            unk[i]= it->GetVertex( i)->Unknowns.Exist( num) ? it->GetVertex( i)->Unknowns( num) : NoIdx;
+        for (int i= 0; i < 4; ++i) {
+            if (unk[i] == NoIdx)
+                continue;
+            for (int j= 0; j < 4; ++j)
+                if (unk[j] != NoIdx)
+                    B( unk[i], unk[j])+= inner_prod( G[i], G[j])*absdet/6.;
+            if (b)
+                (*b)[unk[i]]+= absdet/24.;
+        }
+    }
+    B.Build();
+}
+
+typedef CoarseGridSolverCL<PCG_SsorCL> CoarseT;
+typedef ParMGSolverCL<CoarseT>         ParMGT;
+
+/// \brief Solves A x = b with the given agglomeration size; returns the number of cycles.
+int Solve (ParMGT& solver, size_t agglomSize, const MLMatrixCL& A, VectorCL& x, const VectorCL& b)
+{
+    solver.SetAgglomerationSize( agglomSize);
+    x= 0.;
+    solver.Solve( A, x, b);
+    IF_MASTER
+        std::cout << "agglomeration size " << agglomSize << ": " << solver.GetNumLevels() << " levels, "
+                  << solver.GetNumCoarseUnknowns() << " coarse unknowns, " << solver.GetIter()
+                  << " cycles, residual " << solver.GetResid() << std::endl;
+    return solver.GetIter();
+}
+
+int main (int argc, char** argv)
+{
+  DROPS::ProcInitCL procinit(&argc, &argv);
+  DROPS::ParMultiGridInitCL pmginit;
+  try
+  {
+#ifndef _PAR_MG
+    IF_MASTER
+        std::cout << "TestParMGPar needs multilevel indices; compile with _PAR_MG" << std::endl;
+    return 0;
+#endif
+    ParMultiGridCL pmg= ParMultiGridCL::Instance();
+
+    MGBuilderCL* mgb;
+    if (ProcCL::IamMaster())
+        mgb= new BrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 4, 4, 4);
+    else
+        mgb= new EmptyBrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3));
+    MultiGridCL mg(*mgb);
+    delete mgb;
+    pmg.AttachTo(mg);
+
+    LoadBalHandlerCL lb(mg, metis);
+    lb.DoInitDistribution(ProcCL::Master());
+    for (int ref=0; ref<3; ++ref){
+        MarkAll(mg);
+        pmg.Refine();
+        lb.DoMigration();
+    }
+
+    const BndCondT dir[6]= {DirBC, DirBC, DirBC, DirBC, DirBC, DirBC};
+    BndDataCL<double> bnd(6, dir);
+    MLIdxDescCL idx(P1_FE, mg.GetNumLevel());
+    idx.CreateNumbering(mg.GetLastLevel(), mg, bnd);
+
+    MLMatrixCL A(idx.size());
+    VectorCL b;
+    MLMatrixCL::iterator a= A.begin();
+    for (MLIdxDescCL::const_iterator it= idx.begin(); it != idx.end(); ++it, ++a)
+        SetupLaplace(mg, *it, *a, it == idx.GetFinestIter() ? &b : 0);
+    const ExchangeCL& ex= idx.GetFinest().GetEx();
+    const size_t numGlobal= ProcCL::GlobalSum(ex.GetNumExclusive());
+
+    SSORPcCL   ssor;
+    PCG_SsorCL pcg(ssor, 500, 1e-12, true);
+    CoarseT    coarse(pcg, /*direct*/ true);
+    ParMGT     solver(idx, coarse, 50, 1e-8, numGlobal, /*rel*/ true);
+    SetupP1ProlongationMatrix(mg, *solver.GetProlongation(), &idx, &idx);
+
+    // the finest level is agglomerated: the direct solver on the master solves the system at once
+    VectorCL xAgglom(b.size());
+    const int itAgglom= Solve(solver, numGlobal, A, xAgglom, b);
+    Check(solver.GetNumLevels()==1 && solver.GetNumCoarseUnknowns()==numGlobal, "agglomeration of the finest level");
+    Check(itAgglom<=1 && solver.GetResid()<=1e-8, "direct solve of the agglomerated finest level");
+
+    // only the coarsest level is agglomerated
+    const size_t numCoarse= ProcCL::GlobalSum(idx.GetCoarsest().GetEx().GetNumExclusive());
+    VectorCL x(b.size());
+    const int itMG= Solve(solver, numCoarse, A, x, b);
+    Check(solver.GetNumLevels()==idx.size() && solver.GetNumCoarseUnknowns()==numCoarse, "agglomeration of the coarsest level");
+    Check(solver.GetResid()<=1e-8 && itMG<30, "convergence of the V-cycle");
+    Check(ex.Norm(VectorCL(x - xAgglom), true)<=1e-6*ex.Norm(xAgglom, true), "same solution");
+
+    // reference: Jacobi-PCG
+    ParJac0CL jac(idx.GetFinest());
+    ParPCGSolverCL<ParJac0CL> cg(1000, 1e-8, idx.GetFinest(), jac, /*rel*/ true);
+    VectorCL xCG(b.size());
+    cg.Solve(A.GetFinest(), xCG, b);
+    IF_MASTER
+        std::cout << "Jacobi-PCG: " << cg.GetIter() << " iterations" << std::endl;
+    Check(itMG<cg.GetIter() && ex.Norm(VectorCL(x - xCG), true)<=1e-6*ex.Norm(xCG, true), "multigrid vs. PCG");
+
+    idx.DeleteNumbering(mg);
+    IF_MASTER
+        std::cout << "errors: " << err << std::endl;
+    return err!=0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,164 @@
+/// \file TestShardsPar.cpp
+/// \brief tests the sharded serialization: the merged shards must coincide with the output of WriteMG and WriteDOF
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+// include parallel computing!
+#include "parallel/parallel.h"
+#include "parallel/parmultigrid.h"
+#include "parallel/loadbal.h"
+#include "parallel/parmgserialization.h"
+
+ // include geometric computing
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+
+ // include problem class
+#include "misc/problem.h"
+#include "num/fe.h"
+#include "num/bndData.h"
+
+ // include standards
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace DROPS;
+
+/// \brief Prefixes of the gathered and of the sharded output
+const std::string GatherPrefix= "Gathered_", ShardPrefix= "Sharded_";
+
+double f (const Point3DCL& p, double= 0.)
+{
+    return p[0] + 2.*p[1] + 3.*p[2];
+}
+
+Point3DCL f_vec (const Point3DCL& p, double= 0.)
+{
+    return MakePoint3D( f( p), p[0]*p[1], -p[2]);
+}
+
+/// \brief Set the dof of vec to the values of f or f_vec
+void SetFunction (VecDescCL& vec, const MultiGridCL& mg)
+{
+    const Uint idx=vec.RowIdx->GetIdx();
+    for (MultiGridCL::const_TriangVertexIteratorCL sit(mg.GetTriangVertexBegin()); sit!=mg.GetTriangVertexEnd(); ++sit)
+        if (sit->Unknowns.Exist() && sit->Unknowns.Exist(idx)){
+            const Point3DCL val= f_vec(sit->GetCoord());
+            for (Uint i=0; i<vec.RowIdx->NumUnknownsVertex(); ++i)
+                vec.Data[sit->Unknowns(idx)+i]= vec.RowIdx->NumUnknownsVertex()==1 ? f(sit->GetCoord()) : val[i];
+        }
+    for (MultiGridCL::const_TriangEdgeIteratorCL sit(mg.GetTriangEdgeBegin()); sit!=mg.GetTriangEdgeEnd(); ++sit)
+        if (sit->Unknowns.Exist() && sit->Unknowns.Exist(idx)){
+            const Point3DCL val= f_vec(GetBaryCenter(*sit));
+            for (Uint i=0; i<vec.RowIdx->NumUnknownsEdge(); ++i)
+                vec.Data[sit->Unknowns(idx)+i]= vec.RowIdx->NumUnknownsEdge()==1 ? f(GetBaryCenter(*sit)) : val[i];
+        }
+}
+
+/// \brief True, if both files exist and have the same content
+bool SameFile (const std::string& name)
+{
+    std::ifstream gathered((GatherPrefix+name).c_str()), sharded((ShardPrefix+name).c_str());
+    if (!gathered || !sharded)
+        return false;
+    std::ostringstream g, s;
+    g << gathered.rdbuf();
+    s << sharded.rdbuf();
+    return g.str()==s.str();
+}
+
+int main (int argc, char** argv)
+{
+  DROPS::ProcInitCL procinit(&argc, &argv);
+  DROPS::ParMultiGridInitCL pmginit;
+  try
+  {
+    ParMultiGridCL pmg= ParMultiGridCL::Instance();
+
+    MGBuilderCL* mgb;
+    if (ProcCL::IamMaster())
+        mgb= new BrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 4, 4, 4);
+    else
+        mgb= new EmptyBrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3));
+    MultiGridCL mg(*mgb);
+    delete mgb;
+    pmg.AttachTo(mg);
+
+    LoadBalHandlerCL lb(mg, metis);
+    lb.DoInitDistribution(ProcCL::Master());
+    for (int ref=0; ref<2; ++ref){
+        MarkAll(mg);
+        pmg.Refine();
+        lb.DoMigration();
+    }
+
+    const BndCondT neu[6]= {Nat0BC, Nat0BC, Nat0BC, Nat0BC, Nat0BC, Nat0BC};
+    BndDataCL<double>    bnd(6, neu);
+    BndDataCL<Point3DCL> vbnd(6, neu);
+    IdxDescCL p2idx(P2_FE), vecp2idx(vecP2_FE);
+    p2idx.CreateNumbering(mg.GetLastLevel(), mg, bnd);
+    vecp2idx.CreateNumbering(mg.GetLastLevel(), mg, vbnd);
+    VecDescCL p2, vecp2;
+    p2.SetIdx(&p2idx);
+    vecp2.SetIdx(&vecp2idx);
+    SetFunction(p2, mg);
+    SetFunction(vecp2, mg);
+
+    // gathered on the master
+    {
+        ParMGSerializationCL ser(mg, GatherPrefix, ProcCL::Master());
+        ser.WriteMG();
+        ser.WriteDOF(&p2,    "scalar");
+        ser.WriteDOF(&vecp2, "vector");
+    }
+    // each process writes a shard, the master merges them
+    {
+        ParMGSerializationCL ser(mg, ShardPrefix, ProcCL::Master());
+        ser.WriteMGShards();
+        ser.WriteDOFShards(&p2,    "scalar");
+        ser.WriteDOFShards(&vecp2, "vector");
+    }
+    ProcCL::Barrier();
+
+    int err=0;
+    if (ProcCL::IamMaster()){
+        ParMGSerializationCL merger(mg, ShardPrefix, ProcCL::Master());
+        merger.MergeShards();
+        merger.MergeDOFShards("scalar");
+        merger.MergeDOFShards("vector");
+
+        const char* files[]= { "Vertices", "BoundaryVertices", "Edges", "Faces", "Tetras", "Children",
+                               "scalar_Vertices", "scalar_Edges", "vector_Vertices", "vector_Edges" };
+        for (Uint i=0; i<sizeof(files)/sizeof(files[0]); ++i)
+            if (!SameFile(files[i])){
+                ++err;
+                std::cout << "error: merged shards differ from the gathered output in " << files[i] << std::endl;
+            }
+        std::cout << ProcCL::Size() << " shards merged, errors: " << err << std::endl;
+    }
+    p2idx.DeleteNumbering(mg);
+    vecp2idx.DeleteNumbering(mg);
+    return ProcCL::GlobalMax(err)!=0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
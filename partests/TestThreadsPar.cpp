@@ -0,0 +1,177 @@
+/// \file TestThreadsPar.cpp
+/// \brief tests the OpenMP parallelized inner products and accumulation of ExchangeCL for several numbers of threads
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+// include parallel computing!
+#include "parallel/parallel.h"
+#include "parallel/parmultigrid.h"
+#include "parallel/loadbal.h"
+#include "parallel/exchange.h"
+
+ // include geometric computing
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+
+ // include problem class
+#include "misc/problem.h"
+#include "num/fe.h"
+#include "num/bndData.h"
+
+ // include standards
+#include <iostream>
+#include <cmath>
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        IF_MASTER
+            std::cout << "error: " << msg << std::endl;
+    }
+}
+
+bool Near (double a, double b)
+{
+    return std::fabs( a - b) <= 1e-10*std::fabs( b);
+}
+
+double f (const Point3DCL& p)
+{
+    return std::sin( p[0]) + p[1]*p[2];
+}
+
+/// \brief Set the dof of the accumulated vector x to the values of f
+void SetFunction (VectorCL& x, const IdxDescCL& idx, const MultiGridCL& mg)
+{
+    const Uint num= idx.GetIdx();
+    for (MultiGridCL::const_TriangVertexIteratorCL sit( mg.GetTriangVertexBegin()); sit != mg.GetTriangVertexEnd(); ++sit)
+        if (sit->Unknowns.Exist() && sit->Unknowns.Exist( num))
+            x[sit->Unknowns( num)]= f( sit->GetCoord());
+    for (MultiGridCL::const_TriangEdgeIteratorCL sit( mg.GetTriangEdgeBegin()); sit != mg.GetTriangEdgeEnd(); ++sit)
+        if (sit->Unknowns.Exist() && sit->Unknowns.Exist( num))
+            x[sit->Unknowns( num)]= f( GetBaryCenter( *sit));
+}
+
+/// \brief Results of the OpenMP parallelized members of ExchangeCL
+struct ResultsT
+{
+    double norm, dotAcc, dotDist, numUnknowns, accErr;
+};
+
+/// \brief Computes with the current number of threads: norms and inner products of accumulated and distributed vectors
+///     and the accumulation of a distributed vector.
+ResultsT Compute (const ExchangeCL& ex, const VectorCL& x)
+{
+    // multiplicity of the unknowns, i.e. the accumulated vector of ones on each proc
+    VectorCL mult( 1., x.size());
+    ex.Accumulate( mult);
+    // distributed form of x and of the vector of ones
+    const VectorCL xDist( x/mult), oneDist( 1./mult), one( 1., x.size());
+
+    ResultsT r;
+    r.norm=        ex.Norm( x, true);
+    r.dotAcc=      ex.ParDot( x, true, x, true);
+    r.dotDist=     ex.ParDot( xDist, false, x, true);
+    r.numUnknowns= ex.ParDot( oneDist, false, one, true);
+    VectorCL xAcc( xDist);
+    ex.Accumulate( xAcc);
+    r.accErr= ProcCL::GlobalMax( norm( VectorCL( xAcc - x)));
+    return r;
+}
+
+int main (int argc, char** argv)
+{
+  DROPS::ProcInitCL procinit(&argc, &argv);
+  DROPS::ParMultiGridInitCL pmginit;
+  try
+  {
+    ParMultiGridCL pmg= ParMultiGridCL::Instance();
+
+    MGBuilderCL* mgb;
+    if (ProcCL::IamMaster())
+        mgb= new BrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 8, 8, 8);
+    else
+        mgb= new EmptyBrickBuilderCL(std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3));
+    MultiGridCL mg(*mgb);
+    delete mgb;
+    pmg.AttachTo(mg);
+
+    LoadBalHandlerCL lb(mg, metis);
+    lb.DoInitDistribution(ProcCL::Master());
+    for (int ref=0; ref<2; ++ref){
+        MarkAll(mg);
+        pmg.Refine();
+        lb.DoMigration();
+    }
+
+    const BndCondT neu[6]= {Nat0BC, Nat0BC, Nat0BC, Nat0BC, Nat0BC, Nat0BC};
+    BndDataCL<double> bnd(6, neu);
+    IdxDescCL idx(P2_FE);
+    idx.CreateNumbering(mg.GetLastLevel(), mg, bnd);
+    const ExchangeCL& ex= idx.GetEx();
+    VectorCL x(idx.NumUnknowns());
+    SetFunction(x, idx, mg);
+    const double numGlobal= ProcCL::GlobalSum(ex.GetNumExclusive());
+    IF_MASTER
+        std::cout << numGlobal << " unknowns, ExchangeCL runs multithreaded above " << ExchangeOmpMinSizeC
+                  << " local unknowns\n";
+    Check(ProcCL::GlobalMin(static_cast<int>(idx.NumUnknowns())) > ExchangeOmpMinSizeC, "local vectors too small for the threaded code");
+
+#ifdef _OPENMP
+    const int maxThreads= omp_get_max_threads();
+    omp_set_num_threads(1);
+#else
+    const int maxThreads= 1;
+#endif
+    const ResultsT ref= Compute(ex, x);
+    Check(Near(ref.dotAcc, ref.norm*ref.norm) && Near(ref.dotDist, ref.dotAcc), "inner products with one thread");
+    Check(Near(ref.numUnknowns, numGlobal) && ref.accErr <= 1e-12*ref.norm, "accumulation with one thread");
+
+    for (int threads= 2; threads <= std::max(maxThreads, 4); threads*= 2) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        const ResultsT r= Compute(ex, x);
+        IF_MASTER
+            std::cout << threads << " threads: norm " << r.norm << ", dot " << r.dotAcc << ", unknowns " << r.numUnknowns << '\n';
+        Check(Near(r.norm, ref.norm) && Near(r.dotAcc, ref.dotAcc) && Near(r.dotDist, ref.dotDist), "inner products with several threads");
+        Check(Near(r.numUnknowns, numGlobal) && r.accErr <= 1e-12*ref.norm, "accumulation with several threads");
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+
+    idx.DeleteNumbering(mg);
+    IF_MASTER
+        std::cout << "errors: " << err << std::endl;
+    return err!=0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
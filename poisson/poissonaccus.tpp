@@ -170,6 +170,8 @@ class SourceAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::geom_cache_;
+    using                           base_::geom_pos_;
     SUPGCL& supg_;
     bool    ALE_;
     QuadCL<> rhs;
@@ -205,7 +207,7 @@ void SourceAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& sit)
       UnknownIdx[i]= sit.GetVertex(i)->Unknowns.Exist(idx) ? sit.GetVertex(i)->Unknowns(idx) : NoIdx;
     }
 
-    P1DiscCL::GetGradients(G,det,sit);
+    P1DiscCL::GetGradients(G,det,sit,geom_cache_,geom_pos_);
     absdet= std::fabs(det);
 
     if(supg_.GetSUPG())
@@ -273,6 +275,8 @@ class StiffnessAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::geom_cache_;
+    using                           base_::geom_pos_;
     SUPGCL& supg_;
     bool   ALE_;
     public:
@@ -300,7 +304,7 @@ template<class Coeff,template <class T=double> class QuadCL>
 void StiffnessAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& sit)
 {
     Quad2CL<> quad_a;
-    P1DiscCL::GetGradients(G,det,sit);
+    P1DiscCL::GetGradients(G,det,sit,geom_cache_,geom_pos_);
     absdet= std::fabs(det);
     quad_a.assign( sit, Coeff_.alpha, 0.0);                  //for variable diffusion coefficient
     const double int_a= quad_a.quad( absdet);
@@ -364,6 +368,8 @@ class MassAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::geom_cache_;
+    using                           base_::geom_pos_;
     SUPGCL& supg_;
     bool   ALE_;
     public:
@@ -392,7 +398,7 @@ template<class Coeff,template <class T=double> class QuadCL>
 void MassAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& sit)
 {
 
-    P1DiscCL::GetGradients(G,det,sit);
+    P1DiscCL::GetGradients(G,det,sit,geom_cache_,geom_pos_);
     absdet= std::fabs(det);
     bool with_supg = supg_.GetSUPG();
     instat_vector_fun_ptr vel;
@@ -449,6 +455,8 @@ class ConvectionAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::geom_cache_;
+    using                           base_::geom_pos_;
     bool    ALE_;
     bool adjoint;
     public:
@@ -476,7 +484,7 @@ void ConvectionAccumulator_P1CL<Coeff,QuadCL>::visit (const TetraCL& sit)
 template<class Coeff,template <class T=double> class QuadCL>
 void ConvectionAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& sit)
 {
-    P1DiscCL::GetGradients(G,det,sit);
+    P1DiscCL::GetGradients(G,det,sit,geom_cache_,geom_pos_);
     absdet= std::fabs(det);
 
     for(int i=0; i<4; ++i)
@@ -26,6 +26,7 @@
 #include "num/accumulator.h"
 #include "num/quadrature.h"
 #include "num/lattice-eval.h"
+#include "misc/instrument.h"
 
 extern DROPS::ParamCL P;
 
@@ -1350,7 +1351,32 @@ void LocalSystem1TwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, c
     }
 }
 
+void SetupLocalSystem1_P2 (const TwoPhaseFlowCoeffCL& Coeff, const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<>& ls,
+                           SMatrixCL<3,3> Ak[10][10], double M[10][10])
+{
+    LocalSystem1DataCL loc;
+    if (equal_signs( ls)) {
+        const double phase= sign( ls[0]) > 0 ? 1.0 : -1.0;
+        LocalSystem1OnePhase_P2CL local_onephase( Coeff.mu( phase), Coeff.rho( phase));
+        local_onephase.setup( T, absdet, loc);
+    }
+    else {
+        LocalSystem1TwoPhase_P2CL local_twophase( Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.rho( 1.0), Coeff.rho( -1.0));
+        local_twophase.setup( T, absdet, ls, loc);
+    }
+    add_transpose_kronecker_id( loc.Ak, loc.A);
+    for (int i= 0; i < 10; ++i)
+        for (int j= 0; j < 10; ++j) {
+            Ak[i][j]= loc.Ak[i][j];
+            M[i][j]= loc.M[j][i];
+        }
+}
+
 /// \brief Accumulator to set up the matrices A, M and, if requested the right-hand side b and cplM, cplA for two-phase flow.
+///
+/// If oldPhi is given, A, M, b, cplA, cplM are not set up, but updated from the level set function oldPhi to lset.Phi:
+/// Only the contributions of tetras, on which the phases changed, are subtracted and added again. Tetras, on which
+/// the level set function changed by at most tol, are skipped.
 class System1Accumulator_P2CL : public TetraAccumulatorCL
 {
   private:
@@ -1358,6 +1384,10 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
     const StokesBndDataCL& BndData;
     const LevelsetP2CL& lset;
     double t;
+    const VecDescCL* oldPhi; ///< level set function of the matrices to be updated; 0 for a complete setup
+    double tol;
+    size_t  numPatched;
+    size_t* numPatchedPtr;   ///< number of updated tetras, shared by the clones
 
     IdxDescCL& RowIdx;
     MatrixCL& A;
@@ -1368,6 +1398,8 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
     SparseMatBuilderCL<double, SMatrixCL<3,3> >* mA_;
     SparseMatBuilderCL<double, SDiagMatrixCL<3> >* mM_;
+    SparseMatPatchCL<double, SMatrixCL<3,3> >* pA_;
+    SparseMatPatchCL<double, SDiagMatrixCL<3> >* pM_;
 
     LocalSystem1OnePhase_P2CL local_onephase; ///< used on tetras in a single phase
     LocalSystem1TwoPhase_P2CL local_twophase; ///< used on intersected tetras
@@ -1377,20 +1409,23 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
     SMatrixCL<3,3> T;
     double det, absdet;
-    LocalP2CL<> ls_loc;
+    LocalP2CL<> ls_loc, ls_old;
 
     Quad2CL<Point3DCL> rhs;
     Point3DCL loc_b[10], dirichlet_val[10]; ///< Used to transfer boundary-values from local_setup() update_global_system().
 
-    ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
-    void local_setup (const TetraCL& tet);
-    ///\brief Update the global system.
-    void update_global_system ();
+    ///\brief Computes the mapping from local to global data "n", the local matrices in loc for the level set values ls and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
+    void local_setup (const TetraCL& tet, const LocalP2CL<>& ls);
+    ///\brief Update the global system; the local contributions are scaled by s.
+    template <class BuilderAT, class BuilderMT>
+    void update_global_system (BuilderAT& mA, BuilderMT& mM, double s= 1.);
+    ///\brief True, if the contribution of the tetra differs for ls_old and ls_loc.
+    bool changed () const;
 
   public:
     System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const StokesBndDataCL& BndData_,
         const LevelsetP2CL& ls, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t);
+        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t, const VecDescCL* oldPhi_= 0, double tol_= 0.);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -1404,14 +1439,22 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
 System1Accumulator_P2CL::System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_,
     const LevelsetP2CL& lset_arg, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_)
-    : Coeff( Coeff_), BndData( BndData_), lset( lset_arg), t( t_),
-      RowIdx( RowIdx_), A( A_), M( M_), cplA( cplA_), cplM( cplM_), b( b_),
+    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_, const VecDescCL* oldPhi_, double tol_)
+    : Coeff( Coeff_), BndData( BndData_), lset( lset_arg), t( t_), oldPhi( oldPhi_), tol( tol_),
+      numPatched( 0), numPatchedPtr( &numPatched),
+      RowIdx( RowIdx_), A( A_), M( M_), cplA( cplA_), cplM( cplM_), b( b_), mA_( 0), mM_( 0), pA_( 0), pM_( 0),
       local_twophase( Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.rho( 1.0), Coeff.rho( -1.0))
 {}
 
 void System1Accumulator_P2CL::begin_accumulation ()
 {
+    if (oldPhi != 0) {
+        std::cout << "entering UpdateSystem1_P2CL: ";
+        numPatched= 0;
+        pA_= new SparseMatPatchCL<double, SMatrixCL<3,3> >( &A);
+        pM_= new SparseMatPatchCL<double, SDiagMatrixCL<3> >( &M);
+        return;
+    }
     std::cout << "entering SetupSystem1_P2CL: ";
     const size_t num_unks_vel= RowIdx.NumUnknowns();
     mA_= new SparseMatBuilderCL<double, SMatrixCL<3,3> >( &A, num_unks_vel, num_unks_vel);
@@ -1425,6 +1468,15 @@ void System1Accumulator_P2CL::begin_accumulation ()
 
 void System1Accumulator_P2CL::finalize_accumulation ()
 {
+    if (oldPhi != 0) {
+        pA_->Build();
+        delete pA_;
+        pM_->Build();
+        delete pM_;
+        std::cout << numPatched << " tetras updated\n";
+        DROPS_COUNT( "updated tetras", numPatched);
+        return;
+    }
     mA_->Build();
     delete mA_;
     mM_->Build();
@@ -1436,28 +1488,50 @@ void System1Accumulator_P2CL::finalize_accumulation ()
     std::cout << '\n';
 }
 
+bool System1Accumulator_P2CL::changed () const
+{
+    if (equal_signs( ls_loc) && equal_signs( ls_old) && sign( ls_loc[0]) == sign( ls_old[0]))
+        return false; // both in the same phase: the local matrices coincide
+    for (Uint i= 0; i < 10; ++i)
+        if (std::fabs( ls_loc[i] - ls_old[i]) > tol)
+            return true;
+    return false;
+}
+
 void System1Accumulator_P2CL::visit (const TetraCL& tet)
 {
-    local_setup( tet);
-    update_global_system();
+    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
+    if (oldPhi == 0) {
+        local_setup( tet, ls_loc);
+        update_global_system( *mA_, *mM_);
+        return;
+    }
+    ls_old.assign( tet, *oldPhi, lset.GetBndData());
+    if (!changed())
+        return;
+    local_setup( tet, ls_old);
+    update_global_system( *pA_, *pM_, -1.);
+    local_setup( tet, ls_loc);
+    update_global_system( *pA_, *pM_);
+#   pragma omp atomic
+    ++*numPatchedPtr;
 }
 
-void System1Accumulator_P2CL::local_setup (const TetraCL& tet)
+void System1Accumulator_P2CL::local_setup (const TetraCL& tet, const LocalP2CL<>& ls)
 {
-    GetTrafoTr( T, det, tet);
+    GetTrafoTr( T, det, tet, geom_cache_, geom_pos_);
     absdet= std::fabs( det);
 
     rhs.assign( tet, Coeff.volforce, t);
     n.assign( tet, RowIdx, BndData.Vel);
 
-    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
-    if (equal_signs( ls_loc)) {
-        local_onephase.mu(  local_twophase.mu(  sign( ls_loc[0])));
-        local_onephase.rho( local_twophase.rho( sign( ls_loc[0])));
+    if (equal_signs( ls)) {
+        local_onephase.mu(  local_twophase.mu(  sign( ls[0])));
+        local_onephase.rho( local_twophase.rho( sign( ls[0])));
         local_onephase.setup( T, absdet, loc);
     }
     else
-        local_twophase.setup( T, absdet, ls_loc, loc);
+        local_twophase.setup( T, absdet, ls, loc);
     add_transpose_kronecker_id( loc.Ak, loc.A);
 
     if (b != 0) {
@@ -1474,25 +1548,23 @@ void System1Accumulator_P2CL::local_setup (const TetraCL& tet)
     }
 }
 
-void System1Accumulator_P2CL::update_global_system ()
+template <class BuilderAT, class BuilderMT>
+void System1Accumulator_P2CL::update_global_system (BuilderAT& mA, BuilderMT& mM, double s)
 {
-    SparseMatBuilderCL<double, SMatrixCL<3,3> >& mA= *mA_;
-    SparseMatBuilderCL<double, SDiagMatrixCL<3> >& mM= *mM_;
-
     for(int i= 0; i < 10; ++i)    // assemble row Numb[i]
         if (n.WithUnknowns( i)) { // dof i is not on a Dirichlet boundary
             for(int j= 0; j < 10; ++j) {
                 if (n.WithUnknowns( j)) { // dof j is not on a Dirichlet boundary
-                    mA( n.num[i], n.num[j])+= loc.Ak[i][j];
-                    mM( n.num[i], n.num[j])+= SDiagMatrixCL<3>( loc.M[j][i]);
+                    mA( n.num[i], n.num[j])+= s*loc.Ak[i][j];
+                    mM( n.num[i], n.num[j])+= SDiagMatrixCL<3>( s*loc.M[j][i]);
                 }
                 else if (b != 0) { // right-hand side for eliminated Dirichlet-values
-                    add_to_global_vector( cplA->Data, -loc.Ak[i][j]*dirichlet_val[j], n.num[i]);
-                    add_to_global_vector( cplM->Data, -loc.M[j][i] *dirichlet_val[j], n.num[i]);
+                    add_to_global_vector( cplA->Data, -s*(loc.Ak[i][j]*dirichlet_val[j]), n.num[i]);
+                    add_to_global_vector( cplM->Data, -s*loc.M[j][i] *dirichlet_val[j], n.num[i]);
                 }
             }
             if (b != 0) // assemble the right-hand side
-                add_to_global_vector( b->Data, loc_b[i], n.num[i]);
+                add_to_global_vector( b->Data, s*loc_b[i], n.num[i]);
        }
 }
 
@@ -1511,6 +1583,16 @@ void SetupSystem1_P2( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_,
     // std::cout << "setup: " << time.GetTime() << " seconds" << std::endl;
 }
 
+void UpdateSystem1_P2( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_, MatrixCL& A, MatrixCL& M,
+                       VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, const VecDescCL& oldPhi, double tol, IdxDescCL& RowIdx, double t)
+/// Update matrices A, M and rhs b, which were set up for the level set function oldPhi
+{
+    System1Accumulator_P2CL accu( Coeff_, BndData_, lset, RowIdx, A, M, b, cplA, cplM, t, &oldPhi, tol);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &accu);
+    accumulate( accus, MG_, RowIdx.TriangLevel(), RowIdx.GetMatchingFunction(), RowIdx.GetBndInfo());
+}
+
 
 void SetupSystem1_P2R( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_, MatrixCL& A, MatrixCL& M,
                          VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, IdxDescCL& RowIdx, double t)
@@ -1825,6 +1907,23 @@ void InstatStokes2PhaseP2P1CL::SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, Vec
             throw DROPSErrCL("InstatStokes2PhaseP2P1CL<Coeff>::SetupSystem1 not implemented for this FE type");
 }
 
+void InstatStokes2PhaseP2P1CL::UpdateSystem1( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset,
+    const VecDescCL& oldPhi, double tol, double t) const
+{
+    if (oldPhi.RowIdx != lset.Phi.RowIdx)
+        throw DROPSErrCL("InstatStokes2PhaseP2P1CL::UpdateSystem1: oldPhi and lset.Phi must have the same numbering");
+    MLMatrixCL::iterator itA = A->Data.begin();
+    MLMatrixCL::iterator itM = M->Data.begin();
+    MLIdxDescCL::iterator it = A->RowIdx->begin();
+    for (size_t lvl=0; lvl < A->Data.size(); ++lvl, ++itA, ++itM, ++it)
+        if (it->GetFE()==vecP2_FE)
+            UpdateSystem1_P2( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lset, oldPhi, tol, *it, t);
+        else if (it->GetFE()==vecP2R_FE) // the extended basis depends on the interface: complete setup
+            SetupSystem1_P2R( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lset, *it, t);
+        else
+            throw DROPSErrCL("InstatStokes2PhaseP2P1CL<Coeff>::UpdateSystem1 not implemented for this FE type");
+}
+
 MLTetraAccumulatorTupleCL&
 InstatStokes2PhaseP2P1CL::system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const
 {
@@ -2223,7 +2322,7 @@ void LBAccumulator_P2CL::visit (const TetraCL& tet)
 
 void LBAccumulator_P2CL::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
+    GetTrafoTr( T, det, tet, geom_cache_, geom_pos_);
 
     n.assign( tet, RowIdx, BndData.Vel);
     local_twophase.setup( T, ls_loc, tet, locA);
@@ -133,6 +133,13 @@ class TwoPhaseFlowCoeffCL
         }
 };
 
+/// \brief Computes the local matrices of A and M on a tetra with the level set values ls.
+///
+/// Ak[i][j] is the 3x3-block of A, M[i][j] the scalar factor of the diagonal block of M for the P2-basis functions i and j.
+/// This is used by matrix-free operators, which store the local matrices of the tetras cut by the interface.
+void SetupLocalSystem1_P2 (const TwoPhaseFlowCoeffCL& Coeff, const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<>& ls,
+                           SMatrixCL<3,3> Ak[10][10], double M[10][10]);
+
 /// problem class for instationary two-pase Stokes flow
 
 
@@ -197,6 +204,10 @@ class InstatStokes2PhaseP2P1CL : public ProblemCL<TwoPhaseFlowCoeffCL, StokesBnd
     /// Set up matrices A, M and rhs b (depending on phase bnd)
     void SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
     MLTetraAccumulatorTupleCL& system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
+    /// Update matrices A, M and rhs b, which were set up by SetupSystem1 for the level set function oldPhi, to the level set function lset.Phi.
+    /// Only tetras, on which the phases differ and the level set function changed by more than tol, are reassembled.
+    void UpdateSystem1( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset,
+                        const VecDescCL& oldPhi, double tol, double t) const;
     /// Set up rhs b (depending on phase bnd)
     void SetupRhs1( VecDescCL* b, const LevelsetP2CL& lset, double t) const;
     /// Set up the Laplace-Beltrami-Operator
@@ -24,6 +24,7 @@
 
 #include "stokes/integrTime.h"
 #include "num/stokessolver.h"
+#include <limits>
 
 namespace DROPS
 {
@@ -41,6 +42,88 @@ static void Regularize (MatrixCL& Bs, const IdxDescCL& rowidx, VectorCL ker0, co
 }
 #endif
 
+// Sum of the absolute values of the entries of row i of A.
+static inline double AbsRowSum (const MatrixCL& A, size_t i)
+{
+    const size_t*  rb= A.raw_row();
+    const double* val= A.raw_val();
+    double s= 0.;
+    for (size_t k= rb[i]; k < rb[i+1]; ++k)
+        s+= std::fabs( val[k]);
+    return s;
+}
+
+void PcRefreshCL::Watch (const MatrixCL* A0, const MatrixCL* A1, const MatrixCL* A2, const MatrixCL* A3)
+{
+    const MatrixCL* mat[4]= { A0, A1, A2, A3 };
+    watch_.clear();
+    for (int i= 0; i < 4; ++i)
+        if (mat[i] != 0) {
+            watch_.push_back( WatchCL());
+            watch_.back().mat= mat[i];
+        }
+    force_= true;
+}
+
+double PcRefreshCL::Drift (const WatchCL& w) const
+{
+    const MatrixCL& A= *w.mat;
+    if (A.num_rows() != w.rows || A.num_cols() != w.cols || w.rowsum.size() != A.num_rows())
+        return std::numeric_limits<double>::max();
+
+    double diff= 0., ref= 0.;
+    for (size_t i= 0; i < A.num_rows(); ++i) {
+        diff= std::max( diff, std::fabs( AbsRowSum( A, i) - w.rowsum[i]));
+        ref=  std::max( ref,  std::fabs( w.rowsum[i]));
+    }
+#ifdef _PAR
+    diff= ProcCL::GlobalMax( diff);
+    ref=  ProcCL::GlobalMax( ref);
+#endif
+    return ref > 0. ? diff/ref : (diff > 0. ? std::numeric_limits<double>::max() : 0.);
+}
+
+void PcRefreshCL::Store ()
+{
+    for (std::vector<WatchCL>::iterator w= watch_.begin(); w != watch_.end(); ++w) {
+        const MatrixCL& A= *w->mat;
+        w->version= A.Version();
+        w->rows= A.num_rows();
+        w->cols= A.num_cols();
+        if (tol_ <= 0.)
+            continue;
+        w->rowsum.resize( A.num_rows());
+        for (size_t i= 0; i < A.num_rows(); ++i)
+            w->rowsum[i]= AbsRowSum( A, i);
+    }
+}
+
+bool PcRefreshCL::Check ()
+{
+    bool changed= force_;
+    for (std::vector<WatchCL>::const_iterator w= watch_.begin(); w != watch_.end() && !changed; ++w)
+        changed= w->mat->Version() != w->version;
+    if (!changed)
+        return false;
+
+    bool refresh= force_ || tol_ <= 0. || skipped_ >= maxSkip_;
+    for (std::vector<WatchCL>::iterator w= watch_.begin(); w != watch_.end() && !refresh; ++w)
+        if (w->mat->Version() != w->version) {
+            refresh= Drift( *w) > tol_;
+            w->version= w->mat->Version();
+        }
+    if (!refresh) {
+        ++skipped_;
+        ++numSkip_;
+        return false;
+    }
+    Store();
+    force_= false;
+    skipped_= 0;
+    ++numRefresh_;
+    return true;
+}
+
 void ISMGPreCL::MaybeInitOnes() const
 {
     if (Mpr_.size() == ones_.size()) return;
@@ -53,14 +136,29 @@ void ISMGPreCL::MaybeInitOnes() const
     }
 }
 
+void ISMGPreCL::MaybeRefresh() const
+{
+    if (watchA_ != Apr_.GetFinestPtr() || watchM_ != Mpr_.GetFinestPtr() || watchLevels_ != Apr_.size()) {
+        watchA_= Apr_.GetFinestPtr();
+        watchM_= Mpr_.GetFinestPtr();
+        watchLevels_= Apr_.size();
+        refresh_.Watch( watchA_, watchM_);
+    }
+    const bool refresh= refresh_.Check();
+    // with tolerance 0, the copies follow each change of the hierarchies, also on the coarse levels only
+    if (refresh || refresh_.GetTol() <= 0.) {
+        Aprf_.Get( Apr_);
+        Mprf_.Get( Mpr_);
+    }
+}
+
 void ISBBTPreCL::Update() const
 {
     IF_MASTER
-      std::cout << "ISBBTPreCL::Update: old version: " << Bversion_
-                << "\tnew version: " << B_->Version() << '\n';
+      std::cout << "ISBBTPreCL::Update: version of B: " << B_->Version()
+                << "\trefreshs/skips: " << refresh_.GetNumRefresh() << '/' << refresh_.GetNumSkip() << '\n';
     delete Bs_;
     Bs_= new MatrixCL( *B_);
-    Bversion_= B_->Version();
 
 #ifndef _PAR
     VectorCL Dvelinv( 1.0/ Mvel_->GetDiag());
@@ -91,15 +189,11 @@ void ISBBTPreCL::Update() const
 #ifndef _PAR
 void MinCommPreCL::Update() const
 {
-    std::cout << "MinCommPreCL::Update: old/new versions: " << Aversion_  << '/' << A_->Version()
-        << '\t' << Bversion_ << '/' << B_->Version() << '\t' << Mversion_ << '/' << M_->Version()
-        << '\t' << Mvelversion_ << '/' << Mvel_->Version() << '\n';
+    std::cout << "MinCommPreCL::Update: versions: " << A_->Version() << '\t' << B_->Version()
+        << '\t' << M_->Version() << '\t' << Mvel_->Version()
+        << "\trefreshs/skips: " << refresh_.GetNumRefresh() << '/' << refresh_.GetNumSkip() << '\n';
     delete Bs_;
     Bs_= new MatrixCL( *B_);
-    Aversion_= A_->Version();
-    Bversion_= B_->Version();
-    Mversion_= M_->Version();
-    Mvelversion_= Mvel_->Version();
 
     Assert( Mvel_->GetDiag().min() > 0., "MinCommPreCL::Update: Mvel_->GetDiag().min() <= 0\n", DebugNumericC);
     VectorCL Dvelsqrt( std::sqrt( Mvel_->GetDiag()));
@@ -120,15 +214,11 @@ void MinCommPreCL::Update() const
 
 void BDinvBTPreCL::Update() const
 {
-    std::cout << "BDinvBTPreCL::Update: old/new versions: " << Lversion_  << '/' << L_->Version()
-        << '\t' << Bversion_ << '/' << B_->Version() << '\t' << Mversion_ << '/' << M_->Version()
-        << '\t' << Mvelversion_ << '/' << Mvel_->Version() << '\n';
+    std::cout << "BDinvBTPreCL::Update: versions: " << L_->Version() << '\t' << B_->Version()
+        << '\t' << M_->Version() << '\t' << Mvel_->Version()
+        << "\trefreshs/skips: " << refresh_.GetNumRefresh() << '/' << refresh_.GetNumSkip() << '\n';
     delete Bs_;
     Bs_= new MatrixCL( *B_);
-    Lversion_= L_->Version();
-    Bversion_= B_->Version();
-    Mversion_= M_->Version();
-    Mvelversion_= Mvel_->Version();
 
     Dvelinv_.resize( Mvel_->num_rows());
     if (lumped_)
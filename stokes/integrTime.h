@@ -192,6 +192,51 @@ const double StokesFracStepSchemeCL<BaseMethod, StokesT, SolverT>::theta_[3]
 template<typename, typename>
 class ApproximateSchurComplMatrixCL;
 
+/// \brief Decides, whether a preconditioner has to be set up again after its matrices changed (lazy refresh).
+/** The matrices are watched via SparseMatBaseCL::Version(). If a version changed, the drift
+    max_i |s_i - s_i^0| / max_i |s_i^0| of the row sums s_i= sum_j |a_ij| against the state at the last refresh is
+    computed. The preconditioner is refreshed, if a dimension changed, if the drift of one matrix exceeds the
+    tolerance or if maxSkip changes have been ignored in a row. With tolerance 0 (default), each change triggers a
+    refresh without computing the drift. */
+class PcRefreshCL
+{
+  private:
+    struct WatchCL
+    {
+        const MatrixCL* mat;
+        size_t   version;       ///< version at the last check
+        size_t   rows, cols;    ///< dimensions at the last refresh
+        VectorCL rowsum;        ///< row sums at the last refresh
+    };
+    std::vector<WatchCL> watch_;
+    bool   force_;              ///< refresh at the next check
+    double tol_;
+    int    maxSkip_, skipped_;
+    Ulint  numRefresh_, numSkip_;
+
+    /// \brief Returns the drift of w.mat; infinity, if the dimensions changed.
+    double Drift (const WatchCL& w) const;
+    /// \brief Stores the dimensions and row sums of all watched matrices.
+    void Store ();
+
+  public:
+    PcRefreshCL (double tol= 0., int maxSkip= 10)
+        : force_( true), tol_( tol), maxSkip_( maxSkip), skipped_( 0), numRefresh_( 0), numSkip_( 0) {}
+
+    void SetTol (double tol, int maxSkip= 10) { tol_= tol; maxSkip_= maxSkip; }
+    double GetTol () const { return tol_; }
+
+    /// \brief Watches the given matrices (null pointers are ignored); the next call of Check() returns true.
+    void Watch (const MatrixCL* A0, const MatrixCL* A1= 0, const MatrixCL* A2= 0, const MatrixCL* A3= 0);
+    /// \brief Forces a refresh at the next call of Check().
+    void Invalidate () { force_= true; }
+    /// \brief Returns true, if the preconditioner has to be set up again; the state of the matrices is stored in this case.
+    bool Check ();
+
+    Ulint GetNumRefresh () const { return numRefresh_; } ///< number of refreshs
+    Ulint GetNumSkip    () const { return numSkip_; }    ///< number of ignored changes
+};
+
 /// base class for Schur complement preconditioners
 class SchurPreBaseCL: public PreBaseCL
 {
@@ -203,6 +248,8 @@ class SchurPreBaseCL: public PreBaseCL
     SchurPreBaseCL( double kA, double kM, std::ostream* output=0) : PreBaseCL( output), kA_( kA), kM_( kM) {}
     virtual ~SchurPreBaseCL() {}
     void SetWeights( double kA, double kM) { kA_ = kA; kM_ = kM; }
+    double GetWeightA() const { return kA_; }
+    double GetWeightM() const { return kM_; }
 
     virtual void Apply( const MatrixCL& A,   VectorCL& x, const VectorCL& b) const = 0;
     virtual void Apply( const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const = 0;
@@ -232,19 +279,26 @@ class ISPreCL : public SchurPreBaseCL
     MatrixCL& A_;
     MatrixCL& M_;
     SSORPcCL  ssor_;
+    bool      single_;                                          ///< apply the SSOR-steps in single precision
+    mutable FloatMatrixCacheCL Af_, Mf_;                        ///< single precision copies of A_ and M_
+    mutable FloatVectorCL pf_, p2f_, cf_;
 
   public:
     ISPreCL( MatrixCL& A_pr, MatrixCL& M_pr,
         double kA= 0., double kM= 1., double om= 1.)
-        : SchurPreBaseCL( kA, kM), A_( A_pr), M_( M_pr), ssor_( om)  {}
+        : SchurPreBaseCL( kA, kM), A_( A_pr), M_( M_pr), ssor_( om), single_( false)  {}
     ISPreCL( MLMatrixCL& A_pr, MLMatrixCL& M_pr,
              double kA= 0., double kM= 1., double om= 1.)
-    : SchurPreBaseCL( kA, kM), A_( A_pr.GetFinest()), M_( M_pr.GetFinest()), ssor_( om)  {}
+    : SchurPreBaseCL( kA, kM), A_( A_pr.GetFinest()), M_( M_pr.GetFinest()), ssor_( om), single_( false)  {}
 
     template <typename Mat, typename Vec>
     void Apply(const Mat&, Vec& p, const Vec& c) const;
     void Apply(const MatrixCL& A,   VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
+
+    /// \brief Store and apply the pressure matrices in single precision.
+    void SetSinglePrecision (bool single) { single_= single; Af_.Clear(); Mf_.Clear(); }
+    bool GetSinglePrecision () const { return single_; }
 };
 
 
@@ -346,14 +400,29 @@ class ISMGPreCL : public SchurPreBaseCL
     DROPS::Uint iter_prM_;
     mutable std::vector<DROPS::VectorCL> ones_;
 
+    bool single_;                                               ///< run the V-cycles in single precision
+    mutable FloatMatrixCacheCL Aprf_, Mprf_, Pf_;               ///< single precision copies of Apr_, Mpr_, P_
+    mutable std::vector<FloatVectorCL> onesf_;
+    mutable FloatVectorCL pf_, cf_;
+    MGCycleParamCL param_;                                      ///< cycles for the pressure and the mass matrix
+    mutable PcRefreshCL refresh_;                               ///< decides on the conversion of Apr_, Mpr_ to single precision
+    mutable const MatrixCL* watchA_, * watchM_;                 ///< finest levels watched by refresh_
+    mutable size_t watchLevels_;                                ///< number of levels at the last call of Watch()
+
     void MaybeInitOnes() const;
+    /// \brief Converts Apr_ and Mpr_ to single precision, if refresh_ demands it.
+    void MaybeRefresh() const;
+    /// \brief The preconditioner for the given hierarchies; used in double and in single precision.
+    template <typename MLMat, typename Vec>
+    void DoApply (const MLMat& Apr, const MLMat& Mpr, const MLMat& P, const std::vector<Vec>& ones, Vec& p, const Vec& c) const;
 
   public:
     ISMGPreCL(DROPS::MLMatrixCL& A_pr, DROPS::MLMatrixCL& M_pr,
                     double kA, double kM, DROPS::Uint iter_prA=1,
                     DROPS::Uint iter_prM = 1)
         : SchurPreBaseCL( kA, kM), sm( 1), lvl( -1), omega( 1.0), smoother( omega), solver( directpc, 200, 1e-12),
-          Apr_( A_pr), Mpr_( M_pr), iter_prA_( iter_prA), iter_prM_( iter_prM), ones_(0)
+          Apr_( A_pr), Mpr_( M_pr), iter_prA_( iter_prA), iter_prM_( iter_prM), ones_(0), single_( false),
+          watchA_( 0), watchM_( 0), watchLevels_( 0)
     {}
 
     template <typename Mat, typename Vec>
@@ -363,6 +432,19 @@ class ISMGPreCL : public SchurPreBaseCL
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
 
     MLMatrixCL* GetProlongation() { return &P_; }
+
+    /// \brief Store and apply the multigrid hierarchies in single precision.
+    /// The coarse grid problem is still solved in double precision (MGCoarseSolve), so the tolerance of the coarse
+    /// grid solver is not changed.
+    void SetSinglePrecision (bool single) { single_= single; Aprf_.Clear(); Mprf_.Clear(); Pf_.Clear(); onesf_.clear(); refresh_.Invalidate(); }
+    bool GetSinglePrecision () const { return single_; }
+    /// \brief Lazy refresh of the single precision copies of the hierarchies (cf. PcRefreshCL); the drift is measured on the
+    /// finest levels. In double precision, the cycles run on the current hierarchies, as there is nothing else to set up.
+    void SetRefreshTol (double tol, int maxSkip= 10) { refresh_.SetTol( tol, maxSkip); }
+    const PcRefreshCL& GetRefresh () const { return refresh_; }
+    /// \brief Cycle type and growth of the smoothing steps on coarser levels; the other members of param are not used.
+    void SetCycleParam (const MGCycleParamCL& param) { param_= param; param_.stat= 0; }
+    const MGCycleParamCL& GetCycleParam () const { return param_; }
 };
 
 
@@ -379,11 +461,12 @@ class ISBBTPreCL : public SchurPreBaseCL
   private:
     const MatrixCL*  B_;
     mutable MatrixCL*  Bs_;                                     ///< scaled Matrix B
-    mutable size_t Bversion_;
+    mutable PcRefreshCL refresh_;                               ///< decides on the refresh of Bs_ after changes of B
     const MatrixCL*  M_, *Mvel_;
 
     double     tolA_, tolM_;                                    ///< tolerances of the solvers
     mutable VectorCL Dprsqrtinv_;                               ///< diag(M)^{-1/2}
+    mutable VectorCL c2_, p2_;                                  ///< work vectors of Apply
 #ifndef _PAR
     typedef NEGSPcCL SPcT_;
     SPcT_            spc_;
@@ -410,15 +493,15 @@ class ISBBTPreCL : public SchurPreBaseCL
     ISBBTPreCL (const MatrixCL* B, const MatrixCL* M_pr, const MatrixCL* Mvel,
         const IdxDescCL& pr_idx,
         double kA= 0., double kM= 1., double tolA= 1e-2, double tolM= 1e-2, double regularize= 0.)
-        : SchurPreBaseCL( kA, kM), B_( B), Bs_( 0), Bversion_( 0),
+        : SchurPreBaseCL( kA, kM), B_( B), Bs_( 0),
           M_( M_pr), Mvel_( Mvel), tolA_(tolA), tolM_(tolM),
           solver_( spc_, 500, tolA_, /*relative*/ true),
           solver2_( jacpc_, 500, tolM_, /*relative*/ true),
-          pr_idx_( &pr_idx), regularize_( regularize) {}
+          pr_idx_( &pr_idx), regularize_( regularize) { refresh_.Watch( B_); }
 
     ISBBTPreCL (const ISBBTPreCL& pc)
         : SchurPreBaseCL( pc.kA_, pc.kM_), B_( pc.B_), Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)),
-          Bversion_( pc.Bversion_),
+          refresh_( pc.refresh_),
           M_( pc.M_), Mvel_( pc.Mvel_),
           tolA_(pc.tolA_), tolM_(pc.tolM_),
           Dprsqrtinv_( pc.Dprsqrtinv_),
@@ -430,16 +513,16 @@ class ISBBTPreCL : public SchurPreBaseCL
     ISBBTPreCL (const MatrixCL* B, const MatrixCL* M_pr, const MatrixCL* Mvel,
         const IdxDescCL& pr_idx, const IdxDescCL& vel_idx,
         double kA= 0., double kM= 1., double tolA= 1e-2, double tolM= 1e-2, double regularize= 0.)
-        : SchurPreBaseCL( kA, kM), B_( B), Bs_( 0), Bversion_( 0),
+        : SchurPreBaseCL( kA, kM), B_( B), Bs_( 0),
           M_( M_pr), Mvel_( Mvel), tolA_(tolA), tolM_(tolM),
           BBT_( 0, TRANSP_MUL, 0, MUL, vel_idx, pr_idx),
           PCsolver1_( pr_idx), PCsolver2_(pr_idx),
           solver_( 800, tolA_, pr_idx, PCsolver1_, /*relative*/ true, /*accure*/ true),
           solver2_( 500, tolM_, pr_idx, PCsolver2_, /*relative*/ true),
-          vel_idx_( &vel_idx), pr_idx_( &pr_idx), regularize_( regularize) {}
+          vel_idx_( &vel_idx), pr_idx_( &pr_idx), regularize_( regularize) { refresh_.Watch( B_); }
     ISBBTPreCL (const ISBBTPreCL& pc)
         : SchurPreBaseCL( pc.kA_, pc.kM_), B_( pc.B_), Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)),
-          Bversion_( pc.Bversion_),
+          refresh_( pc.refresh_),
           M_( pc.M_), Mvel_( pc.Mvel_),
           tolA_(pc.tolA_), tolM_(pc.tolM_),
           Dprsqrtinv_( pc.Dprsqrtinv_),
@@ -475,22 +558,27 @@ class ISBBTPreCL : public SchurPreBaseCL
         Mvel_= Mvel;
         M_= M;
         pr_idx_= pr_idx;
-        Bversion_ = 0;
+        refresh_.Watch( B_);
     }
+    /// \brief Set up the preconditioner again only if the row sums of B drift by more than tol (see PcRefreshCL).
+    void SetRefreshTol (double tol, int maxSkip= 10) { refresh_.SetTol( tol, maxSkip); }
+    const PcRefreshCL& GetRefresh () const { return refresh_; }
 };
 
 template <typename Mat, typename Vec>
 void ISBBTPreCL::Apply(const Mat&, Vec& p, const Vec& c) const
 {
-    if (B_->Version() != Bversion_)
+    if (refresh_.Check())
         Update();
 
     p= 0.0;
     if (kA_ != 0.0) {
+        resize_work( c2_, c.size());
+        c2_= Dprsqrtinv_*c;
 #ifndef _PAR
-        solver_.Solve( *Bs_, p, VectorCL( Dprsqrtinv_*c));
+        solver_.Solve( *Bs_, p, c2_);
 #else
-        solver_.Solve( BBT_, p, VectorCL( Dprsqrtinv_*c));
+        solver_.Solve( BBT_, p, c2_);
 #endif
 //            std::cout << "ISBBTPreCL p: iterations: " << solver_.GetIter()
 //                       << "\tresidual: " <<  solver_.GetResid();
@@ -502,7 +590,8 @@ void ISBBTPreCL::Apply(const Mat&, Vec& p, const Vec& c) const
         p= kA_*(Dprsqrtinv_*p);
     }
     if (kM_ != 0.0) {
-        Vec p2_( c.size());
+        resize_work( p2_, c.size());
+        p2_= 0.;
         solver2_.Solve( *M_, p2_, c);
 //            std::cout << "\tISBBTPreCL p2: iterations: " << solver2_.GetIter()
 //                       << "\tresidual: " <<  solver2_.GetResid()
@@ -528,8 +617,9 @@ class MinCommPreCL : public SchurPreBaseCL
   private:
     const MatrixCL* A_, *B_, *Mvel_, *M_;
     mutable MatrixCL* Bs_;
-    mutable size_t Aversion_, Bversion_, Mvelversion_, Mversion_;
+    mutable PcRefreshCL refresh_;                               ///< decides on the refresh after changes of A, B, Mvel
     mutable VectorCL Dprsqrtinv_, Dvelsqrtinv_;
+    mutable VectorCL y_, z_, t_, u_, w_;                        ///< work vectors of Apply
     double  tol_;
 
     typedef NEGSPcCL SPcT_;
@@ -544,16 +634,13 @@ class MinCommPreCL : public SchurPreBaseCL
     MinCommPreCL (const MatrixCL* A, MatrixCL* B, MatrixCL* Mvel, MatrixCL* M_pr, const IdxDescCL& pr_idx,
                   double tol=1e-2, double regularize= 0.0)
         : SchurPreBaseCL( 0, 0), A_( A), B_( B), Mvel_( Mvel), M_( M_pr), Bs_( 0),
-          Aversion_( 0), Bversion_( 0), Mvelversion_( 0), Mversion_( 0),
           tol_(tol),
           spc_( /*symmetric GS*/ true), solver_( spc_, 200, tol_, /*relative*/ true),
-          pr_idx_( &pr_idx), regularize_( regularize) {}
+          pr_idx_( &pr_idx), regularize_( regularize) { refresh_.Watch( A_, B_, Mvel_); }
 
     MinCommPreCL (const MinCommPreCL & pc)
         : SchurPreBaseCL( pc.kA_, pc.kM_), A_( pc.A_), B_( pc.B_), Mvel_( pc.Mvel_), M_( pc.M_),
-          Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)),
-          Aversion_( pc.Aversion_), Bversion_( pc.Bversion_), Mvelversion_( pc.Mvelversion_),
-          Mversion_( pc.Mversion_),
+          Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)), refresh_( pc.refresh_),
           Dprsqrtinv_( pc.Dprsqrtinv_), Dvelsqrtinv_( pc.Dvelsqrtinv_), tol_(pc.tol_),
           spc_( pc.spc_), solver_( spc_, 200, tol_, /*relative*/ true),
           pr_idx_( pc.pr_idx_), regularize_( pc.regularize_) {}
@@ -569,7 +656,7 @@ class MinCommPreCL : public SchurPreBaseCL
     void Apply(const MatrixCL& A,   VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
 
-    void SetMatrixA  (const MatrixCL* A) { A_= A; }
+    void SetMatrixA  (const MatrixCL* A) { A_= A; refresh_.Watch( A_, B_, Mvel_); }
     void SetMatrices (const MatrixCL* A, const MatrixCL* B, const MatrixCL* Mvel, const MatrixCL* M,
                       const IdxDescCL* pr_idx) {
         A_= A;
@@ -577,31 +664,43 @@ class MinCommPreCL : public SchurPreBaseCL
         Mvel_= Mvel;
         M_= M;
         pr_idx_= pr_idx;
-        Aversion_ = Bversion_ = Mvelversion_ = Mversion_ = 0;
+        refresh_.Watch( A_, B_, Mvel_);
     }
+    /// \brief Set up the preconditioner again only if the row sums of A, B or Mvel drift by more than tol (see PcRefreshCL).
+    void SetRefreshTol (double tol, int maxSkip= 10) { refresh_.SetTol( tol, maxSkip); }
+    const PcRefreshCL& GetRefresh () const { return refresh_; }
 };
 
 template <typename Mat, typename Vec>
   void
   MinCommPreCL::Apply (const Mat&, Vec& x, const Vec& b) const
 {
-    if ((A_->Version() != Aversion_) || (Mvel_->Version() != Mvelversion_) || (B_->Version() != Bversion_))
+    if (refresh_.Check())
         Update();
 
-    VectorCL y( b.size());
-    solver_.Solve( *Bs_, y, VectorCL( Dprsqrtinv_*b));
+    resize_work( z_, b.size());
+    z_= Dprsqrtinv_*b;
+    resize_work( y_, b.size());
+    y_= 0.;
+    solver_.Solve( *Bs_, y_, z_);
     if (solver_.GetIter() == solver_.GetMaxIter())
         std::cout << "MinCommPreCL::Apply: 1st BBT-solve: " << solver_.GetIter()
                   << '\t' << solver_.GetResid() << '\n';
-    y*= Dprsqrtinv_;
-    VectorCL z( Dprsqrtinv_*((*B_)*VectorCL( Dvelsqrtinv_*Dvelsqrtinv_*
-        ( (*A_)*VectorCL( Dvelsqrtinv_*Dvelsqrtinv_*transp_mul( *B_, y)) ))));
-    VectorCL t( b.size());
-    solver_.Solve( *Bs_, t, z);
+    y_*= Dprsqrtinv_;
+    // z_= Dprsqrtinv_*B*Dvelinv*A*Dvelinv*B^T*y_
+    y_ATx( u_, *B_, y_);
+    u_*= Dvelsqrtinv_*Dvelsqrtinv_;
+    y_Ax( w_, *A_, u_);
+    w_*= Dvelsqrtinv_*Dvelsqrtinv_;
+    y_Ax( z_, *B_, w_);
+    z_*= Dprsqrtinv_;
+    resize_work( t_, b.size());
+    t_= 0.;
+    solver_.Solve( *Bs_, t_, z_);
     if (solver_.GetIter() == solver_.GetMaxIter())
         std::cout << "MinCommPreCL::Apply: 2nd BBT-solve: " << solver_.GetIter()
                   << '\t' << solver_.GetResid() << '\n';
-    x= Dprsqrtinv_*t;
+    x= Dprsqrtinv_*t_;
 }
 
 //**************************************************************************
@@ -615,8 +714,9 @@ class BDinvBTPreCL: public SchurPreBaseCL
   private:
     const MatrixCL* L_, *B_, *Mvel_, *M_;
     mutable MatrixCL* Bs_;
-    mutable size_t Lversion_, Bversion_, Mvelversion_, Mversion_;
+    mutable PcRefreshCL refresh_;                               ///< decides on the refresh after changes of L, B, Mvel, M
     mutable VectorCL Dprsqrtinv_, Dvelinv_, DSchurinv_;
+    mutable VectorCL y_, b2_;                                   ///< work vectors of Apply
     double  tol_;
     mutable DiagPcCL diagVelPc_, diagSchurPc_;
     typedef ApproximateSchurComplMatrixCL<DiagPcCL,MatrixCL> AppSchurComplMatrixT;
@@ -631,16 +731,14 @@ class BDinvBTPreCL: public SchurPreBaseCL
   public:
     BDinvBTPreCL (const MatrixCL* L, MatrixCL* B, MatrixCL* M_vel, MatrixCL* M_pr, const IdxDescCL& pr_idx,
                   double tol=1e-2, double regularize= 0.0)
-        : SchurPreBaseCL( 0, 0), L_( L), B_( B), Mvel_( M_vel), M_( M_pr), Bs_( 0),
-          Lversion_( 0), Bversion_( 0), Mvelversion_( 0), Mversion_( 0), tol_(tol),
+        : SchurPreBaseCL( 0, 0), L_( L), B_( B), Mvel_( M_vel), M_( M_pr), Bs_( 0), tol_(tol),
           diagVelPc_(Dvelinv_), diagSchurPc_(DSchurinv_), BDinvBT_(0),
           solver_( diagSchurPc_, 200,  tol_, /*relative*/ true), pr_idx_( &pr_idx),
-          regularize_( regularize), lumped_(false) {}
+          regularize_( regularize), lumped_(false) { refresh_.Watch( L_, B_, Mvel_, M_); }
 
     BDinvBTPreCL (const BDinvBTPreCL & pc)
         : SchurPreBaseCL( pc.kA_, pc.kM_), L_( pc.L_), B_( pc.B_), Mvel_( pc.Mvel_), M_( pc.M_),
-          Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)),
-          Lversion_( pc.Lversion_), Bversion_( pc.Bversion_), Mversion_( pc.Mversion_),
+          Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)), refresh_( pc.refresh_),
           Dprsqrtinv_( pc.Dprsqrtinv_), Dvelinv_( pc.Dvelinv_), DSchurinv_( pc.DSchurinv_), tol_(pc.tol_),
           diagVelPc_( Dvelinv_), diagSchurPc_( DSchurinv_), BDinvBT_(0),
           solver_( diagSchurPc_, 200, tol_, /*relative*/ true), pr_idx_( pc.pr_idx_),
@@ -657,7 +755,7 @@ class BDinvBTPreCL: public SchurPreBaseCL
     void Apply(const MatrixCL& A,   VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
 
-    void SetMatrixA  (const MatrixCL* L) { L_= L; }
+    void SetMatrixA  (const MatrixCL* L) { L_= L; refresh_.Watch( L_, B_, Mvel_, M_); }
     void SetMatrices (const MatrixCL* L, const MatrixCL* B, const MatrixCL* M_vel, const MatrixCL* M_pr,
                       const IdxDescCL* pr_idx) {
         L_= L;
@@ -665,33 +763,45 @@ class BDinvBTPreCL: public SchurPreBaseCL
         Mvel_= M_vel;
         M_= M_pr;
         pr_idx_= pr_idx;
-        Lversion_ = Bversion_ = Mvelversion_= Mversion_ = 0;
+        refresh_.Watch( L_, B_, Mvel_, M_);
     }
+    /// \brief Set up the preconditioner again only if the row sums of L, B, Mvel or M drift by more than tol (see PcRefreshCL).
+    void SetRefreshTol (double tol, int maxSkip= 10) { refresh_.SetTol( tol, maxSkip); }
+    const PcRefreshCL& GetRefresh () const { return refresh_; }
     /// Returns true, if the lumped diag of the velocity mass matrix is used, and false, if the diagonal of the velocity convection-diffusion-reaction matrix is considered.
     bool UsesMassLumping() const { return lumped_; }
     /// For lump==true, the lumped diag of the velocity mass matrix is used. Otherwise the diagonal of the velocity convection-diffusion-reaction matrix is considered.
     void SetMassLumping( bool lump) { lumped_= lump; }
     /// If lumping is switched on, the lumped diag of the velocity mass matrix is returned. Otherwise the diagonal of the velocity convection-diffusion-reaction matrix is returned.
     VectorCL GetVelDiag() const { 
-        if ((L_->Version() != Lversion_) || (Mvel_->Version() != Mvelversion_))
+        if (refresh_.Check())
             Update();
         return VectorCL(1.0/Dvelinv_); 
     }
+    /// Inverse of GetVelDiag(); the reference stays valid until the next update of the preconditioner.
+    const VectorCL& GetVelDiagInv() const {
+        if (refresh_.Check())
+            Update();
+        return Dvelinv_;
+    }
 };
 
 template <typename Mat, typename Vec>
   void
   BDinvBTPreCL::Apply (const Mat&, Vec& x, const Vec& b) const
 {
-    if ((L_->Version() != Lversion_) || (Mvel_->Version() != Mvelversion_) || (M_->Version() != Mversion_) || (B_->Version() != Bversion_))
+    if (refresh_.Check())
         Update();
 
-    Vec y( b.size());
-    solver_.Solve( *BDinvBT_, y, Vec( Dprsqrtinv_*b));
+    resize_work( b2_, b.size());
+    b2_= Dprsqrtinv_*b;
+    resize_work( y_, b.size());
+    y_= 0.;
+    solver_.Solve( *BDinvBT_, y_, b2_);
     if (solver_.GetIter() == solver_.GetMaxIter())
         std::cout << "BDinvBTPreCL::Apply: BLBT-solve: " << solver_.GetIter()
                   << '\t' << solver_.GetResid() << '\n';
-    x= Dprsqrtinv_*y;
+    x= Dprsqrtinv_*y_;
 }
 #endif
 
@@ -720,6 +830,17 @@ void InstatStokesThetaSchemeCL<StokesT,SolverT>::DoStep( VectorCL& v, VectorCL&
 template <typename Mat, typename Vec>
 void ISPreCL::Apply(const Mat&, Vec& p, const Vec& c) const
 {
+    if (single_) {
+        convert_vector( cf_, c);
+        resize_work( pf_, c.size());
+        resize_work( p2f_, c.size());
+        ssor_.Apply( Af_.Get( A_), pf_, cf_);
+        ssor_.Apply( Mf_.Get( M_), p2f_, cf_);
+        pf_*= static_cast<float>( kA_);
+        pf_+= static_cast<float>( kM_)*p2f_;
+        convert_vector( p, pf_);
+        return;
+    }
 //    double new_res;
 //    double old_res= norm( c);
     ssor_.Apply( A_, p, c);
@@ -808,48 +929,57 @@ std::cout << "norm( p2): " << norm( p2_);
 }
 */
 
-template<class SmootherCL, class DirectSolverCL>
+template<class SmootherCL, class DirectSolverCL, class OnesT, class MLMatT, class ProlongationT, class Vec>
 void
-MGMPr(const std::vector<VectorCL>::const_iterator& ones,
-      const MLMatrixCL::const_iterator& begin, const MLMatrixCL::const_iterator& fine,
-      MLMatrixCL::const_iterator P, VectorCL& x, const VectorCL& b,
+MGMPr(const OnesT& ones, const MLMatT& A, const ProlongationT& P, size_t fine,
+      Vec& x, const Vec& b,
       const SmootherCL& Smoother, const Uint smoothSteps,
-      DirectSolverCL& Solver, const int numLevel, const int numUnknDirect)
-// Multigrid method, V-cycle. If numLevel==0 or #Unknowns <= numUnknDirect,
+      DirectSolverCL& Solver, const int numLevel, const int numUnknDirect,
+      const MGCycleParamCL& param= MGCycleParamCL())
+// Multigrid method, V-, W- or F-cycle, cf. MGM. If numLevel==0 or #Unknowns <= numUnknDirect,
 // the direct solver Solver is used.
 // If one of the parameters is -1, it will be neglected.
-// If MLMatrixCL.begin() has been reached, the direct solver is used too.
+// If the coarsest level 0 has been reached, the direct solver is used too.
+// ones contains the normalized constant functions of all levels; the finest levels of ones, A and P correspond to each other.
 // Concerning the stabilization see Hackbusch Multigrid-Methods and Applications;
 // Basically we project on the orthogonal complement of the kernel of A before
 // the coarse-grid correction.
 {
-    MLMatrixCL::const_iterator coarse = fine;
-    MLMatrixCL::const_iterator coarseP= P;
+    const size_t fineOnes= CorrespondingLevel( A, ones, fine);
     if(  ( numLevel==-1      ? false : numLevel==0 )
        ||( numUnknDirect==-1 ? false : x.size() <= static_cast<Uint>(numUnknDirect) )
-       || fine==begin)
+       || fine==0)
     { // use direct solver
-        Solver.Solve( *fine, x, b);
-        x-= dot( *ones, x);
+        MGCoarseSolve( Solver, A.GetLevel( fine), x, b);
+        x-= dot( ones[fineOnes], x);
         return;
     }
-    --coarse;
-    --coarseP;
+    const size_t coarse= fine - 1,
+                 fineP= CorrespondingLevel( A, P, fine);
     // presmoothing
-    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( *fine, x, b);
+    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( A.GetLevel( fine), x, b);
     // restriction of defect
-    VectorCL d( transp_mul( *P, VectorCL( b - (*fine)*x)));
-    d-= dot( *(ones-1), d);
-    VectorCL e( d.size());
+    Vec d( transp_mul( P.GetLevel( fineP), Vec( b - A.GetLevel( fine)*x)));
+    d-= dot( ones[fineOnes - 1], d);
+    Vec e( d.size());
     // calculate coarse grid correction
-    MGMPr( ones-1, begin, coarse, coarseP, e, d, Smoother, smoothSteps, Solver, (numLevel==-1 ? -1 : numLevel-1), numUnknDirect);
+    const Uint coarseSteps= param.CoarseSmoothSteps( smoothSteps);
+    const int  coarseLevel= numLevel==-1 ? -1 : numLevel-1;
+    MGMPr( ones, A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, param);
+    if (param.cycle == MG_WCycle)
+        MGMPr( ones, A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, param);
+    else if (param.cycle == MG_FCycle) {
+        MGCycleParamCL vparam( param);
+        vparam.cycle= MG_VCycle;
+        MGMPr( ones, A, P, coarse, e, d, Smoother, coarseSteps, Solver, coarseLevel, numUnknDirect, vparam);
+    }
     // add coarse grid correction
-    x+= (*P) * e;
+    x+= P.GetLevel( fineP) * e;
     // postsmoothing
-    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( *fine, x, b);
+    for (Uint i=0; i<smoothSteps; ++i) Smoother.Apply( A.GetLevel( fine), x, b);
     // This projection could probably be avoided, but it is cheap and with it,
     // we are on the safe side.
-    x-= dot( *ones, x);
+    x-= dot( ones[fineOnes], x);
 }
 
 
@@ -858,28 +988,48 @@ void
 ISMGPreCL::Apply(const Mat& /*A*/, Vec& p, const Vec& c) const
 {
     MaybeInitOnes();
-    p= 0.0;
-    const Vec c2_( c - dot( ones_.back(), c));
-    MLMatrixCL::const_iterator finestP = --P_.end();
+    if (!single_) {
+        DoApply( Apr_, Mpr_, P_, ones_, p, c);
+        return;
+    }
+    if (onesf_.size() != ones_.size() || onesf_.back().size() != ones_.back().size()) {
+        onesf_.resize( ones_.size());
+        for (size_t i= 0; i < ones_.size(); ++i)
+            convert_vector( onesf_[i], ones_[i]);
+    }
+    MaybeRefresh();
+    convert_vector( cf_, c);
+    resize_work( pf_, c.size());
+    DoApply( Aprf_.GetLast(), Mprf_.GetLast(), Pf_.Get( P_), onesf_, pf_, cf_);
+    convert_vector( p, pf_);
+}
+
+template <typename MLMat, typename Vec>
+void
+ISMGPreCL::DoApply (const MLMat& Apr, const MLMat& Mpr, const MLMat& P, const std::vector<Vec>& ones, Vec& p, const Vec& c) const
+{
+    typedef typename Vec::value_type T;
+    p= T( 0.);
+    const Vec c2_( c - dot( ones.back(), c));
 //    double new_res= (Apr_.back().A.Data*p - c).norm();
 //    double old_res;
 //    std::cout << "Pressure: iterations: " << iter_prA_ <<'\t';
     for (DROPS::Uint i=0; i<iter_prA_; ++i) {
-        DROPS::MGMPr( ones_.end()-1, Apr_.begin(), --Apr_.end(), finestP, p, c2_, smoother, sm, solver, lvl, -1);
+        DROPS::MGMPr( ones, Apr, P, Apr.size() - 1, p, c2_, smoother, sm, solver, lvl, -1, param_);
 //        old_res= new_res;
 //        std::cout << " residual: " <<  (new_res= (Apr_.back().A.Data*p - c).norm()) << '\t';
 //        std::cout << " reduction: " << new_res/old_res << '\n';
     }
-    p*= kA_;
+    p*= T( kA_);
 //    std::cout << " residual: " <<  (Apr_.back().A.Data*p - c).norm() << '\t';
 
     Vec p2( p.size());
     for (DROPS::Uint i=0; i<iter_prM_; ++i)
-        DROPS::MGM( Mpr_.begin(), --Mpr_.end(), finestP, p2, c, smoother, sm, solver, lvl, -1);
+        DROPS::MGM( Mpr, P, Mpr.size() - 1, p2, c, smoother, sm, solver, lvl, -1, param_);
 //    std::cout << "Mass: iterations: " << iter_prM_ << '\t'
 //              << " residual: " <<  (Mpr_.back().A.Data*p2 - c).norm() << '\n';
 
-    p+= kM_*p2;
+    p+= T( kM_)*p2;
 }
 
 }    // end of namespace DROPS
@@ -322,7 +322,7 @@ void StokesSystem1Accumulator_P2CL<CoeffT>::visit (const TetraCL& tet)
 template< class CoeffT>
 void StokesSystem1Accumulator_P2CL<CoeffT>::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
+    GetTrafoTr( T, det, tet, geom_cache_, geom_pos_);
     absdet= std::fabs( det);
 
     rhs.assign( tet, Coeff.f, t);
@@ -478,7 +478,7 @@ template< class CoeffT>
 void System2Accumulator_P2P1CL<CoeffT>::visit (const TetraCL& tet)
 {
     double det;
-    GetTrafoTr( T, det, tet);
+    GetTrafoTr( T, det, tet, geom_cache_, geom_pos_);
     P2DiscCL::GetGradients( Grad, GradRef, T);
     absdet= std::fabs( det);
     n.assign( tet, ColIdx, BndData.Vel);
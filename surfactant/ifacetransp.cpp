@@ -81,7 +81,7 @@ void SetupInterfaceMassP1OnTriangle (const LocalP1CL<> p1[4],
     }
 }
 
-void SetupInterfaceMassP1 (const MultiGridCL& MG, MatDescCL* matM, const VecDescCL& ls, const BndDataCL<>& lsetbnd)
+void SetupInterfaceMassP1 (const MultiGridCL& MG, MatDescCL* matM, const VecDescCL& ls, const BndDataCL<>& lsetbnd, const InterfaceBandCL* band)
 {
     const IdxT num_unks=  matM->RowIdx->NumUnknowns();
     MatrixBuilderCL M( &matM->Data, num_unks,  num_unks);
@@ -95,7 +95,7 @@ void SetupInterfaceMassP1 (const MultiGridCL& MG, MatDescCL* matM, const VecDesc
     Quad5_2DCL<double> q[4], m;
 
     InterfaceTriangleCL triangle;
-    DROPS_FOR_TRIANG_CONST_TETRA( MG, lvl, it) {
+    DROPS_FOR_BAND_CONST_TETRA( band, MG, lvl, it) {
         triangle.Init( *it, ls, lsetbnd);
 
         GetLocalNumbP1NoBnd( Numb, *it, *matM->RowIdx);
@@ -128,7 +128,7 @@ void SetupLBP1OnTriangle (InterfaceTriangleCL& triangle, int tri, Point3DCL grad
         }
 }
 
-void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsetbnd, double D)
+void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsetbnd, double D, const InterfaceBandCL* band)
 {
     const IdxT num_rows= mat->RowIdx->NumUnknowns();
     const IdxT num_cols= mat->ColIdx->NumUnknowns();
@@ -146,7 +146,7 @@ void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, cons
 
     InterfaceTriangleCL triangle;
 
-    DROPS_FOR_TRIANG_CONST_TETRA( mg, lvl, it) {
+    DROPS_FOR_BAND_CONST_TETRA( band, mg, lvl, it) {
     	triangle.Init( *it, ls, lsetbnd);
         if (triangle.Intersects()) { // We are at the phase boundary.
             GetLocalNumbP1NoBnd( numr, *it, *mat->RowIdx);
@@ -242,7 +242,7 @@ void SetupMixedMassP1OnTriangle (const BaryCoordCL triangle[3], double det,
     }
 }
 
-void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsetbnd)
+void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsetbnd, const InterfaceBandCL* band)
 {
     const IdxT rows= mat->RowIdx->NumUnknowns(),
                cols= mat->ColIdx->NumUnknowns();
@@ -259,7 +259,7 @@ void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& l
     double coup[4][4];
     InterfaceTriangleCL triangle;
 
-    DROPS_FOR_TRIANG_CONST_TETRA( mg, lvl, it) {
+    DROPS_FOR_BAND_CONST_TETRA( band, mg, lvl, it) {
     	triangle.Init( *it, ls, lsetbnd);
         if (!triangle.Intersects()) continue; // We are at the phase boundary.
 
@@ -286,7 +286,7 @@ void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& l
 }
 
 void SetupInterfaceRhsP1 (const MultiGridCL& mg, VecDescCL* v,
-    const VecDescCL& ls, const BndDataCL<>& lsetbnd, instat_scalar_fun_ptr f)
+    const VecDescCL& ls, const BndDataCL<>& lsetbnd, instat_scalar_fun_ptr f, const InterfaceBandCL* band)
 {
     const IdxT num_unks= v->RowIdx->NumUnknowns();
     const Uint lvl = v->GetLevel();
@@ -301,7 +301,7 @@ void SetupInterfaceRhsP1 (const MultiGridCL& mg, VecDescCL* v,
 
     InterfaceTriangleCL triangle;
 
-    DROPS_FOR_TRIANG_CONST_TETRA( mg, lvl, it) {
+    DROPS_FOR_BAND_CONST_TETRA( band, mg, lvl, it) {
         triangle.Init( *it, ls, lsetbnd);
         if (triangle.Intersects()) { // We are at the phase boundary.
             GetLocalNumbP1NoBnd( num, *it, *v->RowIdx);
@@ -344,28 +344,30 @@ void SurfactantcGP1CL::Update()
 {
     // std::cout << "SurfactantcGP1CL::Update:\n";
     IdxDescCL* cidx= ic.RowIdx;
+    band_.Update( MG_, lset_vd_, lsetbnd_);
 
     M.Data.clear();
     M.SetIdx( cidx, cidx);
-    DROPS::SetupInterfaceMassP1( MG_, &M, lset_vd_, lsetbnd_);
+    DROPS::SetupInterfaceMassP1( MG_, &M, lset_vd_, lsetbnd_, &band_);
     // std::cout << "M is set up.\n";
     A.Data.clear();
     A.SetIdx( cidx, cidx);
-    DROPS::SetupLBP1( MG_, &A, lset_vd_, lsetbnd_, D_);
+    DROPS::SetupLBP1( MG_, &A, lset_vd_, lsetbnd_, D_, &band_);
     // std::cout << "A is set up.\n";
     C.Data.clear();
     C.SetIdx( cidx, cidx);
-    DROPS::SetupConvectionP1( MG_, &C, lset_vd_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, *v_));
+    DROPS::SetupConvectionP1( MG_, &C, lset_vd_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, *v_), &band_);
     // std::cout << "C is set up.\n";
     Md.Data.clear();
     Md.SetIdx( cidx, cidx);
-    DROPS::SetupMassDivP1( MG_, &Md, lset_vd_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, *v_));
+    DROPS::SetupMassDivP1( MG_, &Md, lset_vd_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, *v_), &band_);
     // std::cout << "Md is set up.\n";
 
     if (theta_ != 1.0) {
         M2.Data.clear();
         M2.SetIdx( cidx, cidx);
-        DROPS::SetupInterfaceMassP1( MG_, &M2, oldls_, lsetbnd_);
+        oldband_.Update( MG_, oldls_, lsetbnd_);
+        DROPS::SetupInterfaceMassP1( MG_, &M2, oldls_, lsetbnd_, &oldband_);
         // std::cout << "M2 is set up.\n";
     }
     std::cout << "SurfactantP1CL::Update: Finished\n";
@@ -378,29 +380,31 @@ VectorCL SurfactantcGP1CL::InitStep ()
     idx.CreateNumbering( oldidx_.TriangLevel(), MG_, &lset_vd_, &lsetbnd_); // InitOld deletes oldidx_ and swaps idx and oldidx_.
     std::cout << "new NumUnknowns: " << idx.NumUnknowns() << std::endl;
     ic.SetIdx( &idx);
+    band_.Update( MG_, lset_vd_, lsetbnd_);
+    oldband_.Update( MG_, oldls_, lsetbnd_);
 
     MatDescCL m( &idx, &oldidx_);
-    DROPS::SetupMixedMassP1( MG_, &m, lset_vd_, lsetbnd_);
+    DROPS::SetupMixedMassP1( MG_, &m, lset_vd_, lsetbnd_, &band_);
     // std::cout << "mixed M on new interface is set up.\n";
     VectorCL rhs( theta_*(m.Data*oldic_));
 
     if (theta_ == 1.0) return rhs;
 
     m.Data.clear();
-    DROPS::SetupMixedMassP1( MG_, &m, oldls_, lsetbnd_);
+    DROPS::SetupMixedMassP1( MG_, &m, oldls_, lsetbnd_, &oldband_);
     // std::cout << "mixed M on old interface is set up.\n";
     rhs+= (1. - theta_)*(m.Data*oldic_);
 
     m.Data.clear();
-    DROPS::SetupLBP1( MG_, &m, oldls_, lsetbnd_, D_);
+    DROPS::SetupLBP1( MG_, &m, oldls_, lsetbnd_, D_, &oldband_);
     // std::cout << "mixed A on old interface is set up.\n";
     VectorCL rhs2( m.Data*oldic_);
     m.Data.clear();
-    DROPS::SetupConvectionP1( MG_, &m, oldls_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, oldv_));
+    DROPS::SetupConvectionP1( MG_, &m, oldls_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, oldv_), &oldband_);
     // std::cout << "mixed C on old interface is set up.\n";
     rhs2+= m.Data*oldic_;
     m.Data.clear();
-    DROPS::SetupMassDivP1( MG_, &m, oldls_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, oldv_));
+    DROPS::SetupMassDivP1( MG_, &m, oldls_, lsetbnd_, make_P2Eval( MG_, Bnd_v_, oldv_), &oldband_);
     // std::cout << "mixed Md on old interface is set up.\n";
     rhs2+= m.Data*oldic_;
 
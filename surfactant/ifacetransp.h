@@ -46,13 +46,13 @@ void Restrict (const MultiGridCL& mg, const VecDescCL& xext, VecDescCL& x);
 
 /// \brief The routine sets up the mass-matrix in matM on the interface defined by ls.
 ///        It belongs to the FE induced by standard P1-elements.
-void SetupInterfaceMassP1 (const MultiGridCL& MG, MatDescCL* matM, const VecDescCL& ls, const BndDataCL<>& lsetbnd);
+void SetupInterfaceMassP1 (const MultiGridCL& MG, MatDescCL* matM, const VecDescCL& ls, const BndDataCL<>& lsetbnd, const InterfaceBandCL* band= 0);
 
 /// \brief The routine sets up the Laplace-Beltrami-matrix in mat on the interface defined by ls.
 ///        It belongs to the FE induced by standard P1-elements.
 ///
 /// D is the diffusion-coefficient
-void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, double D);
+void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, double D, const InterfaceBandCL* band= 0);
 
 /// \brief The routine sets up the convection-matrix in mat on the interface defined by ls.
 ///        It belongs to the FE induced by standard P1-elements.
@@ -60,7 +60,7 @@ void SetupLBP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, cons
 /// The template-parameter is only used to circumvent the exact type of the discrete
 /// velocity solution in the Stokes classes.
 template <class DiscVelSolT>
-void SetupConvectionP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, const DiscVelSolT& v);
+void SetupConvectionP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, const DiscVelSolT& v, const InterfaceBandCL* band= 0);
 
 /// \brief Helper of SetupConvectionP1
 void SetupConvectionP1OnTriangle (const BaryCoordCL triangle[3], double det,
@@ -73,7 +73,7 @@ void SetupConvectionP1OnTriangle (const BaryCoordCL triangle[3], double det,
 /// The template-parameter is only used to circumvent the exact type of the discrete
 /// velocity solution in the Stokes classes.
 template <class DiscVelSolT>
-void SetupMassDivP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, const DiscVelSolT& v);
+void SetupMassDivP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, const DiscVelSolT& v, const InterfaceBandCL* band= 0);
 
 /// \brief Helper of SetupMassDivP1
 void SetupMassDivP1OnTriangle (const BaryCoordCL triangle[3], double det,
@@ -83,12 +83,12 @@ void SetupMassDivP1OnTriangle (const BaryCoordCL triangle[3], double det,
 /// \brief The routine sets up the mixed mass-matrix on the interface given by ls: The rows belong
 ///        to the new timestep, the columns to the old timestep. It belongs to the FE induced by
 ///        standard P1-elements.
-void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd);
+void SetupMixedMassP1 (const MultiGridCL& mg, MatDescCL* mat, const VecDescCL& ls, const BndDataCL<>& lsbnd, const InterfaceBandCL* band= 0);
 
 /// \brief The routine sets up the load-vector in v on the interface defined by ls.
 ///        It belongs to the FE induced by standard P1-elements.
 void SetupInterfaceRhsP1 (const MultiGridCL& mg, VecDescCL* v,
-    const VecDescCL& ls, const BndDataCL<>& lsbnd, instat_scalar_fun_ptr f);
+    const VecDescCL& ls, const BndDataCL<>& lsbnd, instat_scalar_fun_ptr f, const InterfaceBandCL* band= 0);
 
 /// \brief Short-hand for simple loops over the interface.
 /// \param t  - Reference to a tetra
@@ -198,6 +198,8 @@ class SurfactantcGP1CL
     VecDescCL           oldls_;  ///< levelset at old time
     VecDescCL           oldv_;   ///< velocity at old time
     double              oldt_;   ///< old time
+    InterfaceBandCL     band_,   ///< tetras cut by the interface at current time step
+                        oldband_;///< tetras cut by the interface at old time
 
     GSPcCL                  pc_;
     GMResSolverCL<GSPcCL>   gm_;
@@ -0,0 +1,306 @@
+/// \file benchmark.cpp
+/// \brief timings and throughput of the main kernels on brick meshes of increasing size; output in JSON format
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+/// Usage: benchmark [sizes [threads [file]]]
+/// \param sizes   comma separated numbers of intervals per direction of the brick; default: 4,8
+/// \param threads comma separated numbers of OpenMP threads; default: 1 and the maximal number
+/// \param file    JSON output; default: benchmark.json
+///
+/// Each brick is refined once regularly. For each size and number of threads, the refinement, the
+/// fast marching method, the accumulation of the two-phase Stokes and the level set matrices, the
+/// matrix builder, the sparse matrix-vector products, multigrid V-cycles and the VTK output are
+/// timed. Short kernels are repeated for at least minTime seconds. The JSON file contains one record
+/// per kernel, size and number of threads with the time per call and the throughput, e.g., in nonzeros
+/// per second; for the sparse matrix-vector products, the memory bandwidth is reported, too.
+
+#include "misc/utils.h"
+#include "num/spmat.h"
+#include "num/solver.h"
+#include "num/MGsolver.h"
+#include "num/fe.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "navstokes/instatnavstokes2phase.h"
+#include "out/vtkOut.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace DROPS;
+
+const double minTime= 0.2; ///< minimal measured time of repeated kernels in seconds
+
+/// \brief Result of one kernel for one mesh size and number of threads.
+struct BenchResultCL
+{
+    std::string kernel, unit;
+    Uint   size;
+    int    threads;
+    double time;        ///< time per call in seconds
+    int    reps;        ///< number of calls
+    double work;        ///< work per call in the given unit
+    double bytes;       ///< transferred bytes per call; 0, if not reported
+
+    double Throughput () const { return work/time; }
+};
+
+std::vector<BenchResultCL> results;
+int maxThreads= 1; ///< number of threads available at start-up
+
+void Report (const std::string& kernel, Uint size, int threads, double time, int reps,
+    double work, const std::string& unit, double bytes= 0.)
+{
+    BenchResultCL r;
+    r.kernel= kernel;
+    r.unit= unit;
+    r.size= size;
+    r.threads= threads;
+    r.time= time/reps;
+    r.reps= reps;
+    r.work= work;
+    r.bytes= bytes;
+    results.push_back( r);
+    std::cout << std::setw( 28) << std::left << kernel << std::right << " n " << std::setw( 3) << size
+              << ", threads " << std::setw( 2) << threads << ": " << std::scientific << std::setprecision( 3)
+              << r.time << " s, " << r.Throughput() << ' ' << unit;
+    if (bytes > 0.)
+        std::cout << ", " << bytes/r.time*1e-9 << " GB/s";
+    std::cout << std::fixed << '\n';
+}
+
+void WriteJSON (const std::string& filename)
+{
+    std::ofstream os( filename.c_str());
+    if (!os)
+        throw DROPSErrCL( "WriteJSON: cannot open file " + filename);
+    os << "{\n  \"benchmark\": \"DROPS kernels\",\n  \"max_threads\": " << maxThreads
+       << ",\n  \"results\": [\n" << std::scientific << std::setprecision( 6);
+    for (size_t i= 0; i < results.size(); ++i) {
+        const BenchResultCL& r= results[i];
+        os << "    { \"kernel\": \"" << r.kernel << "\", \"size\": " << r.size << ", \"threads\": " << r.threads
+           << ", \"time\": " << r.time << ", \"repetitions\": " << r.reps << ", \"work\": " << r.work
+           << ", \"unit\": \"" << r.unit << "\", \"throughput\": " << r.Throughput();
+        if (r.bytes > 0.)
+            os << ", \"GB/s\": " << r.bytes/r.time*1e-9;
+        os << (i + 1 < results.size() ? " },\n" : " }\n");
+    }
+    os << "  ]\n}\n";
+}
+
+std::vector<int> ParseList (const char* s)
+{
+    std::vector<int> l;
+    std::istringstream is( s);
+    int i;
+    while (is >> i) {
+        l.push_back( i);
+        is.ignore( 1, ',');
+    }
+    return l;
+}
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5, 0.5, 0.5)).norm() - 0.3;
+}
+
+Point3DCL Inflow (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[2]*(1. - p[2]), 0., 0.);
+}
+
+Point3DCL Vel (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[1], -p[0], 0.5 + p[2]*p[2]);
+}
+
+/// \brief Bytes of a sparse matrix-vector product, cf. count_spmv.
+double SpMVBytes (const MatrixCL& A)
+{
+    return A.num_nonzeros()*(sizeof( double) + sizeof( size_t)) + (A.num_rows() + 1)*sizeof( size_t)
+        + (A.num_rows() + A.num_cols())*sizeof( double);
+}
+
+void Run (Uint n, int threads)
+{
+    omp_set_num_threads( threads);
+    TimerCL timer;
+
+    // refinement
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), n, n, n);
+    MultiGridCL mg( brick);
+    DROPS_FOR_TRIANG_TETRA( mg, mg.GetLastLevel(), it)
+        it->SetRegRefMark();
+    timer.Reset();
+    mg.Refine();
+    timer.Stop();
+    const double numTetra= std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd());
+    Report( "MultiGridCL::Refine", n, threads, timer.GetTime(), 1, numTetra, "tetras/s");
+
+    double numAllTetra= 0.;
+    for (Uint lvl= 0; lvl <= mg.GetLastLevel(); ++lvl)
+        numAllTetra+= std::distance( mg.GetTriangTetraBegin( lvl), mg.GetTriangTetraEnd( lvl));
+
+    // level set function and fast marching method
+    instat_scalar_fun_ptr sigma( 0);
+    SurfaceTensionCL sf( sigma, 0);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf, 0.1);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+    timer.Reset();
+    lset.Reparam( 0);
+    timer.Stop();
+    Report( "FastmarchingCL::Perform", n, threads, timer.GetTime(), 1, lset.Phi.Data.size(), "dofs/s");
+
+    // two-phase Stokes matrices on all levels
+    BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    StokesBndDataCL::bnd_val_fun bfun[6]= { &Inflow, &Inflow, &Inflow, &Inflow, &Inflow, &Inflow };
+    StokesBndDataCL bnd( 6, bc, bfun);
+    TwoPhaseFlowCoeffCL coeff( 10., 1., 5., 1., 0., MakePoint3D( 0., 0., -9.81));
+    InstatNavierStokes2PhaseP2P1CL NS( mg, coeff, bnd);
+    MLIdxDescCL* vidx= &NS.vel_idx;
+    NS.SetNumVelLvl( mg.GetNumLevel());
+    NS.CreateNumberingVel( mg.GetLastLevel(), vidx);
+    NS.A.SetIdx( vidx, vidx);
+    NS.M.SetIdx( vidx, vidx);
+    NS.b.SetIdx( vidx);
+    NS.v.SetIdx( vidx);
+    VelVecDescCL cplM( vidx);
+    NS.InitVel( &NS.v, Vel);
+    timer.Reset();
+    NS.SetupSystem1( &NS.A, &NS.M, &NS.b, &NS.b, &cplM, lset, 0.);
+    timer.Stop();
+    Report( "System1Accumulator_P2CL", n, threads, timer.GetTime(), 1, numAllTetra, "tetras/s");
+
+    // the same with the affine maps from TetraGeometryCacheCL; the first setup fills the cache
+    mg.SetGeometryCaching( true);
+    NS.SetupSystem1( &NS.A, &NS.M, &NS.b, &NS.b, &cplM, lset, 0.);
+    timer.Reset();
+    NS.SetupSystem1( &NS.A, &NS.M, &NS.b, &NS.b, &cplM, lset, 0.);
+    timer.Stop();
+    Report( "System1Accumulator_P2CL (cached geometry)", n, threads, timer.GetTime(), 1, numAllTetra, "tetras/s");
+    mg.SetGeometryCaching( false);
+
+    // level set matrices
+    lset.E.clear();
+    lset.H.clear();
+    timer.Reset();
+    lset.SetupSystem( NS.GetVelSolution(), 0.1);
+    timer.Stop();
+    Report( "LevelsetAccumulator_P2CL", n, threads, timer.GetTime(), 1, numTetra, "tetras/s");
+
+    // matrix builder with the pattern of A
+    const MatrixCL& A= NS.A.Data.GetFinest();
+    {
+        MatrixCL B;
+        MatrixBuilderCL builder( &B, A.num_rows(), A.num_cols());
+        for (size_t i= 0; i < A.num_rows(); ++i)
+            for (size_t k= A.row_beg( i); k < A.row_beg( i + 1); ++k)
+                builder( i, A.col_ind( k))= A.val( k);
+        timer.Reset();
+        builder.Build();
+        timer.Stop();
+        Report( "SparseMatBuilderCL::Build", n, threads, timer.GetTime(), 1, A.num_nonzeros(), "nnz/s");
+    }
+
+    // sparse matrix-vector products
+    VectorCL x( A.num_cols()), y( A.num_rows());
+    for (size_t i= 0; i < x.size(); ++i)
+        x[i]= std::sin( 0.1*i);
+    int reps= 0;
+    timer.Reset();
+    do {
+        y_Ax( y, A, x);
+        ++reps;
+        timer.Stop();
+    } while (timer.GetTime() < minTime && (timer.Start(), true));
+    Report( "y_Ax", n, threads, timer.GetTime(), reps, A.num_nonzeros(), "nnz/s", SpMVBytes( A));
+    reps= 0;
+    timer.Reset();
+    do {
+        y_ATx( x, A, y);
+        ++reps;
+        timer.Stop();
+    } while (timer.GetTime() < minTime && (timer.Start(), true));
+    Report( "y_ATx", n, threads, timer.GetTime(), reps, A.num_nonzeros(), "nnz/s", SpMVBytes( A));
+
+    // multigrid V-cycles for A + M/dt
+    {
+        MLMatrixCL L;
+        L.LinComb( 1., NS.A.Data, 10., NS.M.Data);
+        SSORsmoothCL smoother( 1.0);
+        SSORPcCL     ssor;
+        PCG_SsorCL   coarse( ssor, 500, 1e-6, true);
+        const int    numCycles= 5;
+        MGSolverCL<SSORsmoothCL, PCG_SsorCL> mgsolver( smoother, coarse, numCycles, -1., false);
+        SetupP2ProlongationMatrix( mg, *mgsolver.GetProlongation(), vidx, vidx);
+        VectorCL b( 1., L.num_rows()), u( L.num_rows());
+        timer.Reset();
+        mgsolver.Solve( L, u, b);
+        timer.Stop();
+        Report( "MGSolverCL V-cycle", n, threads, timer.GetTime(), mgsolver.GetIter(), L.num_rows(), "unknowns/s");
+    }
+
+    // VTK output
+    {
+        VTKOutCL vtk( mg, "DROPS data", 1, ".", "benchmark", /*binary*/ true);
+        vtk.Register( make_VTKVector( NS.GetVelSolution(), "velocity"));
+        vtk.Register( make_VTKScalar( lset.GetSolution(), "level-set"));
+        timer.Reset();
+        vtk.Write( 0.);
+        timer.Stop();
+        Report( "VTKOutCL::Write", n, threads, timer.GetTime(), 1, numTetra, "tetras/s");
+    }
+}
+
+int main (int argc, char** argv)
+{
+  try {
+    maxThreads= omp_get_max_threads();
+    std::vector<int> sizes( ParseList( argc > 1 ? argv[1] : "4,8"));
+    std::vector<int> threads;
+    if (argc > 2)
+        threads= ParseList( argv[2]);
+    else {
+        threads.push_back( 1);
+        if (maxThreads > 1)
+            threads.push_back( maxThreads);
+    }
+    const std::string filename( argc > 3 ? argv[3] : "benchmark.json");
+
+    for (size_t s= 0; s < sizes.size(); ++s)
+        for (size_t t= 0; t < threads.size(); ++t)
+            Run( sizes[s], threads[t]);
+    WriteJSON( filename);
+    std::cout << results.size() << " results written to " << filename << std::endl;
+    return 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -125,11 +125,45 @@ int TestComposite()
     return 0;
 }
 
+int TestInPlace()
+{
+    std::cout << "\n\ny_Ax, y_ATx:\n" << std::endl;
+    DROPS::MatrixCL B;
+    DROPS::MatrixBuilderCL BB(&B, 2, 3);
+    BB( 0, 0)= 1.; BB( 0, 2)= 2.; BB( 1, 1)= -1.; BB( 1, 2)= 3.;
+    BB.Build();
+    DROPS::VectorCL x( 3), p( 2);
+    x[0]= 1.; x[1]= 2.; x[2]= 3.;
+    p[0]= -1.; p[1]= 0.5;
+
+    DROPS::VectorCL y( 7.0, 2), z( 7.0, 3);
+    const double* yaddr= &y[0], *zaddr= &z[0];
+    int err= 0;
+    // repeated products reuse the storage of y and z
+    for (int i= 0; i < 2; ++i) {
+        y_Ax( y, B, x);
+        y_ATx( z, B, p);
+        if (DROPS::norm( DROPS::VectorCL( y - B*x)) != 0. || DROPS::norm( DROPS::VectorCL( z - transp_mul( B, p))) != 0.)
+            ++err;
+    }
+    if (&y[0] != yaddr || &z[0] != zaddr)
+        ++err;
+    std::cout << "y: " << y << "\nz: " << z << '\n';
+
+    // vectors of the wrong size are resized
+    DROPS::VectorCL w;
+    y_ATx( w, B, p);
+    if (w.size() != 3 || DROPS::norm( DROPS::VectorCL( w - z)) != 0.)
+        ++err;
+    std::cout << "errors: " << err << std::endl;
+    return err;
+}
+
 int
 main(int, char**)
 {
   try {
-    return Test() + TestComposite();
+    return Test() + TestComposite() + TestInPlace();
   }
   catch (DROPS::DROPSErrCL err) { err.handle(); }
 }
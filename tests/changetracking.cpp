@@ -0,0 +1,220 @@
+/// \file changetracking.cpp
+/// \brief tests the update of the two-phase Stokes and level set matrices after local changes against a complete setup
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "num/spmat.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "stokes/instatstokes2phase.h"
+
+using namespace DROPS;
+
+double shift= 0.;
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5 + shift, 0.5, 0.5)).norm() - 0.3;
+}
+
+Point3DCL Inflow (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[2]*(1. - p[2]), 0., 0.);
+}
+
+Point3DCL Vel0 (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[1], -p[0], 0.5);
+}
+
+/// \brief Vel0 changed in the corner x, y > 0.7
+Point3DCL Vel1 (const Point3DCL& p, double)
+{
+    Point3DCL v( Vel0( p, 0.));
+    if (p[0] > 0.7 && p[1] > 0.7)
+        v[2]+= (p[0] - 0.7)*(p[1] - 0.7);
+    return v;
+}
+
+/// \brief Returns the maximal difference of the entries of A and B relative to the maximal entry of B.
+double RelDiff (const MatrixCL& A, const MatrixCL& B)
+{
+    MatrixCL D;
+    D.LinComb( 1., A, -1., B);
+    return supnorm( D)/supnorm( B);
+}
+
+double RelDiff (const VectorCL& a, const VectorCL& b)
+{
+    return supnorm( VectorCL( a - b))/supnorm( b);
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 6, 6, 6);
+    MultiGridCL mg( brick);
+
+    instat_scalar_fun_ptr sigma( 0);
+    SurfaceTensionCL sf( sigma, 0);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf, 0.1);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    StokesBndDataCL::bnd_val_fun bfun[6]= { &Inflow, &Inflow, &Inflow, &Inflow, &Inflow, &Inflow };
+    StokesBndDataCL bnd( 6, bc, bfun);
+    TwoPhaseFlowCoeffCL coeff( 10., 1., 5., 1., 0., MakePoint3D( 0., 0., -9.81));
+    InstatStokes2PhaseP2P1CL Stokes( mg, coeff, bnd);
+    MLIdxDescCL* vidx= &Stokes.vel_idx;
+    Stokes.CreateNumberingVel( mg.GetLastLevel(), vidx);
+    Stokes.A.SetIdx( vidx, vidx);
+    Stokes.M.SetIdx( vidx, vidx);
+    Stokes.b.SetIdx( vidx);
+    Stokes.v.SetIdx( vidx);
+    VelVecDescCL cplM( vidx);
+    std::cout << Stokes.v.Data.size() << " velocity unknowns, " << lset.Phi.Data.size() << " levelset unknowns\n";
+
+    int err= 0;
+
+    // A, M, b for the moved interface
+    Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &Stokes.b, &cplM, lset, 0.);
+    VecDescCL oldPhi( &lset.idx);
+    oldPhi.Data= lset.Phi.Data;
+    shift= 0.04;
+    lset.Init( Sphere);
+    Stokes.UpdateSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &Stokes.b, &cplM, lset, oldPhi, 0., 0.);
+
+    MLMatDescCL A( vidx, vidx), M( vidx, vidx);
+    VelVecDescCL b( vidx), cplM2( vidx);
+    Stokes.SetupSystem1( &A, &M, &b, &b, &cplM2, lset, 0.);
+    const double dA= RelDiff( Stokes.A.Data.GetFinest(), A.Data.GetFinest()),
+                 dM= RelDiff( Stokes.M.Data.GetFinest(), M.Data.GetFinest()),
+                 db= RelDiff( Stokes.b.Data, b.Data),
+                 dc= RelDiff( cplM.Data, cplM2.Data);
+    std::cout << "updated system 1: relative differences A " << dA << ", M " << dM << ", b " << db << ", cplM " << dc << '\n';
+    if (dA > 1e-12 || dM > 1e-12 || db > 1e-12 || dc > 1e-12)
+        ++err;
+
+    // E, H for the changed velocity
+    Stokes.InitVel( &Stokes.v, Vel0);
+    lset.SetupSystem( Stokes.GetVelSolution(), 0.1);
+    VelVecDescCL oldVel( vidx);
+    oldVel.Data= Stokes.v.Data;
+    Stokes.InitVel( &Stokes.v, Vel1);
+    lset.UpdateSystem( Stokes.GetVelSolution(), Stokes.GetVelSolution( oldVel), 0., 0.1);
+    const MatrixCL E( lset.E), H( lset.H);
+    lset.SetupSystem( Stokes.GetVelSolution(), 0.1);
+    const double dE= RelDiff( E, lset.E),
+                 dH= RelDiff( H, lset.H);
+    std::cout << "updated level set system: relative differences E " << dE << ", H " << dH << '\n';
+    if (dE > 1e-12 || dH > 1e-12)
+        ++err;
+
+    // several updates with a tolerance as in CoupledTimeDisc2PhaseBaseCL: The matrices are updated exactly to the
+    // tracked level set function, which takes the changes above the tolerance; the changes below the tolerance
+    // must not accumulate. (Advancing the reference in all unknowns lets A and M drift by about 10% here.)
+    shift= 0.;
+    lset.Init( Sphere);
+    MLMatDescCL At( vidx, vidx), Mt( vidx, vidx);
+    VelVecDescCL bt( vidx), cplMt( vidx);
+    Stokes.SetupSystem1( &At, &Mt, &bt, &bt, &cplMt, lset, 0.);
+    VecDescCL trackPhi( &lset.idx);
+    trackPhi.Data= lset.Phi.Data;
+    const double tolPhi= 0.005*supnorm( lset.Phi.Data);
+    for (int step= 1; step <= 10; ++step) {
+        shift= 0.002*step;
+        lset.Init( Sphere);
+        const VectorCL phi( lset.Phi.Data);
+        lset.Phi.Data= trackPhi.Data;
+        AdvanceTrackingReference( lset.Phi.Data, phi, tolPhi);
+        Stokes.UpdateSystem1( &At, &Mt, &bt, &bt, &cplMt, lset, trackPhi, 0., 0.);
+        trackPhi.Data= lset.Phi.Data;
+        lset.Phi.Data= phi;
+    }
+    Stokes.SetupSystem1( &A, &M, &b, &b, &cplM2, lset, 0.);
+    const double dAt= RelDiff( At.Data.GetFinest(), A.Data.GetFinest()),
+                 dMt= RelDiff( Mt.Data.GetFinest(), M.Data.GetFinest()),
+                 dPhi= supnorm( VectorCL( trackPhi.Data - lset.Phi.Data));
+    const VectorCL phi( lset.Phi.Data);
+    lset.Phi.Data= trackPhi.Data;
+    Stokes.SetupSystem1( &A, &M, &b, &b, &cplM2, lset, 0.);
+    lset.Phi.Data= phi;
+    const double dAe= RelDiff( At.Data.GetFinest(), A.Data.GetFinest()),
+                 dMe= RelDiff( Mt.Data.GetFinest(), M.Data.GetFinest());
+    std::cout << "10 updates of system 1 with tolerance: relative differences A " << dAt << ", M " << dMt
+              << ", level set function " << dPhi << " (tolerance " << tolPhi << "); to the tracked level set function A "
+              << dAe << ", M " << dMe << '\n';
+    if (dPhi > tolPhi || dAe > 1e-12 || dMe > 1e-12 || dAt > 3e-2 || dMt > 3e-2)
+        ++err;
+
+    Stokes.InitVel( &Stokes.v, Vel0);
+    lset.SetupSystem( Stokes.GetVelSolution(), 0.1);
+    VelVecDescCL trackVel( vidx);
+    trackVel.Data= Stokes.v.Data;
+    const double tolVel= 0.005*supnorm( Stokes.v.Data);
+    for (int step= 1; step <= 10; ++step) {
+        Stokes.InitVel( &Stokes.v, Vel1);
+        Stokes.v.Data= 0.1*step*Stokes.v.Data + (1. - 0.1*step)*oldVel.Data;
+        VelVecDescCL vel( vidx);
+        vel.Data= trackVel.Data;
+        AdvanceTrackingReference( vel.Data, Stokes.v.Data, tolVel, 3);
+        lset.UpdateSystem( Stokes.GetVelSolution( vel), Stokes.GetVelSolution( trackVel), 0., 0.1);
+        trackVel.Data= vel.Data;
+    }
+    const MatrixCL Et( lset.E), Ht( lset.H);
+    const double dVel= supnorm( VectorCL( trackVel.Data - Stokes.v.Data));
+    lset.SetupSystem( Stokes.GetVelSolution( trackVel), 0.1);
+    const double dEe= RelDiff( Et, lset.E), dHe= RelDiff( Ht, lset.H);
+    lset.SetupSystem( Stokes.GetVelSolution(), 0.1);
+    const double dEt= RelDiff( Et, lset.E), dHt= RelDiff( Ht, lset.H);
+    std::cout << "10 updates of the level set system with tolerance: relative differences E " << dEt << ", H " << dHt
+              << ", velocity " << dVel << " (tolerance " << tolVel << "); to the tracked velocity E " << dEe << ", H " << dHe << '\n';
+    if (dVel > tolVel || dEe > 1e-12 || dHe > 1e-12 || dEt > 1e-3 || dHt > 3e-3)
+        ++err;
+
+    // contributions, which do not belong to the sparsity pattern, are rejected
+    MatrixCL C( lset.E);
+    SparseMatPatchCL<double> patch( &C);
+    patch( 0, C.num_cols() - 1)+= 1.;
+    bool thrown= false;
+    try {
+        patch.Build();
+    }
+    catch (DROPSErrCL&) {
+        thrown= true;
+    }
+    if (!thrown)
+        ++err;
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,190 @@
+/// \file chebyshev.cpp
+/// \brief tests the Chebyshev smoother with Lanczos eigenvalue estimation
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/solver.h"
+#include "num/MGsolver.h"
+#include <iostream>
+#include <new>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief 1D P1 stiffness matrix with n interior nodes on (0,1).
+void BuildLaplace1D (MatrixCL& A, size_t n)
+{
+    const double h= 1./(n + 1);
+    MatrixBuilderCL B( &A, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        B( i, i)= 2./h;
+        if (i > 0)     B( i, i - 1)= -1./h;
+        if (i < n - 1) B( i, i + 1)= -1./h;
+    }
+    B.Build();
+}
+
+/// \brief Linear interpolation from nc to 2*nc+1 interior nodes.
+void BuildProlongation1D (MatrixCL& P, size_t nc)
+{
+    MatrixBuilderCL B( &P, 2*nc + 1, nc);
+    for (size_t i= 0; i < nc; ++i) {
+        B( 2*i,     i)= 0.5;
+        B( 2*i + 1, i)= 1.;
+        B( 2*i + 2, i)= 0.5;
+    }
+    B.Build();
+}
+
+/// \brief Hides the entries of a matrix: only the interface of a matrix-free operator is available.
+class OperatorCL
+{
+  private:
+    const MatrixCL& A_;
+
+  public:
+    OperatorCL (const MatrixCL& A) : A_( A) {}
+    size_t   num_rows () const { return A_.num_rows(); }
+    size_t   Version  () const { return A_.Version(); }
+    VectorCL GetDiag  () const { return A_.GetDiag(); }
+    friend VectorCL operator* (const OperatorCL& op, const VectorCL& x) { return op.A_*x; }
+};
+
+void TestEigenvalues ()
+{
+    // eigenvalues of tridiag(-1, 2, -1): 2 - 2 cos(k pi/(n + 1))
+    const size_t n= 20;
+    std::vector<double> a( n, 2.), b( n - 1, -1.);
+    const double lmax= 2. - 2.*std::cos( n*M_PI/(n + 1));
+    Check( std::fabs( TridiagMaxEigenvalue( a, b) - lmax) < 1e-8, "TridiagMaxEigenvalue");
+
+    // D^{-1}A has the largest eigenvalue 1 + cos(pi/(n + 1)); Lanczos approximates it from below
+    MatrixCL A;
+    BuildLaplace1D( A, 200);
+    const double exact= 1. + std::cos( M_PI/201.),
+                 est= EstimateJacobiMaxEigenvalue( A, VectorCL( 1./A.GetDiag()), 10);
+    std::cout << "largest eigenvalue of D^{-1}A: " << exact << ", estimate: " << est << '\n';
+    Check( est <= exact*(1. + 1e-12) && est > 0.95*exact, "EstimateJacobiMaxEigenvalue");
+}
+
+void TestSmoother ()
+{
+    MatrixCL A;
+    BuildLaplace1D( A, 255);
+    const size_t n= A.num_rows();
+    VectorCL b( n), x( n), e( n);
+    for (size_t i= 0; i < n; ++i)
+        x[i]= std::sin( 0.9*M_PI*i); // oscillating error
+    ChebyshevSmoothCL cheb( 3);
+    cheb.Apply( A, e, VectorCL( A*x));
+    const double red= norm( VectorCL( A*VectorCL( x - e)))/norm( VectorCL( A*x));
+    std::cout << "Chebyshev smoother: reduction of the oscillating residual " << red << '\n';
+    Check( red < 0.25, "damping of oscillating errors");
+
+    // the data is stored per matrix and refreshed, if the matrix changes
+    const double l0= cheb.GetMaxEigenvalue( A);
+    A*= 2.;
+    Check( std::fabs( cheb.GetMaxEigenvalue( A) - l0) < 1e-10*l0, "eigenvalue of D^{-1}A is invariant under scaling");
+    A*= 0.5;
+
+    // the data of a destroyed matrix is not used for a new matrix at the same address
+    {
+        ChebyshevSmoothCL cheb2;
+        MatrixCL C;
+        BuildLaplace1D( C, 255);
+        const double l255= cheb2.GetMaxEigenvalue( C);
+        C.~MatrixCL();
+        new (&C) MatrixCL;
+        MatrixBuilderCL B( &C, 255, 255); // diagonal matrix: D^{-1}C= I
+        for (size_t i= 0; i < 255; ++i)
+            B( i, i)= 1.;
+        B.Build();
+        Check( cheb2.GetMaxEigenvalue( C) < 0.6*l255, "matrix rebuilt at the address of a destroyed matrix");
+    }
+
+    // a matrix-free operator gives the same result
+    OperatorCL op( A);
+    VectorCL e2( n);
+    cheb.Apply( op, e2, VectorCL( A*x));
+    Check( norm( VectorCL( e2 - e)) <= 1e-12*norm( e), "matrix-free operator");
+}
+
+void TestMG ()
+{
+    const size_t numLvl= 7;
+    ChebyshevSmoothCL smoother( 3);
+    SSORPcCL     ssor;
+    PCG_SsorCL   coarse( ssor, 500, 1e-6, true);
+    typedef MGSolverCL<ChebyshevSmoothCL, PCG_SsorCL> MGCL;
+    MGCL mg( smoother, coarse, 1, -1., false);
+
+    MLMatrixCL A( numLvl);
+    size_t n= 3;
+    mg.GetProlongation()->resize( numLvl);
+    MLMatrixCL::iterator a= A.begin(), p= mg.GetProlongation()->begin();
+    for (size_t l= 0; l < numLvl; ++l, ++a, ++p) {
+        BuildLaplace1D( *a, n);
+        if (l > 0)
+            BuildProlongation1D( *p, (n - 1)/2);
+        n= 2*n + 1;
+    }
+    n= A.num_rows();
+    VectorCL b( n);
+    for (size_t i= 0; i < n; ++i)
+        b[i]= std::sin( 0.01*i) + 1.;
+
+    typedef SolverAsPreCL<MGCL> MGPcCL;
+    MGPcCL pc( mg);
+    PCGSolverCL<MGPcCL> cg( pc, 100, 1e-10, true);
+    VectorCL x( n);
+    cg.Solve( A, x, b);
+    std::cout << "PCG with MG and Chebyshev smoother: iterations " << cg.GetIter() << '\n';
+    Check( cg.GetResid() <= 1e-10 && cg.GetIter() <= 10, "PCG with MG and Chebyshev smoother");
+
+    // single precision hierarchy
+    mg.SetSinglePrecision( true);
+    x= 0.;
+    cg.Solve( A, x, b);
+    std::cout << "PCG with single precision MG and Chebyshev smoother: iterations " << cg.GetIter() << '\n';
+    Check( cg.GetResid() <= 1e-10 && cg.GetIter() <= 10, "PCG with single precision MG and Chebyshev smoother");
+}
+
+int main ()
+{
+  try {
+    TestEigenvalues();
+    TestSmoother();
+    TestMG();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,98 @@
+/// \file colorclasses.cpp
+/// \brief tests the coloring of the tetras by ColorClassesCL and the recoloring after refinement
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/bndData.h"
+#include <map>
+
+using namespace DROPS;
+
+void MarkDrop (MultiGridCL& mg, const Point3DCL& c, bool refine)
+{
+    DROPS_FOR_TRIANG_TETRA( mg, -1, It) {
+        if ( (GetBaryCenter(*It)-c).norm()<=std::max(0.15,1.5*std::pow(It->GetVolume(),1.0/3.0)) ) {
+            if (refine) It->SetRegRefMark();
+            else        It->SetRemoveMark();
+        }
+    }
+}
+
+/// \brief Checks, that each tetra of the triangulation has exactly one color and that tetras with a
+/// common vertex have different colors; prints the sizes of the smallest and largest color class.
+int Check (const MultiGridCL& mg, const ColorClassesCL& colors)
+{
+    std::map<const TetraCL*, int> color;
+    int c= 0, err= 0;
+    size_t minsize= ~size_t(0), maxsize= 0;
+    for (ColorClassesCL::const_iterator it= colors.begin(); it != colors.end(); ++it, ++c) {
+        minsize= std::min( minsize, it->size());
+        maxsize= std::max( maxsize, it->size());
+        for (ColorClassesCL::ColorClassT::const_iterator t= it->begin(); t != it->end(); ++t)
+            if (!color.insert( std::make_pair( *t, c)).second)
+                ++err;
+    }
+    if (color.size() != mg.GetTriangTetra().size( mg.GetLastLevel()))
+        ++err;
+    std::map<const VertexCL*, std::vector<int> > vertcolors;
+    for (std::map<const TetraCL*, int>::const_iterator it= color.begin(); it != color.end(); ++it)
+        for (Uint v= 0; v < NumVertsC; ++v)
+            vertcolors[it->first->GetVertex( v)].push_back( it->second);
+    for (std::map<const VertexCL*, std::vector<int> >::iterator it= vertcolors.begin(); it != vertcolors.end(); ++it) {
+        std::sort( it->second.begin(), it->second.end());
+        if (std::adjacent_find( it->second.begin(), it->second.end()) != it->second.end())
+            ++err;
+    }
+    std::cout << colors.num_colors() << " colors, class sizes " << minsize << " ... " << maxsize
+              << ", " << colors.num_recolored() << " tetras colored, errors: " << err << std::endl;
+    return err;
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 4, 4, 4);
+    MultiGridCL mg( brick);
+    BndCondCL bnd( 6);
+    int err= 0;
+    for (int step= 0; step < 4; ++step) {
+        const Point3DCL c= MakePoint3D( 0.2 + 0.1*step, 0.5, 0.5);
+        if (step > 1)
+            MarkDrop( mg, c - MakePoint3D( 0.2, 0., 0.), false);
+        MarkDrop( mg, c, true);
+        mg.Refine();
+        // the first call after the refinement updates the coloring of the last step
+        err+= Check( mg, mg.GetColorClasses( -1, 0, bnd));
+    }
+#ifdef _OPENMP
+    // coloring from scratch with a different number of threads
+    omp_set_num_threads( omp_get_max_threads() > 1 ? 1 : 4);
+    const MultiGridCL& cmg= mg;
+    err+= Check( mg, ColorClassesCL( cmg.GetTriangTetraBegin(), cmg.GetTriangTetraEnd(), 0, bnd));
+#endif
+    return err;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
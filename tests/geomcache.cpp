@@ -0,0 +1,161 @@
+/// \file geomcache.cpp
+/// \brief tests the per-level cache of the affine maps of the tetras
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/accumulator.h"
+#include "num/discretize.h"
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+void MarkDrop (MultiGridCL& mg, const Point3DCL& c)
+{
+    DROPS_FOR_TRIANG_TETRA( mg, -1, It)
+        if ( (GetBaryCenter(*It)-c).norm()<=std::max(0.15,1.5*std::pow(It->GetVolume(),1.0/3.0)) )
+            It->SetRegRefMark();
+}
+
+/// \brief Compares the cached affine maps and P1 gradients with the computed ones.
+class CompareAccuCL : public TetraAccumulatorCL
+{
+  private:
+    double* diff_;
+    size_t* hits_;
+
+  public:
+    CompareAccuCL (double& diff, size_t& hits) : diff_( &diff), hits_( &hits) {}
+
+    void visit (const TetraCL& t) {
+        SMatrixCL<3,3> T, Tc;
+        double det, detc;
+        Point3DCL H[4], Hc[4];
+        GetTrafoTr( T, det, t);
+        GetTrafoTr( Tc, detc, t, geom_cache_, geom_pos_);
+        P1DiscCL::GetGradients( H, det, t);
+        P1DiscCL::GetGradients( Hc, detc, t, geom_cache_, geom_pos_);
+        double d= std::fabs( det - detc);
+        for (Uint i= 0; i < 3; ++i)
+            for (Uint j= 0; j < 3; ++j)
+                d= std::max( d, std::fabs( T( i, j) - Tc( i, j)));
+        for (Uint i= 0; i < 4; ++i)
+            d= std::max( d, (H[i] - Hc[i]).norm());
+#       pragma omp critical
+        {
+            *diff_= std::max( *diff_, d);
+            if (geom_cache_ != 0 && geom_cache_->Contains( t, geom_pos_))
+                ++*hits_;
+        }
+    }
+
+    TetraAccumulatorCL* clone (int) { return new CompareAccuCL( *this); }
+};
+
+/// \brief Accumulates CompareAccuCL on the finest level; returns the number of tetras found in the cache.
+size_t Accumulate (const MultiGridCL& mg, double& diff)
+{
+    size_t hits= 0;
+    diff= 0.;
+    CompareAccuCL accu( diff, hits);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &accu);
+    BndCondCL bnd( 0);
+    accumulate( accus, mg, mg.GetLastLevel(), 0, bnd);
+    return hits;
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 4, 4, 4);
+    MultiGridCL mg( brick);
+    MarkDrop( mg, MakePoint3D( 0.5, 0.5, 0.5));
+    mg.Refine();
+
+    double diff;
+    Check( mg.GetGeometryCache( -1) == 0, "the cache is off by default");
+    Check( Accumulate( mg, diff) == 0, "no cache: no tetra found");
+
+    mg.SetGeometryCaching( true);
+    const TetraGeometryCacheCL* cache= mg.GetGeometryCache( -1);
+    Check( cache != 0 && cache->size() == mg.GetTriangTetra().size( mg.GetLastLevel()), "size of the cache");
+    Check( mg.GetGeometryCache( mg.GetLastLevel()) == cache, "the cache is created once per level");
+    const size_t n= Accumulate( mg, diff);
+    std::cout << "cached tetras: " << n << ", max. difference: " << diff << '\n';
+    Check( n == cache->size(), "all tetras found in the cache");
+    Check( diff == 0., "cached values == computed values");
+    // the other accumulation path: triangulation iterators vs. color classes
+    const int threads= omp_get_max_threads();
+    omp_set_num_threads( threads > 1 ? 1 : 4);
+    Check( Accumulate( mg, diff) == cache->size() && diff == 0., "positions passed by the other accumulation path");
+    omp_set_num_threads( threads);
+
+    // coarse tetras are not contained in the cache of the finest level
+    double det;
+    SMatrixCL<3,3> T;
+    MultiGridCL::const_TetraIterator refined= mg.GetTetrasBegin( 0);
+    while (refined->IsUnrefined())
+        ++refined;
+    for (size_t i= 0; i < cache->size(); ++i)
+        Check( !cache->GetTrafoTr( T, det, *refined, i), "refined tetra of level 0 not contained");
+    Check( !cache->Contains( *mg.GetTriangTetraBegin(), 1), "wrong position");
+
+    mg.Scale( 2.);
+    Accumulate( mg, diff);
+    Check( diff == 0., "Scale invalidates the cache");
+
+    // moving vertices as in ALECL
+    for (MultiGridCL::TriangVertexIteratorCL it= mg.GetTriangVertexBegin(), end= mg.GetTriangVertexEnd(); it != end; ++it) {
+        Point3DCL p= it->GetCoord();
+        p[1]*= 1. + 0.1*p[0];
+        it->ChangeCoord( p);
+    }
+    mg.GetGeometryCache( -1);
+    mg.NotifyCoordChange();
+    Accumulate( mg, diff);
+    Check( diff == 0., "NotifyCoordChange invalidates the cache");
+
+    MarkDrop( mg, MakePoint3D( 1., 1., 1.));
+    mg.Refine();
+    Check( Accumulate( mg, diff) == mg.GetTriangTetra().size( mg.GetLastLevel()) && diff == 0.,
+        "Refine invalidates the cache");
+
+    mg.SetGeometryCaching( false);
+    Check( mg.GetGeometryCache( -1) == 0 && Accumulate( mg, diff) == 0, "cache switched off");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,178 @@
+/// \file insituout.cpp
+/// \brief tests the in-situ output for a spherical droplet: integral quantities, interface triangles and probes
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "out/insituOut.h"
+#include "levelset/levelset.h"
+#include "stokes/instatstokes2phase.h"
+#include "geom/builder.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+bool Near (double a, double b, double tol)
+{
+    return std::fabs( a - b) <= tol*std::fabs( b);
+}
+
+const Point3DCL Center= MakePoint3D( 0.5, 0.5, 0.5);
+const double    Radius= 0.3;
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - Center).norm() - Radius;
+}
+
+Point3DCL Vel (const Point3DCL&, double)
+{
+    return MakePoint3D( 2., 0., 0.);
+}
+
+/// \brief Reads n objects of type T from is.
+template <class T>
+void read_binary (std::istream& is, T* p, size_t n= 1)
+{
+    is.read( reinterpret_cast<char*>( p), n*sizeof( T));
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 16, 16, 16);
+    MultiGridCL mg( brick);
+
+    instat_scalar_fun_ptr sigmaf( 0);
+    SurfaceTensionCL sf( sigmaf);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf, 0.1);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    StokesBndDataCL::bnd_val_fun bfun[6]= { &Vel, &Vel, &Vel, &Vel, &Vel, &Vel };
+    StokesBndDataCL bnd( 6, bc, bfun);
+    TwoPhaseFlowCoeffCL coeff( 1., 1., 1., 1., 0., MakePoint3D( 0., 0., 0.));
+    InstatStokes2PhaseP2P1CL Stokes( mg, coeff, bnd);
+    Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+    Stokes.v.SetIdx( &Stokes.vel_idx);
+    Stokes.InitVel( &Stokes.v, Vel);
+
+    InSituOutCL insitu( mg, lset.Phi, lset.GetBndData(), "", "insituout", 1);
+    insitu.Register( make_InSituScalar( lset.GetSolution(), "phi"));
+    insitu.Register( make_InSituVector( Stokes.GetVelSolution(), "velocity"));
+    insitu.Register( make_InSituLsetInfo( lset, Stokes.GetVelSolution()));
+    insitu.AddProbe( Center);                       // a vertex inside the droplet
+    insitu.AddProbe( MakePoint3D( 0.1, 0.2, 0.3));  // outside
+    insitu.AddProbe( MakePoint3D( 2., 0.5, 0.5));   // outside of the domain
+    insitu.Write( 0.25);
+
+    // descriptor
+    std::ifstream isd( "insituout.isd");
+    std::ostringstream descr;
+    descr << isd.rdbuf();
+    Check( descr.str().find( "variables 2\nphi 1\nvelocity 3\nprobes 3\n") != std::string::npos
+        && descr.str().find( "integrals 15\nmaxGradPhi\nvolume\n") != std::string::npos, "descriptor");
+
+    // step file
+    std::ifstream ist( "insituout_0.ist", std::ios_base::binary);
+    char magic[8];
+    double time;
+    Uint header[4];
+    read_binary( ist, magic, 8);
+    read_binary( ist, &time);
+    read_binary( ist, header, 4);
+    const Uint numTri= header[1], numProbes= header[2], numIntegrals= header[3];
+    std::cout << numTri << " interface triangles, " << numProbes << " probes, " << numIntegrals << " integrals\n";
+    Check( std::string( magic, 8) == "DROPSIST" && time == 0.25 && header[0] == 0, "header");
+    Check( numTri > 0 && numTri == insitu.GetNumTriangles() && numProbes == 2 && numIntegrals == 15, "sizes");
+
+    std::vector<float> coords( 9*numTri), phi( 3*numTri), vel( 9*numTri);
+    read_binary( ist, &coords[0], coords.size());
+    read_binary( ist, &phi[0], phi.size());
+    read_binary( ist, &vel[0], vel.size());
+    double area= 0., maxDist= 0., maxPhi= 0.;
+    for (Uint t= 0; t < numTri; ++t) {
+        Point3DCL p[3];
+        for (int i= 0; i < 3; ++i) {
+            for (int j= 0; j < 3; ++j)
+                p[i][j]= coords[9*t + 3*i + j];
+            maxDist= std::max( maxDist, std::fabs( Sphere( p[i])));
+            maxPhi=  std::max( maxPhi, std::fabs( static_cast<double>( phi[3*t + i])));
+        }
+        Point3DCL n;
+        cross_product( n, p[1] - p[0], p[2] - p[0]);
+        area+= 0.5*n.norm();
+    }
+    std::cout << "area of the triangles " << area << ", distance to the sphere " << maxDist << ", |phi| " << maxPhi << '\n';
+    Check( maxDist < 2e-3 && maxPhi < 2e-3, "triangles on the interface");
+    Check( vel[0] == 2.f && vel[1] == 0.f && vel[2] == 0.f && vel[9*numTri - 3] == 2.f, "velocity on the interface");
+
+    Uint probe[2];
+    float probeVals[2][4];
+    for (Uint i= 0; i < 2; ++i) {
+        read_binary( ist, &probe[i]);
+        read_binary( ist, probeVals[i], 4);
+    }
+    Check( probe[0] == 0 && probe[1] == 1, "probes outside of the domain are skipped");
+    Check( std::fabs( probeVals[0][0] + Radius) < 1e-6 && probeVals[0][1] == 2.f, "values in the probe at the center");
+    Check( std::fabs( probeVals[1][0] - Sphere( MakePoint3D( 0.1, 0.2, 0.3))) < 1e-2, "values in the probe outside");
+
+    // integrals: 0 maxGradPhi, 1 volume, 2-4 barycenter, 5-7 velocity, 8-13 bounding box, 14 surface area
+    double integrals[15];
+    read_binary( ist, integrals, 15);
+    Check( ist.good() && ist.peek() == std::char_traits<char>::eof(), "size of the step file");
+    const double volume= 4./3.*M_PI*std::pow( Radius, 3), surfArea= 4.*M_PI*Radius*Radius;
+    std::cout << "volume " << integrals[1] << " (exact " << volume << "), surface area " << integrals[14]
+              << " (exact " << surfArea << ")\n";
+    Check( Near( integrals[1], volume, 1e-2), "volume of the droplet");
+    Check( Near( integrals[14], surfArea, 1e-2) && Near( area, integrals[14], 1e-5), "surface area of the droplet");
+    Check( (MakePoint3D( integrals[2], integrals[3], integrals[4]) - Center).norm() < 1e-3, "barycenter of the droplet");
+    Check( std::fabs( integrals[5] - 2.) < 1e-10 && std::fabs( integrals[6]) < 1e-10, "velocity of the droplet");
+    Check( std::fabs( integrals[8] - (Center[0] - Radius)) < 1e-2 && std::fabs( integrals[11] - (Center[0] + Radius)) < 1e-2,
+        "bounding box of the droplet");
+
+    // the next step gets the next time code
+    insitu.Write( 0.5);
+    Check( std::ifstream( "insituout_1.ist").good(), "time code of the second step");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,127 @@
+/// \file instrument.cpp
+/// \brief tests the hierarchical instrumentation InstrumentCL
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/instrument.h"
+#include "num/spmat.h"
+#include <fstream>
+#include <sstream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+void Work (const MatrixCL& A, VectorCL& x)
+{
+    DROPS_REGION( "Work");
+    for (int i= 0; i < 3; ++i) {
+        DROPS_REGION( "SpMV");
+        x= A*x;
+    }
+}
+
+int main ()
+{
+  try {
+    MatrixCL A;
+    MatrixBuilderCL B( &A, 100, 100);
+    for (int i= 0; i < 100; ++i) {
+        B( i, i)= 2.;
+        if (i > 0) B( i, i - 1)= -1.;
+    }
+    B.Build();
+    VectorCL x( 1., 100);
+
+    // nothing is recorded, as long as the instrumentation is disabled
+    Work( A, x);
+    InstrumentCL::RegionMapT  regions;
+    InstrumentCL::CounterMapT counters;
+    InstrumentCL::GetData( regions, counters);
+    Check( regions.empty() && counters.empty(), "data recorded while disabled");
+
+    InstrumentCL::Enable( /*trace*/ true);
+    InstrumentCL::OpenCSV( "instrument.csv");
+    for (int step= 1; step <= 2; ++step) {
+        InstrumentCL::BeginStep( step, 0.1*step);
+        Work( A, x);
+#       pragma omp parallel
+        {
+            DROPS_REGION( "Parallel");
+            DROPS_COUNT( "items", 1.);
+        }
+        InstrumentCL::EndStep();
+    }
+    InstrumentCL::CloseCSV();
+    InstrumentCL::WriteSummary( std::cout);
+    InstrumentCL::WriteChromeTrace( "instrument.json");
+
+    InstrumentCL::GetData( regions, counters);
+    Check( regions["TimeStep"].calls == 2, "TimeStep");
+    Check( regions["TimeStep/Work"].calls == 2, "TimeStep/Work");
+    Check( regions["TimeStep/Work/SpMV"].calls == 6, "TimeStep/Work/SpMV");
+    Check( regions["TimeStep/Work/SpMV"].time <= regions["TimeStep/Work"].time, "inclusive time");
+    Check( counters["TimeStep/Work/SpMV/SpMV"].value == 6., "SpMV counter");
+    Check( counters["TimeStep/Work/SpMV/SpMV bytes"].value
+           == 6.*(A.num_nonzeros()*(sizeof( double) + sizeof( size_t)) + 101*sizeof( size_t) + 200*sizeof( double)), "SpMV bytes");
+    // the master thread records below TimeStep, the other threads at the root
+    double items= counters["TimeStep/Parallel/items"].value + counters["Parallel/items"].value;
+    Check( items == 2.*omp_get_max_threads(), "per-thread counters");
+
+    // the paths are ordered as tree
+    InstrumentCL::RegionMapT::const_iterator it= regions.find( "TimeStep");
+    Check( (++it)->first == "TimeStep/Parallel", "order of paths");
+
+    // one CSV row per step and region or counter
+    std::ifstream csv( "instrument.csv");
+    std::string line;
+    int rows= 0;
+    while (std::getline( csv, line))
+        ++rows;
+    const int perStep= 4 + (omp_get_max_threads() > 1 ? 1 : 0) + 3 + (omp_get_max_threads() > 1 ? 1 : 0);
+    Check( rows == 1 + 2*perStep, "rows of the CSV file");
+
+    // 2 time steps with 6 regions on the master thread and 1 region on every other thread
+    std::ifstream json( "instrument.json");
+    std::stringstream ss;
+    ss << json.rdbuf();
+    const std::string trace= ss.str();
+    int events= 0;
+    for (size_t pos= trace.find( "\"ph\":\"X\""); pos != std::string::npos; pos= trace.find( "\"ph\":\"X\"", pos + 1))
+        ++events;
+    Check( events == 2*(6 + omp_get_max_threads() - 1), "events of the trace");
+
+    InstrumentCL::Reset();
+    InstrumentCL::Disable();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
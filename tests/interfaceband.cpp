@@ -0,0 +1,145 @@
+/// \file interfaceband.cpp
+/// \brief tests the set of tetras cut by the interface and the accumulation restricted to it
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5, 0.5, 0.5)).norm() - 0.3;
+}
+
+/// \brief Counts the tetras visited and the tetras with an interface patch on a child.
+class PatchCountAccuCL : public TetraAccumulatorCL
+{
+  private:
+    const LevelsetP2CL& lset_;
+    InterfaceTriangleCL triangle_;
+    size_t* visited_, *cut_;
+
+  public:
+    PatchCountAccuCL (const LevelsetP2CL& lset, size_t* visited, size_t* cut)
+        : lset_( lset), visited_( visited), cut_( cut) {}
+
+    void begin_accumulation () { *visited_= *cut_= 0; }
+    void finalize_accumulation () {}
+    void visit (const TetraCL& t) {
+        triangle_.Init( t, lset_.Phi, lset_.GetBndData());
+        bool cut= false;
+        for (Uint ch= 0; ch < 8; ++ch)
+            cut= triangle_.ComputeForChild( ch) || cut;
+#       pragma omp critical
+        {
+            ++*visited_;
+            if (cut)
+                ++*cut_;
+        }
+    }
+    TetraAccumulatorCL* clone (int) { return new PatchCountAccuCL( *this); }
+};
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 10, 10, 10);
+    MultiGridCL mg( brick);
+
+    instat_scalar_fun_ptr sigma( 0);
+    SurfaceTensionCL sf( sigma, 0);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    const Uint lvl= lset.Phi.GetLevel();
+    match_fun match= mg.GetBnd().GetMatchFun();
+    size_t visited, cut, visitedBand, cutBand;
+    TetraAccumulatorTupleCL accus, accusBand;
+    accus.push_back_acquire( new PatchCountAccuCL( lset, &visited, &cut));
+    accusBand.push_back_acquire( new PatchCountAccuCL( lset, &visitedBand, &cutBand));
+
+    accumulate( accus, mg, lvl, match, lset.idx.GetBndInfo());
+    const InterfaceBandCL& band= lset.GetInterfaceBand();
+    accumulate( accusBand, band, match, lset.idx.GetBndInfo());
+    std::cout << "tetras: " << visited << ", cut: " << cut << ", set: " << band.size() << '\n';
+    Check( cut == cutBand && cutBand > 0, "all cut tetras are visited");
+    Check( visitedBand == band.size() && band.size() == band.GetNumCut(), "only the set is visited");
+    Check( band.size() < visited/5, "size of the set");
+
+    // the set is only rebuilt, if phi or the multigrid change
+    const size_t version= band.GetVersion();
+    lset.GetInterfaceBand();
+    Check( band.GetVersion() == version, "unchanged level set function");
+    lset.Phi.Data+= 0.05;
+    lset.GetInterfaceBand();
+    Check( band.GetVersion() == version + 1, "changed level set function");
+    accumulate( accus, mg, lvl, match, lset.idx.GetBndInfo());
+    accumulate( accusBand, band, match, lset.idx.GetBndInfo());
+    Check( cut == cutBand, "cut tetras after the change of phi");
+
+    // layers around the cut tetras: the first layer consists of the tetras sharing a vertex with a cut tetra
+    const size_t numCut= band.GetNumCut();
+    std::vector<const VertexCL*> verts;
+    for (InterfaceBandCL::const_iterator it= band.begin(); it != band.end(); ++it)
+        for (Uint j= 0; j < 4; ++j)
+            verts.push_back( it->GetVertex( j));
+    std::sort( verts.begin(), verts.end());
+    size_t numLayer= 0;
+    DROPS_FOR_TRIANG_TETRA( mg, lvl, it)
+        for (Uint j= 0; j < 4; ++j)
+            if (std::binary_search( verts.begin(), verts.end(), it->GetVertex( j))) {
+                ++numLayer;
+                break;
+            }
+    lset.GetInterfaceBand( 1);
+    std::cout << "cut: " << numCut << ", with 1 layer: " << band.size() << '\n';
+    Check( band.GetNumCut() == numCut && band.size() == numLayer, "one layer around the cut tetras");
+    lset.GetInterfaceBand( 2);
+    Check( band.GetNumCut() == numCut && band.size() > numLayer, "two layers around the cut tetras");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPSErrCL err) { err.handle(); }
+}
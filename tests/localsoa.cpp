@@ -0,0 +1,116 @@
+/// \file localsoa.cpp
+/// \brief tests the stack allocated local functions and quadrature rules against LocalP2CL and Quad5CL
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/discretize.h"
+#include "misc/utils.h"
+#include <iostream>
+#include <cstdlib>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+double Random ()
+{
+    return std::rand()/double( RAND_MAX) - 0.5;
+}
+
+void TestQuad5 ()
+{
+    LocalP2CL<Point3DCL> v;
+    LocalP2CL<> f;
+    SMatrixCL<3,3> T;
+    for (Uint i= 0; i < 10; ++i) {
+        v[i]= MakePoint3D( Random(), Random(), Random());
+        f[i]= Random();
+    }
+    for (Uint i= 0; i < 3; ++i)
+        for (Uint j= 0; j < 3; ++j)
+            T( i, j)= Random() + (i == j ? 2. : 0.);
+    const double absdet= 0.3;
+
+    // reference values
+    Quad5CL<Point3DCL> GradRef[10], Grad[10], u( v);
+    Quad5CL<> q( f);
+    P2DiscCL::GetGradientsOnRef( GradRef);
+    P2DiscCL::GetGradients( Grad, GradRef, T);
+
+    SQuad5CL<Point3DCL> sGradRef[10], sGrad[10], su( v);
+    SQuad5CL<> sq( f);
+    P2DiscCL::GetGradientsOnRef( sGradRef);
+    P2DiscCL::GetGradients( sGrad, sGradRef, T);
+
+    double maxdiff= 0.;
+    for (Uint k= 0; k < Quad5DataCL::NumNodesC; ++k) {
+        maxdiff= std::max( maxdiff, (u[k] - su[k]).norm());
+        maxdiff= std::max( maxdiff, std::fabs( q[k] - sq[k]));
+        for (Uint i= 0; i < 10; ++i)
+            maxdiff= std::max( maxdiff, (Grad[i][k] - sGrad[i][k]).norm());
+    }
+    Check( maxdiff < 1e-14, "values in the quadrature nodes");
+
+    maxdiff= 0.;
+    for (Uint j= 0; j < 10; ++j) {
+        const Quad5CL<>  uG( dot( u, Grad[j]));
+        const SQuad5CL<> suG( dot( su, sGrad[j]));
+        maxdiff= std::max( maxdiff, std::fabs( uG.quad( absdet) - suG.quad( absdet)));
+        maxdiff= std::max( maxdiff, std::fabs( Quad5CL<>( q*uG).quad( absdet) - SQuad5CL<>( sq*suG).quad( absdet)));
+        for (Uint i= 0; i < 10; ++i)
+            maxdiff= std::max( maxdiff, std::fabs( uG.quadP2( i, absdet) - suG.quadP2( i, absdet)));
+    }
+    Check( maxdiff < 1e-14, "quad and quadP2");
+    Check( (u.quad( absdet) - su.quad( absdet)).norm() < 1e-14, "quad of a vector valued function");
+
+    Quad5CL<Point3DCL>  gradf;
+    SQuad5CL<Point3DCL> sgradf;
+    P2DiscCL::GetFuncGradient( gradf, f, Grad);
+    P2DiscCL::GetFuncGradient( sgradf, f, sGrad);
+    maxdiff= 0.;
+    for (Uint k= 0; k < Quad5DataCL::NumNodesC; ++k)
+        maxdiff= std::max( maxdiff, (gradf[k] - sgradf[k]).norm());
+    Check( maxdiff < 1e-14, "gradient of a P2-function");
+
+    const SLocalP2CL<Point3DCL> sv( v);
+    const BaryCoordCL b= MakeBaryCoord( 0.1, 0.2, 0.3, 0.4);
+    Check( (v( b) - sv( b)).norm() < 1e-14, "SLocalP2CL: evaluation");
+}
+
+int main ()
+{
+  try {
+    std::srand( 4711);
+    TestQuad5();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,118 @@
+/// \file locator.cpp
+/// \brief tests the spatial index LocatorIndexCL against LocatorCL
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include <vector>
+
+using namespace DROPS;
+
+void MarkDrop(DROPS::MultiGridCL& mg, int maxLevel)
+{
+    DROPS::Point3DCL Mitte( 0.5);
+    DROPS_FOR_TRIANG_TETRA( mg, maxLevel, It) {
+        if ( (GetBaryCenter(*It)-Mitte).norm()<=std::max(0.2,1.5*std::pow(It->GetVolume(),1.0/3.0)) )
+            It->SetRegRefMark();
+    }
+}
+
+/// \brief deterministic pseudo random numbers in [0,1)
+double Rand()
+{
+    static unsigned long state= 4711;
+    state= (1103515245ul*state + 12345ul) % 2147483648ul;
+    return state/2147483648.;
+}
+
+int main ()
+{
+  try {
+    DROPS::BrickBuilderCL brick(DROPS::std_basis<3>(0),
+                                DROPS::std_basis<3>(1),
+                                DROPS::std_basis<3>(2),
+                                DROPS::std_basis<3>(3),
+                                6, 6, 6);
+    DROPS::MultiGridCL mg( brick);
+    for (int i= 0; i < 3; ++i) {
+        MarkDrop( mg, -1);
+        mg.Refine();
+    }
+    mg.SizeInfo( std::cout);
+
+    // points inside and some outside of the unit cube
+    std::vector<Point3DCL> p( 20000);
+    for (Uint i= 0; i < p.size(); ++i)
+        p[i]= MakePoint3D( 1.1*Rand() - 0.05, 1.1*Rand() - 0.05, 1.1*Rand() - 0.05);
+
+    TimerCL time;
+    LocatorIndexCL index( mg);
+    time.Stop();
+    std::cout << "index: " << index.GetNumTetra() << " tetras, " << index.memory()/1024 << " kB, build time "
+              << time.GetTime() << " seconds" << std::endl;
+
+    time.Reset();
+    std::vector<LocationCL> loc;
+    index.Locate( loc, p);
+    time.Stop();
+    std::cout << "LocatorIndexCL: " << time.GetTime() << " seconds" << std::endl;
+
+    time.Reset();
+    std::vector<LocationCL> ref( p.size());
+    for (Uint i= 0; i < p.size(); ++i)
+        LocatorCL::Locate( ref[i], mg, -1, p[i]);
+    time.Stop();
+    std::cout << "LocatorCL:      " << time.GetTime() << " seconds" << std::endl;
+
+    // Both locations must agree on whether the point is in the domain. As points on common faces
+    // may be found in different tetras, the barycentric coordinates are checked instead of the tetras.
+    int err= 0;
+    for (Uint i= 0; i < p.size(); ++i) {
+        if (loc[i].IsValid() != ref[i].IsValid()) {
+            ++err;
+            continue;
+        }
+        if (!loc[i].IsValid())
+            continue;
+        const SVectorCL<4>& b= loc[i].GetBaryCoord();
+        Point3DCL q;
+        for (int v= 0; v < 4; ++v)
+            q+= b[v]*loc[i].GetTetra().GetVertex( v)->GetCoord();
+        if (!loc[i].GetTetra().IsInTriang( mg.GetLastLevel()) || (q - p[i]).norm() > 1e-10)
+            ++err;
+    }
+    std::cout << "errors: " << err << std::endl;
+
+    // the index must follow modifications of the multigrid
+    MarkDrop( mg, -1);
+    mg.Refine();
+    index.Update();
+    std::cout << "index after refinement: " << index.GetNumTetra() << " tetras" << std::endl;
+    LocationCL l;
+    if (!index.Locate( l, Point3DCL( 0.5)) || !l.GetTetra().IsInTriang( mg.GetLastLevel()))
+        ++err;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
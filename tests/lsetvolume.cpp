@@ -0,0 +1,109 @@
+/// \file lsetvolume.cpp
+/// \brief tests the volume computation of the level set function on the band of tetras and the volume correction
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+const double Radius= 0.3;
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5, 0.5, 0.5)).norm() - Radius;
+}
+
+/// \brief Compares the band integration with the integration over all tetras.
+void TestBand (const LevelsetP2CL& lset, int l)
+{
+    LevelsetVolumeCL band( lset, l), all( lset, l);
+    all.Init( -10., 10.);
+    Check( all.GetNumBand() == all.GetNumTetra(), "all tetras are band tetras for a large range");
+    const double s[3]= { -0.05, 0., 0.05 };
+    for (int i= 0; i < 3; ++i) {
+        band.Init( s[i], s[i]);
+        double area;
+        const double v= band.GetVolume( s[i], &area),
+                     vref= all.GetVolume( s[i]);
+        std::cout << "l: " << l << ", translation: " << s[i] << ", band tetras: " << band.GetNumBand() << " of " << band.GetNumTetra()
+                  << ", volume: " << v << ", area: " << area << '\n';
+        Check( std::abs( v - vref) <= 1e-12*vref, "volume on the band");
+        Check( band.GetNumBand() < band.GetNumTetra()/4, "size of the band");
+        const double r= Radius - s[i];
+        Check( std::abs( v - 4./3.*M_PI*r*r*r) < 0.05*v, "volume of the sphere");
+        Check( std::abs( area - 4.*M_PI*r*r) < 0.05*area, "area of the sphere");
+    }
+    band.Init( -0.05, 0.05);
+    Check( std::abs( band.GetVolume( 0.) - lset.GetVolume( 0., l)) <= 1e-12*band.GetVolume( 0.), "volume for a range of translations");
+}
+
+void TestAdjust (const LevelsetP2CL& lset, int l)
+{
+    const double d= -0.02,
+                 vol= lset.GetVolume( d, l),
+                 dphi= lset.AdjustVolume( vol, 1e-9, 0., l);
+    std::cout << "l: " << l << ", volume correction: " << dphi << '\n';
+    Check( std::abs( lset.GetVolume( dphi, l) - vol) <= 1e-9*vol, "volume correction");
+    Check( std::abs( dphi - d) < 1e-6, "translation of the volume correction");
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 12, 12, 12);
+    MultiGridCL mg( brick);
+
+    instat_scalar_fun_ptr sigma( 0);
+    SurfaceTensionCL sf( sigma, 0);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    TestBand( lset, 2);
+    TestBand( lset, -2);
+    TestAdjust( lset, 2);
+    TestAdjust( lset, -2);
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,142 @@
+/// \file matfree.cpp
+/// \brief tests the matrix-free application of the two-phase velocity operators against the assembled matrices
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "num/spmat.h"
+#include "num/solver.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "navstokes/instatnavstokes2phase.h"
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5, 0.5, 0.5)).norm() - 0.3;
+}
+
+Point3DCL Inflow (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[2]*(1. - p[2]), 0., 0.);
+}
+
+Point3DCL Vel (const Point3DCL& p, double)
+{
+    return MakePoint3D( p[1], -p[0], 0.5 + p[2]*p[2]);
+}
+
+double RelDiff (const VectorCL& a, const VectorCL& b)
+{
+    return supnorm( VectorCL( a - b))/supnorm( b);
+}
+
+int main ()
+{
+  try {
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 5, 5, 5);
+    MultiGridCL mg( brick);
+
+    instat_scalar_fun_ptr sigma( 0);
+    SurfaceTensionCL sf( sigma, 0);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf, 0.1);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    StokesBndDataCL::bnd_val_fun bfun[6]= { &Inflow, &Inflow, &Inflow, &Inflow, &Inflow, &Inflow };
+    StokesBndDataCL bnd( 6, bc, bfun);
+    TwoPhaseFlowCoeffCL coeff( 10., 1., 5., 1., 0., MakePoint3D( 0., 0., -9.81));
+    InstatNavierStokes2PhaseP2P1CL NS( mg, coeff, bnd);
+    MLIdxDescCL* vidx= &NS.vel_idx;
+    NS.CreateNumberingVel( mg.GetLastLevel(), vidx);
+    NS.A.SetIdx( vidx, vidx);
+    NS.M.SetIdx( vidx, vidx);
+    NS.N.SetIdx( vidx, vidx);
+    NS.b.SetIdx( vidx);
+    NS.v.SetIdx( vidx);
+    VelVecDescCL cplM( vidx), cplN( vidx);
+    NS.InitVel( &NS.v, Vel);
+    NS.SetupSystem1( &NS.A, &NS.M, &NS.b, &NS.b, &cplM, lset, 0.);
+    NS.SetupNonlinear( &NS.N, &NS.v, &cplN, lset, 0.);
+    const MatrixCL& A= NS.A.Data.GetFinest();
+    const MatrixCL& M= NS.M.Data.GetFinest();
+    const MatrixCL& N= NS.N.Data.GetFinest();
+    const size_t n= A.num_rows();
+
+    MatrixFreeVelocityP2CL op( NS, lset);
+    op.Setup();
+    op.SetVelocity( &NS.v);
+    Check( op.num_rows() == n && op.GetNumCutTetras() > 0, "dimensions");
+
+    VectorCL x( n);
+    for (size_t i= 0; i < n; ++i)
+        x[i]= std::sin( 0.3*i) + 0.1;
+
+    // the single operators and a combination as in the time integration
+    const double coeffs[4][3]= { {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}, {0.5, 10., 0.5} };
+    for (int k= 0; k < 4; ++k) {
+        const double a= coeffs[k][0], m= coeffs[k][1], c= coeffs[k][2];
+        op.SetCoeff( a, m, c);
+        MatrixCL L;
+        L.LinComb( a, A, m, M, c, N);
+        const double dy= RelDiff( op*x, L*x),
+                     dd= RelDiff( op.GetDiag(), L.GetDiag());
+        std::cout << "a " << a << ", m " << m << ", c " << c << ": relative difference of the product "
+                  << dy << ", of the diagonal " << dd << '\n';
+        Check( dy < 1e-12 && dd < 1e-12, "matrix-free operator");
+    }
+
+    // the operator can be used in the Krylov solvers
+    const VectorCL Dinv( 1./op.GetDiag());
+    DiagPcCL pc( Dinv);
+    GMResSolverCL<DiagPcCL> gmres( pc, 50, 500, 1e-10, /*relative*/ true);
+    MatrixCL L;
+    L.LinComb( 0.5, A, 10., M, 0.5, N);
+    const VectorCL b( L*x);
+    VectorCL y( n);
+    gmres.Solve( op, y, b);
+    std::cout << "GMRES with the matrix-free operator: iterations " << gmres.GetIter() << ", residual " << gmres.GetResid() << '\n';
+    Check( RelDiff( y, x) < 1e-7, "solution with the matrix-free operator");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
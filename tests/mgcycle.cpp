@@ -0,0 +1,152 @@
+/// \file mgcycle.cpp
+/// \brief tests the cycle types, full multigrid, the adaptive smoothing and the statistics of MGSolverCL
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/solver.h"
+#include "num/MGsolver.h"
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief 1D P1 stiffness matrix with n interior nodes on (0,1).
+void BuildLaplace1D (MatrixCL& A, size_t n)
+{
+    const double h= 1./(n + 1);
+    MatrixBuilderCL B( &A, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        B( i, i)= 2./h;
+        if (i > 0)     B( i, i - 1)= -1./h;
+        if (i < n - 1) B( i, i + 1)= -1./h;
+    }
+    B.Build();
+}
+
+/// \brief Linear interpolation from nc to 2*nc+1 interior nodes.
+void BuildProlongation1D (MatrixCL& P, size_t nc)
+{
+    MatrixBuilderCL B( &P, 2*nc + 1, nc);
+    for (size_t i= 0; i < nc; ++i) {
+        B( 2*i,     i)= 0.5;
+        B( 2*i + 1, i)= 1.;
+        B( 2*i + 2, i)= 0.5;
+    }
+    B.Build();
+}
+
+const size_t numLvl= 7;
+typedef MGSolverCL<JORsmoothCL, PCG_SsorCL> MGCL;
+
+/// \brief Solves the problem with the given cycle parameters; returns the number of cycles.
+int Solve (MGCL& mg, const MLMatrixCL& A, const VectorCL& b, VectorCL& x, const MGCycleParamCL& param)
+{
+    mg.SetCycleParam( param);
+    mg.SetCollectStatistics( true);
+    x= 0.;
+    mg.Solve( A, x, b);
+    return mg.GetIter();
+}
+
+int main ()
+{
+  try {
+    JORsmoothCL  smoother( 0.6);
+    SSORPcCL     ssor;
+    PCG_SsorCL   coarse( ssor, 500, 1e-12, true);
+    MGCL mg( smoother, coarse, 200, 1e-8, true);
+
+    MLMatrixCL A( numLvl);
+    size_t n= 3;
+    mg.GetProlongation()->resize( numLvl);
+    MLMatrixCL::iterator a= A.begin(), p= mg.GetProlongation()->begin();
+    for (size_t l= 0; l < numLvl; ++l, ++a, ++p) {
+        BuildLaplace1D( *a, n);
+        if (l > 0)
+            BuildProlongation1D( *p, (n - 1)/2);
+        n= 2*n + 1;
+    }
+    n= A.num_rows();
+    VectorCL b( n), x( n);
+    for (size_t i= 0; i < n; ++i)
+        b[i]= std::sin( 0.01*i) + 1.;
+
+    // V-, W- and F-cycle
+    const int itV= Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle));
+    const double rateV= mg.GetStatistics().GetConvergenceRate();
+    mg.GetStatistics().Print( std::cout);
+    Check( norm( VectorCL( A*x - b)) <= 1e-8, "V-cycle: residual");
+    Check( mg.GetStatistics().GetLevels().size() == numLvl && mg.GetStatistics().GetLevels()[0].visits == Uint( itV),
+           "V-cycle: statistics");
+
+    const int itW= Solve( mg, A, b, x, MGCycleParamCL( MG_WCycle));
+    const double rateW= mg.GetStatistics().GetConvergenceRate();
+    Check( norm( VectorCL( A*x - b)) <= 1e-8, "W-cycle: residual");
+    Check( mg.GetStatistics().GetLevels()[0].visits == Uint( itW) << (numLvl - 1), "W-cycle: visits of the coarsest level");
+
+    const int itF= Solve( mg, A, b, x, MGCycleParamCL( MG_FCycle));
+    const double rateF= mg.GetStatistics().GetConvergenceRate();
+    Check( norm( VectorCL( A*x - b)) <= 1e-8, "F-cycle: residual");
+    Check( mg.GetStatistics().GetLevels()[0].visits == itF*numLvl, "F-cycle: visits of the coarsest level");
+    std::cout << "iterations: V-cycle " << itV << ", W-cycle " << itW << ", F-cycle " << itF << '\n'
+              << "average reduction: V-cycle " << rateV << ", W-cycle " << rateW << ", F-cycle " << rateF << '\n';
+    Check( itW <= itV && itF <= itV && rateW < rateV && rateF < rateV, "W- and F-cycle converge faster");
+
+    // full multigrid start
+    mg.SetMaxIter( 1);
+    Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle));
+    const double resV= norm( VectorCL( A*x - b));
+    Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle, 1., /*fullMG*/ true));
+    const double resFMG= norm( VectorCL( A*x - b));
+    std::cout << "residual after one cycle: V-cycle " << resV << ", FMG " << resFMG << '\n';
+    Check( resFMG < 0.25*resV, "full multigrid");
+    mg.SetMaxIter( 200);
+    const int itFMG= Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle, 1., true));
+    Check( itFMG < itV && norm( VectorCL( A*x - b)) <= 1e-8, "full multigrid: iterations");
+
+    // variable V-cycle: the smoothing steps double on each coarser level
+    const int itVar= Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle, 2.));
+    Check( mg.GetStatistics().GetLevels()[1].smoothSteps == Uint( 2*itVar) << (numLvl - 2)
+           && mg.GetStatistics().GetLevels()[numLvl - 1].smoothSteps == Uint( 2*itVar), "variable V-cycle: smoothing steps");
+    Check( itVar <= itV, "variable V-cycle: iterations");
+
+    // adaptive smoothing: the rate of the V-cycle is too slow for the requested rate
+    const int itAd= Solve( mg, A, b, x, MGCycleParamCL( MG_VCycle, 1., false, 0.5*rateV));
+    std::cout << "adaptive smoothing: iterations " << itAd << ", smoothing steps on the finest level "
+              << mg.GetStatistics().GetLevels()[numLvl - 1].smoothSteps << '\n';
+    Check( itAd < itV && mg.GetStatistics().GetLevels()[numLvl - 1].smoothSteps > Uint( 2*itAd), "adaptive smoothing");
+    Check( norm( VectorCL( A*x - b)) <= 1e-8, "adaptive smoothing: residual");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
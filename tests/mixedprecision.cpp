@@ -0,0 +1,219 @@
+/// \file mixedprecision.cpp
+/// \brief tests single precision preconditioners inside the double precision Krylov solvers
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/solver.h"
+#include "num/MGsolver.h"
+#include "stokes/integrTime.h"
+#include "num/stokessolver.h"
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief 1D P1 stiffness matrix with n interior nodes on (0,1) plus a mass-like shift s.
+void BuildLaplace1D (MatrixCL& A, size_t n, double s)
+{
+    const double h= 1./(n + 1);
+    MatrixBuilderCL B( &A, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        B( i, i)= 2./h + s*h;
+        if (i > 0)     B( i, i - 1)= -1./h;
+        if (i < n - 1) B( i, i + 1)= -1./h;
+    }
+    B.Build();
+}
+
+/// \brief Linear interpolation from nc to 2*nc+1 interior nodes.
+void BuildProlongation1D (MatrixCL& P, size_t nc)
+{
+    MatrixBuilderCL B( &P, 2*nc + 1, nc);
+    for (size_t i= 0; i < nc; ++i) {
+        B( 2*i,     i)= 0.5;
+        B( 2*i + 1, i)= 1.;
+        B( 2*i + 2, i)= 0.5;
+    }
+    B.Build();
+}
+
+/// \brief Convection-diffusion matrix on a n x n grid.
+void BuildConvDiff (MatrixCL& A, size_t n, double c)
+{
+    MatrixBuilderCL B( &A, n*n, n*n);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j < n; ++j) {
+            const size_t k= i*n + j;
+            B( k, k)= 4.;
+            if (i > 0)     B( k, k - n)= -1. - c;
+            if (i < n - 1) B( k, k + n)= -1. + c;
+            if (j > 0)     B( k, k - 1)= -1. - 0.5*c;
+            if (j < n - 1) B( k, k + 1)= -1. + 0.5*c;
+        }
+    B.Build();
+}
+
+typedef MGSolverCL<SSORsmoothCL, PCG_SsorCL> MGCL;
+
+void TestMG ()
+{
+    const size_t numLvl= 7;
+    SSORsmoothCL smoother( 1.0);
+    SSORPcCL     ssor;
+    PCG_SsorCL   coarse( ssor, 500, 1e-6, true);
+    MGCL mg( smoother, coarse, 1, -1., false),
+         mgf( smoother, coarse, 1, -1., false);
+    mgf.SetSinglePrecision( true);
+
+    MLMatrixCL A( numLvl);
+    size_t n= 3;
+    mg.GetProlongation()->resize( numLvl);
+    MLMatrixCL::iterator a= A.begin(), p= mg.GetProlongation()->begin();
+    for (size_t l= 0; l < numLvl; ++l, ++a, ++p) {
+        BuildLaplace1D( *a, n, 1.);
+        if (l > 0)
+            BuildProlongation1D( *p, (n - 1)/2);
+        n= 2*n + 1;
+    }
+    *mgf.GetProlongation()= *mg.GetProlongation();
+    n= A.num_rows();
+
+    VectorCL b( n);
+    for (size_t i= 0; i < n; ++i)
+        b[i]= std::sin( 0.01*i) + 1.;
+
+    // multigrid as preconditioner of CG
+    typedef SolverAsPreCL<MGCL> MGPcCL;
+    MGPcCL pc( mg), pcf( mgf);
+    PCGSolverCL<MGPcCL> cg( pc, 100, 1e-10, true), cgf( pcf, 100, 1e-10, true);
+    VectorCL x( n), xf( n);
+    cg.Solve( A, x, b);
+    cgf.Solve( A, xf, b);
+    std::cout << "PCG with MG: iterations " << cg.GetIter() << ", single precision MG: " << cgf.GetIter() << '\n';
+    Check( cgf.GetResid() <= 1e-10, "PCG with single precision MG: convergence");
+    Check( cgf.GetIter() <= cg.GetIter() + 2, "PCG with single precision MG: iterations");
+    Check( norm( VectorCL( A*xf - b)) <= 1e-9*norm( b), "PCG with single precision MG: residual");
+
+    // the copy of the hierarchy is refreshed, if the matrix changes
+    FloatMatrixCacheCL cache;
+    const float a0= cache.Get( A).GetFinest().raw_val()[0];
+    Check( &cache.Get( A) == &cache.Get( A), "reuse of the single precision hierarchy");
+    for (MLMatrixCL::iterator it= A.begin(); it != A.end(); ++it)
+        *it*= 2.;
+    Check( cache.Get( A).GetFinest().raw_val()[0] == 2.f*a0 && cache.Get( A).begin()->raw_val()[0] == float( A.begin()->raw_val()[0]),
+           "refresh of the single precision hierarchy");
+    xf= 0.;
+    cgf.Solve( A, xf, b);
+    Check( norm( VectorCL( A*xf - b)) <= 1e-9*norm( b), "PCG with single precision MG after a change of the matrix");
+}
+
+void TestPc ()
+{
+    const size_t n= 40;
+    MatrixCL A;
+    BuildConvDiff( A, n, 0.3);
+    VectorCL b( n*n);
+    for (size_t i= 0; i < n*n; ++i)
+        b[i]= std::cos( 0.1*i);
+
+    SSORPcCL ssor;
+    typedef SinglePrecisionPcCL<SSORPcCL> SinglePcCL;
+    SinglePcCL ssorf( ssor);
+    GCRSolverCL<SSORPcCL>   gcr( ssor, 50, 500, 1e-10, /*relative*/ true);
+    GCRSolverCL<SinglePcCL> gcrf( ssorf, 50, 500, 1e-10, /*relative*/ true);
+    VectorCL x( n*n), xf( n*n);
+    gcr.Solve( A, x, b);
+    gcrf.Solve( A, xf, b);
+    std::cout << "GCR with SSOR: iterations " << gcr.GetIter() << ", single precision SSOR: " << gcrf.GetIter() << '\n';
+    Check( norm( VectorCL( A*xf - b)) <= 1e-10*norm( b), "GCR with single precision SSOR: residual");
+    Check( gcrf.GetIter() <= gcr.GetIter() + 2, "GCR with single precision SSOR: iterations");
+    Check( supnorm( VectorCL( x - xf)) <= 1e-8*supnorm( x), "GCR with single precision SSOR: solution");
+}
+
+void TestISMG ()
+{
+    // 1D hierarchies of a pressure stiffness and a lumped pressure mass matrix
+    const size_t numLvl= 6;
+    MLMatrixCL Apr( numLvl), Mpr( numLvl);
+    ISMGPreCL ismg( Apr, Mpr, 1., 1., 2, 2), ismgf( Apr, Mpr, 1., 1., 2, 2);
+    ismgf.SetSinglePrecision( true);
+    ismg.GetProlongation()->resize( numLvl);
+    size_t n= 3;
+    MLMatrixCL::iterator a= Apr.begin(), m= Mpr.begin(), p= ismg.GetProlongation()->begin();
+    for (size_t l= 0; l < numLvl; ++l, ++a, ++m, ++p) {
+        BuildLaplace1D( *a, n, 1.);
+        *m= MatrixCL( std::valarray<double>( 1./(n + 1), n));
+        if (l > 0)
+            BuildProlongation1D( *p, (n - 1)/2);
+        n= 2*n + 1;
+    }
+    *ismgf.GetProlongation()= *ismg.GetProlongation();
+    n= Apr.num_rows();
+
+    VectorCL c( n), x( n), xf( n);
+    for (size_t i= 0; i < n; ++i)
+        c[i]= std::sin( 0.05*i);
+    ismg.Apply( Apr, x, c);
+    ismgf.Apply( Apr, xf, c);
+    const double diff= supnorm( VectorCL( x - xf))/supnorm( x);
+    std::cout << "ISMGPreCL: relative difference of single and double precision " << diff << '\n';
+    Check( diff <= 1e-6, "ISMGPreCL in single precision");
+
+    // lazy refresh of the single precision copies: a small drift is ignored, a large one is not
+    ISMGPreCL ismgl( Apr, Mpr, 1., 1., 2, 2);
+    ismgl.SetSinglePrecision( true);
+    ismgl.SetRefreshTol( 1e-3, 2);
+    *ismgl.GetProlongation()= *ismg.GetProlongation();
+    ismgl.Apply( Apr, xf, c);
+    for (a= Apr.begin(); a != Apr.end(); ++a)
+        *a*= 1. + 1e-5;
+    ismgl.Apply( Apr, xf, c);
+    Check( ismgl.GetRefresh().GetNumRefresh() == 1 && ismgl.GetRefresh().GetNumSkip() == 1, "ISMGPreCL: small drift");
+    for (a= Apr.begin(); a != Apr.end(); ++a)
+        *a*= 2.;
+    ismg.Apply( Apr, x, c);
+    ismgl.Apply( Apr, xf, c);
+    const double diffl= supnorm( VectorCL( x - xf))/supnorm( x);
+    std::cout << "ISMGPreCL: relative difference after a refresh " << diffl << '\n';
+    Check( ismgl.GetRefresh().GetNumRefresh() == 2 && diffl <= 1e-6, "ISMGPreCL: large drift");
+}
+
+int main ()
+{
+  try {
+    TestMG();
+    TestPc();
+    TestISMG();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
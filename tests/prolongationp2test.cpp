@@ -29,6 +29,9 @@
 #include "geom/builder.h"
 #include "num/fe.h"
 #include "misc/problem.h"
+#include "num/MGsolver.h"
+#include "num/poissonsolverfactory.h"
+#include "misc/params.h"
 
 using namespace DROPS;
 
@@ -115,6 +118,19 @@ int TestProlongation()
                 }
             }
         }
+        // the same operator without a matrix
+        DROPS::ProlongationCL Pfree;
+        Pfree.Init( mg, i0, i1, DROPS::ProlongationCL::MatrixFreeC);
+        VectorCL xc( i0.NumUnknowns()), xf( i1.NumUnknowns());
+        for (size_t k= 0; k < xc.size(); ++k)
+            xc[k]= std::sin( 1. + k);
+        for (size_t k= 0; k < xf.size(); ++k)
+            xf[k]= std::cos( 1. + k);
+        if (norm( VectorCL( Pfree*xc - P.Data*xc)) > 1e-14
+            || norm( VectorCL( transp_mul( Pfree, xf) - transp_mul( P.Data, xf))) > 1e-14) {
+            std::cout << "Matrix-free prolongation differs: rule= " << i << std::endl;
+            ++ret;
+        }
 //        std::cout << "Rule: " << i << std::endl;
 //        std::cout << P.Data << std::endl;
         DROPS::DeleteNumbOnSimplex( i0.GetIdx(), mg.GetAllVertexBegin( i0.TriangLevel()),
@@ -133,11 +149,184 @@ int TestProlongation()
 }
 
 
+/// \brief Compares the levels of P with the matrices Pref for random vectors; returns the number of differences.
+int CompareProlongation (const DROPS::MLProlongationCL& P, const DROPS::MLMatrixCL& Pref)
+{
+    int ret= 0;
+    DROPS::MLMatrixCL::const_iterator ref= ++Pref.begin();
+    for (DROPS::MLProlongationCL::const_iterator it= ++P.begin(); it != P.end(); ++it, ++ref) {
+        VectorCL xc( it->num_cols()), xf( it->num_rows());
+        for (size_t k= 0; k < xc.size(); ++k)
+            xc[k]= std::sin( 0.1*k);
+        for (size_t k= 0; k < xf.size(); ++k)
+            xf[k]= std::cos( 0.1*k);
+        const VectorCL Px( *ref*xc), PTx( transp_mul( *ref, xf));
+        if (norm( VectorCL( *it*xc - Px)) > 1e-12*norm( Px)
+            || norm( VectorCL( transp_mul( *it, xf) - PTx)) > 1e-12*norm( PTx))
+            ++ret;
+    }
+    return ret;
+}
+
+/// \brief Graph Laplacian of the P1 unknowns plus a mass-like diagonal.
+void BuildGraphLaplacian (const DROPS::MultiGridCL& mg, const DROPS::IdxDescCL& idx, DROPS::MatrixCL& A)
+{
+    const Uint sys= idx.GetIdx();
+    DROPS::MatrixBuilderCL B( &A, idx.NumUnknowns(), idx.NumUnknowns());
+    for (DROPS::MultiGridCL::const_TriangEdgeIteratorCL it= mg.GetTriangEdgeBegin( idx.TriangLevel()),
+         end= mg.GetTriangEdgeEnd( idx.TriangLevel()); it != end; ++it) {
+        const DROPS::IdxT i= it->GetVertex( 0)->Unknowns( sys), j= it->GetVertex( 1)->Unknowns( sys);
+        B( i, j)-= 1.;
+        B( j, i)-= 1.;
+        B( i, i)+= 1.;
+        B( j, j)+= 1.;
+    }
+    for (DROPS::IdxT i= 0; i < idx.NumUnknowns(); ++i)
+        B( i, i)+= 0.1;
+    B.Build();
+}
+
+/// \brief MLProlongationCL for P1 and vecP2: results, setup on demand and MG with the matrix-free prolongation.
+int TestOnDemand ()
+{
+    std::cout << "\n-----------------------------------------------------------------"
+                 "\nTesting prolongations set up on demand:\n";
+    int ret= 0;
+    DROPS::BrickBuilderCL brick( DROPS::Point3DCL( 0.), DROPS::std_basis<3>( 1), DROPS::std_basis<3>( 2),
+                                 DROPS::std_basis<3>( 3), 2, 2, 2);
+    DROPS::MultiGridCL mg( brick);
+    MarkDrop( mg, mg.GetLastLevel());
+    mg.Refine();
+    MarkDrop( mg, mg.GetLastLevel());
+    mg.Refine();
+    const DROPS::BndCondT bc[6]= { DROPS::DirBC, DROPS::DirBC, DROPS::DirBC, DROPS::DirBC, DROPS::DirBC, DROPS::DirBC };
+    const DROPS::BndCondCL dir( 6, bc);
+    DROPS::MLIdxDescCL vidx( DROPS::vecP2_FE, mg.GetNumLevel(), dir), pidx( DROPS::P1_FE, mg.GetNumLevel());
+    vidx.CreateNumbering( mg.GetLastLevel(), mg);
+    pidx.CreateNumbering( mg.GetLastLevel(), mg);
+
+    DROPS::MLMatrixCL PVref, PPref;
+    SetupP2ProlongationMatrix( mg, PVref, &vidx, &vidx);
+    SetupP1ProlongationMatrix( mg, PPref, &pidx, &pidx);
+    DROPS::MLProlongationCL PV, PVfree( DROPS::ProlongationCL::MatrixFreeC), PP, PPfree( DROPS::ProlongationCL::MatrixFreeC);
+    PV.Init( mg, &vidx, &vidx);
+    PVfree.Init( mg, &vidx, &vidx);
+    PP.Init( mg, &pidx, &pidx);
+    PPfree.Init( mg, &pidx, &pidx);
+    if (PV.size() != 3 || PV.GetFinest().GetNumBuilds() != 0) {
+        std::cout << "MLProlongationCL: levels or setup before the first use\n";
+        ++ret;
+    }
+    if (CompareProlongation( PV, PVref) + CompareProlongation( PVfree, PVref)
+        + CompareProlongation( PP, PPref) + CompareProlongation( PPfree, PPref) != 0) {
+        std::cout << "MLProlongationCL: results differ from SetupP1/P2ProlongationMatrix\n";
+        ++ret;
+    }
+    CompareProlongation( PV, PVref);
+    if (PV.GetFinest().GetNumBuilds() != 1 || !PV.GetFinest().IsUpToDate()) {
+        std::cout << "MLProlongationCL: the matrix is not reused\n";
+        ++ret;
+    }
+    size_t nnz= 0;
+    for (DROPS::MLMatrixCL::const_iterator it= PVref.begin(); it != PVref.end(); ++it)
+        nnz+= it->num_nonzeros();
+    std::cout << "vecP2: " << vidx.NumUnknowns() << " unknowns, " << nnz << " nonzeros in the prolongations, none for MatrixFreeC\n";
+
+    // multigrid with the matrix-free prolongation takes the same iterations
+    DROPS::MLMatrixCL A( mg.GetNumLevel());
+    BuildGraphLaplacian( mg, pidx.GetFinest(), A.GetFinest());
+    DROPS::MLMatrixCL::iterator a= A.GetFinestIter(), p= PPref.GetFinestIter();
+    for (; a != A.begin(); --p) {
+        DROPS::MatrixCL Pt;
+        transpose( *p, Pt);
+        DROPS::MatrixCL& fine= *a;
+        galerkin_product( Pt, fine, *p, *--a);
+    }
+    VectorCL b( A.GetFinest().num_rows()), x1( b.size()), x2( b.size());
+    for (size_t k= 0; k < b.size(); ++k)
+        b[k]= std::sin( 0.3*k);
+    DROPS::SSORsmoothCL smoother( 1.0);
+    DROPS::SSORPcCL     ssor;
+    DROPS::PCG_SsorCL   coarse( ssor, 500, 1e-12, true);
+    DROPS::MGSolverCL<DROPS::SSORsmoothCL, DROPS::PCG_SsorCL> mgref( smoother, coarse, 50, 1e-8);
+    *mgref.GetProlongation()= PPref;
+    mgref.Solve( A, x1, b);
+    DROPS::MGSolverCL<DROPS::SSORsmoothCL, DROPS::PCG_SsorCL, DROPS::MLProlongationCL> mgfree( smoother, coarse, 50, 1e-8);
+    mgfree.GetProlongation()->Init( mg, &pidx, &pidx);
+    mgfree.GetProlongation()->SetMode( DROPS::ProlongationCL::MatrixFreeC);
+    mgfree.Solve( A, x2, b);
+    std::cout << "MG: " << mgref.GetIter() << " iterations with matrices, " << mgfree.GetIter() << " matrix-free\n";
+    if (mgref.GetIter() != mgfree.GetIter() || norm( VectorCL( x1 - x2)) > 1e-10*norm( x1)) {
+        std::cout << "MG with MLProlongationCL differs\n";
+        ++ret;
+    }
+
+    // the same through the factory: Poisson.ProlongationMode 1 selects the matrix-free prolongation
+    DROPS::ParamCL P;
+    P.put( "Poisson.Method", 103);
+    P.put( "Poisson.Relax", 1.);
+    P.put( "Poisson.Iter", 50);
+    P.put( "Poisson.Tol", 1e-8);
+    P.put( "Poisson.RelativeErr", 1.);
+    P.put( "Poisson.Restart", 100);
+    P.put( "Poisson.SmoothingSteps", 1);
+    P.put( "Poisson.NumLvl", -1);
+    P.put( "Poisson.ProlongationMode", 1);
+    DROPS::PoissonSolverFactoryCL<DROPS::MLProlongationCL> factory( P, pidx);
+    DROPS::PoissonSolverBaseCL* solver= factory.CreatePoissonSolver();
+    SetupP1ProlongationMatrix( mg, *factory.GetProlongation(), &pidx, &pidx);
+    VectorCL x3( b.size());
+    solver->Solve( A, x3, b);
+    std::cout << "PoissonSolverFactoryCL<MLProlongationCL>: " << solver->GetIter() << " iterations\n";
+    if (factory.GetProlongation()->GetMode() != DROPS::ProlongationCL::MatrixFreeC
+        || factory.GetProlongation()->GetFinest().GetNumBuilds() != 0
+        || solver->GetResid() > 1e-8 || norm( VectorCL( x3 - x1)) > 1e-6*norm( x1)) {
+        std::cout << "PoissonSolverFactoryCL: matrix-free prolongation failed\n";
+        ++ret;
+    }
+    delete solver;
+    try {
+        DROPS::PoissonSolverFactoryCL<> assembled( P, pidx);
+        std::cout << "PoissonSolverFactoryCL: MLMatrixCL accepted the matrix-free mode\n";
+        ++ret;
+    }
+    catch (DROPS::DROPSErrCL&) {}
+
+    // UpdateProlongationCL only initializes an MLProlongationCL
+    DROPS::MLProlongationCL PPupd;
+    DROPS::UpdateProlongationCL update( mg, &PPupd, &pidx, &pidx);
+    if (CompareProlongation( PPupd, PPref) != 0) {
+        std::cout << "UpdateProlongationCL: MLProlongationCL differs\n";
+        ++ret;
+    }
+
+    // a new numbering after the refinement invalidates the matrices
+    vidx.DeleteNumbering( mg);
+    pidx.DeleteNumbering( mg);
+    MarkDrop( mg, mg.GetLastLevel());
+    mg.Refine();
+    vidx.resize( mg.GetNumLevel(), DROPS::vecP2_FE, dir);
+    pidx.resize( mg.GetNumLevel(), DROPS::P1_FE);
+    vidx.CreateNumbering( mg.GetLastLevel(), mg);
+    pidx.CreateNumbering( mg.GetLastLevel(), mg);
+    PVref.clear();
+    SetupP2ProlongationMatrix( mg, PVref, &vidx, &vidx);
+    if (PV.GetFinest().IsUpToDate() || PV.size() != mg.GetNumLevel() || CompareProlongation( PV, PVref) != 0
+        || PV.GetFinest().GetNumBuilds() != 1 || CompareProlongation( PVfree, PVref) != 0) {
+        std::cout << "MLProlongationCL: not updated after the refinement\n";
+        ++ret;
+    }
+    std::cout << "\n-----------------------------------------------------------------"
+              << std::endl;
+    return ret;
+}
+
 // Returns 0, iff everything seems ok.
 int main ()
 {
   try {
     int ret= TestProlongation();
+    ret+= TestOnDemand();
     return ret;
   }
   catch (DROPS::DROPSErrCL err) { err.handle(); }
@@ -0,0 +1,139 @@
+/// \file recycle.cpp
+/// \brief tests the lazy refresh of preconditioners and the recycling of search directions in GCR and GMRESR
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/solver.h"
+#include "stokes/integrTime.h"
+#include "num/stokessolver.h"
+#include <iostream>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief Convection-diffusion matrix on a n x n grid; the convection is scaled by c, the diagonal is shifted by s.
+void BuildConvDiff (MatrixCL& A, size_t n, double c, double s)
+{
+    MatrixBuilderCL B( &A, n*n, n*n);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j < n; ++j) {
+            const size_t k= i*n + j;
+            B( k, k)= 4. + s;
+            if (i > 0)     B( k, k - n)= -1. - c;
+            if (i < n - 1) B( k, k + n)= -1. + c;
+            if (j > 0)     B( k, k - 1)= -1. - 0.5*c;
+            if (j < n - 1) B( k, k + 1)= -1. + 0.5*c;
+        }
+    B.Build();
+}
+
+void TestRefresh ()
+{
+    std::cout << "PcRefreshCL:\n";
+    MatrixCL A;
+    BuildConvDiff( A, 10, 0.3, 0.);
+    PcRefreshCL refresh( 1e-3, 2);
+    refresh.Watch( &A);
+    Check( refresh.Check(), "first check");
+    Check( !refresh.Check(), "unchanged matrix");
+
+    A*= 1. + 1e-5;
+    Check( !refresh.Check(), "small drift 1");
+    A*= 1. + 1e-5;
+    Check( !refresh.Check(), "small drift 2");
+    A*= 1. + 1e-5;
+    Check( refresh.Check(), "maximal number of skips");
+    A*= 1.1;
+    Check( refresh.Check(), "large drift");
+    BuildConvDiff( A, 11, 0.3, 0.);
+    Check( refresh.Check(), "dimension");
+    Check( refresh.GetNumRefresh() == 4 && refresh.GetNumSkip() == 2, "statistics");
+
+    refresh.SetTol( 0.);
+    A*= 1. + 1e-12;
+    Check( refresh.Check(), "tolerance 0");
+}
+
+void TestRecycle ()
+{
+    const size_t n= 30;
+    MatrixCL A;
+    BuildConvDiff( A, n, 0.3, 0.);
+    VectorCL b( n*n);
+    for (size_t i= 0; i < n*n; ++i)
+        b[i]= std::sin( 0.1*i);
+    JACPcCL pc;
+
+    GCRSolverCL<JACPcCL> gcr( pc, 20, 500, 1e-8, /*relative*/ true),
+                         gcrrec( pc, 20, 500, 1e-8, /*relative*/ true);
+    gcrrec.SetRecycle( 10);
+    GMResRSolverCL<JACPcCL> gmresr( pc, 5, 500, 5, 1e-8, 1e-2, /*relative*/ true),
+                            gmresrrec( pc, 5, 500, 5, 1e-8, 1e-2, /*relative*/ true);
+    gmresrrec.SetRecycle( 10);
+
+    VectorCL x( n*n);
+    gcrrec.Solve( A, x, b);
+    x= 0.;
+    gmresrrec.Solve( A, x, b);
+    Check( gcrrec.GetRecycle().size() == 10, "size of the recycled space");
+
+    // slightly changed system
+    BuildConvDiff( A, n, 0.31, 0.01);
+    b*= 1.01;
+    VectorCL x0( n*n), x1( n*n), x2( n*n), x3( n*n);
+    gcr.Solve( A, x0, b);
+    gcrrec.Solve( A, x1, b);
+    gmresr.Solve( A, x2, b);
+    gmresrrec.Solve( A, x3, b);
+    std::cout << "GCR iterations: " << gcr.GetIter() << ", with recycling: " << gcrrec.GetIter() << '\n'
+              << "GMResR iterations: " << gmresr.GetIter() << ", with recycling: " << gmresrrec.GetIter() << '\n';
+    Check( gcrrec.GetIter() < gcr.GetIter(), "GCR iterations");
+    Check( gmresrrec.GetIter() < gmresr.GetIter(), "GMResR iterations");
+    Check( norm( VectorCL( A*x1 - b)) <= 1e-8*norm( b), "GCR residual");
+    Check( norm( VectorCL( A*x3 - b)) <= 1e-8*norm( b), "GMResR residual");
+
+    // a system of another dimension discards the recycled space
+    BuildConvDiff( A, n + 1, 0.3, 0.);
+    VectorCL b2( 1., (n + 1)*(n + 1)), x4( (n + 1)*(n + 1));
+    gcrrec.Solve( A, x4, b2);
+    Check( norm( VectorCL( A*x4 - b2)) <= 1e-8*norm( b2), "GCR residual after change of dimension");
+}
+
+int main ()
+{
+  try {
+    TestRefresh();
+    TestRecycle();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
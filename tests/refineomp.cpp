@@ -0,0 +1,109 @@
+/// \file refineomp.cpp
+/// \brief tests the OpenMP-parallel refinement against the serial refinement
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include <sstream>
+
+using namespace DROPS;
+
+void MarkDrop (MultiGridCL& mg, const Point3DCL& c, bool refine)
+{
+    DROPS_FOR_TRIANG_TETRA( mg, -1, It) {
+        if ( (GetBaryCenter(*It)-c).norm()<=std::max(0.15,1.5*std::pow(It->GetVolume(),1.0/3.0)) ) {
+            if (refine) It->SetRegRefMark();
+            else        It->SetRemoveMark();
+        }
+    }
+}
+
+/// \brief Writes the vertices and tetras of all levels in the order of the containers.
+/// The ids are written relative to the smallest id, as the id counters are global.
+std::string Fingerprint (const MultiGridCL& mg)
+{
+    Ulint minVert= ~0ul, minTetra= ~0ul;
+    for (MultiGridCL::const_VertexIterator it= mg.GetAllVertexBegin(); it != mg.GetAllVertexEnd(); ++it)
+        minVert= std::min( minVert, it->GetId().GetIdent());
+    for (MultiGridCL::const_TetraIterator it= mg.GetAllTetraBegin(); it != mg.GetAllTetraEnd(); ++it)
+        minTetra= std::min( minTetra, it->GetId().GetIdent());
+
+    std::ostringstream os;
+    for (Uint lvl= 0; lvl <= mg.GetLastLevel(); ++lvl) {
+        os << "level " << lvl << '\n';
+        for (MultiGridCL::const_VertexIterator it= mg.GetVerticesBegin( lvl); it != mg.GetVerticesEnd( lvl); ++it)
+            os << it->GetId().GetIdent() - minVert << ' ' << it->GetCoord() << '\n';
+        for (MultiGridCL::const_EdgeIterator it= mg.GetEdgesBegin( lvl); it != mg.GetEdgesEnd( lvl); ++it)
+            os << GetBaryCenter( *it) << '\n';
+        for (MultiGridCL::const_FaceIterator it= mg.GetFacesBegin( lvl); it != mg.GetFacesEnd( lvl); ++it)
+            os << GetBaryCenter( *it) << '\n';
+        for (MultiGridCL::const_TetraIterator it= mg.GetTetrasBegin( lvl); it != mg.GetTetrasEnd( lvl); ++it) {
+            os << it->GetId().GetIdent() - minTetra << ' ' << it->GetRefRule();
+            for (Uint v= 0; v < NumVertsC; ++v)
+                os << ' ' << it->GetVertex( v)->GetId().GetIdent() - minVert;
+            os << '\n';
+        }
+    }
+    return os.str();
+}
+
+/// \brief Refines and coarsens a drop moving through the unit cube, returns the fingerprints of all steps.
+std::string Run (int numThreads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads( numThreads);
+#else
+    (void)numThreads;
+#endif
+    BrickBuilderCL brick( std_basis<3>(0), std_basis<3>(1), std_basis<3>(2), std_basis<3>(3), 4, 4, 4);
+    MultiGridCL mg( brick);
+    std::string fp;
+    for (int step= 0; step < 4; ++step) {
+        const Point3DCL c= MakePoint3D( 0.2 + 0.075*step, 0.5, 0.5);
+        if (step > 2)
+            MarkDrop( mg, c - MakePoint3D( 0.3, 0., 0.), false);
+        MarkDrop( mg, c, true);
+        mg.Refine();
+        if (!mg.IsSane( std::cout))
+            throw DROPSErrCL( "Run: multigrid is not sane");
+        fp+= Fingerprint( mg);
+    }
+    mg.SizeInfo( std::cout);
+    return fp;
+}
+
+int main ()
+{
+  try {
+    const std::string serial= Run( 1);
+    int err= 0;
+    for (int numThreads= 2; numThreads <= 4; numThreads+= 2) {
+        const bool same= Run( numThreads) == serial;
+        std::cout << numThreads << " threads: " << (same ? "identical to serial refinement" : "differs from serial refinement") << std::endl;
+        err+= !same;
+    }
+    return err;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,198 @@
+/// \file sparsedirect.cpp
+/// \brief tests the sparse direct solver with nested dissection and cached symbolic factorization
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/sparsedirect.h"
+#include "num/MGsolver.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief 7-point Laplacian on a n x n x n grid plus convection c in x-direction.
+void BuildConvDiff3D (MatrixCL& A, size_t n, double c)
+{
+    MatrixBuilderCL B( &A, n*n*n, n*n*n);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j < n; ++j)
+            for (size_t k= 0; k < n; ++k) {
+                const size_t r= (i*n + j)*n + k;
+                B( r, r)= 6.;
+                if (i > 0)     B( r, r - n*n)= -1. - c;
+                if (i < n - 1) B( r, r + n*n)= -1. + c;
+                if (j > 0)     B( r, r - n)= -1.;
+                if (j < n - 1) B( r, r + n)= -1.;
+                if (k > 0)     B( r, r - 1)= -1.;
+                if (k < n - 1) B( r, r + 1)= -1.;
+            }
+    B.Build();
+}
+
+/// \brief 1D P1 stiffness matrix with n interior nodes on (0,1).
+void BuildLaplace1D (MatrixCL& A, size_t n)
+{
+    const double h= 1./(n + 1);
+    MatrixBuilderCL B( &A, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        B( i, i)= 2./h;
+        if (i > 0)     B( i, i - 1)= -1./h;
+        if (i < n - 1) B( i, i + 1)= -1./h;
+    }
+    B.Build();
+}
+
+/// \brief Linear interpolation from nc to 2*nc+1 interior nodes.
+void BuildProlongation1D (MatrixCL& P, size_t nc)
+{
+    MatrixBuilderCL B( &P, 2*nc + 1, nc);
+    for (size_t i= 0; i < nc; ++i) {
+        B( 2*i,     i)= 0.5;
+        B( 2*i + 1, i)= 1.;
+        B( 2*i + 2, i)= 0.5;
+    }
+    B.Build();
+}
+
+double RelResid (const MatrixCL& A, const VectorCL& x, const VectorCL& b)
+{
+    return norm( VectorCL( A*x - b))/norm( b);
+}
+
+void TestDirect ()
+{
+    MatrixCL A;
+    BuildConvDiff3D( A, 12, 0.);
+    const size_t n= A.num_rows();
+
+    std::vector<size_t> p;
+    NestedDissection( A, p);
+    std::vector<size_t> q( p);
+    std::sort( q.begin(), q.end());
+    bool isPerm= q.size() == n;
+    for (size_t i= 0; i < q.size() && isPerm; ++i)
+        isPerm= q[i] == i;
+    Check( isPerm, "nested dissection: permutation");
+
+    VectorCL b( n), x( n);
+    for (size_t i= 0; i < n; ++i)
+        b[i]= std::sin( 0.1*i) + 0.5;
+    SparseDirectSolverCL solver;
+    solver.Solve( A, x, b);
+    std::cout << "Laplacian: " << n << " unknowns, nonzeros of L and U: " << solver.GetNumNonzeros()
+              << ", levels: " << solver.GetNumLevels() << ", residual: " << RelResid( A, x, b) << '\n';
+    Check( RelResid( A, x, b) < 1e-12, "Laplacian: residual");
+    Check( solver.GetNumLevels() < n/4, "elimination tree of the nested dissection ordering");
+
+    // unchanged matrix: no factorization; changed values: numeric factorization only
+    solver.Solve( A, x, b);
+    Check( solver.GetNumSymbolic() == 1 && solver.GetNumNumeric() == 1, "unchanged matrix");
+    MatrixCL C;
+    BuildConvDiff3D( C, 12, 0.4);
+    solver.Solve( C, x, b);
+    Check( solver.GetNumSymbolic() == 1 && solver.GetNumNumeric() == 2, "changed values");
+    Check( RelResid( C, x, b) < 1e-12, "convection-diffusion: residual");
+
+    // changed pattern: new symbolic factorization
+    BuildConvDiff3D( C, 10, 0.4);
+    VectorCL b2( 1., C.num_rows()), x2( C.num_rows());
+    solver.Solve( C, x2, b2);
+    Check( solver.GetNumSymbolic() == 2 && solver.GetNumNumeric() == 3, "changed pattern");
+    Check( RelResid( C, x2, b2) < 1e-12, "changed pattern: residual");
+
+    // singular matrix
+    MatrixCL Z( A);
+    Z*= 0.;
+    bool thrown= false;
+    try {
+        solver.Solve( Z, x, b);
+    }
+    catch (DROPSErrCL) { thrown= true; }
+    Check( thrown, "zero pivot");
+}
+
+void TestCoarse ()
+{
+    const size_t numLvl= 7;
+    SSORsmoothCL smoother( 1.0);
+    SSORPcCL     ssor;
+    PCG_SsorCL   pcg( ssor, 500, 1e-6, true);
+    typedef CoarseGridSolverCL<PCG_SsorCL> CoarseT;
+    CoarseT      coarse( pcg, true);
+    typedef MGSolverCL<SSORsmoothCL, CoarseT> MGCL;
+    MGCL mg( smoother, coarse, 1, -1., false);
+
+    MLMatrixCL A( numLvl);
+    size_t n= 31;
+    mg.GetProlongation()->resize( numLvl);
+    MLMatrixCL::iterator a= A.begin(), p= mg.GetProlongation()->begin();
+    for (size_t l= 0; l < numLvl; ++l, ++a, ++p) {
+        BuildLaplace1D( *a, n);
+        if (l > 0)
+            BuildProlongation1D( *p, (n - 1)/2);
+        n= 2*n + 1;
+    }
+    n= A.num_rows();
+    VectorCL b( n), x( n);
+    for (size_t i= 0; i < n; ++i)
+        b[i]= std::sin( 0.01*i) + 1.;
+
+    typedef SolverAsPreCL<MGCL> MGPcCL;
+    MGPcCL pc( mg);
+    PCGSolverCL<MGPcCL> cg( pc, 100, 1e-10, true);
+    cg.Solve( A, x, b);
+    std::cout << "PCG with MG and direct coarse grid solver: iterations " << cg.GetIter() << '\n';
+    Check( cg.GetResid() <= 1e-10, "MG with direct coarse grid solver");
+    Check( coarse.GetDirectSolver().GetNumNumeric() == 1, "MG: one factorization of the coarse grid matrix");
+
+    mg.SetSinglePrecision( true);
+    x= 0.;
+    cg.Solve( A, x, b);
+    Check( cg.GetResid() <= 1e-10, "single precision MG with direct coarse grid solver");
+    Check( coarse.GetDirectSolver().GetNumSymbolic() == 1, "single precision MG: symbolic factorization is kept");
+
+    coarse.SetDirect( false);
+    x= 0.;
+    cg.Solve( A, x, b);
+    Check( cg.GetResid() <= 1e-10, "MG with iterative coarse grid solver");
+}
+
+int main ()
+{
+  try {
+    TestDirect();
+    TestCoarse();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,194 @@
+/// \file spgemm.cpp
+/// \brief tests the parallel transpose, linear combinations and sparse matrix-matrix products
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "num/spmat.h"
+#include <iostream>
+#include <cmath>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+/// \brief Random sparse matrix with about nzPerRow entries per row.
+void BuildRandom (MatrixCL& A, size_t rows, size_t cols, size_t nzPerRow, unsigned int seed)
+{
+    std::srand( seed);
+    MatrixBuilderCL B( &A, rows, cols);
+    for (size_t i= 0; i < rows; ++i)
+        for (size_t k= 0; k < nzPerRow; ++k)
+            B( i, std::rand()%cols)+= 1. + std::rand()%10;
+    B.Build();
+}
+
+/// \brief 1D P1 stiffness matrix with n interior nodes on (0,1).
+void BuildLaplace1D (MatrixCL& A, size_t n)
+{
+    const double h= 1./(n + 1);
+    MatrixBuilderCL B( &A, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        B( i, i)= 2./h;
+        if (i > 0)     B( i, i - 1)= -1./h;
+        if (i < n - 1) B( i, i + 1)= -1./h;
+    }
+    B.Build();
+}
+
+/// \brief Linear interpolation from nc to 2*nc+1 interior nodes.
+void BuildProlongation1D (MatrixCL& P, size_t nc)
+{
+    MatrixBuilderCL B( &P, 2*nc + 1, nc);
+    for (size_t i= 0; i < nc; ++i) {
+        B( 2*i,     i)= 0.5;
+        B( 2*i + 1, i)= 1.;
+        B( 2*i + 2, i)= 0.5;
+    }
+    B.Build();
+}
+
+/// \brief Maximal difference of the entries; the patterns may differ.
+double MaxDiff (const MatrixCL& A, const MatrixCL& B)
+{
+    MatrixCL D;
+    D.LinComb( 1., A, -1., B);
+    return supnorm( D);
+}
+
+bool SamePattern (const MatrixCL& A, const MatrixCL& B)
+{
+    return A.num_rows() == B.num_rows() && A.num_cols() == B.num_cols() && A.num_nonzeros() == B.num_nonzeros()
+        && std::equal( A.raw_row(), A.raw_row() + A.num_rows() + 1, B.raw_row())
+        && std::equal( A.raw_col(), A.raw_col() + A.num_nonzeros(), B.raw_col());
+}
+
+void TestTranspose ()
+{
+    MatrixCL A, At, Att;
+    BuildRandom( A, 1000, 700, 8, 1);
+    transpose( A, At);
+    Check( At.num_rows() == 700 && At.num_cols() == 1000 && At.num_nonzeros() == A.num_nonzeros(), "transpose: dimensions");
+    bool sorted= true;
+    for (size_t i= 0; i < At.num_rows(); ++i)
+        for (size_t k= At.row_beg( i) + 1; k < At.row_beg( i + 1); ++k)
+            sorted= sorted && At.col_ind( k - 1) < At.col_ind( k);
+    Check( sorted, "transpose: column indices are ascending");
+    VectorCL x( 1000);
+    for (size_t i= 0; i < x.size(); ++i)
+        x[i]= std::sin( 0.1*i);
+    Check( norm( VectorCL( At*x - transp_mul( A, x))) < 1e-12*norm( x), "transpose: A^T x");
+    transpose( At, Att);
+    Check( SamePattern( A, Att) && MaxDiff( A, Att) == 0., "transpose: (A^T)^T == A");
+}
+
+void TestLinComb ()
+{
+    MatrixCL A, B, C, D, R, R3, R4;
+    BuildRandom( A, 500, 400, 5, 2);
+    BuildRandom( B, 500, 400, 5, 3);
+    BuildRandom( C, 500, 400, 5, 4);
+    BuildRandom( D, 500, 400, 5, 5);
+    R.LinComb( 1., A, 2., B);
+    R3.LinComb( 1., R, -3., C);
+    R.LinComb( 1., A, 2., B, -3., C);
+    Check( SamePattern( R, R3) && MaxDiff( R, R3) < 1e-12, "LinComb of three matrices");
+    R4.LinComb( 1., R3, 0.5, D);
+    R.LinComb( 1., A, 2., B, -3., C, 0.5, D);
+    Check( SamePattern( R, R4) && MaxDiff( R, R4) < 1e-12, "LinComb of four matrices");
+}
+
+void TestProduct ()
+{
+    MatrixCL A, B, C;
+    BuildRandom( A, 300, 200, 6, 6);
+    BuildRandom( B, 200, 250, 6, 7);
+    SparseMatProductCL<> prod;
+    prod.Multiply( A, B, C);
+    Check( C.num_rows() == 300 && C.num_cols() == 250, "product: dimensions");
+    VectorCL x( 250);
+    for (size_t i= 0; i < x.size(); ++i)
+        x[i]= std::cos( 0.3*i);
+    const VectorCL ABx( A*VectorCL( B*x));
+    Check( norm( VectorCL( C*x - ABx)) < 1e-12*norm( ABx), "product: (AB)x == A(Bx)");
+    std::cout << "product: " << C.num_nonzeros() << " nonzeros\n";
+
+    // changed values: numeric phase only
+    MatrixCL A2( A);
+    A2*= 2.;
+    MatrixCL C2;
+    prod.Multiply( A2, B, C2);
+    Check( prod.GetNumSymbolic() == 1 && prod.GetNumNumeric() == 2, "product: reuse of the symbolic phase");
+    MatrixCL C2ref( C);
+    C2ref*= 2.;
+    Check( SamePattern( C, C2) && MaxDiff( C2, C2ref) < 1e-12*supnorm( C2), "product: changed values");
+
+    // changed pattern: new symbolic phase
+    BuildRandom( A2, 300, 200, 7, 8);
+    prod.Multiply( A2, B, C2);
+    Check( prod.GetNumSymbolic() == 2, "product: changed pattern");
+    const VectorCL A2Bx( A2*VectorCL( B*x));
+    Check( norm( VectorCL( C2*x - A2Bx)) < 1e-12*norm( A2Bx), "product: changed pattern, (AB)x == A(Bx)");
+}
+
+void TestGalerkin ()
+{
+    // P^T A_h P is the stiffness matrix of the coarse grid.
+    MatrixCL Af, Ac, P, Pt, G;
+    BuildLaplace1D( Af, 63);
+    BuildLaplace1D( Ac, 31);
+    BuildProlongation1D( P, 31);
+    transpose( P, Pt);
+    galerkin_product( Pt, Af, P, G);
+    Check( G.num_rows() == 31 && G.num_cols() == 31, "Galerkin product: dimensions");
+    Check( MaxDiff( G, Ac) < 1e-10*supnorm( Ac), "Galerkin product: coarse stiffness matrix");
+
+    // the diagonal of B diag(d) B^T
+    MatrixCL B, Bt, S;
+    BuildRandom( B, 100, 300, 6, 9);
+    transpose( B, Bt);
+    VectorCL d( 300);
+    for (size_t i= 0; i < d.size(); ++i)
+        d[i]= 1. + 0.01*i;
+    BDBT( B, Bt, d, S);
+    Check( norm( VectorCL( S.GetDiag() - B.GetSchurDiag( d))) < 1e-12*norm( S.GetDiag()), "B D B^T: diagonal");
+}
+
+int main ()
+{
+  try {
+    TestTranspose();
+    TestLinComb();
+    TestProduct();
+    TestGalerkin();
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
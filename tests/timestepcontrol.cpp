@@ -0,0 +1,167 @@
+/// \file timestepcontrol.cpp
+/// \brief tests the adaptive time step control and the update of the Schur complement weights
+/// \author agent
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2026 agent
+*/
+
+#include "levelset/coupling.h"
+#include "geom/builder.h"
+#include <iostream>
+#include <cmath>
+
+using namespace DROPS;
+
+int err= 0;
+
+void Check (bool cond, const std::string& msg)
+{
+    if (!cond) {
+        ++err;
+        std::cout << "error: " << msg << std::endl;
+    }
+}
+
+bool Equal (double a, double b)
+{
+    return std::fabs( a - b) <= 1e-12*std::fabs( b);
+}
+
+double Sphere (const Point3DCL& p)
+{
+    return (p - MakePoint3D( 0.5, 0.5, 0.5)).norm() - 0.3;
+}
+
+/// \brief Constant velocity with |u| = 2.
+Point3DCL Vel (const Point3DCL&, double)
+{
+    return MakePoint3D( 2., 0., 0.);
+}
+
+/// \brief Schur complement preconditioner, which only stores its weights.
+class WeightsPreCL : public SchurPreBaseCL
+{
+  public:
+    WeightsPreCL (double kA, double kM) : SchurPreBaseCL( kA, kM) {}
+    void Apply (const MatrixCL&,   VectorCL& x, const VectorCL& b) const { x= b; }
+    void Apply (const MLMatrixCL&, VectorCL& x, const VectorCL& b) const { x= b; }
+};
+
+/// \brief Time discretization without steps; SetTimeStep is overwritten as in the schemes of coupling.h.
+class NoStepTimeDiscCL : public TimeDisc2PhaseCL
+{
+  private:
+    typedef TimeDisc2PhaseCL base_;
+
+  public:
+    NoStepTimeDiscCL (StokesT& Stokes, LevelsetP2CL& ls, LevelsetModifyCL& lsetmod, double dt)
+        : base_( Stokes, ls, lsetmod, dt) {}
+
+    void SetTimeStep (double dt) { base_::SetTimeStep( dt); }
+    void DoStep (int) {}
+    void Update () {}
+};
+
+int main ()
+{
+  try {
+    // all tetras have an edge of length 1/6
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 6, 6, 6);
+    MultiGridCL mg( brick);
+    const double h= 1./6.;
+
+    instat_scalar_fun_ptr sigmaf( 0);
+    SurfaceTensionCL sf( sigmaf);
+    BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    LsetBndDataCL::bnd_val_fun lsfun[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, lsbc, lsfun);
+    LevelsetP2CL lset( mg, lsbnd, sf, 0.1);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    StokesBndDataCL::bnd_val_fun bfun[6]= { &Vel, &Vel, &Vel, &Vel, &Vel, &Vel };
+    StokesBndDataCL bnd( 6, bc, bfun);
+    const double rho1= 1., rho2= 3., sigma= 0.5;
+    TwoPhaseFlowCoeffCL coeff( rho1, rho2, 1., 1., sigma, MakePoint3D( 0., 0., 0.));
+    StokesT Stokes( mg, coeff, bnd);
+    MLIdxDescCL* vidx= &Stokes.vel_idx;
+    Stokes.CreateNumberingVel( mg.GetLastLevel(), vidx);
+    Stokes.v.SetIdx( vidx);
+    Stokes.b.SetIdx( vidx);
+    Stokes.InitVel( &Stokes.v, Vel);
+    const VectorCL v0( Stokes.v.Data);
+
+    // CFL bound: cfl h/|u|
+    TimeStepControlCL cfl( 1e-6, 1., 0.5, 0., rho1 + rho2, sigma);
+    double dt= cfl.Compute( Stokes, lset, 1., true, v0);
+    std::cout << "CFL bound " << cfl.GetCFLTimeStep() << ", next step " << dt << '\n';
+    Check( Equal( cfl.GetCFLTimeStep(), 0.5*h/2.) && Equal( dt, 0.5*h/2.), "CFL bound");
+    Check( cfl.GetCapillaryTimeStep() == -1. && cfl.GetErrorEstimate() == -1., "unused bounds are not computed");
+
+    // capillary bound: sqrt( (rho_1+rho_2) h^3/(4 pi sigma)) for the smallest edge of the cut tetras
+    TimeStepControlCL cap( 1e-6, 1., 0., 1., rho1 + rho2, sigma);
+    dt= cap.Compute( Stokes, lset, 1., true, v0);
+    const double dtCap= std::sqrt( (rho1 + rho2)*h*h*h/(4.*M_PI*sigma));
+    std::cout << "capillary bound " << cap.GetCapillaryTimeStep() << ", next step " << dt << '\n';
+    Check( Equal( cap.GetCapillaryTimeStep(), dtCap) && Equal( dt, dtCap), "capillary bound");
+
+    // growth, hysteresis, non-converged coupling iteration, range
+    TimeStepControlCL grow( 1e-6, 1., 0., 0., rho1 + rho2, sigma, 0., 2., 1.25);
+    Check( Equal( grow.Compute( Stokes, lset, 0.1, true, v0), 0.2), "growth of the step size");
+    Check( Equal( grow.Compute( Stokes, lset, 0.1, false, v0), 0.05), "coupling iteration not converged");
+    Check( Equal( grow.Compute( Stokes, lset, 0.8, true, v0), 1.), "maximal step size");
+    TimeStepControlCL keep( 1e-6, 1., 0., 0., rho1 + rho2, sigma, 0., 1.2, 1.25);
+    Check( Equal( keep.Compute( Stokes, lset, 0.1, true, v0), 0.1), "hysteresis keeps the step size");
+    TimeStepControlCL small( 0.06, 1., 0., 0., rho1 + rho2, sigma, 0., 2., 1.25);
+    Check( Equal( small.Compute( Stokes, lset, 0.1, false, v0), 0.06), "minimal step size");
+
+    // error controller: exact for velocities, which are linear in time
+    TimeStepControlCL errctl( 1e-6, 1., 0., 0., rho1 + rho2, sigma, 1e-4, 10., 1.25);
+    Stokes.v.Data= 1.*v0;
+    errctl.Compute( Stokes, lset, 0.1, true, VectorCL( 0.*v0));
+    Check( errctl.GetErrorEstimate() == -1., "no error estimate without history");
+    Stokes.v.Data= 2.*v0;
+    dt= errctl.Compute( Stokes, lset, 0.1, true, VectorCL( 1.*v0));
+    Check( errctl.GetErrorEstimate() == 0. && Equal( dt, 1.), "linear velocity: no restriction");
+    Stokes.v.Data= 3.3*v0;
+    dt= errctl.Compute( Stokes, lset, 0.1, true, VectorCL( 2.*v0));
+    const double e= 0.3/3.3;
+    std::cout << "error estimate " << errctl.GetErrorEstimate() << ", next step " << dt << '\n';
+    Check( Equal( errctl.GetErrorEstimate(), e) && Equal( dt, 0.9*0.1*std::sqrt( 1e-4/e)), "error controller");
+    Stokes.v.Data= v0;
+
+    // the one-argument SetTimeStep updates the weight 1/dt of the Schur complement preconditioner
+    LevelsetModifyCL lsetmod( 0, 0, 1., 1., 0, 0.);
+    NoStepTimeDiscCL nostep( Stokes, lset, lsetmod, 0.1);
+    WeightsPreCL ispc( 1./0.1, 0.5);
+    nostep.SetSchurPrePtr( &ispc);
+    TimeDisc2PhaseCL& timedisc= nostep;
+    timedisc.SetTimeStep( 0.025);
+    Check( Equal( ispc.GetWeightA(), 40.) && ispc.GetWeightM() == 0.5 && timedisc.GetTimeStep() == 0.025,
+        "SetTimeStep updates the Schur complement weights");
+    Check( Equal( grow.Compute( timedisc, v0), 0.05), "Compute for a TimeDisc2PhaseCL");
+
+    std::cout << "errors: " << err << std::endl;
+    return err != 0;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
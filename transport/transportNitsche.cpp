@@ -515,6 +515,14 @@ void TransportP1XCL::GetSolutionOnPart( VecDescCL& ct_part, bool pPart, bool Is_
     if (!Is_ct && (GetHenry(pPart)!=1.0)) cp/=GetHenry(pPart);
 }
 
+const InterfaceBandCL* TransportP1XCL::GetInterfaceBand( Uint lvl) const
+{
+    if (lvl != lset_.GetLevel())
+        return 0;
+    band_.Update( MG_, lset_, Bnd_ls_);
+    return &band_;
+}
+
 ///Assembles the Nitsche Bilinearform. Gathers the weighting functions and calls the Local NitscheSetup for each
 ///intersected tetrahedron
 void TransportP1XCL::SetupNitscheSystem( MatrixCL& matA, IdxDescCL& RowIdx/*, bool new_time */) const
@@ -533,7 +541,8 @@ void TransportP1XCL::SetupNitscheSystem( MatrixCL& matA, IdxDescCL& RowIdx/*, bo
     const MultiGridCL& mg= this->GetMG();
     BndDataCL<> Bndlset(mg.GetBnd().GetNumBndSeg());    
 
-    DROPS_FOR_TRIANG_TETRA( MG_, /*default level*/lvl, it)
+    const InterfaceBandCL* band= GetInterfaceBand( lvl);
+    DROPS_FOR_BAND_CONST_TETRA( band, MG_, /*default level*/lvl, it)
     {
         InterfaceTetraCL patch;
         patch.Init( *it, lset_,0.);
@@ -758,7 +767,8 @@ double TransportP1XCL::Interface_L2error() const
     LocalNumbP1CL ln;
     double err_sq=0.;
 
-    DROPS_FOR_TRIANG_TETRA( MG_, /*default level*/lvl, it)
+    const InterfaceBandCL* band= GetInterfaceBand( lvl);
+    DROPS_FOR_BAND_CONST_TETRA( band, MG_, /*default level*/lvl, it)
     {
         InterfaceTriangleCL triangle;
         triangle.Init( *it, lset_,0.);
@@ -132,6 +132,7 @@ class TransportP1XCL
     instat_scalar_fun_ptr c_;        ///<mass/reaction term
     double omit_bound_;              ///discard criteria for XFEM-Basis
     double sdstab_;
+    mutable InterfaceBandCL band_;   ///< tetras cut by the interface lset_
     void SetupInstatSystem(MatrixCL&, VecDescCL*, MatrixCL&, VecDescCL*, MatrixCL&, VecDescCL*, VecDescCL*,
         IdxDescCL&, const double) const;
     void SetupNitscheSystem( MatrixCL&, IdxDescCL&)const;
@@ -140,6 +141,8 @@ class TransportP1XCL
     void SetupInstatMixedSystem(MatrixCL&, VecDescCL*, MatrixCL&, VecDescCL*, MatrixCL&, VecDescCL*, VecDescCL*,
         IdxDescCL&, IdxDescCL&, const double) const;
     void SetupMixedNitscheSystem( MatrixCL&, IdxDescCL&, IdxDescCL&, const double) const;
+    /// \brief Tetras cut by the interface, if lvl is the level of lset_; 0 otherwise, i.e., all tetras of lvl must be visited.
+    const InterfaceBandCL* GetInterfaceBand( Uint lvl) const;
 
   public:
 /*    TransportP1XCL( MultiGridCL& mg, BndDataT& Bnd, BndDataT& Bndt, const VelBndDataT& Bnd_v, LsetBndDataCL& Bnd_ls,